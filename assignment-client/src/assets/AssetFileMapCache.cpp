@@ -0,0 +1,126 @@
+//
+//  AssetFileMapCache.cpp
+//  assignment-client/src/assets
+//
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AssetFileMapCache.h"
+
+#include <QtCore/QMutexLocker>
+
+#include "AssetServerLogging.h"
+
+// the limit is on address space rather than resident memory, the kernel pages mapped assets in and out as needed
+const qint64 AssetFileMapCache::DEFAULT_MAX_MAPPED_BYTES = 4LL * 1024 * 1024 * 1024;
+// keep well clear of the default open file descriptor limits
+const int AssetFileMapCache::DEFAULT_MAX_MAPPED_FILES = 256;
+
+MappedAssetFile::MappedAssetFile(const QString& filePath) : _file(filePath) {
+    if (!_file.open(QIODevice::ReadOnly)) {
+        return;
+    }
+
+    _size = _file.size();
+    if (_size == 0) {
+        // empty files can't be mapped, but are still valid assets
+        _isValid = true;
+        return;
+    }
+
+    _data = reinterpret_cast<const char*>(_file.map(0, _size));
+    if (_data) {
+        _isValid = true;
+    } else {
+        qCWarning(asset_server) << "Failed to map asset file" << filePath << _file.errorString();
+        _size = 0;
+    }
+}
+
+MappedAssetFile::~MappedAssetFile() {
+    if (_data) {
+        _file.unmap(reinterpret_cast<uchar*>(const_cast<char*>(_data)));
+    }
+}
+
+AssetFileMapCache::AssetFileMapCache(qint64 maxMappedBytes, int maxMappedFiles) :
+    _maxMappedBytes(maxMappedBytes),
+    _maxMappedFiles(maxMappedFiles)
+{
+}
+
+MappedAssetFilePointer AssetFileMapCache::map(const AssetUtils::AssetHash& hash, const QString& filePath) {
+    {
+        QMutexLocker locker(&_mutex);
+        auto it = _entries.find(hash);
+        if (it != _entries.end()) {
+            _lru.splice(_lru.begin(), _lru, it.value());
+            return _lru.front().second;
+        }
+    }
+
+    // map outside of the lock, opening the file can block on the disk
+    auto mappedFile = std::make_shared<const MappedAssetFile>(filePath);
+    if (!mappedFile->isValid()) {
+        return nullptr;
+    }
+
+    if (mappedFile->getSize() > _maxMappedBytes) {
+        // too big to keep around, the caller still gets to use the mapping
+        return mappedFile;
+    }
+
+    QMutexLocker locker(&_mutex);
+    auto it = _entries.find(hash);
+    if (it != _entries.end()) {
+        // another task mapped the same file in the meantime, share theirs
+        _lru.splice(_lru.begin(), _lru, it.value());
+        return _lru.front().second;
+    }
+
+    _lru.emplace_front(hash, mappedFile);
+    _entries.insert(hash, _lru.begin());
+    _mappedBytes += mappedFile->getSize();
+    evict();
+
+    return mappedFile;
+}
+
+void AssetFileMapCache::invalidate(const AssetUtils::AssetHash& hash) {
+    QMutexLocker locker(&_mutex);
+    auto it = _entries.find(hash);
+    if (it != _entries.end()) {
+        _mappedBytes -= it.value()->second->getSize();
+        _lru.erase(it.value());
+        _entries.erase(it);
+    }
+}
+
+void AssetFileMapCache::clear() {
+    QMutexLocker locker(&_mutex);
+    _lru.clear();
+    _entries.clear();
+    _mappedBytes = 0;
+}
+
+int AssetFileMapCache::getNumMappedFiles() const {
+    QMutexLocker locker(&_mutex);
+    return _entries.size();
+}
+
+qint64 AssetFileMapCache::getNumMappedBytes() const {
+    QMutexLocker locker(&_mutex);
+    return _mappedBytes;
+}
+
+void AssetFileMapCache::evict() {
+    while (!_lru.empty() && (_mappedBytes > _maxMappedBytes || (int)_lru.size() > _maxMappedFiles)) {
+        auto& leastRecentlyUsed = _lru.back();
+        _mappedBytes -= leastRecentlyUsed.second->getSize();
+        _entries.remove(leastRecentlyUsed.first);
+        _lru.pop_back();
+    }
+}
@@ -0,0 +1,78 @@
+//
+//  AssetFileMapCache.h
+//  assignment-client/src/assets
+//
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AssetFileMapCache_h
+#define hifi_AssetFileMapCache_h
+
+#include <list>
+#include <memory>
+
+#include <QtCore/QFile>
+#include <QtCore/QHash>
+#include <QtCore/QMutex>
+#include <QtCore/QString>
+
+#include <AssetUtils.h>
+
+// A read-only memory mapping of an asset file. The mapping stays valid for as long as something holds a pointer to it,
+// even if it has since been evicted from the AssetFileMapCache.
+class MappedAssetFile {
+public:
+    MappedAssetFile(const QString& filePath);
+    ~MappedAssetFile();
+
+    bool isValid() const { return _isValid; }
+    const char* getData() const { return _data; }
+    qint64 getSize() const { return _size; }
+
+private:
+    QFile _file;
+    const char* _data { nullptr };
+    qint64 _size { 0 };
+    bool _isValid { false };
+};
+
+using MappedAssetFilePointer = std::shared_ptr<const MappedAssetFile>;
+
+// Bounded LRU cache of asset file mappings, shared by the SendAssetTasks running on the transfer thread pool so that
+// concurrent downloads of the same asset share one mapping instead of each reading the file into memory.
+class AssetFileMapCache {
+public:
+    static const qint64 DEFAULT_MAX_MAPPED_BYTES;
+    static const int DEFAULT_MAX_MAPPED_FILES;
+
+    AssetFileMapCache(qint64 maxMappedBytes = DEFAULT_MAX_MAPPED_BYTES, int maxMappedFiles = DEFAULT_MAX_MAPPED_FILES);
+
+    // Returns the mapping for the asset file at filePath, or nullptr if the file cannot be opened.
+    MappedAssetFilePointer map(const AssetUtils::AssetHash& hash, const QString& filePath);
+
+    // Drops the cached mapping for hash, called when the asset file is removed from disk.
+    void invalidate(const AssetUtils::AssetHash& hash);
+    void clear();
+
+    int getNumMappedFiles() const;
+    qint64 getNumMappedBytes() const;
+
+private:
+    // must be called with _mutex held
+    void evict();
+
+    using LRUList = std::list<std::pair<AssetUtils::AssetHash, MappedAssetFilePointer>>;
+
+    mutable QMutex _mutex;
+    LRUList _lru; // most recently used first
+    QHash<AssetUtils::AssetHash, LRUList::iterator> _entries;
+    qint64 _mappedBytes { 0 };
+
+    const qint64 _maxMappedBytes;
+    const int _maxMappedFiles;
+};
+
+#endif // hifi_AssetFileMapCache_h
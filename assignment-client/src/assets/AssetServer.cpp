@@ -12,6 +12,7 @@
 
 #include "AssetServer.h"
 
+#include <algorithm>
 #include <thread>
 #include <memory>
 
@@ -25,6 +26,7 @@
 #include <QtCore/QJsonDocument>
 #include <QtCore/QSaveFile>
 #include <QtCore/QString>
+#include <QtCore/QThread>
 #include <QtGui/QImageReader>
 #include <QtCore/QVector>
 #include <QtCore/QUrlQuery>
@@ -125,12 +127,66 @@ void AssetServer::bakeAsset(const AssetUtils::AssetHash& assetHash, const AssetU
         connect(task.get(), &BakeAssetTask::bakeFailed, this, &AssetServer::handleFailedBake);
         connect(task.get(), &BakeAssetTask::bakeAborted, this, &AssetServer::handleAbortedBake);
 
-        _bakingTaskPool.start(task.get());
+        // bakes wait in our queue rather than the thread pool's, so that they only start once they fit in the memory budget
+        _queuedBakes.push_back({ task, estimateBakeMemoryUsage(assetPath, filePath) });
+        startQueuedBakes();
     } else {
         qDebug() << "Already in queue";
     }
 }
 
+qint64 AssetServer::estimateBakeMemoryUsage(const AssetUtils::AssetPath& assetPath, const QString& filePath) {
+    // rough peak memory used by the oven relative to the size of the source file:
+    // models are parsed into an HFM model plus draco meshes, and compressed images are decoded to RGBA with mips
+    static const qint64 MODEL_BAKE_MEMORY_FACTOR = 10;
+    static const qint64 TEXTURE_BAKE_MEMORY_FACTOR = 16;
+    static const qint64 DEFAULT_BAKE_MEMORY_FACTOR = 2;
+    // baseline for the oven process itself
+    static const qint64 MIN_BAKE_MEMORY_USAGE = 64 * 1024 * 1024;
+
+    auto fileSize = QFileInfo(filePath).size();
+    qint64 factor;
+    switch (assetTypeForFilename(assetPath)) {
+        case BakedAssetType::Model:
+            factor = MODEL_BAKE_MEMORY_FACTOR;
+            break;
+        case BakedAssetType::Texture:
+            factor = TEXTURE_BAKE_MEMORY_FACTOR;
+            break;
+        default:
+            factor = DEFAULT_BAKE_MEMORY_FACTOR;
+            break;
+    }
+    return MIN_BAKE_MEMORY_USAGE + fileSize * factor;
+}
+
+void AssetServer::startQueuedBakes() {
+    while (!_queuedBakes.empty() && _runningBakeMemory.size() < _bakingTaskPool.maxThreadCount()) {
+        auto& queuedBake = _queuedBakes.front();
+
+        // a bake bigger than the whole budget still gets to run, but only on its own
+        qint64 memoryInUse = 0;
+        for (auto memory : _runningBakeMemory) {
+            memoryInUse += memory;
+        }
+        if (!_runningBakeMemory.empty() && memoryInUse + queuedBake.estimatedMemory > _bakingMemoryBudget) {
+            break;
+        }
+
+        auto task = queuedBake.task;
+        _runningBakeMemory[task->getAssetHash()] = queuedBake.estimatedMemory;
+        _queuedBakes.pop_front();
+
+        _bakingTaskPool.start(task.get());
+    }
+}
+
+void AssetServer::finishBake(const AssetUtils::AssetHash& assetHash) {
+    _pendingBakes.remove(assetHash);
+    _runningBakeMemory.remove(assetHash);
+    startQueuedBakes();
+}
+
 QString AssetServer::getPathToAssetHash(const AssetUtils::AssetHash& assetHash) {
     return _filesDirectory.absoluteFilePath(assetHash);
 }
@@ -294,6 +350,8 @@ void updateConsumedCores() {
 AssetServer::AssetServer(ReceivedMessage& message) :
     ThreadedAssignment(message),
     _transferTaskPool(this),
+    _fileMapCache(std::make_shared<AssetFileMapCache>()),
+    _hotAssetCache(std::make_shared<HotAssetCache>()),
     _bakingTaskPool(this),
     _filesizeLimit(AssetUtils::MAX_UPLOAD_SIZE)
 {
@@ -304,7 +362,7 @@ AssetServer::AssetServer(ReceivedMessage& message) :
     // so the ideal is greater than the number of cores on the system.
     static const int TASK_POOL_THREAD_COUNT = 50;
     _transferTaskPool.setMaxThreadCount(TASK_POOL_THREAD_COUNT);
-    _bakingTaskPool.setMaxThreadCount(1);
+    _bakingTaskPool.setMaxThreadCount(std::max(1, QThread::idealThreadCount() / 2));
 
     // Queue all requests until the Asset Server is fully setup
     auto& packetReceiver = DependencyManager::get<NodeList>()->getPacketReceiver();
@@ -331,12 +389,23 @@ void AssetServer::aboutToFinish() {
     // remove pending transfer tasks
     _transferTaskPool.clear();
 
+    // release our hold on asset file mappings, tasks that are still running keep the ones they use alive
+    _fileMapCache->clear();
+    _hotAssetCache->clear();
+
+    // drop the bakes that are still waiting for room in the memory budget
+    for (auto& queuedBake : _queuedBakes) {
+        _pendingBakes.remove(queuedBake.task->getAssetHash());
+    }
+    _queuedBakes.clear();
+
     // abort each of our still running bake tasks, remove pending bakes that were never put on the thread pool
     auto it = _pendingBakes.begin();
     while (it != _pendingBakes.end()) {
         auto pendingRunnable =  _bakingTaskPool.tryTake(it->get());
 
         if (pendingRunnable) {
+            _runningBakeMemory.remove(it.key());
             it = _pendingBakes.erase(it);
         } else {
             qDebug() << "Aborting bake for" << it.key();
@@ -393,6 +462,22 @@ void AssetServer::completeSetup() {
                     " (" << maxBandwidth << "bits/s)";
     }
 
+    // get the limits on concurrent baking, before the initial bake of our assets is queued
+    static const QString MAX_CONCURRENT_BAKES_OPTION = "max_concurrent_bakes";
+    auto maxConcurrentBakes = assetServerObject[MAX_CONCURRENT_BAKES_OPTION].toInt(0);
+    if (maxConcurrentBakes > 0) {
+        _bakingTaskPool.setMaxThreadCount(maxConcurrentBakes);
+    }
+
+    static const QString BAKING_MEMORY_BUDGET_OPTION = "baking_memory_budget";
+    static const qint64 BYTES_PER_MEGABYTE = 1024 * 1024;
+    auto bakingMemoryBudget = assetServerObject[BAKING_MEMORY_BUDGET_OPTION].toInt(0);
+    if (bakingMemoryBudget > 0) {
+        _bakingMemoryBudget = bakingMemoryBudget * BYTES_PER_MEGABYTE;
+    }
+    qCInfo(asset_server) << "Running up to" << _bakingTaskPool.maxThreadCount() << "bakes at once, within"
+        << _bakingMemoryBudget / BYTES_PER_MEGABYTE << "MB";
+
     // get the path to the asset folder from the domain server settings
     static const QString ASSETS_PATH_OPTION = "assets_path";
     auto assetsJSONValue = assetServerObject[ASSETS_PATH_OPTION];
@@ -459,6 +544,15 @@ void AssetServer::completeSetup() {
         _filesizeLimit = assetsFilesizeLimit * BITS_PER_MEGABITS;
     }
 
+    // get the size of the in-memory cache of popular assets
+    static const QString ASSETS_MEMORY_CACHE_SIZE_OPTION = "assets_memory_cache_size";
+    auto memoryCacheSizeJSONValue = assetServerObject[ASSETS_MEMORY_CACHE_SIZE_OPTION];
+    auto memoryCacheSize = memoryCacheSizeJSONValue.toInt((int)(HotAssetCache::DEFAULT_CAPACITY / BYTES_PER_MEGABYTE));
+    if (memoryCacheSize >= 0) {
+        _hotAssetCache->setCapacity(memoryCacheSize * BYTES_PER_MEGABYTE);
+        qCInfo(asset_server) << "Set in-memory asset cache size to" << memoryCacheSize << "MB";
+    }
+
     PathUtils::removeTemporaryApplicationDirs();
     PathUtils::removeTemporaryApplicationDirs("Oven");
 
@@ -543,6 +637,8 @@ void AssetServer::cleanupUnmappedFiles() {
                 // remove the unmapped file
                 QFile removeableFile { fileInfo.absoluteFilePath() };
 
+                _fileMapCache->invalidate(filename);
+                _hotAssetCache->invalidate(filename);
                 if (removeableFile.remove()) {
                     qCDebug(asset_server) << "\tDeleted" << filename << "from asset files directory since it is unmapped.";
 
@@ -872,7 +968,7 @@ void AssetServer::handleAssetGet(QSharedPointer<ReceivedMessage> message, Shared
     }
 
     // Queue task
-    auto task = new SendAssetTask(message, senderNode, _filesDirectory);
+    auto task = new SendAssetTask(message, senderNode, _filesDirectory, _fileMapCache, _hotAssetCache);
     _transferTaskPool.start(task);
 }
 
@@ -886,7 +982,8 @@ void AssetServer::handleAssetUpload(QSharedPointer<ReceivedMessage> message, Sha
     if (canWriteToAssetServer) {
         qCDebug(asset_server) << "Starting an UploadAssetTask for upload from" << message->getSourceID();
 
-        auto task = new UploadAssetTask(message, senderNode, _filesDirectory, _filesizeLimit);
+        auto task = new UploadAssetTask(message, senderNode, _filesDirectory, _filesizeLimit,
+                                        _fileMapCache, _hotAssetCache);
         _transferTaskPool.start(task);
     } else {
         // this is a node the domain told us is not allowed to rez entities
@@ -965,6 +1062,8 @@ void AssetServer::sendStatsPacket() {
         serverStats[uuid] = nodeStats;
     });
 
+    serverStats["Hot Asset Cache"] = _hotAssetCache->getStatsJSON();
+
     // send off the stats packets
     ThreadedAssignment::addPacketStatsAndSendStatsPacket(serverStats);
 }
@@ -1180,6 +1279,8 @@ bool AssetServer::deleteMappings(const AssetUtils::AssetPathList& paths) {
             // remove the unmapped file
             QFile removeableFile { _filesDirectory.absoluteFilePath(hash) };
 
+            _fileMapCache->invalidate(hash);
+            _hotAssetCache->invalidate(hash);
             if (removeableFile.remove()) {
                 qCDebug(asset_server) << "\tDeleted" << hash << "from asset files directory since it is now unmapped.";
 
@@ -1317,7 +1418,7 @@ void AssetServer::handleFailedBake(QString originalAssetHash, QString assetPath,
 
     writeMetaFile(originalAssetHash, meta);
 
-    _pendingBakes.remove(originalAssetHash);
+    finishBake(originalAssetHash);
 }
 
 void AssetServer::handleCompletedBake(QString originalAssetHash, QString originalAssetPath,
@@ -1340,7 +1441,7 @@ void AssetServer::handleCompletedBake(QString originalAssetHash, QString origina
 
         writeMetaFile(originalAssetHash, meta);
 
-        _pendingBakes.remove(originalAssetHash);
+        finishBake(originalAssetHash);
     };
 
     bool errorCompletingBake { false };
@@ -1473,7 +1574,7 @@ void AssetServer::handleAbortedBake(QString originalAssetHash, QString assetPath
     qDebug() << "Aborted bake:" << originalAssetHash;
 
     // for an aborted bake we don't do anything but remove the BakeAssetTask from our pending bakes
-    _pendingBakes.remove(originalAssetHash);
+    finishBake(originalAssetHash);
 }
 
 static const QString BAKE_VERSION_KEY = "bake_version";
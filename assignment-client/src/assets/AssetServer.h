@@ -12,6 +12,8 @@
 #ifndef hifi_AssetServer_h
 #define hifi_AssetServer_h
 
+#include <deque>
+
 #include <QtCore/QDir>
 #include <QtCore/QSharedPointer>
 #include <QtCore/QThreadPool>
@@ -19,7 +21,9 @@
 
 #include <ThreadedAssignment.h>
 
+#include "AssetFileMapCache.h"
 #include "AssetUtils.h"
+#include "HotAssetCache.h"
 #include "ReceivedMessage.h"
 
 #include "RegisteredMetaTypes.h"
@@ -71,6 +75,8 @@ struct AssetMeta {
 
 class BakeAssetTask;
 
+static const qint64 DEFAULT_BAKING_MEMORY_BUDGET = 4LL * 1024 * 1024 * 1024;
+
 class AssetServer : public ThreadedAssignment {
     Q_OBJECT
 public:
@@ -137,6 +143,11 @@ private:
     bool needsToBeBaked(const AssetUtils::AssetPath& path, const AssetUtils::AssetHash& assetHash);
     void bakeAsset(const AssetUtils::AssetHash& assetHash, const AssetUtils::AssetPath& assetPath, const QString& filePath);
 
+    /// Start as many queued bakes as the baking thread count and memory budget allow
+    void startQueuedBakes();
+    void finishBake(const AssetUtils::AssetHash& assetHash);
+    qint64 estimateBakeMemoryUsage(const AssetUtils::AssetPath& assetPath, const QString& filePath);
+
     /// Move baked content for asset to baked directory and update baked status
     void handleCompletedBake(QString originalAssetHash, QString assetPath, QString bakedTempOutputDir);
     void handleFailedBake(QString originalAssetHash, QString assetPath, QString errors);
@@ -157,9 +168,25 @@ private:
     /// Task pool for handling uploads and downloads of assets
     QThreadPool _transferTaskPool;
 
+    /// Memory mappings of asset files shared by the download tasks
+    std::shared_ptr<AssetFileMapCache> _fileMapCache;
+
+    /// In-memory cache of recently requested asset ranges
+    std::shared_ptr<HotAssetCache> _hotAssetCache;
+
     QHash<AssetUtils::AssetHash, std::shared_ptr<BakeAssetTask>> _pendingBakes;
     QThreadPool _bakingTaskPool;
 
+    // Bake work is not deduplicated: a model's oven run bakes every texture the model uses, even one that another
+    // model's bake already baked. Only the stored output is shared, since baked files are stored by content hash.
+    struct QueuedBake {
+        std::shared_ptr<BakeAssetTask> task;
+        qint64 estimatedMemory;
+    };
+    std::deque<QueuedBake> _queuedBakes;
+    QHash<AssetUtils::AssetHash, qint64> _runningBakeMemory;
+    qint64 _bakingMemoryBudget { DEFAULT_BAKING_MEMORY_BUDGET };
+
     QMutex _queuedRequestsMutex;
     bool _isQueueingRequests { true };
     using RequestQueue = QVector<QPair<QSharedPointer<ReceivedMessage>, SharedNodePointer>>;
@@ -52,10 +52,17 @@ void BakeAssetTask::run() {
         return;
     }
 
-    // Copy file to bake the temporary dir and give a name the oven can work with
+    // Give the file to bake a name the oven can work with in the temporary dir. Where we can, that is a link to
+    // the asset file rather than a copy of it.
     auto assetName = _assetPath.split("/").last();
     auto tempAssetPath = tempOutputDir + "/" + assetName;
-    auto success = QFile::copy(_filePath, tempAssetPath);
+    bool success = false;
+#ifndef Q_OS_WIN
+    success = QFile::link(_filePath, tempAssetPath);
+#endif
+    if (!success) {
+        success = QFile::copy(_filePath, tempAssetPath);
+    }
     if (!success) {
         QString errors = "Couldn't copy file to bake to temporary directory";
         emit bakeFailed(_assetHash, _assetPath, errors);
@@ -27,6 +27,8 @@ class BakeAssetTask : public QObject, public QRunnable {
 public:
     BakeAssetTask(const AssetUtils::AssetHash& assetHash, const AssetUtils::AssetPath& assetPath, const QString& filePath);
 
+    const AssetUtils::AssetHash& getAssetHash() const { return _assetHash; }
+
     // Thread-safe inspection methods
     bool isBaking() { return _isBaking.load(); }
     bool wasAborted() const { return _wasAborted.load(); }
@@ -0,0 +1,251 @@
+//
+//  HotAssetCache.cpp
+//  assignment-client/src/assets
+//
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "HotAssetCache.h"
+
+#include <algorithm>
+
+#include <QtCore/QMutexLocker>
+
+const qint64 HotAssetCache::DEFAULT_CAPACITY = 256 * 1024 * 1024;
+
+// share of the capacity used for the admission window, W-TinyLFU uses ~1% but asset ranges are coarse grained
+static const int WINDOW_PERCENT = 5;
+// share of the capacity a single range may use
+static const int MAX_ENTRY_FRACTION = 8;
+
+FrequencySketch::FrequencySketch(int width) :
+    _counters(width * DEPTH, 0),
+    _width(width),
+    _sampleSize(10 * width)
+{
+}
+
+int FrequencySketch::indexOf(uint hash, int row) const {
+    // derive one index per row from the key hash, with a different odd multiplier for each row
+    static const uint SEEDS[DEPTH] = { 0x97cb3127u, 0xb492b66fu, 0x9ae16a3bu, 0x2545f491u };
+    uint h = (hash ^ (hash >> 16)) * SEEDS[row];
+    h ^= h >> 15;
+    return row * _width + (int)(h % (uint)_width);
+}
+
+void FrequencySketch::increment(uint hash) {
+    bool wasIncremented = false;
+    for (int row = 0; row < DEPTH; ++row) {
+        auto& counter = _counters[indexOf(hash, row)];
+        if (counter < MAX_COUNT) {
+            ++counter;
+            wasIncremented = true;
+        }
+    }
+
+    if (wasIncremented && ++_additions >= _sampleSize) {
+        age();
+    }
+}
+
+int FrequencySketch::estimate(uint hash) const {
+    int frequency = MAX_COUNT;
+    for (int row = 0; row < DEPTH; ++row) {
+        frequency = std::min(frequency, (int)_counters[indexOf(hash, row)]);
+    }
+    return frequency;
+}
+
+void FrequencySketch::age() {
+    for (auto& counter : _counters) {
+        counter >>= 1;
+    }
+    _additions /= 2;
+}
+
+HotAssetCache::HotAssetCache(qint64 capacity) : _capacity(capacity) {
+}
+
+void HotAssetCache::setCapacity(qint64 capacity) {
+    QMutexLocker locker(&_mutex);
+    _capacity = capacity;
+    evict();
+}
+
+qint64 HotAssetCache::getCapacity() const {
+    QMutexLocker locker(&_mutex);
+    return _capacity;
+}
+
+qint64 HotAssetCache::getMaxCacheableSize() const {
+    return getCapacity() / MAX_ENTRY_FRACTION;
+}
+
+QString HotAssetCache::makeKey(const QString& hash, qint64 offset, qint64 size) {
+    return hash + ":" + QString::number(offset) + ":" + QString::number(size);
+}
+
+QByteArray HotAssetCache::get(const QString& key, const Loader& loader) {
+    std::promise<QByteArray> loadPromise;
+    {
+        QMutexLocker locker(&_mutex);
+        _sketch.increment(qHash(key));
+
+        auto it = _entries.find(key);
+        if (it != _entries.end()) {
+            ++_stats.hits;
+            auto entry = it.value();
+            auto& list = entry->isInWindow ? _window : _main;
+            list.splice(list.begin(), list, entry);
+            return entry->data;
+        }
+
+        auto pendingIt = _pendingLoads.find(key);
+        if (pendingIt != _pendingLoads.end()) {
+            // someone else is already reading this range, wait for them instead of going to disk again
+            ++_stats.coalesced;
+            auto pendingLoad = pendingIt.value();
+            locker.unlock();
+            return pendingLoad.get();
+        }
+
+        ++_stats.misses;
+        _pendingLoads.insert(key, loadPromise.get_future().share());
+    }
+
+    auto data = loader();
+
+    {
+        QMutexLocker locker(&_mutex);
+        _pendingLoads.remove(key);
+        if (!data.isEmpty() && data.size() <= _capacity / MAX_ENTRY_FRACTION) {
+            insert(key, data);
+        }
+    }
+
+    loadPromise.set_value(data);
+    return data;
+}
+
+void HotAssetCache::insert(const QString& key, const QByteArray& data) {
+    _window.push_front({ key, data, true });
+    _entries.insert(key, _window.begin());
+    _windowBytes += data.size();
+    evict();
+}
+
+void HotAssetCache::evict() {
+    const qint64 windowCapacity = _capacity * WINDOW_PERCENT / 100;
+    const qint64 mainCapacity = _capacity - windowCapacity;
+
+    // ranges leaving the window compete for a spot in the main region
+    while (!_window.empty() && _windowBytes > windowCapacity) {
+        auto candidate = std::prev(_window.end());
+        _windowBytes -= candidate->data.size();
+
+        // walk the least recently used ranges the candidate would displace, and only displace them if it has been
+        // requested more often than every one of them
+        qint64 candidateSize = candidate->data.size();
+        int candidateFrequency = _sketch.estimate(qHash(candidate->key));
+        bool isAdmitted = candidateSize <= mainCapacity;
+        int numVictims = 0;
+        qint64 victimBytes = 0;
+        auto victim = _main.end();
+        while (isAdmitted && _mainBytes - victimBytes + candidateSize > mainCapacity) {
+            --victim;
+            if (_sketch.estimate(qHash(victim->key)) >= candidateFrequency) {
+                isAdmitted = false;
+            } else {
+                ++numVictims;
+                victimBytes += victim->data.size();
+            }
+        }
+
+        if (isAdmitted) {
+            for (int i = 0; i < numVictims; ++i) {
+                remove(std::prev(_main.end()));
+                ++_stats.evictions;
+            }
+            candidate->isInWindow = false;
+            _mainBytes += candidateSize;
+            _main.splice(_main.begin(), _window, candidate);
+        } else {
+            _entries.remove(candidate->key);
+            _window.erase(candidate);
+            ++_stats.rejections;
+        }
+    }
+
+    // the capacity may have been reduced
+    while (!_main.empty() && _mainBytes > mainCapacity) {
+        remove(std::prev(_main.end()));
+        ++_stats.evictions;
+    }
+}
+
+void HotAssetCache::remove(EntryList::iterator it) {
+    if (it->isInWindow) {
+        _windowBytes -= it->data.size();
+    } else {
+        _mainBytes -= it->data.size();
+    }
+    _entries.remove(it->key);
+    (it->isInWindow ? _window : _main).erase(it);
+}
+
+void HotAssetCache::invalidate(const QString& hash) {
+    QMutexLocker locker(&_mutex);
+    auto it = _entries.begin();
+    while (it != _entries.end()) {
+        auto entry = it.value();
+        if (entry->key.startsWith(hash + ":")) {
+            it = _entries.erase(it);
+            if (entry->isInWindow) {
+                _windowBytes -= entry->data.size();
+                _window.erase(entry);
+            } else {
+                _mainBytes -= entry->data.size();
+                _main.erase(entry);
+            }
+        } else {
+            ++it;
+        }
+    }
+}
+
+void HotAssetCache::clear() {
+    QMutexLocker locker(&_mutex);
+    _entries.clear();
+    _window.clear();
+    _main.clear();
+    _windowBytes = 0;
+    _mainBytes = 0;
+}
+
+HotAssetCache::Stats HotAssetCache::getStats() const {
+    QMutexLocker locker(&_mutex);
+    Stats stats = _stats;
+    stats.bytes = _windowBytes + _mainBytes;
+    stats.entries = _entries.size();
+    return stats;
+}
+
+QJsonObject HotAssetCache::getStatsJSON() const {
+    auto stats = getStats();
+    auto requests = stats.hits + stats.misses + stats.coalesced;
+
+    QJsonObject statsObject;
+    statsObject["1. Hits"] = (double)stats.hits;
+    statsObject["2. Misses"] = (double)stats.misses;
+    statsObject["3. Coalesced"] = (double)stats.coalesced;
+    statsObject["4. Hit Rate (%)"] = requests > 0 ? (100.0 * (stats.hits + stats.coalesced) / requests) : 0.0;
+    statsObject["5. Evictions"] = (double)stats.evictions;
+    statsObject["6. Rejected"] = (double)stats.rejections;
+    statsObject["7. Entries"] = stats.entries;
+    statsObject["8. Size (MB)"] = (double)stats.bytes / (1024.0 * 1024.0);
+    statsObject["9. Capacity (MB)"] = (double)getCapacity() / (1024.0 * 1024.0);
+    return statsObject;
+}
@@ -0,0 +1,117 @@
+//
+//  HotAssetCache.h
+//  assignment-client/src/assets
+//
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_HotAssetCache_h
+#define hifi_HotAssetCache_h
+
+#include <functional>
+#include <future>
+#include <list>
+#include <vector>
+
+#include <QtCore/QByteArray>
+#include <QtCore/QHash>
+#include <QtCore/QJsonObject>
+#include <QtCore/QMutex>
+#include <QtCore/QString>
+
+// Approximate access counts for cache keys, in a count-min sketch of 4 bit counters.
+// All counters are halved periodically so that the estimates favour recent popularity.
+class FrequencySketch {
+public:
+    FrequencySketch(int width = DEFAULT_WIDTH);
+
+    void increment(uint hash);
+    int estimate(uint hash) const;
+
+private:
+    static const int DEFAULT_WIDTH = 4096;
+    static const int DEPTH = 4;
+    static const uint8_t MAX_COUNT = 15;
+
+    int indexOf(uint hash, int row) const;
+    void age();
+
+    std::vector<uint8_t> _counters;
+    int _width;
+    int _additions { 0 };
+    int _sampleSize;
+};
+
+// Size bounded in-memory cache of asset byte ranges, shared by the SendAssetTasks on the transfer thread pool.
+//
+// Admission and eviction follow W-TinyLFU: new ranges enter a small LRU window, and a range leaving the window only
+// displaces the least recently used range of the main region if it has been requested more often recently.
+// Concurrent requests for a range that is not cached yet are coalesced so that only one of them reads it from disk.
+class HotAssetCache {
+public:
+    static const qint64 DEFAULT_CAPACITY;
+
+    struct Stats {
+        quint64 hits { 0 };
+        quint64 misses { 0 };
+        quint64 coalesced { 0 };
+        quint64 evictions { 0 };
+        quint64 rejections { 0 };
+        qint64 bytes { 0 };
+        int entries { 0 };
+    };
+
+    using Loader = std::function<QByteArray()>;
+
+    HotAssetCache(qint64 capacity = DEFAULT_CAPACITY);
+
+    void setCapacity(qint64 capacity);
+    qint64 getCapacity() const;
+
+    // Ranges bigger than this are never cached, so one large asset can't flush everything else.
+    qint64 getMaxCacheableSize() const;
+
+    // Returns the cached bytes for key, or calls loader to read them - at most once for concurrent requests of a key.
+    QByteArray get(const QString& key, const Loader& loader);
+
+    // Drops all the cached ranges of an asset, keys must start with the asset hash.
+    void invalidate(const QString& hash);
+    void clear();
+
+    Stats getStats() const;
+    QJsonObject getStatsJSON() const;
+
+    static QString makeKey(const QString& hash, qint64 offset, qint64 size);
+
+private:
+    struct Entry {
+        QString key;
+        QByteArray data;
+        bool isInWindow { true };
+    };
+    using EntryList = std::list<Entry>;
+
+    // these must be called with _mutex held
+    void insert(const QString& key, const QByteArray& data);
+    void evict();
+    void remove(EntryList::iterator it);
+
+    mutable QMutex _mutex;
+
+    EntryList _window; // most recently used first
+    EntryList _main; // most recently used first
+    QHash<QString, EntryList::iterator> _entries;
+    QHash<QString, std::shared_future<QByteArray>> _pendingLoads;
+    FrequencySketch _sketch;
+
+    qint64 _capacity;
+    qint64 _windowBytes { 0 };
+    qint64 _mainBytes { 0 };
+
+    Stats _stats;
+};
+
+#endif // hifi_HotAssetCache_h
@@ -13,8 +13,6 @@
 
 #include <cmath>
 
-#include <QFile>
-
 #include <DependencyManager.h>
 #include <NetworkLogging.h>
 #include <NLPacket.h>
@@ -26,15 +24,37 @@
 #include "ByteRange.h"
 #include "ClientServerUtils.h"
 
-SendAssetTask::SendAssetTask(QSharedPointer<ReceivedMessage> message, const SharedNodePointer& sendToNode, const QDir& resourcesDir) :
+SendAssetTask::SendAssetTask(QSharedPointer<ReceivedMessage> message, const SharedNodePointer& sendToNode, const QDir& resourcesDir,
+                             std::shared_ptr<AssetFileMapCache> fileMapCache,
+                             std::shared_ptr<HotAssetCache> hotAssetCache) :
     QRunnable(),
     _message(message),
     _senderNode(sendToNode),
-    _resourcesDir(resourcesDir)
+    _resourcesDir(resourcesDir),
+    _fileMapCache(fileMapCache),
+    _hotAssetCache(hotAssetCache)
 {
     
 }
 
+QByteArray SendAssetTask::readCacheableRange(const QString& hexHash, const QString& filePath, ByteRange byteRange) {
+    auto mappedFile = _fileMapCache->map(hexHash, filePath);
+    if (!mappedFile) {
+        return QByteArray();
+    }
+
+    auto fileSize = mappedFile->getSize();
+    byteRange.fixupRange(fileSize);
+    if (fileSize < byteRange.fromInclusive || fileSize < byteRange.toExclusive
+        || byteRange.size() > _hotAssetCache->getMaxCacheableSize()) {
+        // errors and large ranges are handled by the uncached path
+        return QByteArray();
+    }
+
+    auto offset = byteRange.fromInclusive >= 0 ? byteRange.fromInclusive : fileSize + byteRange.fromInclusive;
+    return QByteArray(mappedFile->getData() + offset, byteRange.size());
+}
+
 void SendAssetTask::run() {
     MessageID messageID;
     ByteRange byteRange;
@@ -64,17 +84,30 @@ void SendAssetTask::run() {
         replyPacketList->writePrimitive(AssetUtils::AssetServerError::InvalidByteRange);
     } else {
         QString filePath = _resourcesDir.filePath(QString(hexHash));
-        
-        QFile file { filePath };
 
-        if (file.open(QIODevice::ReadOnly)) {
+        // popular ranges are served from memory, requests that arrive while one is being read share that read
+        auto cacheKey = HotAssetCache::makeKey(hexHash, byteRange.fromInclusive, byteRange.toExclusive);
+        auto cachedData = _hotAssetCache->get(cacheKey, [&] {
+            return readCacheableRange(hexHash, filePath, byteRange);
+        });
+
+        auto mappedFile = cachedData.isEmpty() ? _fileMapCache->map(hexHash, filePath) : nullptr;
+
+        if (!cachedData.isEmpty()) {
+            replyPacketList->writePrimitive(AssetUtils::AssetServerError::NoError);
+            replyPacketList->writePrimitive((AssetUtils::DataOffset)cachedData.size());
+            replyPacketList->write(cachedData);
+
+            qCDebug(networking) << "Sending cached asset: " << hexHash;
+        } else if (mappedFile) {
+            auto fileSize = mappedFile->getSize();
 
             // first fixup the range based on the now known file size
-            byteRange.fixupRange(file.size());
+            byteRange.fixupRange(fileSize);
 
             // check if we're being asked to read data that we just don't have
             // because of the file size
-            if (file.size() < byteRange.fromInclusive || file.size() < byteRange.toExclusive) {
+            if (fileSize < byteRange.fromInclusive || fileSize < byteRange.toExclusive) {
                 replyPacketList->writePrimitive(AssetUtils::AssetServerError::InvalidByteRange);
                 qCDebug(networking) << "Bad byte range: " << hexHash << " "
                     << byteRange.fromInclusive << ":" << byteRange.toExclusive;
@@ -82,29 +115,17 @@ void SendAssetTask::run() {
                 // we have a valid byte range, handle it and send the asset
                 auto size = byteRange.size();
 
-                if (byteRange.fromInclusive >= 0) {
-
-                    // this range is positive, meaning we just need to seek into the file and then read from there
-                    file.seek(byteRange.fromInclusive);
-                    replyPacketList->writePrimitive(AssetUtils::AssetServerError::NoError);
-                    replyPacketList->writePrimitive(size);
-                    replyPacketList->write(file.read(size));
-                } else {
-                    // this range is negative, at least the first part of the read will be back into the end of the file
-
-                    // seek to the part of the file where the negative range begins
-                    file.seek(file.size() + byteRange.fromInclusive);
+                // a positive range starts at fromInclusive, a negative one is measured back from the end of the file
+                auto offset = byteRange.fromInclusive >= 0 ? byteRange.fromInclusive : fileSize + byteRange.fromInclusive;
 
-                    replyPacketList->writePrimitive(AssetUtils::AssetServerError::NoError);
-                    replyPacketList->writePrimitive(size);
+                replyPacketList->writePrimitive(AssetUtils::AssetServerError::NoError);
+                replyPacketList->writePrimitive(size);
 
-                    // first write everything from the negative range to the end of the file
-                    replyPacketList->write(file.read(size));
-                }
+                // the packet list splits this into MTU sized packets, copying straight out of the mapping
+                replyPacketList->write(mappedFile->getData() + offset, size);
 
                 qCDebug(networking) << "Sending asset: " << hexHash;
             }
-            file.close();
         } else {
             qCDebug(networking) << "Asset not found: " << filePath << "(" << hexHash << ")";
             replyPacketList->writePrimitive(AssetUtils::AssetServerError::AssetNotFound);
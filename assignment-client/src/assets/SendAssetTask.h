@@ -17,22 +17,31 @@
 #include <QtCore/QString>
 #include <QtCore/QRunnable>
 
+#include "AssetFileMapCache.h"
 #include "AssetUtils.h"
 #include "AssetServer.h"
+#include "ByteRange.h"
+#include "HotAssetCache.h"
 #include "Node.h"
 
 class NLPacket;
 
 class SendAssetTask : public QRunnable {
 public:
-    SendAssetTask(QSharedPointer<ReceivedMessage> message, const SharedNodePointer& sendToNode, const QDir& resourcesDir);
+    SendAssetTask(QSharedPointer<ReceivedMessage> message, const SharedNodePointer& sendToNode, const QDir& resourcesDir,
+                  std::shared_ptr<AssetFileMapCache> fileMapCache, std::shared_ptr<HotAssetCache> hotAssetCache);
 
     void run() override;
 
 private:
+    // Returns an empty QByteArray if the range can't be read or is too large to be cached
+    QByteArray readCacheableRange(const QString& hexHash, const QString& filePath, ByteRange byteRange);
+
     QSharedPointer<ReceivedMessage> _message;
     SharedNodePointer _senderNode;
     QDir _resourcesDir;
+    std::shared_ptr<AssetFileMapCache> _fileMapCache;
+    std::shared_ptr<HotAssetCache> _hotAssetCache;
 };
 
 #endif
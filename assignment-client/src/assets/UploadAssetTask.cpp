@@ -11,36 +11,56 @@
 
 #include "UploadAssetTask.h"
 
-#include <QtCore/QBuffer>
 #include <QtCore/QFile>
+#include <QtCore/QFileInfo>
+#include <QtCore/QTemporaryFile>
 
+#include <AssetHasher.h>
 #include <AssetUtils.h>
 #include <NodeList.h>
 #include <NLPacketList.h>
 
 #include "ClientServerUtils.h"
 
+static const qint64 HASH_FILE_CHUNK_SIZE = 64 * 1024;
+
+// whether the stored file at filePath holds fileSize bytes that hash to hash
+static bool isStoredFileValid(const QString& filePath, uint64_t fileSize, const QByteArray& hash) {
+    QFile file { filePath };
+    if ((uint64_t)file.size() != fileSize || !file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    AssetHasher hasher;
+    QByteArray chunk;
+    while (!(chunk = file.read(HASH_FILE_CHUNK_SIZE)).isEmpty()) {
+        hasher.addData(chunk);
+    }
+    return file.error() == QFile::NoError && hasher.result() == hash;
+}
+
 UploadAssetTask::UploadAssetTask(QSharedPointer<ReceivedMessage> receivedMessage, SharedNodePointer senderNode,
-                                 const QDir& resourcesDir, uint64_t filesizeLimit) :
+                                 const QDir& resourcesDir, uint64_t filesizeLimit,
+                                 std::shared_ptr<AssetFileMapCache> fileMapCache,
+                                 std::shared_ptr<HotAssetCache> hotAssetCache) :
     _receivedMessage(receivedMessage),
     _senderNode(senderNode),
     _resourcesDir(resourcesDir),
-    _filesizeLimit(filesizeLimit)
+    _filesizeLimit(filesizeLimit),
+    _fileMapCache(fileMapCache),
+    _hotAssetCache(hotAssetCache)
 {
     
 }
 
 void UploadAssetTask::run() {
-    auto data = _receivedMessage->getMessage();
-    
-    QBuffer buffer { &data };
-    buffer.open(QIODevice::ReadOnly);
-    
+    _receivedMessage->seek(0);
+
     MessageID messageID;
-    buffer.read(reinterpret_cast<char*>(&messageID), sizeof(messageID));
+    _receivedMessage->readPrimitive(&messageID);
     
     uint64_t fileSize;
-    buffer.read(reinterpret_cast<char*>(&fileSize), sizeof(fileSize));
+    _receivedMessage->readPrimitive(&fileSize);
 
     if (_senderNode) {
         qDebug() << "UploadAssetTask reading a file of " << fileSize << "bytes from" << uuidStringWithoutCurlyBraces(_senderNode->getUUID());
@@ -54,58 +74,90 @@ void UploadAssetTask::run() {
     if (fileSize > _filesizeLimit) {
         replyPacket->writePrimitive(AssetUtils::AssetServerError::AssetTooLarge);
     } else {
-        QByteArray fileData = buffer.read(fileSize);
-        
-        auto hash = AssetUtils::hashData(fileData);
-        auto hexHash = hash.toHex();
+        // We don't know the name of the file until it is hashed, so spool the upload to a temporary file while hashing
+        // it, straight from the received packets.
+        QTemporaryFile tempFile { _resourcesDir.filePath("upload-XXXXXX.tmp") };
+        AssetHasher hasher;
+
+        bool spooled = tempFile.open();
+        uint64_t bytesLeft = fileSize;
+        while (spooled && bytesLeft > 0) {
+            auto chunk = _receivedMessage->readChunkWithoutCopy((qint64)bytesLeft);
+            if (chunk.isEmpty()) {
+                qWarning() << "Upload is shorter than its declared size of" << fileSize << "bytes";
+                spooled = false;
+                break;
+            }
 
-        if (_senderNode) {
-            qDebug() << "Hash for uploaded file from" << uuidStringWithoutCurlyBraces(_senderNode->getUUID()) << "is: (" << hexHash << ")";
-        } else {
-            qDebug() << "Hash for uploaded file from" << _receivedMessage->getSenderSockAddr() << "is: (" << hexHash << ")";
+            hasher.addData(chunk);
+            spooled = tempFile.write(chunk) == chunk.size();
+            bytesLeft -= chunk.size();
         }
-        
-        QFile file { _resourcesDir.filePath(QString(hexHash)) };
+        spooled = spooled && tempFile.flush();
 
-        bool existingCorrectFile = false;
-        
-        if (file.exists()) {
-            // check if the local file has the correct contents, otherwise we overwrite
-            if (file.open(QIODevice::ReadOnly) && AssetUtils::hashData(file.readAll()) == hash) {
-                qDebug() << "Not overwriting existing verified file: " << hexHash;
-
-                existingCorrectFile = true;
+        auto hash = hasher.result();
+        auto hexHash = hash.toHex();
 
-                replyPacket->writePrimitive(AssetUtils::AssetServerError::NoError);
-                replyPacket->write(hash);
+        if (!spooled) {
+            qWarning() << "Failed to spool upload to" << tempFile.fileName() << " - upload failed.";
+            replyPacket->writePrimitive(AssetUtils::AssetServerError::FileOperationFailed);
+        } else {
+            if (_senderNode) {
+                qDebug() << "Hash for uploaded file from" << uuidStringWithoutCurlyBraces(_senderNode->getUUID()) << "is: (" << hexHash << ")";
             } else {
-                qDebug() << "Overwriting an existing file whose contents did not match the expected hash: " << hexHash;
-                file.close();
+                qDebug() << "Hash for uploaded file from" << _receivedMessage->getSenderSockAddr() << "is: (" << hexHash << ")";
             }
-        }
 
-        if (!existingCorrectFile) {
-            if (file.open(QIODevice::WriteOnly) && file.write(fileData) == qint64(fileSize)) {
-                qDebug() << "Wrote file" << hexHash << "to disk. Upload complete";
-                file.close();
+            auto filePath = _resourcesDir.filePath(QString(hexHash));
+            bool fileExists = QFileInfo::exists(filePath);
 
-                replyPacket->writePrimitive(AssetUtils::AssetServerError::NoError);
-                replyPacket->write(hash);
+            bool stored = false;
+            if (fileExists && isStoredFileValid(filePath, fileSize, hash)) {
+                qDebug() << "Not overwriting existing file: " << hexHash;
+                stored = true;
             } else {
-                qWarning() << "Failed to upload or write to file" << hexHash << " - upload failed.";
+                // move a damaged file aside rather than removing it, so that it is only lost once the upload replaces it
+                QString replacedFilePath;
+                if (fileExists) {
+                    qDebug() << "Replacing an existing file whose contents did not match its hash: " << hexHash;
+                    replacedFilePath = tempFile.fileName() + ".replaced";
+                    if (!QFile::rename(filePath, replacedFilePath)) {
+                        replacedFilePath.clear();
+                    }
+                }
 
-                // upload has failed - remove the file and return an error
-                auto removed = file.remove();
+                tempFile.close();
+                if (tempFile.rename(filePath)) {
+                    tempFile.setAutoRemove(false);
+                    qDebug() << "Wrote file" << hexHash << "to disk. Upload complete";
+                    stored = true;
+                } else if (replacedFilePath.isEmpty() && QFileInfo::exists(filePath) &&
+                           isStoredFileValid(filePath, fileSize, hash)) {
+                    // a concurrent upload of the same content got there first
+                    qDebug() << "File" << hexHash << "was stored by another upload. Upload complete";
+                    stored = true;
+                }
 
-                if (!removed) {
-                    qWarning() << "Removal of failed upload file" << hexHash << "failed.";
+                if (!replacedFilePath.isEmpty()) {
+                    if (stored) {
+                        // the cached mapping and ranges are of the damaged file
+                        _fileMapCache->invalidate(QString(hexHash));
+                        _hotAssetCache->invalidate(QString(hexHash));
+                        QFile::remove(replacedFilePath);
+                    } else {
+                        QFile::rename(replacedFilePath, filePath);
+                    }
                 }
-                
+            }
+
+            if (stored) {
+                replyPacket->writePrimitive(AssetUtils::AssetServerError::NoError);
+                replyPacket->write(hash);
+            } else {
+                qWarning() << "Failed to upload or write to file" << hexHash << " - upload failed.";
                 replyPacket->writePrimitive(AssetUtils::AssetServerError::FileOperationFailed);
             }
         }
-
-
     }
     
     auto nodeList = DependencyManager::get<NodeList>();
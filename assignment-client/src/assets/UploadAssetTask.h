@@ -19,6 +19,8 @@
 #include <QtCore/QRunnable>
 #include <QtCore/QSharedPointer>
 
+#include "AssetFileMapCache.h"
+#include "HotAssetCache.h"
 #include "ReceivedMessage.h"
 
 class NLPacketList;
@@ -27,7 +29,8 @@ class Node;
 class UploadAssetTask : public QRunnable {
 public:
     UploadAssetTask(QSharedPointer<ReceivedMessage> message, QSharedPointer<Node> senderNode, 
-                    const QDir& resourcesDir, uint64_t filesizeLimit);
+                    const QDir& resourcesDir, uint64_t filesizeLimit,
+                    std::shared_ptr<AssetFileMapCache> fileMapCache, std::shared_ptr<HotAssetCache> hotAssetCache);
 
     void run() override;
 
@@ -36,6 +39,8 @@ private:
     QSharedPointer<Node> _senderNode;
     QDir _resourcesDir;
     uint64_t _filesizeLimit;
+    std::shared_ptr<AssetFileMapCache> _fileMapCache;
+    std::shared_ptr<HotAssetCache> _hotAssetCache;
 };
 
 #endif // hifi_UploadAssetTask_h
@@ -17,6 +17,7 @@
 #include <QtCore/QJsonDocument>
 #include <QtCore/QJsonObject>
 #include <QtCore/QJsonValue>
+#include <QtCore/QThread>
 #include <shared/QtHelpers.h>
 
 #include <LogHandler.h>
@@ -61,6 +62,8 @@ vector<AudioMixer::ReverbSettings> AudioMixer::_zoneReverbSettings;
 AudioMixer::AudioMixer(ReceivedMessage& message) :
     ThreadedAssignment(message)
 {
+    // leave most cores to the slaves, which mix at the same time
+    _decodeThreadPool.setMaxThreadCount(std::max(1, QThread::idealThreadCount() / 2));
 
     // Always clear settings first
     // This prevents previous assignment settings from sticking around
@@ -287,12 +290,22 @@ void AudioMixer::sendStatsPacket() {
     statsObject["trailing_mix_ratio"] = _trailingMixRatio;
     statsObject["throttling_ratio"] = _throttlingRatio;
 
+    // totals since the mixer started, unlike the per frame stats
+    auto& tracer = _workerSharedData.frameTracer;
+    statsObject["frames_over_deadline"] = (qint64)tracer.getNumDeadlineMisses();
+    statsObject["frame_traces_written"] = (qint64)tracer.getNumDumps();
+
     statsObject["avg_streams_per_frame"] = (float)_stats.sumStreams / (float)_numStatFrames;
     statsObject["avg_listeners_per_frame"] = (float)_stats.sumListeners / (float)_numStatFrames;
     statsObject["avg_listeners_(silent)_per_frame"] = (float)_stats.sumListenersSilent / (float)_numStatFrames;
 
     statsObject["silent_packets_per_frame"] = (float)_numSilentPackets / (float)_numStatFrames;
 
+    // audio decoded while the previous frame mixed, and how much of that decoding the mixer didn't wait for
+    statsObject["predecoded_packets_per_frame"] = (float)_stats.predecodedPackets / (float)_numStatFrames;
+    statsObject["%_predecode_overlapped"] = _stats.predecodeTime > 0 ?
+        100.0f * (1.0f - std::min((float)_stats.predecodeWaitTime / (float)_stats.predecodeTime, 1.0f)) : 0.0f;
+
     // timing stats
     QJsonObject timingStats;
 
@@ -311,6 +324,9 @@ void AudioMixer::sendStatsPacket() {
     addTiming(_mixTiming, "mix");
     addTiming(_eventsTiming, "events");
 
+    timingStats["us_per_predecode"] = (qint64)(_stats.predecodeTime / _numStatFrames);
+    timingStats["us_per_predecode_wait"] = (qint64)(_stats.predecodeWaitTime / _numStatFrames);
+
 #ifdef HIFI_AUDIO_MIXER_DEBUG
     timingStats["ns_per_mix"] = (_stats.totalMixes > 0) ?  (float)(_stats.mixTime / _stats.totalMixes) : 0;
 #endif
@@ -430,10 +446,13 @@ void AudioMixer::start() {
         }
 
         auto frameTimer = _frameTiming.timer();
+        auto& tracer = _workerSharedData.frameTracer;
+        tracer.beginFrame(frame);
 
         // process (node-isolated) audio packets across slave threads
         {
             auto packetsTimer = _packetsTiming.timer();
+            FRAME_TRACE_RANGE(tracer, "processPackets");
 
             // first clear the concurrent vector of added streams that the slaves will add to when they process packets
             _workerSharedData.addedStreams.clear();
@@ -446,6 +465,7 @@ void AudioMixer::start() {
         // process queued events (networking, global audio packets, &c.)
         {
             auto eventsTimer = _eventsTiming.timer();
+            FRAME_TRACE_RANGE(tracer, "processEvents");
 
             // clear removed nodes and removed streams before we process events that will setup the new set
             _workerSharedData.removedNodes.clear();
@@ -460,18 +480,30 @@ void AudioMixer::start() {
         if (_throttlingRatio > EPSILON) {
             numToRetain = nodeList->size() * (1.0f - _throttlingRatio);
         }
+        // the packets queued for the next frame stay put until then, so their audio can be decoded during the mix
+        startPredecode();
+
         nodeList->nestedEach([&](NodeList::const_iterator cbegin, NodeList::const_iterator cend) {
             // mix across slave threads
             auto mixTimer = _mixTiming.timer();
+            FRAME_TRACE_RANGE(tracer, "mix");
             _slavePool.mix(cbegin, cend, frame, numToRetain);
         });
 
+        {
+            FRAME_TRACE_RANGE(tracer, "finishPredecode");
+            finishPredecode();
+        }
+
         // gather stats
         _slavePool.each([&](AudioMixerSlave& slave) {
             _stats.accumulate(slave.stats);
             slave.stats.reset();
         });
 
+        // the slaves and decode workers are idle again, so a trace of the frame can be written
+        tracer.endFrame(AudioConstants::NETWORK_FRAME_USECS);
+
         ++frame;
         ++_numStatFrames;
 
@@ -484,6 +516,48 @@ void AudioMixer::start() {
     }
 }
 
+void AudioMixer::startPredecode() {
+    _predecodeNodes.clear();
+    DependencyManager::get<NodeList>()->eachNode([&](const SharedNodePointer& node) {
+        if (node->getLinkedData()) {
+            _predecodeNodes.push_back(node);
+        }
+    });
+
+    _nextPredecodeNode = 0;
+    int numWorkers = std::min((int)_predecodeNodes.size(), _decodeThreadPool.maxThreadCount());
+    for (int i = 0; i < numWorkers; ++i) {
+        _decodeThreadPool.start([this] {
+            FRAME_TRACE_RANGE(_workerSharedData.frameTracer, "predecode");
+            auto start = p_high_resolution_clock::now();
+            int numPredecoded = 0;
+
+            // each worker takes the next node until there are none left
+            int index = _nextPredecodeNode++;
+            while (index < (int)_predecodeNodes.size()) {
+                auto clientData = static_cast<AudioMixerClientData*>(_predecodeNodes[index]->getLinkedData());
+                numPredecoded += clientData->predecodePackets();
+                index = _nextPredecodeNode++;
+            }
+
+            _numPredecodedPackets += numPredecoded;
+            _predecodeTime += chrono::duration_cast<chrono::microseconds>(p_high_resolution_clock::now() - start).count();
+        });
+    }
+}
+
+void AudioMixer::finishPredecode() {
+    auto start = p_high_resolution_clock::now();
+    _decodeThreadPool.waitForDone();
+    _stats.predecodeWaitTime += chrono::duration_cast<chrono::microseconds>(p_high_resolution_clock::now() - start).count();
+
+    _stats.predecodedPackets += _numPredecodedPackets.exchange(0);
+    _stats.predecodeTime += _predecodeTime.exchange(0);
+
+    // release the nodes, which may have been killed while we held them
+    _predecodeNodes.clear();
+}
+
 chrono::microseconds AudioMixer::timeFrame() {
     // advance the next frame
     auto now = p_high_resolution_clock::now();
@@ -590,6 +664,19 @@ void AudioMixer::parseSettingsObject(const QJsonObject& settingsObject) {
         }
 
         qCDebug(audio) << "Throttle Start:" << _throttleStartTarget << "Throttle Backoff:" << _throttleBackoffTarget;
+
+        const QString FRAME_TRACING_KEY = "frame_tracing";
+        const QString FRAME_TRACE_SAMPLE_INTERVAL_KEY = "frame_trace_sample_interval";
+        const QString FRAME_TRACE_ON_DEADLINE_MISS_KEY = "frame_trace_on_deadline_miss";
+
+        auto& tracer = _workerSharedData.frameTracer;
+        tracer.setEnabled(audioThreadingGroupObject[FRAME_TRACING_KEY].toBool(false));
+        tracer.setSampleInterval(audioThreadingGroupObject[FRAME_TRACE_SAMPLE_INTERVAL_KEY].toInt(1));
+        tracer.setDumpOnDeadlineMiss(audioThreadingGroupObject[FRAME_TRACE_ON_DEADLINE_MISS_KEY].toBool(true));
+        if (tracer.isEnabled()) {
+            tracing::FrameTracer::installDumpSignalHandler();
+            qCDebug(audio) << "Frame tracing enabled, tracing one frame in" << tracer.getSampleInterval();
+        }
     }
 
     if (settingsObject.contains(AUDIO_BUFFER_GROUP_KEY)) {
@@ -12,7 +12,11 @@
 #ifndef hifi_AudioMixer_h
 #define hifi_AudioMixer_h
 
+#include <atomic>
+#include <vector>
+
 #include <QtCore/QSharedPointer>
+#include <QtCore/QThreadPool>
 
 #include <AABox.h>
 #include <AudioHRTF.h>
@@ -89,6 +93,10 @@ private:
     std::chrono::microseconds timeFrame();
     void throttle(std::chrono::microseconds frameDuration, int frame);
 
+    // decode the audio queued for the next frame on the decode pool, while this frame mixes
+    void startPredecode();
+    void finishPredecode();
+
     AudioMixerClientData* getOrCreateClientData(Node* node);
 
     QString percentageForMixStats(int counter);
@@ -109,6 +117,12 @@ private:
 
     AudioMixerSlavePool _slavePool { _workerSharedData };
 
+    QThreadPool _decodeThreadPool;
+    std::vector<SharedNodePointer> _predecodeNodes;
+    std::atomic<int> _nextPredecodeNode { 0 };
+    std::atomic<int> _numPredecodedPackets { 0 };
+    std::atomic<uint64_t> _predecodeTime { 0 };
+
     class Timer {
     public:
         class Timing{
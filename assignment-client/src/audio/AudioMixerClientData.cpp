@@ -18,6 +18,7 @@
 #include <QtCore/QDebug>
 #include <QtCore/QJsonArray>
 
+#include <MixedAudioPacket.h>
 #include <udt/PacketHeaders.h>
 #include <UUID.h>
 
@@ -115,11 +116,68 @@ int AudioMixerClientData::processPackets(ConcurrentAddedStreams& addedStreams) {
     }
     assert(_packetQueue.empty());
 
+    for (auto& stream : _audioStreams) {
+        stream->clearPredecodedAudio();
+    }
+
     // now that we have processed all packets for this frame
     // we can prepare the sources from this client to be ready for mixing
     return checkBuffersBeforeFrameSend();
 }
 
+int AudioMixerClientData::predecodePackets() {
+    SharedNodePointer node = _packetQueue.node;
+    if (!node || node->isUpstream()) {
+        // replicated agents can change codec with any packet
+        return 0;
+    }
+
+    int numPredecoded = 0;
+
+    // a stream's packets are decoded in order, so a packet that can't be predecoded blocks the ones after it
+    std::vector<InboundAudioStream*> blockedStreams;
+
+    for (auto& packet : _packetQueue.getPackets()) {
+        auto packetType = packet->getType();
+        if (packetType != PacketType::MicrophoneAudioNoEcho
+            && packetType != PacketType::MicrophoneAudioWithEcho
+            && packetType != PacketType::InjectAudio
+            && packetType != PacketType::SilentAudioFrame) {
+            // other packets can change the codec or the streams
+            break;
+        }
+
+        StreamID streamIdentifier;
+        if (packetType == PacketType::InjectAudio) {
+            packet->seek(sizeof(StreamSequenceNumber));
+            packet->readString();
+            streamIdentifier = QUuid::fromRfc4122(packet->readWithoutCopy(NUM_BYTES_RFC4122_UUID));
+            packet->seek(0);
+        }
+
+        auto streamIt = std::find_if(_audioStreams.begin(), _audioStreams.end(), [&](const SharedStreamPointer& stream) {
+            return stream->getStreamIdentifier() == streamIdentifier;
+        });
+        if (streamIt == _audioStreams.end()) {
+            // processPackets will add a stream for this packet
+            break;
+        }
+
+        InboundAudioStream* stream = streamIt->get();
+        if (std::find(blockedStreams.begin(), blockedStreams.end(), stream) != blockedStreams.end()) {
+            continue;
+        }
+
+        if (containsValidPosition(*packet) && stream->predecodeAudioData(*packet)) {
+            ++numPredecoded;
+        } else {
+            blockedStreams.push_back(stream);
+        }
+    }
+
+    return numPredecoded;
+}
+
 bool isReplicatedPacket(PacketType packetType) {
     return packetType == PacketType::ReplicatedMicrophoneAudioNoEcho
         || packetType == PacketType::ReplicatedMicrophoneAudioWithEcho
@@ -764,22 +822,26 @@ void AudioMixerClientData::sendSelectAudioFormat(SharedNodePointer node, const Q
     nodeList->sendPacket(std::move(replyPacket), *node);
 }
 
-void AudioMixerClientData::encodeFrameOfZeros(QByteArray& encodedZeros) {
-    static QByteArray zeros(AudioConstants::NETWORK_FRAME_BYTES_STEREO, 0);
+int AudioMixerClientData::encodeFrameOfZeros(char* encodedBuffer, int encodedCapacity) {
+    static const int16_t ZEROS[AudioConstants::NETWORK_FRAME_SAMPLES_STEREO] = { 0 };
+    int encodedSize = 0;
     if (_shouldFlushEncoder) {
-        if (_encoder) {
-            _encoder->encode(zeros, encodedZeros);
-        } else {
-            encodedZeros = zeros;
-        }
+        encodedSize = encodeFrame(reinterpret_cast<const char*>(ZEROS), encodedBuffer, encodedCapacity);
     }
     _shouldFlushEncoder = false;
+    return encodedSize;
+}
+
+int AudioMixerClientData::encodeFrame(const char* decodedBuffer, char* encodedBuffer, int encodedCapacity) {
+    return encodeMixedAudioFrame(_encoder, decodedBuffer, AudioConstants::NETWORK_FRAME_BYTES_STEREO, encodedBuffer,
+                                 encodedCapacity);
 }
 
 void AudioMixerClientData::setupCodec(CodecPluginPointer codec, const QString& codecName) {
     cleanupCodec(); // cleanup any previously allocated coders first
     _codec = codec;
     _selectedCodecName = codecName;
+    _selectedCodecNameUtf8 = codecName.toUtf8();
     if (codec) {
         _encoder = codec->createEncoder(AudioConstants::SAMPLE_RATE, AudioConstants::STEREO);
         _decoder = codec->createDecoder(AudioConstants::SAMPLE_RATE, AudioConstants::MONO);
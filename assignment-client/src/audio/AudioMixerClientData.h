@@ -55,6 +55,9 @@ public:
 
     void queuePacket(QSharedPointer<ReceivedMessage> packet, SharedNodePointer node);
     int processPackets(ConcurrentAddedStreams& addedStreams); // returns the number of available streams this frame
+    // decodes the audio of queued stream packets ahead of processPackets, returns the number of packets decoded
+    // called from a decode worker while the mixer mixes, when nothing else touches the queue or the streams' decoders
+    int predecodePackets();
 
     AudioStreamVector& getAudioStreams() { return _audioStreams; }
     AvatarAudioStream* getAvatarAudioStream();
@@ -95,19 +98,19 @@ public:
 
     void setupCodec(CodecPluginPointer codec, const QString& codecName);
     void cleanupCodec();
-    void encode(const QByteArray& decodedBuffer, QByteArray& encodedBuffer) {
-        if (_encoder) {
-            _encoder->encode(decodedBuffer, encodedBuffer);
-        } else {
-            encodedBuffer = decodedBuffer;
-        }
+    // encode a frame of mixed audio straight into an outgoing packet's payload, returning the number of bytes written
+    int encode(const int16_t* mixedSamples, char* encodedBuffer, int encodedCapacity) {
+        int encodedSize = encodeFrame(reinterpret_cast<const char*>(mixedSamples), encodedBuffer, encodedCapacity);
         // once you have encoded, you need to flush eventually.
         _shouldFlushEncoder = true;
+        return encodedSize;
     }
-    void encodeFrameOfZeros(QByteArray& encodedZeros);
+    int encodeFrameOfZeros(char* encodedBuffer, int encodedCapacity);
     bool shouldFlushEncoder() { return _shouldFlushEncoder; }
 
     QString getCodecName() { return _selectedCodecName; }
+    // the codec name as it is written into mixed audio packets, kept so that it isn't converted for every packet
+    const QByteArray& getCodecNameUtf8() const { return _selectedCodecNameUtf8; }
 
     bool shouldMuteClient() { return _shouldMuteClient; }
     void setShouldMuteClient(bool shouldMuteClient) { _shouldMuteClient = shouldMuteClient; }
@@ -175,6 +178,8 @@ public slots:
 private:
     struct PacketQueue : public std::queue<QSharedPointer<ReceivedMessage>> {
         QWeakPointer<Node> node;
+
+        const container_type& getPackets() const { return c; }
     };
     PacketQueue _packetQueue;
 
@@ -186,6 +191,8 @@ private:
 
     bool containsValidPosition(ReceivedMessage& message) const;
 
+    int encodeFrame(const char* decodedBuffer, char* encodedBuffer, int encodedCapacity);
+
     Streams _streams;
 
     quint16 _outgoingMixedAudioSequenceNumber;
@@ -199,6 +206,7 @@ private:
 
     CodecPluginPointer _codec;
     QString _selectedCodecName;
+    QByteArray _selectedCodecNameUtf8;
     Encoder* _encoder{ nullptr }; // for outbound mixed stream
     Decoder* _decoder{ nullptr }; // for mic stream
 
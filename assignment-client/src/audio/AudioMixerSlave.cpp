@@ -18,6 +18,7 @@
 #include <glm/gtx/vector_angle.hpp>
 
 #include <LogHandler.h>
+#include <MixedAudioPacket.h>
 #include <NetworkAccessManager.h>
 #include <NodeList.h>
 #include <Node.h>
@@ -42,11 +43,12 @@ using MixableStream = AudioMixerClientData::MixableStream;
 using MixableStreamsVector = AudioMixerClientData::MixableStreamsVector;
 
 // packet helpers
-std::unique_ptr<NLPacket> createAudioPacket(PacketType type, int size, quint16 sequence, QString codec);
-void sendMixPacket(const SharedNodePointer& node, AudioMixerClientData& data, QByteArray& buffer);
-void sendSilentPacket(const SharedNodePointer& node, AudioMixerClientData& data);
-void sendMutePacket(const SharedNodePointer& node, AudioMixerClientData&);
-void sendEnvironmentPacket(const SharedNodePointer& node, AudioMixerClientData& data);
+void sendAudioPacket(NLPacketArena& arena, std::unique_ptr<NLPacket> packet, const Node& node);
+void sendMixPacket(NLPacketArena& arena, tracing::FrameTracer& tracer, const SharedNodePointer& node,
+        AudioMixerClientData& data, const int16_t* mixedSamples, bool mixHasAudio);
+void sendSilentPacket(NLPacketArena& arena, const SharedNodePointer& node, AudioMixerClientData& data);
+void sendMutePacket(NLPacketArena& arena, const SharedNodePointer& node, AudioMixerClientData&);
+void sendEnvironmentPacket(NLPacketArena& arena, const SharedNodePointer& node, AudioMixerClientData& data);
 
 // mix helpers
 inline float approximateGain(const AvatarAudioStream& listeningNodeStream, const PositionalAudioStream& streamToAdd);
@@ -58,6 +60,8 @@ inline float computeAzimuth(const AvatarAudioStream& listeningNodeStream, const
 void AudioMixerSlave::processPackets(const SharedNodePointer& node) {
     AudioMixerClientData* data = (AudioMixerClientData*)node->getLinkedData();
     if (data) {
+        FRAME_TRACE_RANGE_ARG(_sharedData.frameTracer, "processPackets", node->getLocalID());
+
         // process packets and collect the number of streams available for this frame
         stats.sumStreams += data->processPackets(_sharedData.addedStreams);
     }
@@ -89,36 +93,32 @@ void AudioMixerSlave::mix(const SharedNodePointer& node) {
 
     // send mute packet, if necessary
     if (AudioMixer::shouldMute(avatarStream->getQuietestFrameLoudness()) || data->shouldMuteClient()) {
-        sendMutePacket(node, *data);
+        sendMutePacket(_packetArena, node, *data);
     }
 
     // send audio packets, if necessary
     if (node->getType() == NodeType::Agent && node->getActiveSocket()) {
+        auto& tracer = _sharedData.frameTracer;
+        FRAME_TRACE_RANGE_ARG(tracer, "listener", node->getLocalID());
         ++stats.sumListeners;
 
         // mix the audio
-        bool mixHasAudio = prepareMix(node);
+        bool mixHasAudio;
+        {
+            FRAME_TRACE_RANGE(tracer, "mix");
+            mixHasAudio = prepareMix(node);
+        }
 
         // send audio packet
         if (mixHasAudio || data->shouldFlushEncoder()) {
-            QByteArray encodedBuffer;
-            if (mixHasAudio) {
-                // encode the audio
-                QByteArray decodedBuffer(reinterpret_cast<char*>(_bufferSamples), AudioConstants::NETWORK_FRAME_BYTES_STEREO);
-                data->encode(decodedBuffer, encodedBuffer);
-            } else {
-                // time to flush (resets shouldFlush until the next encode)
-                data->encodeFrameOfZeros(encodedBuffer);
-            }
-
-            sendMixPacket(node, *data, encodedBuffer);
+            sendMixPacket(_packetArena, tracer, node, *data, _bufferSamples, mixHasAudio);
         } else {
             ++stats.sumListenersSilent;
-            sendSilentPacket(node, *data);
+            sendSilentPacket(_packetArena, node, *data);
         }
 
         // send environment packet
-        sendEnvironmentPacket(node, *data);
+        sendEnvironmentPacket(_packetArena, node, *data);
 
         // send stats packet (about every second)
         const unsigned int NUM_FRAMES_PER_SEC = (int)ceil(AudioConstants::NETWORK_FRAMES_PER_SEC);
@@ -601,52 +601,60 @@ void AudioMixerSlave::resetHRTFState(AudioMixerClientData::MixableStream& mixabl
     ++stats.hrtfResets;
 }
 
-std::unique_ptr<NLPacket> createAudioPacket(PacketType type, int size, quint16 sequence, QString codec) {
-    auto audioPacket = NLPacket::create(type, size);
-    audioPacket->writePrimitive(sequence);
-    audioPacket->writeString(codec);
-    return audioPacket;
+void sendAudioPacket(NLPacketArena& arena, std::unique_ptr<NLPacket> packet, const Node& node) {
+    // unreliable sends are done with the packet on return, so it goes straight back to the arena
+    arena.send(*DependencyManager::get<NodeList>(), std::move(packet), node);
 }
 
-void sendMixPacket(const SharedNodePointer& node, AudioMixerClientData& data, QByteArray& buffer) {
-    const int MIX_PACKET_SIZE =
-        sizeof(quint16) + AudioConstants::MAX_CODEC_NAME_LENGTH_ON_WIRE + AudioConstants::NETWORK_FRAME_BYTES_STEREO;
+void sendMixPacket(NLPacketArena& arena, tracing::FrameTracer& tracer, const SharedNodePointer& node,
+        AudioMixerClientData& data, const int16_t* mixedSamples, bool mixHasAudio) {
     quint16 sequence = data.getOutgoingSequenceNumber();
-    QString codec = data.getCodecName();
-    auto mixPacket = createAudioPacket(PacketType::MixedAudio, MIX_PACKET_SIZE, sequence, codec);
-
-    // pack samples
-    mixPacket->write(buffer.constData(), buffer.size());
+    auto mixPacket = createMixedAudioPacket(arena, PacketType::MixedAudio, sequence, data.getCodecNameUtf8());
+
+    // encode the samples straight into the payload
+    {
+        FRAME_TRACE_RANGE(tracer, "encode");
+        char* encodedBuffer = mixPacket->getPayload() + mixPacket->pos();
+        int encodedCapacity = (int)mixPacket->bytesAvailableForWrite();
+        int encodedSize;
+        if (mixHasAudio) {
+            encodedSize = data.encode(mixedSamples, encodedBuffer, encodedCapacity);
+        } else {
+            // time to flush (resets shouldFlush until the next encode)
+            encodedSize = data.encodeFrameOfZeros(encodedBuffer, encodedCapacity);
+        }
+        mixPacket->setPayloadSize(mixPacket->pos() + encodedSize);
+    }
 
     // send packet
-    DependencyManager::get<NodeList>()->sendPacket(std::move(mixPacket), *node);
+    {
+        FRAME_TRACE_RANGE(tracer, "send");
+        sendAudioPacket(arena, std::move(mixPacket), *node);
+    }
     data.incrementOutgoingMixedAudioSequenceNumber();
 }
 
-void sendSilentPacket(const SharedNodePointer& node, AudioMixerClientData& data) {
-    const int SILENT_PACKET_SIZE =
-        sizeof(quint16) + AudioConstants::MAX_CODEC_NAME_LENGTH_ON_WIRE + sizeof(quint16);
+void sendSilentPacket(NLPacketArena& arena, const SharedNodePointer& node, AudioMixerClientData& data) {
     quint16 sequence = data.getOutgoingSequenceNumber();
-    QString codec = data.getCodecName();
-    auto mixPacket = createAudioPacket(PacketType::SilentAudioFrame, SILENT_PACKET_SIZE, sequence, codec);
+    auto mixPacket = createMixedAudioPacket(arena, PacketType::SilentAudioFrame, sequence, data.getCodecNameUtf8());
 
     // pack number of samples
     mixPacket->writePrimitive(AudioConstants::NETWORK_FRAME_SAMPLES_STEREO);
 
     // send packet
-    DependencyManager::get<NodeList>()->sendPacket(std::move(mixPacket), *node);
+    sendAudioPacket(arena, std::move(mixPacket), *node);
     data.incrementOutgoingMixedAudioSequenceNumber();
 }
 
-void sendMutePacket(const SharedNodePointer& node, AudioMixerClientData& data) {
-    auto mutePacket = NLPacket::create(PacketType::NoisyMute, 0);
-    DependencyManager::get<NodeList>()->sendPacket(std::move(mutePacket), *node);
+void sendMutePacket(NLPacketArena& arena, const SharedNodePointer& node, AudioMixerClientData& data) {
+    auto mutePacket = arena.acquire(PacketType::NoisyMute);
+    sendAudioPacket(arena, std::move(mutePacket), *node);
 
     // probably now we just reset the flag, once should do it (?)
     data.setShouldMuteClient(false);
 }
 
-void sendEnvironmentPacket(const SharedNodePointer& node, AudioMixerClientData& data) {
+void sendEnvironmentPacket(NLPacketArena& arena, const SharedNodePointer& node, AudioMixerClientData& data) {
     bool hasReverb = false;
     float reverbTime, wetLevel;
 
@@ -684,15 +692,10 @@ void sendEnvironmentPacket(const SharedNodePointer& node, AudioMixerClientData&
     bool sendData = dataChanged || (randFloat() < CHANCE_OF_SEND);
 
     if (sendData) {
-        // size the packet
         unsigned char bitset = 0;
-        int packetSize = sizeof(bitset);
-        if (hasReverb) {
-            packetSize += sizeof(reverbTime) + sizeof(wetLevel);
-        }
 
         // write the packet
-        auto envPacket = NLPacket::create(PacketType::AudioEnvironment, packetSize);
+        auto envPacket = arena.acquire(PacketType::AudioEnvironment);
         if (hasReverb) {
             setAtBit(bitset, HAS_REVERB_BIT);
         }
@@ -703,7 +706,7 @@ void sendEnvironmentPacket(const SharedNodePointer& node, AudioMixerClientData&
         }
 
         // send the packet
-        DependencyManager::get<NodeList>()->sendPacket(std::move(envPacket), *node);
+        sendAudioPacket(arena, std::move(envPacket), *node);
     }
 }
 
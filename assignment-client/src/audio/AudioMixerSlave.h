@@ -20,6 +20,8 @@
 #include <AABox.h>
 #include <AudioHRTF.h>
 #include <AudioRingBuffer.h>
+#include <FrameTracer.h>
+#include <NLPacketArena.h>
 #include <ThreadedAssignment.h>
 #include <UUIDHasher.h>
 #include <NodeList.h>
@@ -39,6 +41,8 @@ public:
         AudioMixerClientData::ConcurrentAddedStreams addedStreams;
         std::vector<Node::LocalID> removedNodes;
         std::vector<NodeIDStreamID> removedStreams;
+
+        tracing::FrameTracer frameTracer { "audio-mixer" };
     };
 
     AudioMixerSlave(SharedData& sharedData) : _sharedData(sharedData) {};
@@ -75,6 +79,9 @@ private:
     float _mixSamples[AudioConstants::NETWORK_FRAME_SAMPLES_STEREO];
     int16_t _bufferSamples[AudioConstants::NETWORK_FRAME_SAMPLES_STEREO];
 
+    // outgoing packets, recycled once sent so that a frame's sends don't allocate
+    NLPacketArena _packetArena;
+
     // frame state
     ConstIter _begin;
     ConstIter _end;
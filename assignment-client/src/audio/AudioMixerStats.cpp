@@ -36,6 +36,10 @@ void AudioMixerStats::reset() {
     inactive = 0;
     active = 0;
 
+    predecodedPackets = 0;
+    predecodeTime = 0;
+    predecodeWaitTime = 0;
+
 #ifdef HIFI_AUDIO_MIXER_DEBUG
     mixTime = 0;
 #endif
@@ -66,6 +70,10 @@ void AudioMixerStats::accumulate(const AudioMixerStats& otherStats) {
     inactive += otherStats.inactive;
     active += otherStats.active;
 
+    predecodedPackets += otherStats.predecodedPackets;
+    predecodeTime += otherStats.predecodeTime;
+    predecodeWaitTime += otherStats.predecodeWaitTime;
+
 #ifdef HIFI_AUDIO_MIXER_DEBUG
     mixTime += otherStats.mixTime;
 #endif
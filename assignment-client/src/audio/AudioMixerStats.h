@@ -12,9 +12,7 @@
 #ifndef hifi_AudioMixerStats_h
 #define hifi_AudioMixerStats_h
 
-#ifdef HIFI_AUDIO_MIXER_DEBUG
 #include <cstdint>
-#endif
 
 struct AudioMixerStats {
     int sumStreams { 0 };
@@ -41,6 +39,12 @@ struct AudioMixerStats {
     int inactive { 0 };
     int active { 0 };
 
+    // audio decoded by the decode pool ahead of packet processing, while the previous frame mixed
+    int predecodedPackets { 0 };
+    uint64_t predecodeTime { 0 };
+    // how long the mixer waited for the decode pool after mixing
+    uint64_t predecodeWaitTime { 0 };
+
 #ifdef HIFI_AUDIO_MIXER_DEBUG
     uint64_t mixTime { 0 };
 #endif
@@ -66,3 +66,17 @@ int AvatarAudioStream::parseStreamProperties(PacketType type, const QByteArray&
 
     return readBytes;
 }
+
+int AvatarAudioStream::getStreamPropertiesSize(PacketType type, const QByteArray& packetAfterSeqNum) const {
+    // silent frames use the decoder to fade out, and a change of channel flag restarts it
+    if (type == PacketType::SilentAudioFrame || packetAfterSeqNum.isEmpty()) {
+        return -1;
+    }
+    bool isStereo = packetAfterSeqNum.at(0) == 1;
+    if (isStereo != _isStereo) {
+        return -1;
+    }
+
+    int positionalBytes = getPositionalDataSize(packetAfterSeqNum.mid(sizeof(ChannelFlag)));
+    return positionalBytes < 0 ? -1 : (int)sizeof(ChannelFlag) + positionalBytes;
+}
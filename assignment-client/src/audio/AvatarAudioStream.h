@@ -26,6 +26,7 @@ private:
     Q_DISABLE_COPY(AvatarAudioStream)
 
     int parseStreamProperties(PacketType type, const QByteArray& packetAfterSeqNum, int& numAudioSamples) override;
+    int getStreamPropertiesSize(PacketType type, const QByteArray& packetAfterSeqNum) const override;
 };
 
 #endif // hifi_AvatarAudioStream_h
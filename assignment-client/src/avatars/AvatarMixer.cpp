@@ -266,6 +266,9 @@ void AvatarMixer::start() {
         auto frameDuration = timeFrame(frameTimestamp); // calculates last frame duration and sleeps remainder of target amount
         throttle(frameDuration, frame); // determines _throttlingRatio for upcoming mix frame
 
+        auto& tracer = _slaveSharedData.frameTracer;
+        tracer.beginFrame(frame);
+
         int lockWait, nodeTransform, functor;
 
         // Set our query each frame
@@ -293,6 +296,7 @@ void AvatarMixer::start() {
 
         // Allow nodes to process any pending/queued packets across our worker threads
         {
+            FRAME_TRACE_RANGE(tracer, "processIncomingPackets");
             auto start = usecTimestampNow();
 
             nodeList->nestedEach([&](NodeList::const_iterator cbegin, NodeList::const_iterator cend) {
@@ -312,6 +316,7 @@ void AvatarMixer::start() {
         // process pending display names... this doesn't currently run on multiple threads, because it
         // side-effects the mixer's data, which is fine because it's a very low cost operation
         {
+            FRAME_TRACE_RANGE(tracer, "manageIdentityData");
             auto start = usecTimestampNow();
             nodeList->nestedEach([&](NodeList::const_iterator cbegin, NodeList::const_iterator cend) {
                 std::for_each(cbegin, cend, [&](const SharedNodePointer& node) {
@@ -332,6 +337,7 @@ void AvatarMixer::start() {
 
         // this is where we need to put the real work...
         {
+            FRAME_TRACE_RANGE(tracer, "broadcastAvatarData");
             auto start = usecTimestampNow();
             nodeList->nestedEach([&](NodeList::const_iterator cbegin, NodeList::const_iterator cend) {
                 auto start = usecTimestampNow();
@@ -354,6 +360,7 @@ void AvatarMixer::start() {
         // play nice with qt event-looping
         {
             // since we're a while loop we need to yield to qt's event processing
+            FRAME_TRACE_RANGE(tracer, "processEvents");
             auto start = usecTimestampNow();
             QCoreApplication::processEvents();
             if (_isFinished) {
@@ -365,6 +372,9 @@ void AvatarMixer::start() {
             _processEventsElapsedTime += (end - start);
         }
 
+        // the slaves are idle again, so a trace of the frame can be written
+        tracer.endFrame(USECS_PER_SECOND / AVATAR_MIXER_BROADCAST_FRAMES_PER_SECOND);
+
         _lastFrameTimestamp = frameTimestamp;
 
     }
@@ -769,6 +779,11 @@ void AvatarMixer::sendStatsPacket() {
     statsObject["trailing_mix_ratio"] = _trailingMixRatio;
     statsObject["throttling_ratio"] = _throttlingRatio;
 
+    // totals since the mixer started, unlike the per frame stats
+    auto& tracer = _slaveSharedData.frameTracer;
+    statsObject["frames_over_deadline"] = (qint64)tracer.getNumDeadlineMisses();
+    statsObject["frame_traces_written"] = (qint64)tracer.getNumDumps();
+
 #ifdef DEBUG_EVENT_QUEUE
     QJsonObject qtStats;
 
@@ -1033,6 +1048,21 @@ void AvatarMixer::parseDomainServerSettings(const QJsonObject& domainSettings) {
         }
     }
 
+    {
+        const QString FRAME_TRACING_KEY = "frame_tracing";
+        const QString FRAME_TRACE_SAMPLE_INTERVAL_KEY = "frame_trace_sample_interval";
+        const QString FRAME_TRACE_ON_DEADLINE_MISS_KEY = "frame_trace_on_deadline_miss";
+
+        auto& tracer = _slaveSharedData.frameTracer;
+        tracer.setEnabled(avatarMixerGroupObject[FRAME_TRACING_KEY].toBool(false));
+        tracer.setSampleInterval(avatarMixerGroupObject[FRAME_TRACE_SAMPLE_INTERVAL_KEY].toInt(1));
+        tracer.setDumpOnDeadlineMiss(avatarMixerGroupObject[FRAME_TRACE_ON_DEADLINE_MISS_KEY].toBool(true));
+        if (tracer.isEnabled()) {
+            tracing::FrameTracer::installDumpSignalHandler();
+            qCDebug(avatars) << "Avatar mixer frame tracing enabled, tracing one frame in" << tracer.getSampleInterval();
+        }
+    }
+
     {   // Fraction of downstream bandwidth reserved for 'hero' avatars:
         static const QString PRIORITY_FRACTION_KEY = "priority_fraction";
         if (avatarMixerGroupObject.contains(PRIORITY_FRACTION_KEY)) {
@@ -63,6 +63,7 @@ void AvatarMixerSlave::processIncomingPackets(const SharedNodePointer& node) {
     auto start = usecTimestampNow();
     auto nodeData = dynamic_cast<AvatarMixerClientData*>(node->getLinkedData());
     if (nodeData) {
+        FRAME_TRACE_RANGE_ARG(_sharedData->frameTracer, "processPackets", node->getLocalID());
         _stats.nodesProcessed++;
         _stats.packetsProcessed += nodeData->processPackets(*_sharedData);
     }
@@ -264,6 +265,7 @@ static const int AVATAR_MIXER_BROADCAST_FRAMES_PER_SECOND = 45;
 
 void AvatarMixerSlave::broadcastAvatarData(const SharedNodePointer& node) {
     quint64 start = usecTimestampNow();
+    FRAME_TRACE_RANGE_ARG(_sharedData->frameTracer, "broadcast", node->getLocalID());
 
     if ((node->getType() == NodeType::Agent || node->getType() == NodeType::EntityScriptServer) && node->getLinkedData() && node->getActiveSocket() && !node->isUpstream()) {
         broadcastAvatarDataToAgent(node);
@@ -509,7 +511,7 @@ void AvatarMixerSlave::broadcastAvatarDataToAgent(const SharedNodePointer& node)
     int remainingAvatars = (int)avatarPriorityQueues[kHero].size() + (int)avatarPriorityQueues[kNonhero].size();
     auto traitsPacketList = NLPacketList::create(PacketType::BulkAvatarTraits, QByteArray(), true, true);
 
-    auto avatarPacket = NLPacket::create(PacketType::BulkAvatarData);
+    auto avatarPacket = _packetArena.acquire(PacketType::BulkAvatarData);
     const int avatarPacketCapacity = avatarPacket->getPayloadCapacity();
     int avatarSpaceAvailable = avatarPacketCapacity;
     int numPacketsSent = 0;
@@ -582,6 +584,7 @@ void AvatarMixerSlave::broadcastAvatarDataToAgent(const SharedNodePointer& node)
 
             do {
                 auto startSerialize = chrono::high_resolution_clock::now();
+                // still allocates a new byte array for each avatar, which is then copied into the pooled packet
                 QByteArray bytes = sourceAvatar->toByteArray(detail, lastEncodeForOther, lastSentJointsForOther,
                     sendStatus, dropFaceTracking, distanceAdjust, destinationPosition,
                     &lastSentJointsForOther, avatarSpaceAvailable);
@@ -594,9 +597,9 @@ void AvatarMixerSlave::broadcastAvatarDataToAgent(const SharedNodePointer& node)
                 numAvatarDataBytes += bytes.size();
                 if (!sendStatus || avatarSpaceAvailable < (int)AvatarDataPacket::MIN_BULK_PACKET_SIZE) {
                     // Weren't able to fit everything.
-                    nodeList->sendPacket(std::move(avatarPacket), *destinationNode);
+                    _packetArena.send(*nodeList, std::move(avatarPacket), *destinationNode);
                     ++numPacketsSent;
-                    avatarPacket = NLPacket::create(PacketType::BulkAvatarData);
+                    avatarPacket = _packetArena.acquire(PacketType::BulkAvatarData);
                     avatarSpaceAvailable = avatarPacketCapacity;
                 }
             } while (!sendStatus);
@@ -641,10 +644,13 @@ void AvatarMixerSlave::broadcastAvatarDataToAgent(const SharedNodePointer& node)
     }
 
     quint64 startPacketSending = usecTimestampNow();
+    FRAME_TRACE_RANGE(_sharedData->frameTracer, "send");
 
     if (avatarPacket->getPayloadSize() != 0) {
-        nodeList->sendPacket(std::move(avatarPacket), *destinationNode);
+        _packetArena.send(*nodeList, std::move(avatarPacket), *destinationNode);
         ++numPacketsSent;
+    } else {
+        _packetArena.recycle(std::move(avatarPacket));
     }
 
     _stats.numDataPacketsSent += numPacketsSent;
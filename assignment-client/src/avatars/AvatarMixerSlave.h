@@ -12,6 +12,8 @@
 #ifndef hifi_AvatarMixerSlave_h
 #define hifi_AvatarMixerSlave_h
 
+#include <FrameTracer.h>
+#include <NLPacketArena.h>
 #include <NodeList.h>
 
 class AvatarMixerClientData;
@@ -100,6 +102,8 @@ struct SlaveSharedData {
     QStringList skeletonURLWhitelist;
     QUrl skeletonReplacementURL;
     EntityTreePointer entityTree;
+
+    tracing::FrameTracer frameTracer { "avatar-mixer" };
 };
 
 class AvatarMixerSlave {
@@ -143,6 +147,9 @@ private:
     float _throttlingRatio { 0.0f };
     float _avatarHeroFraction { 0.4f };
 
+    // bulk avatar data packets, recycled once sent
+    NLPacketArena _packetArena;
+
     AvatarMixerSlaveStats _stats;
     SlaveSharedData* _sharedData;
 };
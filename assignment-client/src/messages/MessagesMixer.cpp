@@ -11,17 +11,57 @@
 
 #include "MessagesMixer.h"
 
+#include <algorithm>
+#include <atomic>
+
 #include <QtCore/QCoreApplication>
 #include <QtCore/QJsonObject>
 #include <QBuffer>
 #include <LogHandler.h>
 #include <MessagesClient.h>
 #include <NodeList.h>
+#include <NumericalConstants.h>
+#include <SharedUtil.h>
+#include <task/Parallel.h>
 #include <udt/PacketHeaders.h>
 
 const QString MESSAGES_MIXER_LOGGING_NAME = "messages-mixer";
 const int MESSAGES_MIXER_RATE_LIMITER_INTERVAL = 1000; // 1 second
 
+// channels with at least this many subscribers send their messages from the thread pool
+const int MIN_SUBSCRIBERS_FOR_PARALLEL_SEND = 64;
+const int SUBSCRIBERS_PER_SEND_JOB = 32;
+
+// Returns the payload of a MessagesData packet as the mixer sends it on, which is the payload it received unless the
+// message is malformed, and the UTF-8 name of its channel.
+static QByteArray readForwardedMessage(QSharedPointer<ReceivedMessage> receivedMessage, QByteArray& channelUtf8) {
+    quint16 channelLength = 0;
+    receivedMessage->readPrimitive(&channelLength);
+    channelUtf8 = receivedMessage->read(channelLength);
+    bool isText = false;
+    receivedMessage->readPrimitive(&isText);
+    quint32 messageLength = 0;
+    receivedMessage->readPrimitive(&messageLength);
+
+    qint64 expectedSize = (qint64)(sizeof(channelLength) + channelLength + sizeof(isText) + sizeof(messageLength)) +
+        (qint64)messageLength + NUM_BYTES_RFC4122_UUID;
+    if (channelUtf8.length() == channelLength && receivedMessage->getSize() == expectedSize) {
+        return receivedMessage->getMessage();
+    }
+
+    // decode and encode it again, the way the mixer used to, for the same result
+    QString channel, message;
+    QByteArray data;
+    QUuid senderID;
+    receivedMessage->seek(0);
+    MessagesClient::decodeMessagesPacket(receivedMessage, channel, isText, message, data, senderID);
+    channelUtf8 = channel.toUtf8();
+    auto packetList = isText ? MessagesClient::encodeMessagesPacket(channel, message, senderID) :
+                               MessagesClient::encodeMessagesDataPacket(channel, data, senderID);
+    packetList->closeCurrentPacket();
+    return packetList->getMessage();
+}
+
 MessagesMixer::MessagesMixer(ReceivedMessage& message) : ThreadedAssignment(message)
 {
     connect(DependencyManager::get<NodeList>().data(), &NodeList::nodeKilled, this, &MessagesMixer::nodeKilled);
@@ -34,21 +74,41 @@ MessagesMixer::MessagesMixer(ReceivedMessage& message) : ThreadedAssignment(mess
         PacketReceiver::makeSourcedListenerReference<MessagesMixer>(this, &MessagesMixer::handleMessagesUnsubscribe));
 }
 
+MessagesMixer::ChannelID MessagesMixer::findOrAddChannel(const QByteArray& channelUtf8) {
+    auto itr = _channelIDs.find(channelUtf8);
+    if (itr != _channelIDs.end()) {
+        return *itr;
+    }
+    ChannelID channelID = (ChannelID)_channels.size();
+    _channels.emplace_back();
+    _channels.back().name = QString::fromUtf8(channelUtf8);
+    _channelIDs.insert(channelUtf8, channelID);
+    return channelID;
+}
+
+void MessagesMixer::unsubscribe(ChannelID channelID, const QUuid& nodeID) {
+    auto& subscribers = _channels[channelID].subscribers;
+    auto subscriber = std::find_if(subscribers.begin(), subscribers.end(), [&](const SharedNodePointer& node) {
+        return node->getUUID() == nodeID;
+    });
+    if (subscriber != subscribers.end()) {
+        *subscriber = subscribers.back();
+        subscribers.pop_back();
+    }
+}
+
 void MessagesMixer::nodeKilled(SharedNodePointer killedNode) {
-    for (auto& channel : _channelSubscribers) {
-        channel.remove(killedNode->getUUID());
+    auto itr = _nodeChannels.find(killedNode->getUUID());
+    if (itr != _nodeChannels.end()) {
+        for (ChannelID channelID : *itr) {
+            unsubscribe(channelID, killedNode->getUUID());
+        }
+        _nodeChannels.erase(itr);
     }
 }
 
 void MessagesMixer::handleMessages(QSharedPointer<ReceivedMessage> receivedMessage, SharedNodePointer senderNode) {
-    QString channel, message;
-    QByteArray data;
-    QUuid senderID;
-    bool isText;
     auto senderUUID = senderNode->getUUID();
-    MessagesClient::decodeMessagesPacket(receivedMessage, channel, isText, message, data, senderID);
-
-    auto nodeList = DependencyManager::get<NodeList>();
 
     auto itr = _allSubscribers.find(senderUUID);
     if (itr == _allSubscribers.end()) {
@@ -59,30 +119,63 @@ void MessagesMixer::handleMessages(QSharedPointer<ReceivedMessage> receivedMessa
         *itr += 1;
     }
 
-    nodeList->eachMatchingNode(
-        [&](const SharedNodePointer& node)->bool {
-        return node->getActiveSocket() && _channelSubscribers[channel].contains(node->getUUID());
-    },
-        [&](const SharedNodePointer& node) {
-        auto packetList = isText ? MessagesClient::encodeMessagesPacket(channel, message, senderID) :
-                                   MessagesClient::encodeMessagesDataPacket(channel, data, senderID);
-        nodeList->sendPacketList(std::move(packetList), *node);
-    });
+    QByteArray channelUtf8;
+    QByteArray payload = readForwardedMessage(receivedMessage, channelUtf8);
+    auto channelItr = _channelIDs.find(channelUtf8);
+    if (channelItr == _channelIDs.end()) {
+        return;
+    }
+    Channel& channel = _channels[*channelItr];
+    ++channel.numMessagesReceived;
+
+    // the payload is shared by every subscriber, only the packet list around it is per connection
+    auto nodeList = DependencyManager::get<NodeList>();
+    std::atomic<int> numMessagesSent { 0 };
+    auto sendToSubscribers = [&](int begin, int end) {
+        int numSent = 0;
+        for (int i = begin; i < end; ++i) {
+            const SharedNodePointer& node = channel.subscribers[i];
+            if (node->getActiveSocket()) {
+                auto packetList = NLPacketList::create(PacketType::MessagesData, QByteArray(), true, true);
+                packetList->write(payload);
+                nodeList->sendPacketList(std::move(packetList), *node);
+                ++numSent;
+            }
+        }
+        numMessagesSent += numSent;
+    };
+
+    int numSubscribers = (int)channel.subscribers.size();
+    if (numSubscribers >= MIN_SUBSCRIBERS_FOR_PARALLEL_SEND) {
+        task::parallelForRange(numSubscribers, SUBSCRIBERS_PER_SEND_JOB, sendToSubscribers);
+    } else {
+        sendToSubscribers(0, numSubscribers);
+    }
+    channel.numMessagesSent += numMessagesSent;
 }
 
 void MessagesMixer::handleMessagesSubscribe(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode) {
-    auto senderUUID = senderNode->getUUID();
-    QString channel = QString::fromUtf8(message->getMessage());
+    ChannelID channelID = findOrAddChannel(message->getMessage());
 
-    _channelSubscribers[channel] << senderUUID;
+    auto& nodeChannels = _nodeChannels[senderNode->getUUID()];
+    if (std::find(nodeChannels.begin(), nodeChannels.end(), channelID) == nodeChannels.end()) {
+        nodeChannels.push_back(channelID);
+        _channels[channelID].subscribers.push_back(senderNode);
+    }
 }
 
 void MessagesMixer::handleMessagesUnsubscribe(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode) {
-    auto senderUUID = senderNode->getUUID();
-    QString channel = QString::fromUtf8(message->getMessage());
+    auto channelItr = _channelIDs.find(message->getMessage());
+    auto nodeItr = _nodeChannels.find(senderNode->getUUID());
+    if (channelItr == _channelIDs.end() || nodeItr == _nodeChannels.end()) {
+        return;
+    }
 
-    if (_channelSubscribers.contains(channel)) {
-        _channelSubscribers[channel].remove(senderUUID);
+    auto nodeChannel = std::find(nodeItr->begin(), nodeItr->end(), *channelItr);
+    if (nodeChannel != nodeItr->end()) {
+        *nodeChannel = nodeItr->back();
+        nodeItr->pop_back();
+        unsubscribe(*channelItr, senderNode->getUUID());
     }
 }
 
@@ -99,6 +192,27 @@ void MessagesMixer::sendStatsPacket() {
     });
 
     statsObject["messages"] = messagesMixerObject;
+
+    // add stats for each channel that had messages since the last stats packet
+    quint64 now = usecTimestampNow();
+    float secondsElapsed = (_lastStatsTime > 0 && now > _lastStatsTime) ?
+        (float)(now - _lastStatsTime) / (float)USECS_PER_SECOND : 1.0f;
+    _lastStatsTime = now;
+
+    QJsonObject channelsObject;
+    for (auto& channel : _channels) {
+        if (channel.numMessagesReceived > 0) {
+            QJsonObject channelStats;
+            channelStats["subscribers"] = (int)channel.subscribers.size();
+            channelStats["messages_per_second"] = (float)channel.numMessagesReceived / secondsElapsed;
+            channelStats["sent_per_second"] = (float)channel.numMessagesSent / secondsElapsed;
+            channelStats["fan_out"] = (float)channel.numMessagesSent / (float)channel.numMessagesReceived;
+            channelsObject[channel.name] = channelStats;
+        }
+        channel.numMessagesReceived = 0;
+        channel.numMessagesSent = 0;
+    }
+    statsObject["channels"] = channelsObject;
     ThreadedAssignment::addPacketStatsAndSendStatsPacket(statsObject);
 }
 
@@ -15,8 +15,11 @@
 #ifndef hifi_MessagesMixer_h
 #define hifi_MessagesMixer_h
 
+#include <vector>
+
 #include <QtCore/QSharedPointer>
 
+#include <Node.h>
 #include <ThreadedAssignment.h>
 
 /// Handles assignments of type MessagesMixer - distribution of avatar data to various clients
@@ -42,7 +45,27 @@ private slots:
     void processMaxMessagesContainer();
 
 private:
-    QHash<QString, QSet<QUuid>> _channelSubscribers;
+    using ChannelID = int;
+
+    class Channel {
+    public:
+        QString name;
+        // the nodes subscribed to the channel, in no particular order
+        std::vector<SharedNodePointer> subscribers;
+        // since the last stats packet
+        quint64 numMessagesReceived { 0 };
+        quint64 numMessagesSent { 0 };
+    };
+
+    ChannelID findOrAddChannel(const QByteArray& channelUtf8);
+    void unsubscribe(ChannelID channelID, const QUuid& nodeID);
+
+    // channels are interned by their UTF-8 name, as the clients send it, and are never removed
+    QHash<QByteArray, ChannelID> _channelIDs;
+    std::vector<Channel> _channels;
+    QHash<QUuid, std::vector<ChannelID>> _nodeChannels;
+    quint64 _lastStatsTime { 0 };
+
     QHash<QUuid, int> _allSubscribers;
 
     const int DEFAULT_NODE_MESSAGES_PER_SECOND = 1000;
@@ -17,6 +17,14 @@ macro(TARGET_BULLET)
         list(APPEND BULLET_LIBRARIES ${LIB_DIR}/libBulletSoftBody.a)
     else()
         find_package(Bullet REQUIRED)
+        # the headers must agree with the library about BT_THREADSAFE, which only the bullet3 port's multithreading
+        # feature records, so any other Bullet is taken to be single threaded
+        get_filename_component(BULLET_INSTALL_DIR "${BULLET_INCLUDE_DIR}/../.." ABSOLUTE)
+        if (EXISTS "${BULLET_INSTALL_DIR}/share/bullet3/threadsafe")
+            set(BULLET_THREADSAFE 1)
+        else()
+            set(BULLET_THREADSAFE 0)
+        endif()
    endif()
     # perform the system include hack for OS X to ignore warnings
     if (APPLE)
@@ -25,6 +33,9 @@ macro(TARGET_BULLET)
       target_include_directories(${TARGET_NAME} SYSTEM PRIVATE ${BULLET_INCLUDE_DIRS})
     endif()
     target_compile_definitions(${TARGET_NAME} PUBLIC BT_ENABLE_PROFILE)
+    if (BULLET_THREADSAFE)
+        target_compile_definitions(${TARGET_NAME} PUBLIC BT_THREADSAFE=1)
+    endif()
     target_link_libraries(${TARGET_NAME} ${BULLET_LIBRARIES})
 endmacro()
 
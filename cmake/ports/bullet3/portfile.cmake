@@ -40,4 +40,9 @@ file(REMOVE_RECURSE "${CURRENT_PACKAGES_DIR}/debug/share")
 file(REMOVE_RECURSE "${CURRENT_PACKAGES_DIR}/debug/include")
 file(REMOVE_RECURSE "${CURRENT_PACKAGES_DIR}/include/bullet/BulletInverseDynamics/details")
 
+# lets target_bullet() know that code using these headers must define BT_THREADSAFE
+if ("multithreading" IN_LIST FEATURES)
+    file(WRITE "${CURRENT_PACKAGES_DIR}/share/${PORT}/threadsafe" "BT_THREADSAFE=1\n")
+endif()
+
 file(INSTALL "${SOURCE_PATH}/LICENSE.txt" DESTINATION "${CURRENT_PACKAGES_DIR}/share/${PORT}" RENAME copyright)
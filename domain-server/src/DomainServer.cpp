@@ -12,6 +12,7 @@
 
 #include "DomainServer.h"
 
+#include <algorithm>
 #include <memory>
 #include <random>
 #include <iostream>
@@ -1265,6 +1266,17 @@ void DomainServer::processListRequestPacket(QSharedPointer<ReceivedMessage> mess
         safeInterestSet.remove(NodeType::Agent);
     }
 
+    // the last domain list this node received in full, so that it only gets what changed since
+    quint32 lastDomainListVersion = 0;
+    if (!packetStream.atEnd()) {
+        packetStream >> lastDomainListVersion;
+    }
+
+    // a node with new interests needs every node it is now interested in
+    if (safeInterestSet != nodeData->getNodeInterestSet()) {
+        lastDomainListVersion = 0;
+    }
+
     // update the NodeInterestSet in case there have been any changes
     nodeData->setNodeInterestSet(safeInterestSet);
 
@@ -1274,7 +1286,11 @@ void DomainServer::processListRequestPacket(QSharedPointer<ReceivedMessage> mess
     // client-side send time of last connect/domain list request
     nodeData->setLastDomainCheckinTimestamp(nodeRequestData.lastPingTimestamp);
 
-    sendDomainListToNode(sendingNode, message->getFirstPacketReceiveTime(), message->getSenderSockAddr(), false);
+    // pick up any change to this node's sockets, permissions or replication for the lists of the other nodes
+    updateDomainListEntry(sendingNode);
+
+    sendDomainListToNode(sendingNode, message->getFirstPacketReceiveTime(), message->getSenderSockAddr(), false,
+                         lastDomainListVersion);
 }
 
 bool DomainServer::isInInterestSet(const SharedNodePointer& nodeA, const SharedNodePointer& nodeB) {
@@ -1352,20 +1368,65 @@ void DomainServer::handleConnectedNode(SharedNodePointer newNode, quint64 reques
         newNode->setIsReplicated(true);
     }
 
+    updateDomainListEntry(newNode);
+
     // send out this node to our other connected nodes
     broadcastNewNode(newNode);
 }
 
-void DomainServer::sendDomainListToNode(const SharedNodePointer& node, quint64 requestPacketReceiveTime, const SockAddr &senderSockAddr, bool newConnection) {
+void DomainServer::sendDomainListToNode(const SharedNodePointer& node, quint64 requestPacketReceiveTime, const SockAddr &senderSockAddr,
+                                        bool newConnection, quint32 lastDomainListVersion) {
     const int NUM_DOMAIN_LIST_EXTENDED_HEADER_BYTES = NUM_BYTES_RFC4122_UUID + NLPacket::NUM_BYTES_LOCALID +
         NUM_BYTES_RFC4122_UUID + NLPacket::NUM_BYTES_LOCALID + 4;
 
+    DomainServerNodeData* nodeData = static_cast<DomainServerNodeData*>(node->getLinkedData());
+    auto limitedNodeList = DependencyManager::get<LimitedNodeList>();
+
+    // send only what changed since the last list the node received in full, if we still know what that is
+    bool isDelta = !newConnection && lastDomainListVersion != 0 && lastDomainListVersion >= _oldestDomainListDeltaVersion
+        && lastDomainListVersion <= _domainListVersion;
+    quint32 baseVersion = isDelta ? lastDomainListVersion : 0;
+
+    // store the nodeInterestSet on this DomainServerNodeData, in case it has changed
+    auto& nodeInterestSet = nodeData->getNodeInterestSet();
+
+    // find the entries first, so that the node knows from any packet of the list how many entries make it up
+    std::vector<SharedNodePointer> listedNodes;
+    std::vector<QUuid> removedNodes;
+    if (nodeInterestSet.size() > 0) {
+
+        // DTLSServerSession* dtlsSession = _isUsingDTLS ? _dtlsSessions[senderSockAddr] : NULL;
+        if (nodeData->isAuthenticated()) {
+            // if this authenticated node has any interest types, send back those nodes as well
+            limitedNodeList->eachNode([&](const SharedNodePointer& otherNode) {
+                auto otherNodeData = static_cast<DomainServerNodeData*>(otherNode->getLinkedData());
+                if (isDelta && otherNodeData && otherNodeData->getDomainListEntryVersion() <= baseVersion) {
+                    // the node already has this entry
+                    return;
+                }
+                if (otherNode->getUUID() != node->getUUID() && isInInterestSet(node, otherNode)) {
+                    listedNodes.push_back(otherNode);
+                }
+            });
+
+            if (isDelta) {
+                auto removedNode = std::upper_bound(_removedNodes.begin(), _removedNodes.end(), baseVersion,
+                    [](quint32 version, const RemovedNode& removedNode) {
+                        return version < removedNode.domainListVersion;
+                    });
+                for (; removedNode != _removedNodes.end(); ++removedNode) {
+                    if (nodeInterestSet.contains(removedNode->type)) {
+                        removedNodes.push_back(removedNode->uuid);
+                    }
+                }
+            }
+        }
+    }
+
     // setup the extended header for the domain list packets
     // this data is at the beginning of each of the domain list packets
     QByteArray extendedHeader(NUM_DOMAIN_LIST_EXTENDED_HEADER_BYTES, 0);
     QDataStream extendedHeaderStream(&extendedHeader, QIODevice::WriteOnly);
-    DomainServerNodeData* nodeData = static_cast<DomainServerNodeData*>(node->getLinkedData());
-    auto limitedNodeList = DependencyManager::get<LimitedNodeList>();
 
     extendedHeaderStream << limitedNodeList->getSessionUUID();
     extendedHeaderStream << limitedNodeList->getSessionLocalID();
@@ -1377,35 +1438,38 @@ void DomainServer::sendDomainListToNode(const SharedNodePointer& node, quint64 r
     extendedHeaderStream << quint64(duration_cast<microseconds>(system_clock::now().time_since_epoch()).count());
     extendedHeaderStream << quint64(duration_cast<microseconds>(p_high_resolution_clock::now().time_since_epoch()).count()) - requestPacketReceiveTime;
     extendedHeaderStream << newConnection;
+    extendedHeaderStream << _domainListVersion;
+    extendedHeaderStream << baseVersion;
+    extendedHeaderStream << (quint32)(listedNodes.size() + removedNodes.size());
     auto domainListPackets = NLPacketList::create(PacketType::DomainList, extendedHeader);
 
     // always send the node their own UUID back
     QDataStream domainListStream(domainListPackets.get());
 
-    // store the nodeInterestSet on this DomainServerNodeData, in case it has changed
-    auto& nodeInterestSet = nodeData->getNodeInterestSet();
-
-    if (nodeInterestSet.size() > 0) {
+    for (const auto& removedNodeID : removedNodes) {
+        domainListPackets->startSegment();
+        domainListStream << true;
+        domainListStream << removedNodeID;
+        domainListPackets->endSegment();
+    }
 
-        // DTLSServerSession* dtlsSession = _isUsingDTLS ? _dtlsSessions[senderSockAddr] : NULL;
-        if (nodeData->isAuthenticated()) {
-            // if this authenticated node has any interest types, send back those nodes as well
-            limitedNodeList->eachNode([this, node, &domainListPackets, &domainListStream](const SharedNodePointer& otherNode) {
-                if (otherNode->getUUID() != node->getUUID() && isInInterestSet(node, otherNode)) {
-                    // since we're about to add a node to the packet we start a segment
-                    domainListPackets->startSegment();
+    for (const auto& otherNode : listedNodes) {
+        // since we're about to add a node to the packet we start a segment
+        domainListPackets->startSegment();
 
-                    // don't send avatar nodes to other avatars, that will come from avatar mixer
-                    domainListStream << *otherNode.data();
+        domainListStream << false;
+        auto otherNodeData = static_cast<DomainServerNodeData*>(otherNode->getLinkedData());
+        if (otherNodeData && !otherNodeData->getDomainListEntry().isEmpty()) {
+            domainListPackets->write(otherNodeData->getDomainListEntry());
+        } else {
+            domainListStream << *otherNode.data();
+        }
 
-                    // pack the secret that these two nodes will use to communicate with each other
-                    domainListStream << connectionSecretForNodes(node, otherNode);
+        // pack the secret that these two nodes will use to communicate with each other
+        domainListStream << connectionSecretForNodes(node, otherNode);
 
-                    // we've added the node we wanted so end the segment now
-                    domainListPackets->endSegment();
-                }
-            });
-        }
+        // we've added the node we wanted so end the segment now
+        domainListPackets->endSegment();
     }
 
     // send an empty list to the node, in case there were no other nodes
@@ -1415,6 +1479,20 @@ void DomainServer::sendDomainListToNode(const SharedNodePointer& node, quint64 r
     limitedNodeList->sendPacketList(std::move(domainListPackets), *node);
 }
 
+void DomainServer::updateDomainListEntry(const SharedNodePointer& node) {
+    auto nodeData = static_cast<DomainServerNodeData*>(node->getLinkedData());
+    if (!nodeData) {
+        return;
+    }
+
+    QByteArray entry;
+    QDataStream entryStream(&entry, QIODevice::WriteOnly);
+    entryStream << *node.data();
+    if (entry != nodeData->getDomainListEntry()) {
+        nodeData->setDomainListEntry(entry, ++_domainListVersion);
+    }
+}
+
 QUuid DomainServer::connectionSecretForNodes(const SharedNodePointer& nodeA, const SharedNodePointer& nodeB) {
     DomainServerNodeData* nodeAData = static_cast<DomainServerNodeData*>(nodeA->getLinkedData());
     DomainServerNodeData* nodeBData = static_cast<DomainServerNodeData*>(nodeB->getLinkedData());
@@ -3413,6 +3491,14 @@ void DomainServer::nodeKilled(SharedNodePointer node) {
         }
     }
 
+    // keep the removal for the domain lists of the nodes that haven't heard about it yet
+    const size_t MAX_REMOVED_NODES = 1000;
+    _removedNodes.push_back({ ++_domainListVersion, node->getUUID(), node->getType() });
+    if (_removedNodes.size() > MAX_REMOVED_NODES) {
+        _oldestDomainListDeltaVersion = _removedNodes.front().domainListVersion;
+        _removedNodes.pop_front();
+    }
+
     broadcastNodeDisconnect(node);
 }
 
@@ -13,6 +13,8 @@
 #ifndef hifi_DomainServer_h
 #define hifi_DomainServer_h
 
+#include <deque>
+
 #include <QtCore/QCoreApplication>
 #include <QtCore/QHash>
 #include <QtCore/QJsonObject>
@@ -202,7 +204,9 @@ private:
     void handleKillNode(SharedNodePointer nodeToKill);
     void broadcastNodeDisconnect(const SharedNodePointer& disconnnectedNode);
 
-    void sendDomainListToNode(const SharedNodePointer& node, quint64 requestPacketReceiveTime, const SockAddr& senderSockAddr, bool newConnection);
+    void sendDomainListToNode(const SharedNodePointer& node, quint64 requestPacketReceiveTime, const SockAddr& senderSockAddr,
+                              bool newConnection, quint32 lastDomainListVersion = 0);
+    void updateDomainListEntry(const SharedNodePointer& node);
 
     bool isInInterestSet(const SharedNodePointer& nodeA, const SharedNodePointer& nodeB);
 
@@ -266,6 +270,19 @@ private:
     DomainGatekeeper _gatekeeper;
     DomainServerExporter _exporter;
 
+    // Domain lists only carry what changed since the last list version the node received in full: the nodes whose
+    // entry changed after that version, and the nodes removed after it.
+    class RemovedNode {
+    public:
+        quint32 domainListVersion;
+        QUuid uuid;
+        NodeType_t type;
+    };
+    quint32 _domainListVersion { 0 };
+    std::deque<RemovedNode> _removedNodes;
+    // nodes that last received a list in full before this version get a full list again
+    quint32 _oldestDomainListDeltaVersion { 0 };
+
     HTTPManager _httpManager;
     HTTPManager* _httpExporterManager { nullptr };
     HTTPManager* _httpMetadataExporterManager { nullptr };
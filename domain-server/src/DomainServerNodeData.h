@@ -76,6 +76,14 @@ public:
 
     bool hasCheckedIn() const { return _hasCheckedIn; }
     void setHasCheckedIn(bool hasCheckedIn) { _hasCheckedIn = hasCheckedIn; }
+
+    // the node as it is written in domain lists, and the domain list version it last changed at
+    const QByteArray& getDomainListEntry() const { return _domainListEntry; }
+    quint32 getDomainListEntryVersion() const { return _domainListEntryVersion; }
+    void setDomainListEntry(const QByteArray& entry, quint32 version) {
+        _domainListEntry = entry;
+        _domainListEntryVersion = version;
+    }
     
 private:
     QJsonObject overrideValuesIfNeeded(const QJsonObject& newStats);
@@ -103,6 +111,9 @@ private:
     bool _wasAssigned { false };
 
     bool _hasCheckedIn { false };
+
+    QByteArray _domainListEntry;
+    quint32 _domainListEntryVersion { 0 };
 };
 
 #endif // hifi_DomainServerNodeData_h
@@ -131,6 +131,10 @@ Item {
                         visible: root.expanded
                         text: "Avatars NOT Updated: " + root.notUpdatedAvatarCount
                     }
+                    StatText {
+                        visible: root.expanded
+                        text: "Avatar Anim LODs: " + root.avatarAnimationLODCounts
+                    }
                     StatText {
                         visible: root.expanded
                         text: "Total picks:\n    " +
@@ -133,6 +133,7 @@
 #include <RecordingScriptingInterface.h>
 #include <render/EngineStats.h>
 #include <SecondaryCamera.h>
+#include <ShapeCache.h>
 #include <ResourceCache.h>
 #include <ResourceRequest.h>
 #include <SandboxUtils.h>
@@ -338,6 +339,9 @@ static const int WATCHDOG_TIMER_TIMEOUT = 100;
 
 static const float INITIAL_QUERY_RADIUS = 10.0f;  // priority radius for entities before physics enabled
 
+static const std::string SHAPE_CACHE_DIRNAME = "shape_cache";
+static const size_t SHAPE_CACHE_MAX_SIZE = 512 * BYTES_PER_MEGABYTES;
+
 static const QString DESKTOP_LOCATION = QStandardPaths::writableLocation(QStandardPaths::DesktopLocation);
 
 Setting::Handle<int> maxOctreePacketsPerSecond{"maxOctreePPS", DEFAULT_MAX_OCTREE_PPS};
@@ -5722,7 +5726,10 @@ void Application::init() {
         return atan2(maxSize, distance);
     });
 
+    // keep the BVHs and hulls of detailed collision shapes across sessions
+    ShapeCache::enable(SHAPE_CACHE_DIRNAME, SHAPE_CACHE_MAX_SIZE);
     ObjectMotionState::setShapeManager(&_shapeManager);
+    _physicsEngine->setNumThreads(_physicsThreadCount.get());
     _physicsEngine->init();
 
     EntityTreePointer tree = getEntities()->getTree();
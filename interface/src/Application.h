@@ -684,6 +684,7 @@ private:
     Setting::Handle<QString> _preferredCursor;
     Setting::Handle<bool> _miniTabletEnabledSetting;
     Setting::Handle<bool> _keepLogWindowOnTop { "keepLogWindowOnTop", false };
+    Setting::Handle<int> _physicsThreadCount { "physicsThreadCount", 1 };
 
     float _scaleMirror;
     float _mirrorYawOffset;
@@ -38,6 +38,7 @@
 #include <UsersScriptingInterface.h>
 #include <UUID.h>
 #include <shared/ConicalViewFrustum.h>
+#include <task/Parallel.h>
 #include <ui/AvatarInputs.h>
 
 #include "Application.h"
@@ -52,6 +53,9 @@
 // in the update loop - this also results in ~30hz when in desktop mode which is essentially
 // what we want
 
+// enough avatars to keep the thread pool busy copying joints, few enough to check the time budget often
+static const int AVATARS_PER_UPDATE_BATCH = 16;
+
 // We add _myAvatar into the hash with all the other AvatarData, and we use the default NULL QUid as the key.
 const QUuid MY_AVATAR_KEY;  // NULL key
 
@@ -216,6 +220,17 @@ float AvatarManager::getAvatarSimulationRate(const QUuid& sessionID, const QStri
     return avatar ? avatar->getSimulationRate(rateName) : 0.0f;
 }
 
+// the angular size of the avatar as seen from the nearest view, as in its sort priority
+static float computeAngularSize(const ConicalViewFrustums& views, const glm::vec3& position, float radius) {
+    const float MIN_RADIUS = 0.1f;
+    float angularSize = 0.0f;
+    for (const auto& view : views) {
+        float distance = glm::length(position - view.getPosition()) + 0.001f;
+        angularSize = std::max(angularSize, std::max(radius, MIN_RADIUS) / distance);
+    }
+    return angularSize;
+}
+
 void AvatarManager::updateOtherAvatars(float deltaTime) {
     {
         // lock the hash for read to check the size
@@ -296,6 +311,18 @@ void AvatarManager::updateOtherAvatars(float deltaTime) {
     render::Transaction renderTransaction;
     workload::Transaction workloadTransaction;
 
+    // Avatars are updated in batches.  Copying the joints received from the network into the rigs of a batch is spread
+    // across the thread pool, the rest of the update stays on this thread, and the time budget is checked between batches.
+    struct BatchEntry {
+        std::shared_ptr<OtherAvatar> avatar;
+        bool inView;
+    };
+    std::array<int, NUM_ANIMATION_LODS> numAvatarsAtAnimationLOD {{ 0, 0, 0, 0 }};
+    std::vector<BatchEntry> batch;
+    std::vector<OtherAvatar*> avatarsToUpdateJoints;
+    batch.reserve(AVATARS_PER_UPDATE_BATCH);
+    avatarsToUpdateJoints.reserve(AVATARS_PER_UPDATE_BATCH);
+
     for (int p = kHero; p < NumVariants; p++) {
         auto& priorityQueue = avatarPriorityQueues[p];
         // Sorting the current queue HERE as part of the measured timing.
@@ -303,44 +330,103 @@ void AvatarManager::updateOtherAvatars(float deltaTime) {
 
         auto passExpiry = updatePriorityExpiries[p];
 
-        for (auto it = sortedAvatarVector.begin(); it != sortedAvatarVector.end(); ++it) {
-            const SortableAvatar& sortData = *it;
-            const auto avatar = std::static_pointer_cast<OtherAvatar>(sortData.getAvatar());
-            if (!avatar->_isClientAvatar) {
-                avatar->setIsClientAvatar(true);
-            }
-            // TODO: to help us scale to more avatars it would be nice to not have to poll this stuff every update
-            if (avatar->getSkeletonModel()->isLoaded()) {
-                // remove the orb if it is there
-                avatar->removeOrb();
-                if (avatar->needsPhysicsUpdate()) {
-                    _otherAvatarsToChangeInPhysics.insert(avatar);
+        auto it = sortedAvatarVector.begin();
+        while (it != sortedAvatarVector.end()) {
+            uint64_t now = usecTimestampNow();
+            if (now >= passExpiry) {
+                // we've spent our time budget for this priority bucket
+                // let's deal with the reminding avatars if this pass and BREAK from the loop
+
+                if (p == kHero) {
+                    // Hero,
+                    // --> put them back in the non hero queue
+
+                    auto& crowdQueue = avatarPriorityQueues[kNonHero];
+                    while (it != sortedAvatarVector.end()) {
+                        crowdQueue.push(SortableAvatar((*it).getAvatar()));
+                        ++it;
+                    }
+                } else {
+                    // Non Hero
+                    // --> bail on the rest of the avatar updates
+                    // --> more avatars may freeze until their priority trickles up
+                    // --> some scale animations may glitch
+                    // --> some avatar velocity measurements may be a little off
+
+                    // no time to simulate, but we take the time to count how many were tragically missed
+                    numAvatarsNotUpdated = sortedAvatarVector.end() - it;
                 }
-            } else {
-                avatar->updateOrbPosition();
-            }
 
-            // for ALL avatars...
-            if (_shouldRender) {
-                avatar->ensureInScene(avatar, qApp->getMain3DScene());
+                // We had to cut short this pass, we must break out of the loop here
+                break;
             }
 
-            avatar->animateScaleChanges(deltaTime);
+            // we're within budget
+            auto batchEnd = it + std::min<ptrdiff_t>(AVATARS_PER_UPDATE_BATCH, sortedAvatarVector.end() - it);
+            batch.clear();
+            avatarsToUpdateJoints.clear();
+            for (; it != batchEnd; ++it) {
+                const SortableAvatar& sortData = *it;
+                const auto avatar = std::static_pointer_cast<OtherAvatar>(sortData.getAvatar());
+                if (!avatar->_isClientAvatar) {
+                    avatar->setIsClientAvatar(true);
+                }
+                // TODO: to help us scale to more avatars it would be nice to not have to poll this stuff every update
+                if (avatar->getSkeletonModel()->isLoaded()) {
+                    // remove the orb if it is there
+                    avatar->removeOrb();
+                    if (avatar->needsPhysicsUpdate()) {
+                        _otherAvatarsToChangeInPhysics.insert(avatar);
+                    }
+                } else {
+                    avatar->updateOrbPosition();
+                }
+
+                // for ALL avatars...
+                if (_shouldRender) {
+                    avatar->ensureInScene(avatar, qApp->getMain3DScene());
+                }
+
+                avatar->animateScaleChanges(deltaTime);
 
-            uint64_t now = usecTimestampNow();
-            if (now < passExpiry) {
-                // we're within budget
                 bool inView = sortData.getPriority() > OUT_OF_VIEW_THRESHOLD;
                 if (inView && avatar->hasNewJointData()) {
                     numAvatarsUpdated++;
                 }
+                if (inView) {
+                    // heroes are always animated in full
+                    int lod = 0;
+                    if (p != kHero) {
+                        float angularSize = computeAngularSize(views, sortData.getPosition(), sortData.getRadius());
+                        while (lod < NUM_ANIMATION_LODS - 1 && angularSize < _animationLODThresholds[lod]) {
+                            ++lod;
+                        }
+                    }
+                    avatar->setAnimationLOD((OtherAvatar::AnimationLOD)lod, _animationFrameCount);
+                    ++numAvatarsAtAnimationLOD[lod];
+                }
                 auto transitStatus = avatar->_transit.update(deltaTime, avatar->_serverPosition, _transitConfig);
                 if (avatar->getIsNewAvatar() && (transitStatus == AvatarTransit::Status::START_TRANSIT ||
                                                  transitStatus == AvatarTransit::Status::ABORT_TRANSIT)) {
                     avatar->_transit.reset();
                     avatar->setIsNewAvatar(false);
                 }
-                avatar->simulate(deltaTime, inView);
+                if (inView && avatar->needsJointsFromNetwork()) {
+                    avatarsToUpdateJoints.push_back(avatar.get());
+                }
+                batch.push_back({ avatar, inView });
+            }
+
+            {
+                PROFILE_RANGE(simulation, "updateJointsFromNetwork");
+                task::parallelFor((int)avatarsToUpdateJoints.size(), [&](int i) {
+                    avatarsToUpdateJoints[i]->updateJointsFromNetwork();
+                });
+            }
+
+            for (const auto& entry : batch) {
+                const auto& avatar = entry.avatar;
+                avatar->simulate(deltaTime, entry.inView);
                 if (avatar->getSkeletonModel()->isLoaded() && avatar->getWorkloadRegion() == workload::Region::R1) {
                     _myAvatar->addAvatarHandsToFlow(avatar);
                 }
@@ -351,33 +437,6 @@ void AvatarManager::updateOtherAvatars(float deltaTime) {
                 avatar->updateRenderItem(renderTransaction);
                 avatar->updateSpaceProxy(workloadTransaction);
                 avatar->setLastRenderUpdateTime(startTime);
-
-            } else {
-                // we've spent our time budget for this priority bucket
-                // let's deal with the reminding avatars if this pass and BREAK from the for loop
-
-                if (p == kHero) {
-                    // Hero,
-                    // --> put them back in the non hero queue
-
-                    auto& crowdQueue = avatarPriorityQueues[kNonHero];
-                    while (it != sortedAvatarVector.end()) {
-                        crowdQueue.push(SortableAvatar((*it).getAvatar()));
-                        ++it;
-                    }
-                } else {
-                    // Non Hero
-                    // --> bail on the rest of the avatar updates
-                    // --> more avatars may freeze until their priority trickles up
-                    // --> some scale animations may glitch
-                    // --> some avatar velocity measurements may be a little off
-
-                    // no time to simulate, but we take the time to count how many were tragically missed
-                    numAvatarsNotUpdated = sortedAvatarVector.end() - it;
-                }
-
-                // We had to cut short this pass, we must break out of the for loop here
-                break;
             }
         }
 
@@ -395,6 +454,8 @@ void AvatarManager::updateOtherAvatars(float deltaTime) {
     _numAvatarsUpdated = numAvatarsUpdated;
     _numAvatarsNotUpdated = numAvatarsNotUpdated;
     _numHeroAvatarsUpdated = numHerosUpdated;
+    _numAvatarsAtAnimationLOD = numAvatarsAtAnimationLOD;
+    ++_animationFrameCount;
 
     _avatarSimulationTime = (float)(usecTimestampNow() - startTime) / (float)USECS_PER_MSEC;
 }
@@ -979,6 +1040,25 @@ float AvatarManager::getAvatarSortCoefficient(const QString& name) {
     return 0.0f;
 }
 
+QVariantList AvatarManager::getAnimationLODThresholds() const {
+    QVariantList thresholds;
+    for (float threshold : _animationLODThresholds) {
+        thresholds.push_back(threshold);
+    }
+    return thresholds;
+}
+
+void AvatarManager::setAnimationLODThresholds(const QVariantList& thresholds) {
+    if (thresholds.size() != (int)_animationLODThresholds.size()) {
+        qCWarning(interfaceapp) << "AvatarManager::setAnimationLODThresholds expects" << _animationLODThresholds.size()
+                                << "thresholds";
+        return;
+    }
+    for (int i = 0; i < thresholds.size(); ++i) {
+        _animationLODThresholds[i] = thresholds[i].toFloat();
+    }
+}
+
 // HACK
 void AvatarManager::setAvatarSortCoefficient(const QString& name, const QScriptValue& value) {
     bool somethingChanged = false;
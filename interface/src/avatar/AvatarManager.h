@@ -12,6 +12,7 @@
 #ifndef hifi_AvatarManager_h
 #define hifi_AvatarManager_h
 
+#include <array>
 #include <set>
 
 #include <QtCore/QHash>
@@ -116,6 +117,7 @@ public:
     int getNumAvatarsNotUpdated() const { return _numAvatarsNotUpdated; }
     int getNumHeroAvatars() const { return _numHeroAvatars; }
     int getNumHeroAvatarsUpdated() const { return _numHeroAvatarsUpdated; }
+    int getNumAvatarsAtAnimationLOD(OtherAvatar::AnimationLOD lod) const { return _numAvatarsAtAnimationLOD[(int)lod]; }
     float getAvatarSimulationTime() const { return _avatarSimulationTime; }
 
     void updateMyAvatar(float deltaTime);
@@ -244,6 +246,26 @@ public:
      */
     Q_INVOKABLE QVariantMap getPalData(const QStringList& specificAvatarIdentifiers = QStringList());
 
+    /*@jsdoc
+     * Gets the angular sizes at which other avatars drop to lower animation levels of detail. The angular size of an 
+     * avatar is its bounding radius divided by its distance from the camera.
+     * <p>Avatars at least as large as the first value have their joints updated every frame. Smaller avatars have them 
+     * updated every second frame, then every fourth frame without their fingers, then every eighth frame without their 
+     * fingers.</p>
+     * @function AvatarManager.getAnimationLODThresholds
+     * @returns {number[]} The three angular sizes, largest first.
+     */
+    Q_INVOKABLE QVariantList getAnimationLODThresholds() const;
+
+    /*@jsdoc
+     * Sets the angular sizes at which other avatars drop to lower animation levels of detail. See 
+     * {@link AvatarManager.getAnimationLODThresholds|getAnimationLODThresholds}.
+     * @function AvatarManager.setAnimationLODThresholds
+     * @param {number[]} thresholds - The three angular sizes, largest first. Use <code>[0, 0, 0]</code> to always update 
+     *     every joint every frame.
+     */
+    Q_INVOKABLE void setAnimationLODThresholds(const QVariantList& thresholds);
+
     float getMyAvatarSendRate() const { return _myAvatarSendRate.rate(); }
 
     void queuePhysicsChange(const OtherAvatarPointer& avatar);
@@ -312,6 +334,12 @@ private:
 
     AvatarTransit::TransitConfig  _transitConfig;
     bool _drawOtherAvatarSkeletons { false };
+
+    static const int NUM_ANIMATION_LODS = (int)OtherAvatar::AnimationLOD::NumLODs;
+    // the angular sizes below which other avatars drop to each animation LOD after the first
+    std::array<float, NUM_ANIMATION_LODS - 1> _animationLODThresholds {{ 0.1f, 0.05f, 0.025f }};
+    std::array<int, NUM_ANIMATION_LODS> _numAvatarsAtAnimationLOD {{ 0, 0, 0, 0 }};
+    uint32_t _animationFrameCount { 0 };
 };
 
 #endif // hifi_AvatarManager_h
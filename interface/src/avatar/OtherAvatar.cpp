@@ -251,6 +251,21 @@ void OtherAvatar::setCollisionWithOtherAvatarsFlags() {
     }
 }
 
+void OtherAvatar::setAnimationLOD(AnimationLOD lod, uint32_t frameCount) {
+    _animationLOD = lod;
+    uint32_t framesPerUpdate = 1 << (uint32_t)lod;
+    _isAnimationFrame = ((frameCount + qHash(getID())) & (framesPerUpdate - 1)) == 0;
+}
+
+void OtherAvatar::updateJointsFromNetwork() {
+    PROFILE_RANGE(simulation, "copyJoints");
+    bool reducedSkeleton = _animationLOD >= AnimationLOD::Quarter;
+    _skeletonModel->getRig().copyJointsFromJointData(_jointData, reducedSkeleton);
+    glm::mat4 rootTransform = glm::scale(_skeletonModel->getScale()) * glm::translate(_skeletonModel->getOffset());
+    _skeletonModel->getRig().computeExternalPoses(rootTransform);
+    _jointsUpdatedFromNetwork = true;
+}
+
 void OtherAvatar::simulate(float deltaTime, bool inView) {
     PROFILE_RANGE(simulation, "simulate");
 
@@ -269,10 +284,11 @@ void OtherAvatar::simulate(float deltaTime, bool inView) {
         PROFILE_RANGE(simulation, "updateJoints");
         if (inView) {
             Head* head = getHead();
-            if (_hasNewJointData || _transit.isActive()) {
-                _skeletonModel->getRig().copyJointsFromJointData(_jointData);
-                glm::mat4 rootTransform = glm::scale(_skeletonModel->getScale()) * glm::translate(_skeletonModel->getOffset());
-                _skeletonModel->getRig().computeExternalPoses(rootTransform);
+            if (needsJointsFromNetwork()) {
+                if (!_jointsUpdatedFromNetwork) {
+                    updateJointsFromNetwork();
+                }
+                _jointsUpdatedFromNetwork = false;
                 _jointDataSimulationRate.increment();
 
                 head->simulate(deltaTime);
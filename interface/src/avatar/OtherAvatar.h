@@ -63,6 +63,26 @@ public:
 
     void setCollisionWithOtherAvatarsFlags() override;
 
+    // How often the joints of the avatar are updated, and whether all of them are.
+    enum class AnimationLOD : uint8_t {
+        Full = 0,
+        Half,
+        Quarter,   // no fingers from here on
+        Eighth,
+        NumLODs
+    };
+
+    // frameCount staggers the updates of the avatars at the same LOD across frames
+    void setAnimationLOD(AnimationLOD lod, uint32_t frameCount);
+    AnimationLOD getAnimationLOD() const { return _animationLOD; }
+
+    // true when the rig needs the joints received from the network this frame, if the avatar is in view
+    bool needsJointsFromNetwork() { return _isAnimationFrame && (_hasNewJointData || _transit.isActive()); }
+    // Copies the joints received from the network into the rig and computes its poses.  This only touches the rig of
+    // this avatar, so it can run for several avatars at once on worker threads before they are simulated.
+    // Otherwise simulate does it.
+    void updateJointsFromNetwork();
+
     void simulate(float deltaTime, bool inView) override;
     void debugJointData() const;
     friend AvatarManager;
@@ -91,6 +111,9 @@ protected:
     uint8_t _workloadRegion { workload::Region::INVALID };
     BodyLOD _bodyLOD { BodyLOD::Sphere };
     bool _needsDetailedRebuild { false };
+    bool _jointsUpdatedFromNetwork { false };
+    AnimationLOD _animationLOD { AnimationLOD::Full };
+    bool _isAnimationFrame { true };
 };
 
 using OtherAvatarPointer = std::shared_ptr<OtherAvatar>;
@@ -130,6 +130,11 @@ void Stats::updateStats(bool force) {
     STAT_UPDATE(updatedAvatarCount, avatarManager->getNumAvatarsUpdated());
     STAT_UPDATE(updatedHeroAvatarCount, avatarManager->getNumHeroAvatarsUpdated());
     STAT_UPDATE(notUpdatedAvatarCount, avatarManager->getNumAvatarsNotUpdated());
+    QStringList animationLODCounts;
+    for (int i = 0; i < (int)OtherAvatar::AnimationLOD::NumLODs; ++i) {
+        animationLODCounts << QString::number(avatarManager->getNumAvatarsAtAnimationLOD((OtherAvatar::AnimationLOD)i));
+    }
+    STAT_UPDATE(avatarAnimationLODCounts, animationLODCounts.join("/"));
     STAT_UPDATE(serverCount, (int)nodeList->size());
     STAT_UPDATE_FLOAT(renderrate, qApp->getRenderLoopRate(), 0.1f);
     RefreshRateManager& refreshRateManager = qApp->getRefreshRateManager();
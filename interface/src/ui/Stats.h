@@ -96,6 +96,10 @@ private: \
  * @property {number} notUpdatedAvatarCount - The number of avatars in the domain, other than the client's, that weren't able 
  *     to be updated in the most recent game loop because there wasn't enough time to.
  *     <em>Read-only.</em>
+ * @property {string} avatarAnimationLODCounts - The number of avatars in view, other than the client's, at each animation 
+ *     level of detail in the most recent game loop: full, half rate, quarter rate and eighth rate, separated by 
+ *     <code>"/"</code>.
+ *     <em>Read-only.</em>
  * @property {number} packetInCount - The number of packets being received from the domain server, in packets per second.
  *     <em>Read-only.</em>
  * @property {number} packetOutCount - The number of packets being sent to the domain server, in packets per second.
@@ -488,6 +492,7 @@ class Stats : public QQuickItem {
     STATS_PROPERTY(int, updatedAvatarCount, 0)
     STATS_PROPERTY(int, updatedHeroAvatarCount, 0)
     STATS_PROPERTY(int, notUpdatedAvatarCount, 0)
+    STATS_PROPERTY(QString, avatarAnimationLODCounts, QString())
     STATS_PROPERTY(int, packetInCount, 0)
     STATS_PROPERTY(int, packetOutCount, 0)
     STATS_PROPERTY(float, mbpsIn, 0)
@@ -816,6 +821,13 @@ signals:
      */
     void notUpdatedAvatarCountChanged();
 
+    /*@jsdoc
+     * Triggered when the value of the <code>avatarAnimationLODCounts</code> property changes.
+     * @function Stats.avatarAnimationLODCountsChanged
+     * @returns {Signal}
+     */
+    void avatarAnimationLODCountsChanged();
+
     /*@jsdoc
      * Triggered when the value of the <code>packetInCount</code> property changes.
      * @function Stats.packetInCountChanged
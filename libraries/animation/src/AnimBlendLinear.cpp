@@ -94,9 +94,15 @@ void AnimBlendLinear::evaluateAndBlendChildren(const AnimVariantMap& animVars, c
             _poses.resize(prevPoses.size());
 
             if (_blendType == AnimBlendType_Normal) {
-                ::blend(_poses.size(), &prevPoses[0], &nextPoses[0], alpha, &_poses[0]);
+                _soaPrevPoses.load(prevPoses);
+                _soaNextPoses.load(nextPoses);
+                ::blend(_soaPrevPoses, _soaNextPoses, alpha, _soaPoses);
+                _soaPoses.store(_poses);
             } else if (_blendType == AnimBlendType_AddRelative) {
-                ::blendAdd(_poses.size(), &prevPoses[0], &nextPoses[0], alpha, &_poses[0]);
+                _soaPrevPoses.load(prevPoses);
+                _soaNextPoses.load(nextPoses);
+                ::blendAdd(_soaPrevPoses, _soaNextPoses, alpha, _soaPoses);
+                _soaPoses.store(_poses);
             } else if (_blendType == AnimBlendType_AddAbsolute) {
                 // convert prev from relative to absolute
                 AnimPoseVec absPrev = prevPoses;
@@ -118,7 +124,10 @@ void AnimBlendLinear::evaluateAndBlendChildren(const AnimVariantMap& animVars, c
                 }
 
                 // then blend
-                ::blendAdd(_poses.size(), &prevPoses[0], &relOffsetPoses[0], alpha, &_poses[0]);
+                _soaPrevPoses.load(prevPoses);
+                _soaNextPoses.load(relOffsetPoses);
+                ::blendAdd(_soaPrevPoses, _soaNextPoses, alpha, _soaPoses);
+                _soaPoses.store(_poses);
             }
         }
     }
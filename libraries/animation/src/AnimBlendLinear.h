@@ -12,6 +12,7 @@
 #define hifi_AnimBlendLinear_h
 
 #include "AnimNode.h"
+#include "AnimPoseSoA.h"
 
 // Linear blend between two AnimNodes.
 // the amount of blending is determined by the alpha parameter.
@@ -43,6 +44,11 @@ protected:
 
     AnimPoseVec _poses;
 
+    // the children's poses and the blend of them, kept from frame to frame so that blending doesn't allocate
+    AnimPoseSoA _soaPrevPoses;
+    AnimPoseSoA _soaNextPoses;
+    AnimPoseSoA _soaPoses;
+
     float _alpha;
     AnimBlendType _blendType;
 
@@ -0,0 +1,328 @@
+//
+//  AnimPoseSoA.cpp
+//  libraries/animation/src
+//
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AnimPoseSoA.h"
+
+#include <assert.h>
+#include <math.h>
+#include <algorithm>
+
+static const int POSES_PER_BLOCK = 8;
+
+void AnimPoseSoA::resize(int numPoses) {
+    _numPoses = numPoses;
+    _stride = (numPoses + POSES_PER_BLOCK) & ~(POSES_PER_BLOCK - 1);
+    _data.assign(NumComponents * _stride, 0.0f);
+    std::fill_n(getComponent(ScaleX), 3 * _stride, 1.0f);
+    std::fill_n(getComponent(RotW), _stride, 1.0f);
+}
+
+AnimPose AnimPoseSoA::getPose(int index) const {
+    const float* p = &_data[index];
+    return AnimPose(glm::vec3(p[ScaleX * _stride], p[ScaleY * _stride], p[ScaleZ * _stride]),
+                    glm::quat(p[RotW * _stride], p[RotX * _stride], p[RotY * _stride], p[RotZ * _stride]),
+                    glm::vec3(p[TransX * _stride], p[TransY * _stride], p[TransZ * _stride]));
+}
+
+void AnimPoseSoA::setPose(int index, const AnimPose& pose) {
+    float* p = &_data[index];
+    p[ScaleX * _stride] = pose.scale().x;
+    p[ScaleY * _stride] = pose.scale().y;
+    p[ScaleZ * _stride] = pose.scale().z;
+    p[RotX * _stride] = pose.rot().x;
+    p[RotY * _stride] = pose.rot().y;
+    p[RotZ * _stride] = pose.rot().z;
+    p[RotW * _stride] = pose.rot().w;
+    p[TransX * _stride] = pose.trans().x;
+    p[TransY * _stride] = pose.trans().y;
+    p[TransZ * _stride] = pose.trans().z;
+}
+
+void AnimPoseSoA::load(const AnimPoseVec& poses) {
+    // every pose is overwritten, so only a new size needs the padding reset
+    if (_numPoses != (int)poses.size() || _data.empty()) {
+        resize((int)poses.size());
+    }
+    for (int i = 0; i < _numPoses; ++i) {
+        setPose(i, poses[i]);
+    }
+}
+
+void AnimPoseSoA::store(AnimPoseVec& poses) const {
+    poses.resize(_numPoses);
+    for (int i = 0; i < _numPoses; ++i) {
+        poses[i] = getPose(i);
+    }
+}
+
+AnimJointLevels::AnimJointLevels(const std::vector<int>& parentIndices) {
+    _numJoints = (int)parentIndices.size();
+
+    // joints with a parent out of range, or in a loop, are treated as roots
+    std::vector<std::vector<int>> jointsByDepth;
+    std::vector<int> depths(_numJoints, 0);
+    for (int i = 0; i < _numJoints; ++i) {
+        int depth = 0;
+        int parent = parentIndices[i];
+        while (parent >= 0 && parent < _numJoints && depth < _numJoints) {
+            parent = parentIndices[parent];
+            ++depth;
+        }
+        if (depth == _numJoints) {
+            depth = 0;
+        }
+        depths[i] = depth;
+        if (depth >= (int)jointsByDepth.size()) {
+            jointsByDepth.resize(depth + 1);
+        }
+        jointsByDepth[depth].push_back(i);
+    }
+
+    for (const auto& levelJoints : jointsByDepth) {
+        if (levelJoints.empty()) {
+            continue;
+        }
+        for (int joint : levelJoints) {
+            int parent = parentIndices[joint];
+            bool isRoot = depths[joint] == 0;
+            _joints.push_back(joint);
+            _parents.push_back(isRoot ? _numJoints : parent);
+        }
+        while (_joints.size() % POSES_PER_BLOCK != 0) {
+            _joints.push_back(_joints.back());
+            _parents.push_back(_parents.back());
+        }
+        _levelOffsets.push_back((int)_joints.size());
+    }
+}
+
+//
+// Scalar kernels.  The AVX2 kernels do the same operations in the same order, so that both give the same results.
+//
+
+static inline void normalizeQuat(float& x, float& y, float& z, float& w) {
+    float length = sqrtf(((x * x + y * y) + z * z) + w * w);
+    if (length > 0.0f) {
+        float oneOverLength = 1.0f / length;
+        x *= oneOverLength;
+        y *= oneOverLength;
+        z *= oneOverLength;
+        w *= oneOverLength;
+    } else {
+        x = 0.0f;
+        y = 0.0f;
+        z = 0.0f;
+        w = 1.0f;
+    }
+}
+
+// result = p * q
+static inline void multiplyQuats(float px, float py, float pz, float pw, float qx, float qy, float qz, float qw,
+                                 float& x, float& y, float& z, float& w) {
+    w = ((pw * qw - px * qx) - py * qy) - pz * qz;
+    x = ((pw * qx + px * qw) + py * qz) - pz * qy;
+    y = ((pw * qy + py * qw) + pz * qx) - px * qz;
+    z = ((pw * qz + pz * qw) + px * qy) - py * qx;
+}
+
+void blendPoses_ref(const float* a, const float* b, float alpha, float* result, int stride) {
+    using P = AnimPoseSoA;
+    float oneMinusAlpha = 1.0f - alpha;
+
+    for (int c : { P::ScaleX, P::ScaleY, P::ScaleZ, P::TransX, P::TransY, P::TransZ }) {
+        for (int i = c * stride; i < (c + 1) * stride; ++i) {
+            result[i] = a[i] * oneMinusAlpha + b[i] * alpha;
+        }
+    }
+
+    for (int i = 0; i < stride; ++i) {
+        float ax = a[P::RotX * stride + i];
+        float ay = a[P::RotY * stride + i];
+        float az = a[P::RotZ * stride + i];
+        float aw = a[P::RotW * stride + i];
+        float bx = b[P::RotX * stride + i];
+        float by = b[P::RotY * stride + i];
+        float bz = b[P::RotZ * stride + i];
+        float bw = b[P::RotW * stride + i];
+
+        // take the shortest path
+        if (((ax * bx + ay * by) + az * bz) + aw * bw < 0.0f) {
+            bx = -bx;
+            by = -by;
+            bz = -bz;
+            bw = -bw;
+        }
+        float x = ax * oneMinusAlpha + bx * alpha;
+        float y = ay * oneMinusAlpha + by * alpha;
+        float z = az * oneMinusAlpha + bz * alpha;
+        float w = aw * oneMinusAlpha + bw * alpha;
+        normalizeQuat(x, y, z, w);
+
+        result[P::RotX * stride + i] = x;
+        result[P::RotY * stride + i] = y;
+        result[P::RotZ * stride + i] = z;
+        result[P::RotW * stride + i] = w;
+    }
+}
+
+void blendAddPoses_ref(const float* a, const float* b, float alpha, float* result, int stride) {
+    using P = AnimPoseSoA;
+    float oneMinusAlpha = 1.0f - alpha;
+
+    for (int c : { P::ScaleX, P::ScaleY, P::ScaleZ }) {
+        for (int i = c * stride; i < (c + 1) * stride; ++i) {
+            result[i] = a[i] * (oneMinusAlpha + b[i] * alpha);
+        }
+    }
+    for (int c : { P::TransX, P::TransY, P::TransZ }) {
+        for (int i = c * stride; i < (c + 1) * stride; ++i) {
+            result[i] = a[i] + alpha * b[i];
+        }
+    }
+
+    for (int i = 0; i < stride; ++i) {
+        // lerp from identity to the delta, with the delta on the same side as identity
+        float dx = b[P::RotX * stride + i];
+        float dy = b[P::RotY * stride + i];
+        float dz = b[P::RotZ * stride + i];
+        float dw = b[P::RotW * stride + i];
+        if (dw < 0.0f) {
+            dx = -dx;
+            dy = -dy;
+            dz = -dz;
+            dw = -dw;
+        }
+        dx = dx * alpha;
+        dy = dy * alpha;
+        dz = dz * alpha;
+        dw = oneMinusAlpha + dw * alpha;
+
+        float x, y, z, w;
+        multiplyQuats(a[P::RotX * stride + i], a[P::RotY * stride + i], a[P::RotZ * stride + i], a[P::RotW * stride + i],
+                      dx, dy, dz, dw, x, y, z, w);
+        normalizeQuat(x, y, z, w);
+
+        result[P::RotX * stride + i] = x;
+        result[P::RotY * stride + i] = y;
+        result[P::RotZ * stride + i] = z;
+        result[P::RotW * stride + i] = w;
+    }
+}
+
+void composePoses_ref(const float* relative, float* absolute, int stride, const int* joints, const int* parents,
+                      int numEntries) {
+    using P = AnimPoseSoA;
+    const float* r = relative;
+    float* a = absolute;
+
+    for (int k = 0; k < numEntries; ++k) {
+        int i = joints[k];
+        int p = parents[k];
+
+        float psx = a[P::ScaleX * stride + p];
+        float psy = a[P::ScaleY * stride + p];
+        float psz = a[P::ScaleZ * stride + p];
+        float pqx = a[P::RotX * stride + p];
+        float pqy = a[P::RotY * stride + p];
+        float pqz = a[P::RotZ * stride + p];
+        float pqw = a[P::RotW * stride + p];
+
+        float x, y, z, w;
+        multiplyQuats(pqx, pqy, pqz, pqw, r[P::RotX * stride + i], r[P::RotY * stride + i], r[P::RotZ * stride + i],
+                      r[P::RotW * stride + i], x, y, z, w);
+
+        // rotate the scaled translation by the parent rotation
+        float vx = psx * r[P::TransX * stride + i];
+        float vy = psy * r[P::TransY * stride + i];
+        float vz = psz * r[P::TransZ * stride + i];
+        float uvx = pqy * vz - pqz * vy;
+        float uvy = pqz * vx - pqx * vz;
+        float uvz = pqx * vy - pqy * vx;
+        float uuvx = pqy * uvz - pqz * uvy;
+        float uuvy = pqz * uvx - pqx * uvz;
+        float uuvz = pqx * uvy - pqy * uvx;
+        float tx = a[P::TransX * stride + p] + (vx + (uvx * pqw + uuvx) * 2.0f);
+        float ty = a[P::TransY * stride + p] + (vy + (uvy * pqw + uuvy) * 2.0f);
+        float tz = a[P::TransZ * stride + p] + (vz + (uvz * pqw + uuvz) * 2.0f);
+
+        a[P::ScaleX * stride + i] = psx * r[P::ScaleX * stride + i];
+        a[P::ScaleY * stride + i] = psy * r[P::ScaleY * stride + i];
+        a[P::ScaleZ * stride + i] = psz * r[P::ScaleZ * stride + i];
+        a[P::RotX * stride + i] = x;
+        a[P::RotY * stride + i] = y;
+        a[P::RotZ * stride + i] = z;
+        a[P::RotW * stride + i] = w;
+        a[P::TransX * stride + i] = tx;
+        a[P::TransY * stride + i] = ty;
+        a[P::TransZ * stride + i] = tz;
+    }
+}
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+//
+// Runtime CPU dispatch
+//
+#include <CPUDetect.h>
+
+void blendPoses_AVX2(const float* a, const float* b, float alpha, float* result, int stride);
+void blendAddPoses_AVX2(const float* a, const float* b, float alpha, float* result, int stride);
+void composePoses_AVX2(const float* relative, float* absolute, int stride, const int* joints, const int* parents,
+                       int numEntries);
+
+static void blendPoses(const float* a, const float* b, float alpha, float* result, int stride) {
+    static auto f = cpuSupportsAVX2() ? blendPoses_AVX2 : blendPoses_ref;
+    (*f)(a, b, alpha, result, stride);
+}
+
+static void blendAddPoses(const float* a, const float* b, float alpha, float* result, int stride) {
+    static auto f = cpuSupportsAVX2() ? blendAddPoses_AVX2 : blendAddPoses_ref;
+    (*f)(a, b, alpha, result, stride);
+}
+
+static void composePoses(const float* relative, float* absolute, int stride, const int* joints, const int* parents,
+                         int numEntries) {
+    static auto f = cpuSupportsAVX2() ? composePoses_AVX2 : composePoses_ref;
+    (*f)(relative, absolute, stride, joints, parents, numEntries);
+}
+
+#else   // portable reference code
+static auto& blendPoses = blendPoses_ref;
+static auto& blendAddPoses = blendAddPoses_ref;
+static auto& composePoses = composePoses_ref;
+#endif
+
+void blend(const AnimPoseSoA& a, const AnimPoseSoA& b, float alpha, AnimPoseSoA& result) {
+    assert(a.size() == b.size());
+    if (result.size() != a.size()) {
+        result.resize(a.size());
+    }
+    blendPoses(a.getData(), b.getData(), alpha, result.getData(), a.getStride());
+}
+
+void blendAdd(const AnimPoseSoA& a, const AnimPoseSoA& b, float alpha, AnimPoseSoA& result) {
+    assert(a.size() == b.size());
+    if (result.size() != a.size()) {
+        result.resize(a.size());
+    }
+    blendAddPoses(a.getData(), b.getData(), alpha, result.getData(), a.getStride());
+}
+
+void buildAbsolutePoses(const AnimPoseSoA& relativePoses, const AnimJointLevels& levels, const AnimPose& rootPose,
+                        AnimPoseSoA& absolutePoses) {
+    assert(relativePoses.size() == levels.getNumJoints());
+    if (absolutePoses.size() != relativePoses.size()) {
+        absolutePoses.resize(relativePoses.size());
+    }
+
+    // the roots are parented to the spare pose past the end
+    absolutePoses.setPose(relativePoses.size(), rootPose);
+    composePoses(relativePoses.getData(), absolutePoses.getData(), relativePoses.getStride(), levels.getJoints().data(),
+                 levels.getParents().data(), (int)levels.getJoints().size());
+}
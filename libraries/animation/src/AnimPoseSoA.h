@@ -0,0 +1,101 @@
+//
+//  AnimPoseSoA.h
+//  libraries/animation/src
+//
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AnimPoseSoA_h
+#define hifi_AnimPoseSoA_h
+
+#include <vector>
+
+#include "AnimPose.h"
+
+// A set of poses stored as one array per component (scale x, y, z, rotation x, y, z, w, translation x, y, z) rather
+// than as an array of AnimPose, so that the blending and hierarchy kernels can work on eight poses at a time.
+//
+// The arrays are padded with identity poses to a multiple of eight, with at least one spare pose past the end.
+class AnimPoseSoA {
+public:
+    enum Component {
+        ScaleX = 0,
+        ScaleY,
+        ScaleZ,
+        RotX,
+        RotY,
+        RotZ,
+        RotW,
+        TransX,
+        TransY,
+        TransZ,
+        NumComponents
+    };
+
+    AnimPoseSoA() {}
+    explicit AnimPoseSoA(const AnimPoseVec& poses) { load(poses); }
+
+    // resets every pose to identity
+    void resize(int numPoses);
+    int size() const { return _numPoses; }
+    // the number of poses in each component array, including the padding
+    int getStride() const { return _stride; }
+
+    AnimPose getPose(int index) const;
+    void setPose(int index, const AnimPose& pose);
+
+    // keeps the arrays of a buffer that already has as many poses, so that reloading it every frame doesn't allocate
+    void load(const AnimPoseVec& poses);
+    void store(AnimPoseVec& poses) const;
+
+    const float* getData() const { return _data.data(); }
+    float* getData() { return _data.data(); }
+    const float* getComponent(Component component) const { return &_data[component * _stride]; }
+    float* getComponent(Component component) { return &_data[component * _stride]; }
+
+private:
+    std::vector<float> _data;
+    int _numPoses { 0 };
+    int _stride { 0 };
+};
+
+// The joints of a skeleton grouped by their depth, so that the absolute poses of a whole group can be computed at once
+// from the absolute poses of the group above.
+class AnimJointLevels {
+public:
+    AnimJointLevels() {}
+    explicit AnimJointLevels(const std::vector<int>& parentIndices);
+
+    int getNumJoints() const { return _numJoints; }
+    int getNumLevels() const { return (int)_levelOffsets.size() - 1; }
+
+    // each level is padded to a multiple of eight joints by repeating its last joint
+    const std::vector<int>& getJoints() const { return _joints; }
+    // the parent of each entry of getJoints(), or the number of joints for roots
+    const std::vector<int>& getParents() const { return _parents; }
+    // where each level starts in getJoints(), followed by the end of the last level
+    const std::vector<int>& getLevelOffsets() const { return _levelOffsets; }
+
+private:
+    std::vector<int> _joints;
+    std::vector<int> _parents;
+    std::vector<int> _levelOffsets { 0 };
+    int _numJoints { 0 };
+};
+
+// same as blend() in AnimUtil.h, for every pose of a and b, which must be the same size
+void blend(const AnimPoseSoA& a, const AnimPoseSoA& b, float alpha, AnimPoseSoA& result);
+
+// same as blendAdd() in AnimUtil.h, for every pose of a and b, which must be the same size
+void blendAdd(const AnimPoseSoA& a, const AnimPoseSoA& b, float alpha, AnimPoseSoA& result);
+
+// Computes the absolute poses of a skeleton from its relative poses, with the root joints relative to rootPose.
+// The poses are composed as scale, rotation and translation, which is the same as multiplying their matrices for
+// skeletons without non-uniform scale.
+void buildAbsolutePoses(const AnimPoseSoA& relativePoses, const AnimJointLevels& levels, const AnimPose& rootPose,
+                        AnimPoseSoA& absolutePoses);
+
+#endif // hifi_AnimPoseSoA_h
@@ -38,6 +38,13 @@ class AnimationCacheScriptingInterface : public ScriptableResourceCache, public
      * @property {number} numCached - Total number of cached resource. <em>Read-only.</em>
      * @property {number} sizeTotal - Size in bytes of all resources. <em>Read-only.</em>
      * @property {number} sizeCached - Size in bytes of all cached resources. <em>Read-only.</em>
+     * @property {number} numArtifactHits - Number of resources restored from the disk cache of processed resources.
+     *     <em>Read-only.</em>
+     * @property {number} numArtifactMisses - Number of resources not found in the disk cache of processed resources.
+     *     <em>Read-only.</em>
+     * @property {number} sizeArtifacts - Size in bytes of the disk cache of processed resources. <em>Read-only.</em>
+     * @property {number} maxSizeArtifacts - Maximum size in bytes of the disk cache of processed resources, or
+     *     <code>0</code> if the cache doesn't keep processed resources on disk. <em>Read-only.</em>
      * @property {number} numGlobalQueriesPending - Total number of global queries pending (across all resource cache managers).
      *     <em>Read-only.</em>
      * @property {number} numGlobalQueriesLoading - Total number of global queries loading (across all resource cache managers).
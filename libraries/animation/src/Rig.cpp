@@ -663,6 +663,16 @@ void Rig::initJointStates(const HFMModel& hfmModel, const glm::mat4& modelOffset
 
     _leftEyeJointChildren = _animSkeleton->getChildrenOfJoint(indexOfJoint("LeftEye"));
     _rightEyeJointChildren = _animSkeleton->getChildrenOfJoint(indexOfJoint("RightEye"));
+    findFingerJoints();
+}
+
+void Rig::findFingerJoints() {
+    _isFingerJoint.assign(_animSkeleton->getNumJoints(), false);
+    for (int handIndex : { _leftHandJointIndex, _rightHandJointIndex }) {
+        for (int fingerIndex : _animSkeleton->getChildrenOfJoint(handIndex)) {
+            _isFingerJoint[fingerIndex] = true;
+        }
+    }
 }
 
 void Rig::reset(const HFMModel& hfmModel) {
@@ -709,6 +719,7 @@ void Rig::reset(const HFMModel& hfmModel) {
 
     _leftEyeJointChildren = _animSkeleton->getChildrenOfJoint(indexOfJoint("LeftEye"));
     _rightEyeJointChildren = _animSkeleton->getChildrenOfJoint(indexOfJoint("RightEye"));
+    findFingerJoints();
 
     if (!_animGraphURL.isEmpty()) {
         _animNode.reset();
@@ -2629,7 +2640,7 @@ void Rig::copyJointsIntoJointData(QVector<JointData>& jointDataVec) const {
     }
 }
 
-void Rig::copyJointsFromJointData(const QVector<JointData>& jointDataVec) {
+void Rig::copyJointsFromJointData(const QVector<JointData>& jointDataVec, bool reducedSkeleton) {
     DETAILED_PROFILE_RANGE(simulation_animation_detail, "copyJoints");
     DETAILED_PERFORMANCE_TIMER("copyJoints");
 
@@ -2663,8 +2674,19 @@ void Rig::copyJointsFromJointData(const QVector<JointData>& jointDataVec) {
         }
     }
 
-    // convert rotations from absolute to parent relative.
-    _animSkeleton->convertAbsoluteRotationsToRelative(rotations);
+    if (reducedSkeleton && (int)_isFingerJoint.size() == numJoints) {
+        // convert rotations from absolute to parent relative, except for the fingers
+        for (int i = numJoints - 1; i >= 0; --i) {
+            int parentIndex = _animSkeleton->getParentIndex(i);
+            if (parentIndex != AnimSkeleton::INVALID_JOINT_INDEX && !_isFingerJoint[i]) {
+                rotations[i] = glm::inverse(rotations[parentIndex]) * rotations[i];
+            }
+        }
+    } else {
+        reducedSkeleton = false;
+        // convert rotations from absolute to parent relative.
+        _animSkeleton->convertAbsoluteRotationsToRelative(rotations);
+    }
 
     // store new relative poses
     if (numJoints != (int)_internalPoseSet._relativePoses.size()) {
@@ -2672,6 +2694,9 @@ void Rig::copyJointsFromJointData(const QVector<JointData>& jointDataVec) {
     }
     const AnimPoseVec& relativeDefaultPoses = _animSkeleton->getRelativeDefaultPoses();
     for (int i = 0; i < numJoints; i++) {
+        if (reducedSkeleton && _isFingerJoint[i]) {
+            continue;
+        }
         const JointData& data = jointDataVec.at(_remoteToLocalJointMap[i]);
         _internalPoseSet._relativePoses[i].rot() = rotations[i];
         if (data.translationIsDefaultPose) {
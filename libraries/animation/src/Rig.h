@@ -223,7 +223,8 @@ public:
     bool getRelativeDefaultJointTranslation(int index, glm::vec3& translationOut) const;
 
     void copyJointsIntoJointData(QVector<JointData>& jointDataVec) const;
-    void copyJointsFromJointData(const QVector<JointData>& jointDataVec);
+    // with reducedSkeleton, the finger joints keep their current poses
+    void copyJointsFromJointData(const QVector<JointData>& jointDataVec, bool reducedSkeleton = false);
     void computeExternalPoses(const glm::mat4& modelOffsetMat);
 
     void computeAvatarBoundingCapsule(const HFMModel& hfmModel, float& radiusOut, float& heightOut, glm::vec3& offsetOut) const;
@@ -337,6 +338,10 @@ protected:
     int _rightElbowJointIndex { -1 };
     int _rightShoulderJointIndex { -1 };
 
+    // the joints below the hands, skipped when copying a reduced skeleton
+    void findFingerJoints();
+    std::vector<bool> _isFingerJoint;
+
     glm::vec3 _lastForward;
     glm::vec3 _lastPosition;
     glm::vec3 _lastVelocity;
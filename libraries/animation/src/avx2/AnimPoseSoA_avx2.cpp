@@ -0,0 +1,208 @@
+//
+//  AnimPoseSoA_avx2.cpp
+//  libraries/animation/src
+//
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifdef __AVX2__
+
+// keep multiplies and adds separate, so that the results match the scalar kernels exactly
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC optimize("fp-contract=off")
+#endif
+
+#include <immintrin.h>
+
+#include "../AnimPoseSoA.h"
+
+using P = AnimPoseSoA;
+
+struct Quat8 {
+    __m256 x, y, z, w;
+};
+
+static inline __m256 select8(__m256 mask, __m256 a, __m256 b) {
+    return _mm256_blendv_ps(b, a, mask);
+}
+
+static inline Quat8 normalizeQuat8(Quat8 q) {
+    __m256 length2 = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(q.x, q.x), _mm256_mul_ps(q.y, q.y)),
+                                                 _mm256_mul_ps(q.z, q.z)),
+                                   _mm256_mul_ps(q.w, q.w));
+    __m256 length = _mm256_sqrt_ps(length2);
+    __m256 oneOverLength = _mm256_div_ps(_mm256_set1_ps(1.0f), length);
+    __m256 isValid = _mm256_cmp_ps(length, _mm256_setzero_ps(), _CMP_GT_OQ);
+    __m256 zero = _mm256_setzero_ps();
+    Quat8 result;
+    result.x = select8(isValid, _mm256_mul_ps(q.x, oneOverLength), zero);
+    result.y = select8(isValid, _mm256_mul_ps(q.y, oneOverLength), zero);
+    result.z = select8(isValid, _mm256_mul_ps(q.z, oneOverLength), zero);
+    result.w = select8(isValid, _mm256_mul_ps(q.w, oneOverLength), _mm256_set1_ps(1.0f));
+    return result;
+}
+
+// p * q
+static inline Quat8 multiplyQuat8(Quat8 p, Quat8 q) {
+    Quat8 result;
+    result.w = _mm256_sub_ps(_mm256_sub_ps(_mm256_sub_ps(_mm256_mul_ps(p.w, q.w), _mm256_mul_ps(p.x, q.x)),
+                                           _mm256_mul_ps(p.y, q.y)),
+                             _mm256_mul_ps(p.z, q.z));
+    result.x = _mm256_sub_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(p.w, q.x), _mm256_mul_ps(p.x, q.w)),
+                                           _mm256_mul_ps(p.y, q.z)),
+                             _mm256_mul_ps(p.z, q.y));
+    result.y = _mm256_sub_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(p.w, q.y), _mm256_mul_ps(p.y, q.w)),
+                                           _mm256_mul_ps(p.z, q.x)),
+                             _mm256_mul_ps(p.x, q.z));
+    result.z = _mm256_sub_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(p.w, q.z), _mm256_mul_ps(p.z, q.w)),
+                                           _mm256_mul_ps(p.x, q.y)),
+                             _mm256_mul_ps(p.y, q.x));
+    return result;
+}
+
+static inline Quat8 loadQuat8(const float* data, int stride, int i) {
+    return { _mm256_loadu_ps(&data[P::RotX * stride + i]), _mm256_loadu_ps(&data[P::RotY * stride + i]),
+             _mm256_loadu_ps(&data[P::RotZ * stride + i]), _mm256_loadu_ps(&data[P::RotW * stride + i]) };
+}
+
+static inline void storeQuat8(float* data, int stride, int i, Quat8 q) {
+    _mm256_storeu_ps(&data[P::RotX * stride + i], q.x);
+    _mm256_storeu_ps(&data[P::RotY * stride + i], q.y);
+    _mm256_storeu_ps(&data[P::RotZ * stride + i], q.z);
+    _mm256_storeu_ps(&data[P::RotW * stride + i], q.w);
+}
+
+void blendPoses_AVX2(const float* a, const float* b, float alpha, float* result, int stride) {
+    __m256 alpha8 = _mm256_set1_ps(alpha);
+    __m256 oneMinusAlpha8 = _mm256_set1_ps(1.0f - alpha);
+    __m256 signBit = _mm256_set1_ps(-0.0f);
+
+    for (int c : { P::ScaleX, P::ScaleY, P::ScaleZ, P::TransX, P::TransY, P::TransZ }) {
+        for (int i = c * stride; i < (c + 1) * stride; i += 8) {
+            __m256 r = _mm256_add_ps(_mm256_mul_ps(_mm256_loadu_ps(&a[i]), oneMinusAlpha8),
+                                     _mm256_mul_ps(_mm256_loadu_ps(&b[i]), alpha8));
+            _mm256_storeu_ps(&result[i], r);
+        }
+    }
+
+    for (int i = 0; i < stride; i += 8) {
+        Quat8 qa = loadQuat8(a, stride, i);
+        Quat8 qb = loadQuat8(b, stride, i);
+
+        // take the shortest path
+        __m256 dot = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(qa.x, qb.x), _mm256_mul_ps(qa.y, qb.y)),
+                                                 _mm256_mul_ps(qa.z, qb.z)),
+                                   _mm256_mul_ps(qa.w, qb.w));
+        __m256 flip = _mm256_and_ps(_mm256_cmp_ps(dot, _mm256_setzero_ps(), _CMP_LT_OQ), signBit);
+        qb.x = _mm256_xor_ps(qb.x, flip);
+        qb.y = _mm256_xor_ps(qb.y, flip);
+        qb.z = _mm256_xor_ps(qb.z, flip);
+        qb.w = _mm256_xor_ps(qb.w, flip);
+
+        Quat8 q;
+        q.x = _mm256_add_ps(_mm256_mul_ps(qa.x, oneMinusAlpha8), _mm256_mul_ps(qb.x, alpha8));
+        q.y = _mm256_add_ps(_mm256_mul_ps(qa.y, oneMinusAlpha8), _mm256_mul_ps(qb.y, alpha8));
+        q.z = _mm256_add_ps(_mm256_mul_ps(qa.z, oneMinusAlpha8), _mm256_mul_ps(qb.z, alpha8));
+        q.w = _mm256_add_ps(_mm256_mul_ps(qa.w, oneMinusAlpha8), _mm256_mul_ps(qb.w, alpha8));
+        storeQuat8(result, stride, i, normalizeQuat8(q));
+    }
+}
+
+void blendAddPoses_AVX2(const float* a, const float* b, float alpha, float* result, int stride) {
+    __m256 alpha8 = _mm256_set1_ps(alpha);
+    __m256 oneMinusAlpha8 = _mm256_set1_ps(1.0f - alpha);
+    __m256 signBit = _mm256_set1_ps(-0.0f);
+
+    for (int c : { P::ScaleX, P::ScaleY, P::ScaleZ }) {
+        for (int i = c * stride; i < (c + 1) * stride; i += 8) {
+            __m256 bScale = _mm256_add_ps(oneMinusAlpha8, _mm256_mul_ps(_mm256_loadu_ps(&b[i]), alpha8));
+            _mm256_storeu_ps(&result[i], _mm256_mul_ps(_mm256_loadu_ps(&a[i]), bScale));
+        }
+    }
+    for (int c : { P::TransX, P::TransY, P::TransZ }) {
+        for (int i = c * stride; i < (c + 1) * stride; i += 8) {
+            __m256 r = _mm256_add_ps(_mm256_loadu_ps(&a[i]), _mm256_mul_ps(alpha8, _mm256_loadu_ps(&b[i])));
+            _mm256_storeu_ps(&result[i], r);
+        }
+    }
+
+    for (int i = 0; i < stride; i += 8) {
+        // lerp from identity to the delta, with the delta on the same side as identity
+        Quat8 delta = loadQuat8(b, stride, i);
+        __m256 flip = _mm256_and_ps(_mm256_cmp_ps(delta.w, _mm256_setzero_ps(), _CMP_LT_OQ), signBit);
+        delta.x = _mm256_mul_ps(_mm256_xor_ps(delta.x, flip), alpha8);
+        delta.y = _mm256_mul_ps(_mm256_xor_ps(delta.y, flip), alpha8);
+        delta.z = _mm256_mul_ps(_mm256_xor_ps(delta.z, flip), alpha8);
+        delta.w = _mm256_add_ps(oneMinusAlpha8, _mm256_mul_ps(_mm256_xor_ps(delta.w, flip), alpha8));
+
+        storeQuat8(result, stride, i, normalizeQuat8(multiplyQuat8(loadQuat8(a, stride, i), delta)));
+    }
+}
+
+void composePoses_AVX2(const float* relative, float* absolute, int stride, const int* joints, const int* parents,
+                       int numEntries) {
+    const float* r = relative;
+    float* a = absolute;
+    __m256 two = _mm256_set1_ps(2.0f);
+    alignas(32) float result[P::NumComponents][8];
+
+    // the entries come in blocks of 8 joints of the same depth, whose parents are already done
+    for (int k = 0; k < numEntries; k += 8) {
+        __m256i joint8 = _mm256_loadu_si256((const __m256i*)&joints[k]);
+        __m256i parent8 = _mm256_loadu_si256((const __m256i*)&parents[k]);
+
+        __m256 psx = _mm256_i32gather_ps(&a[P::ScaleX * stride], parent8, 4);
+        __m256 psy = _mm256_i32gather_ps(&a[P::ScaleY * stride], parent8, 4);
+        __m256 psz = _mm256_i32gather_ps(&a[P::ScaleZ * stride], parent8, 4);
+        Quat8 pq = { _mm256_i32gather_ps(&a[P::RotX * stride], parent8, 4),
+                     _mm256_i32gather_ps(&a[P::RotY * stride], parent8, 4),
+                     _mm256_i32gather_ps(&a[P::RotZ * stride], parent8, 4),
+                     _mm256_i32gather_ps(&a[P::RotW * stride], parent8, 4) };
+        Quat8 rq = { _mm256_i32gather_ps(&r[P::RotX * stride], joint8, 4),
+                     _mm256_i32gather_ps(&r[P::RotY * stride], joint8, 4),
+                     _mm256_i32gather_ps(&r[P::RotZ * stride], joint8, 4),
+                     _mm256_i32gather_ps(&r[P::RotW * stride], joint8, 4) };
+        Quat8 q = multiplyQuat8(pq, rq);
+
+        // rotate the scaled translation by the parent rotation
+        __m256 vx = _mm256_mul_ps(psx, _mm256_i32gather_ps(&r[P::TransX * stride], joint8, 4));
+        __m256 vy = _mm256_mul_ps(psy, _mm256_i32gather_ps(&r[P::TransY * stride], joint8, 4));
+        __m256 vz = _mm256_mul_ps(psz, _mm256_i32gather_ps(&r[P::TransZ * stride], joint8, 4));
+        __m256 uvx = _mm256_sub_ps(_mm256_mul_ps(pq.y, vz), _mm256_mul_ps(pq.z, vy));
+        __m256 uvy = _mm256_sub_ps(_mm256_mul_ps(pq.z, vx), _mm256_mul_ps(pq.x, vz));
+        __m256 uvz = _mm256_sub_ps(_mm256_mul_ps(pq.x, vy), _mm256_mul_ps(pq.y, vx));
+        __m256 uuvx = _mm256_sub_ps(_mm256_mul_ps(pq.y, uvz), _mm256_mul_ps(pq.z, uvy));
+        __m256 uuvy = _mm256_sub_ps(_mm256_mul_ps(pq.z, uvx), _mm256_mul_ps(pq.x, uvz));
+        __m256 uuvz = _mm256_sub_ps(_mm256_mul_ps(pq.x, uvy), _mm256_mul_ps(pq.y, uvx));
+        __m256 tx = _mm256_add_ps(_mm256_i32gather_ps(&a[P::TransX * stride], parent8, 4),
+                                  _mm256_add_ps(vx, _mm256_mul_ps(_mm256_add_ps(_mm256_mul_ps(uvx, pq.w), uuvx), two)));
+        __m256 ty = _mm256_add_ps(_mm256_i32gather_ps(&a[P::TransY * stride], parent8, 4),
+                                  _mm256_add_ps(vy, _mm256_mul_ps(_mm256_add_ps(_mm256_mul_ps(uvy, pq.w), uuvy), two)));
+        __m256 tz = _mm256_add_ps(_mm256_i32gather_ps(&a[P::TransZ * stride], parent8, 4),
+                                  _mm256_add_ps(vz, _mm256_mul_ps(_mm256_add_ps(_mm256_mul_ps(uvz, pq.w), uuvz), two)));
+
+        _mm256_store_ps(result[P::ScaleX], _mm256_mul_ps(psx, _mm256_i32gather_ps(&r[P::ScaleX * stride], joint8, 4)));
+        _mm256_store_ps(result[P::ScaleY], _mm256_mul_ps(psy, _mm256_i32gather_ps(&r[P::ScaleY * stride], joint8, 4)));
+        _mm256_store_ps(result[P::ScaleZ], _mm256_mul_ps(psz, _mm256_i32gather_ps(&r[P::ScaleZ * stride], joint8, 4)));
+        _mm256_store_ps(result[P::RotX], q.x);
+        _mm256_store_ps(result[P::RotY], q.y);
+        _mm256_store_ps(result[P::RotZ], q.z);
+        _mm256_store_ps(result[P::RotW], q.w);
+        _mm256_store_ps(result[P::TransX], tx);
+        _mm256_store_ps(result[P::TransY], ty);
+        _mm256_store_ps(result[P::TransZ], tz);
+
+        // no scatter in AVX2
+        for (int j = 0; j < 8; ++j) {
+            int joint = joints[k + j];
+            for (int c = 0; c < P::NumComponents; ++c) {
+                a[c * stride + joint] = result[c][j];
+            }
+        }
+    }
+}
+
+#endif
@@ -13,6 +13,7 @@
 #include <math.h>
 #include <stdint.h>
 #include <stddef.h>
+#include <string.h>
 
 #ifndef MAX
 #define MAX(a,b) ((a) > (b) ? (a) : (b))
@@ -152,10 +153,10 @@ static const int IEEE754_EXPN_BIAS = 127;
 // x < 2^(31-LOG2_HEADROOM) returns 0x7fffffff
 // x > 2^LOG2_HEADROOM returns 0
 //
-FORCEINLINE static int32_t peaklog2(float* input) {
+FORCEINLINE static int32_t peaklog2(const float* input) {
 
     // float as integer bits
-    uint32_t u = *(uint32_t*)input;
+    uint32_t u = *(const uint32_t*)input;
 
     // absolute value
     uint32_t peak = u & IEEE754_FABS_MASK;
@@ -188,11 +189,11 @@ FORCEINLINE static int32_t peaklog2(float* input) {
 // x < 2^(31-LOG2_HEADROOM) returns 0x7fffffff
 // x > 2^LOG2_HEADROOM returns 0
 //
-FORCEINLINE static int32_t peaklog2(float* input0, float* input1) {
+FORCEINLINE static int32_t peaklog2(const float* input0, const float* input1) {
 
     // float as integer bits
-    uint32_t u0 = *(uint32_t*)input0;
-    uint32_t u1 = *(uint32_t*)input1;
+    uint32_t u0 = *(const uint32_t*)input0;
+    uint32_t u1 = *(const uint32_t*)input1;
 
     // max absolute value
     u0 &= IEEE754_FABS_MASK;
@@ -227,13 +228,13 @@ FORCEINLINE static int32_t peaklog2(float* input0, float* input1) {
 // x < 2^(31-LOG2_HEADROOM) returns 0x7fffffff
 // x > 2^LOG2_HEADROOM returns 0
 //
-FORCEINLINE static int32_t peaklog2(float* input0, float* input1, float* input2, float* input3) {
+FORCEINLINE static int32_t peaklog2(const float* input0, const float* input1, const float* input2, const float* input3) {
 
     // float as integer bits
-    uint32_t u0 = *(uint32_t*)input0;
-    uint32_t u1 = *(uint32_t*)input1;
-    uint32_t u2 = *(uint32_t*)input2;
-    uint32_t u3 = *(uint32_t*)input3;
+    uint32_t u0 = *(const uint32_t*)input0;
+    uint32_t u1 = *(const uint32_t*)input1;
+    uint32_t u2 = *(const uint32_t*)input2;
+    uint32_t u3 = *(const uint32_t*)input3;
 
     // max absolute value
     u0 &= IEEE754_FABS_MASK;
@@ -517,90 +518,32 @@ template<> class MaxFilter<128> : public MaxFilterT<128,  53,  76> {};
 template<> class MaxFilter<256> : public MaxFilterT<256, 106, 151> {};
 
 //
-// N-1 sample delay (mono)
+// N-1 sample delay of interleaved frames with C channels, processed a block at a time
 //
-template<int N, typename T = float>
-class MonoDelay {
+template<int N, int C, typename T = float>
+class BlockDelay {
 
-    static_assert((N & (N - 1)) == 0, "N must be a power of 2");
+    static const int DELAY = C * (N - 1);
 
-    T _buffer[N] = {};
-    size_t _index = 0;
+    T _buffer[DELAY] = {};
 
 public:
-    void process(T& x) {
-
-        const size_t MASK = N - 1;  // buffer wrap
-        size_t i = _index;
-
-        _buffer[i] = x;
-
-        i = (i + (N - 1)) & MASK;
-
-        x = _buffer[i];
-
-        _index = i;
-    }
-};
+    // output must not overlap input
+    void process(const T* input, T* output, int numFrames) {
 
-//
-// N-1 sample delay (stereo)
-//
-template<int N, typename T = float>
-class StereoDelay {
-
-    static_assert((N & (N - 1)) == 0, "N must be a power of 2");
-
-    T _buffer[2*N] = {};
-    size_t _index = 0;
-
-public:
-    void process(T& x0, T& x1) {
+        int numSamples = C * numFrames;
 
-        const size_t MASK = 2*N - 1;    // buffer wrap
-        size_t i = _index;
+        if (numSamples >= DELAY) {
 
-        _buffer[i+0] = x0;
-        _buffer[i+1] = x1;
+            memcpy(output, _buffer, DELAY * sizeof(T));
+            memcpy(output + DELAY, input, (numSamples - DELAY) * sizeof(T));
+            memcpy(_buffer, input + (numSamples - DELAY), DELAY * sizeof(T));
 
-        i = (i + 2*(N - 1)) & MASK;
+        } else {
 
-        x0 = _buffer[i+0];
-        x1 = _buffer[i+1];
-
-        _index = i;
-    }
-};
-
-//
-// N-1 sample delay (quad)
-//
-template<int N, typename T = float>
-class QuadDelay {
-
-    static_assert((N & (N - 1)) == 0, "N must be a power of 2");
-
-    T _buffer[4*N] = {};
-    size_t _index = 0;
-
-public:
-    void process(T& x0, T& x1, T& x2, T& x3) {
-
-        const size_t MASK = 4*N - 1;    // buffer wrap
-        size_t i = _index;
-
-        _buffer[i+0] = x0;
-        _buffer[i+1] = x1;
-        _buffer[i+2] = x2;
-        _buffer[i+3] = x3;
-
-        i = (i + 4*(N - 1)) & MASK;
-
-        x0 = _buffer[i+0];
-        x1 = _buffer[i+1];
-        x2 = _buffer[i+2];
-        x3 = _buffer[i+3];
-
-        _index = i;
+            memcpy(output, _buffer, numSamples * sizeof(T));
+            memmove(_buffer, _buffer + numSamples, (DELAY - numSamples) * sizeof(T));
+            memcpy(_buffer + (DELAY - numSamples), input, numSamples * sizeof(T));
+        }
     }
 };
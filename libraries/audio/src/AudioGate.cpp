@@ -389,328 +389,211 @@ int32_t GateImpl::envelope(int32_t attn) {
     return attn;
 }
 
-//
-// Gate (mono)
-//
-template<int N>
-class GateMono : public GateImpl {
+template<int C> class DCBlock;
 
-    MonoDCBlock _dc;
-    MaxFilter<N> _filter;
-    MonoDelay<N, int32_t> _delay;
+template<> class DCBlock<1> : public MonoDCBlock {
+public:
+    void process(int32_t* x) { MonoDCBlock::process(x[0]); }
+};
 
+template<> class DCBlock<2> : public StereoDCBlock {
 public:
-    GateMono(int sampleRate) : GateImpl(sampleRate) {}
+    void process(int32_t* x) { StereoDCBlock::process(x[0], x[1]); }
+};
 
-    // mono input/output (in-place is allowed)
-    bool process(int16_t* input, int16_t* output, int numFrames) override;
-    bool removeDC(int16_t* input, int16_t* output, int numFrames) override;
+template<> class DCBlock<4> : public QuadDCBlock {
+public:
+    void process(int32_t* x) { QuadDCBlock::process(x[0], x[1], x[2], x[3]); }
 };
 
-template<int N>
-bool GateMono<N>::process(int16_t* input, int16_t* output, int numFrames) {
+//
+// Gate kernels
+//
 
-    clearHistogram();
-    int32_t mask = 0;
+// peak detect and convert to log2 domain, for each frame
+void gatePeaks_ref(const int32_t* input, int32_t* peaks, int numChannels, int numFrames) {
 
     for (int n = 0; n < numFrames; n++) {
 
-        int32_t x = input[n];
-
-        // remove DC
-        _dc.process(x);
+        const int32_t* x = &input[numChannels * n];
 
         // peak detect
-        int32_t peak = abs(x);
+        int32_t peak = abs(x[0]);
+        for (int c = 1; c < numChannels; c++) {
+            peak = MAX(peak, abs(x[c]));
+        }
 
         // convert to log2 domain
-        peak = fixlog2(peak);
-
-        // apply peak hold
-        peak = peakhold(peak);
-
-        // count peak level
-        updateHistogram(peak);
-
-        // apply hysteresis
-        peak = hysteresis(peak);
-
-        // compute gate attenuation
-        int32_t attn = (peak > _threshAdapt) ? 0x7fffffff : 0;    // hard-knee, 1:inf ratio
-
-        // apply envelope
-        attn = envelope(attn);
-
-        // convert from log2 domain
-        attn = fixexp2(attn);
-
-        // lowpass filter
-        attn = _filter.process(attn);
-
-        // delay audio
-        _delay.process(x);
-
-        // apply gain
-        x = MULQ31(x, attn);
-
-        // store 16-bit output
-        x = saturateQ30(x);
-        output[n] = (int16_t)x;
-
-        mask |= x;
+        peaks[n] = fixlog2(peak);
     }
-
-    // update adaptive threshold
-    processHistogram(numFrames);
-    return mask != 0;
 }
 
-template<int N>
-bool GateMono<N>::removeDC(int16_t* input, int16_t* output, int numFrames) {
+// apply the gain of each frame and store 16-bit output, returns true when output is non-zero
+bool gateOutput_ref(const int32_t* input, const int32_t* attn, int16_t* output, int numChannels, int numFrames) {
 
     int32_t mask = 0;
 
     for (int n = 0; n < numFrames; n++) {
+        for (int c = 0; c < numChannels; c++) {
 
-        int32_t x = input[n];
+            // apply gain
+            int32_t x = MULQ31(input[numChannels * n + c], attn[n]);
 
-        // remove DC
-        _dc.process(x);
-
-        // store 16-bit output
-        x = saturateQ30(x);
-        output[n] = (int16_t)x;
+            // store 16-bit output
+            x = saturateQ30(x);
+            output[numChannels * n + c] = (int16_t)x;
 
-        mask |= x;
+            mask |= x;
+        }
     }
 
     return mask != 0;
 }
 
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+
 //
-// Gate (stereo)
+// Runtime CPU dispatch
 //
-template<int N>
-class GateStereo : public GateImpl {
 
-    StereoDCBlock _dc;
-    MaxFilter<N> _filter;
-    StereoDelay<N, int32_t> _delay;
+#include "CPUDetect.h"
 
-public:
-    GateStereo(int sampleRate) : GateImpl(sampleRate) {}
+void gatePeaks_AVX2(const int32_t* input, int32_t* peaks, int numChannels, int numFrames);
+bool gateOutput_AVX2(const int32_t* input, const int32_t* attn, int16_t* output, int numChannels, int numFrames);
 
-    // interleaved stereo input/output (in-place is allowed)
-    bool process(int16_t* input, int16_t* output, int numFrames) override;
-    bool removeDC(int16_t* input, int16_t* output, int numFrames) override;
-};
-
-template<int N>
-bool GateStereo<N>::process(int16_t* input, int16_t* output, int numFrames) {
-
-    clearHistogram();
-    int32_t mask = 0;
-
-    for (int n = 0; n < numFrames; n++) {
-
-        int32_t x0 = input[2*n+0];
-        int32_t x1 = input[2*n+1];
-
-        // remove DC
-        _dc.process(x0, x1);
-
-        // peak detect
-        int32_t peak = MAX(abs(x0), abs(x1));
-
-        // convert to log2 domain
-        peak = fixlog2(peak);
-
-        // apply peak hold
-        peak = peakhold(peak);
-
-        // count peak level
-        updateHistogram(peak);
-
-        // apply hysteresis
-        peak = hysteresis(peak);
-
-        // compute gate attenuation
-        int32_t attn = (peak > _threshAdapt) ? 0x7fffffff : 0;    // hard-knee, 1:inf ratio
-
-        // apply envelope
-        attn = envelope(attn);
-
-        // convert from log2 domain
-        attn = fixexp2(attn);
-
-        // lowpass filter
-        attn = _filter.process(attn);
-
-        // delay audio
-        _delay.process(x0, x1);
-
-        // apply gain
-        x0 = MULQ31(x0, attn);
-        x1 = MULQ31(x1, attn);
-
-        // store 16-bit output
-        x0 = saturateQ30(x0);
-        x1 = saturateQ30(x1);
-        output[2*n+0] = (int16_t)x0;
-        output[2*n+1] = (int16_t)x1;
-
-        mask |= (x0 | x1);
-    }
-
-    // update adaptive threshold
-    processHistogram(numFrames);
-    return mask != 0;
+static void gatePeaks(const int32_t* input, int32_t* peaks, int numChannels, int numFrames) {
+    static auto f = cpuSupportsAVX2() ? gatePeaks_AVX2 : gatePeaks_ref;
+    (*f)(input, peaks, numChannels, numFrames); // dispatch
 }
 
-template<int N>
-bool GateStereo<N>::removeDC(int16_t* input, int16_t* output, int numFrames) {
-
-    int32_t mask = 0;
-
-    for (int n = 0; n < numFrames; n++) {
-
-        int32_t x0 = input[2*n+0];
-        int32_t x1 = input[2*n+1];
+static bool gateOutput(const int32_t* input, const int32_t* attn, int16_t* output, int numChannels, int numFrames) {
+    static auto f = cpuSupportsAVX2() ? gateOutput_AVX2 : gateOutput_ref;
+    return (*f)(input, attn, output, numChannels, numFrames); // dispatch
+}
 
-        // remove DC
-        _dc.process(x0, x1);
+#else   // portable reference code
 
-        // store 16-bit output
-        x0 = saturateQ30(x0);
-        x1 = saturateQ30(x1);
-        output[2*n+0] = (int16_t)x0;
-        output[2*n+1] = (int16_t)x1;
+static auto& gatePeaks = gatePeaks_ref;
+static auto& gateOutput = gateOutput_ref;
 
-        mask |= (x0 | x1);
-    }
-
-    return mask != 0;
-}
+#endif
 
 //
-// Gate (quad)
+// Gate (interleaved mono, stereo or quad)
 //
-template<int N>
-class GateQuad : public GateImpl {
+// The peak detection and output stages run on blocks of frames, leaving the DC-blocking
+// filter, detector, envelope and lowpass filter to run one frame at a time.
+//
+static const int GATE_BLOCK = 256;
+
+template<int N, int C>
+class GateT : public GateImpl {
 
-    QuadDCBlock _dc;
+    DCBlock<C> _dc;
     MaxFilter<N> _filter;
-    QuadDelay<N, int32_t> _delay;
+    BlockDelay<N, C, int32_t> _delay;
 
 public:
-    GateQuad(int sampleRate) : GateImpl(sampleRate) {}
+    GateT(int sampleRate) : GateImpl(sampleRate) {}
 
-    // interleaved quad input/output (in-place is allowed)
+    // interleaved input/output (in-place is allowed)
     bool process(int16_t* input, int16_t* output, int numFrames) override;
     bool removeDC(int16_t* input, int16_t* output, int numFrames) override;
 };
 
-template<int N>
-bool GateQuad<N>::process(int16_t* input, int16_t* output, int numFrames) {
+template<int N, int C>
+bool GateT<N, C>::process(int16_t* input, int16_t* output, int numFrames) {
 
     clearHistogram();
-    int32_t mask = 0;
+    bool isNonZero = false;
 
-    for (int n = 0; n < numFrames; n++) {
+    int32_t x[C * GATE_BLOCK];
+    int32_t attn[GATE_BLOCK];
+    int32_t delayed[C * GATE_BLOCK];
 
-        int32_t x0 = input[4*n+0];
-        int32_t x1 = input[4*n+1];
-        int32_t x2 = input[4*n+2];
-        int32_t x3 = input[4*n+3];
+    for (int i = 0; i < numFrames; i += GATE_BLOCK) {
 
-        // remove DC
-        _dc.process(x0, x1, x2, x3);
+        int blockFrames = MIN(numFrames - i, GATE_BLOCK);
 
-        // peak detect
-        int32_t peak = MAX(MAX(abs(x0), abs(x1)), MAX(abs(x2), abs(x3)));
+        for (int n = 0; n < blockFrames; n++) {
+            for (int c = 0; c < C; c++) {
+                x[C * n + c] = input[C * (i + n) + c];
+            }
 
-        // convert to log2 domain
-        peak = fixlog2(peak);
+            // remove DC
+            _dc.process(&x[C * n]);
+        }
 
-        // apply peak hold
-        peak = peakhold(peak);
+        // peak detect and convert to log2 domain
+        gatePeaks(x, attn, C, blockFrames);
 
-        // count peak level
-        updateHistogram(peak);
+        for (int n = 0; n < blockFrames; n++) {
 
-        // apply hysteresis
-        peak = hysteresis(peak);
+            // apply peak hold
+            int32_t peak = peakhold(attn[n]);
 
-        // compute gate attenuation
-        int32_t attn = (peak > _threshAdapt) ? 0x7fffffff : 0;    // hard-knee, 1:inf ratio
+            // count peak level
+            updateHistogram(peak);
 
-        // apply envelope
-        attn = envelope(attn);
+            // apply hysteresis
+            peak = hysteresis(peak);
 
-        // convert from log2 domain
-        attn = fixexp2(attn);
+            // compute gate attenuation
+            int32_t a = (peak > _threshAdapt) ? 0x7fffffff : 0;    // hard-knee, 1:inf ratio
 
-        // lowpass filter
-        attn = _filter.process(attn);
+            // apply envelope
+            a = envelope(a);
 
-        // delay audio
-        _delay.process(x0, x1, x2, x3);
+            // convert from log2 domain
+            a = fixexp2(a);
 
-        // apply gain
-        x0 = MULQ31(x0, attn);
-        x1 = MULQ31(x1, attn);
-        x2 = MULQ31(x2, attn);
-        x3 = MULQ31(x3, attn);
+            // lowpass filter
+            attn[n] = _filter.process(a);
+        }
 
-        // store 16-bit output
-        x0 = saturateQ30(x0);
-        x1 = saturateQ30(x1);
-        x2 = saturateQ30(x2);
-        x3 = saturateQ30(x3);
-        output[4*n+0] = (int16_t)x0;
-        output[4*n+1] = (int16_t)x1;
-        output[4*n+2] = (int16_t)x2;
-        output[4*n+3] = (int16_t)x3;
-
-        mask |= (x0 | x1 | x2 | x3);
+        // delay audio
+        _delay.process(x, delayed, blockFrames);
+
+        // apply gain and store 16-bit output
+        isNonZero |= gateOutput(delayed, attn, &output[C * i], C, blockFrames);
     }
 
     // update adaptive threshold
     processHistogram(numFrames);
-    return mask != 0;
+    return isNonZero;
 }
 
-template<int N>
-bool GateQuad<N>::removeDC(int16_t* input, int16_t* output, int numFrames) {
+template<int N, int C>
+bool GateT<N, C>::removeDC(int16_t* input, int16_t* output, int numFrames) {
 
     int32_t mask = 0;
 
     for (int n = 0; n < numFrames; n++) {
 
-        int32_t x0 = input[4*n+0];
-        int32_t x1 = input[4*n+1];
-        int32_t x2 = input[4*n+2];
-        int32_t x3 = input[4*n+3];
+        int32_t x[C];
+        for (int c = 0; c < C; c++) {
+            x[c] = input[C * n + c];
+        }
 
         // remove DC
-        _dc.process(x0, x1, x2, x3);
+        _dc.process(x);
 
         // store 16-bit output
-        x0 = saturateQ30(x0);
-        x1 = saturateQ30(x1);
-        x2 = saturateQ30(x2);
-        x3 = saturateQ30(x3);
-        output[4*n+0] = (int16_t)x0;
-        output[4*n+1] = (int16_t)x1;
-        output[4*n+2] = (int16_t)x2;
-        output[4*n+3] = (int16_t)x3;
-
-        mask |= (x0 | x1 | x2 | x3);
+        for (int c = 0; c < C; c++) {
+            x[c] = saturateQ30(x[c]);
+            output[C * n + c] = (int16_t)x[c];
+
+            mask |= x[c];
+        }
     }
 
     return mask != 0;
 }
 
+template<int N> using GateMono = GateT<N, 1>;
+template<int N> using GateStereo = GateT<N, 2>;
+template<int N> using GateQuad = GateT<N, 4>;
+
 //
 // Public API
 //
@@ -192,178 +192,144 @@ int32_t LimiterImpl::envelope(int32_t attn) {
 }
 
 //
-// Limiter (mono)
+// Limiter kernels
 //
-template<int N>
-class LimiterMono : public LimiterImpl {
 
-    MinFilter<N> _filter;
-    MonoDelay<N> _delay;
-
-public:
-    LimiterMono(int sampleRate) : LimiterImpl(sampleRate) {}
-
-    void process(float* input, int16_t* output, int numFrames) override;
-};
-
-template<int N>
-void LimiterMono<N>::process(float* input, int16_t* output, int numFrames) {
+// compute the limiter attenuation in log2 domain, for the peak of each frame
+void limiterPeaks_ref(const float* input, int32_t threshold, int32_t* attn, int numChannels, int numFrames) {
 
     for (int n = 0; n < numFrames; n++) {
 
+        const float* x = &input[numChannels * n];
+
         // peak detect and convert to log2 domain
-        int32_t peak = peaklog2(&input[n]);
+        int32_t peak;
+        if (numChannels == 1) {
+            peak = peaklog2(&x[0]);
+        } else if (numChannels == 2) {
+            peak = peaklog2(&x[0], &x[1]);
+        } else {
+            peak = peaklog2(&x[0], &x[1], &x[2], &x[3]);
+        }
 
         // compute limiter attenuation
-        int32_t attn = MAX(_threshold - peak, 0);
-
-        // apply envelope
-        attn = envelope(attn);
+        attn[n] = MAX(threshold - peak, 0);
+    }
+}
 
-        // convert from log2 domain
-        attn = fixexp2(attn);
+// apply the gain and dither of each frame, and store 16-bit output
+void limiterOutput_ref(const float* input, const float* gain, const float* noise, int16_t* output,
+                       int numChannels, int numFrames) {
 
-        // lowpass filter
-        attn = _filter.process(attn);
-        float gain = attn * _outGain;
+    for (int n = 0; n < numFrames; n++) {
+        for (int c = 0; c < numChannels; c++) {
 
-        // delay audio
-        float x = input[n];
-        _delay.process(x);
+            float x = input[numChannels * n + c];
 
-        // apply gain
-        x *= gain;
+            // apply gain
+            x *= gain[n];
 
-        // apply dither
-        x += dither();
+            // apply dither
+            x += noise[n];
 
-        // store 16-bit output
-        output[n] = (int16_t)floatToInt(x);
+            // store 16-bit output
+            output[numChannels * n + c] = (int16_t)floatToInt(x);
+        }
     }
 }
 
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+
 //
-// Limiter (stereo)
+// Runtime CPU dispatch
 //
-template<int N>
-class LimiterStereo : public LimiterImpl {
-
-    MinFilter<N> _filter;
-    StereoDelay<N> _delay;
-
-public:
-    LimiterStereo(int sampleRate) : LimiterImpl(sampleRate) {}
-
-    // interleaved stereo input/output
-    void process(float* input, int16_t* output, int numFrames) override;
-};
-
-template<int N>
-void LimiterStereo<N>::process(float* input, int16_t* output, int numFrames) {
 
-    for (int n = 0; n < numFrames; n++) {
+#include "CPUDetect.h"
 
-        // peak detect and convert to log2 domain
-        int32_t peak = peaklog2(&input[2*n+0], &input[2*n+1]);
+void limiterPeaks_AVX2(const float* input, int32_t threshold, int32_t* attn, int numChannels, int numFrames);
+void limiterOutput_AVX2(const float* input, const float* gain, const float* noise, int16_t* output,
+                        int numChannels, int numFrames);
 
-        // compute limiter attenuation
-        int32_t attn = MAX(_threshold - peak, 0);
+static void limiterPeaks(const float* input, int32_t threshold, int32_t* attn, int numChannels, int numFrames) {
+    static auto f = cpuSupportsAVX2() ? limiterPeaks_AVX2 : limiterPeaks_ref;
+    (*f)(input, threshold, attn, numChannels, numFrames); // dispatch
+}
 
-        // apply envelope
-        attn = envelope(attn);
+static void limiterOutput(const float* input, const float* gain, const float* noise, int16_t* output,
+                          int numChannels, int numFrames) {
+    static auto f = cpuSupportsAVX2() ? limiterOutput_AVX2 : limiterOutput_ref;
+    (*f)(input, gain, noise, output, numChannels, numFrames); // dispatch
+}
 
-        // convert from log2 domain
-        attn = fixexp2(attn);
+#else   // portable reference code
 
-        // lowpass filter
-        attn = _filter.process(attn);
-        float gain = attn * _outGain;
+static auto& limiterPeaks = limiterPeaks_ref;
+static auto& limiterOutput = limiterOutput_ref;
 
-        // delay audio
-        float x0 = input[2*n+0];
-        float x1 = input[2*n+1];
-        _delay.process(x0, x1);
-
-        // apply gain
-        x0 *= gain;
-        x1 *= gain;
-
-        // apply dither
-        float d = dither();
-        x0 += d;
-        x1 += d;
-
-        // store 16-bit output
-        output[2*n+0] = (int16_t)floatToInt(x0);
-        output[2*n+1] = (int16_t)floatToInt(x1);
-    }
-}
+#endif
 
 //
-// Limiter (quad)
+// Limiter (interleaved mono, stereo or quad)
 //
-template<int N>
-class LimiterQuad : public LimiterImpl {
+// The peak detection and output stages run on blocks of frames, leaving only the
+// envelope and lowpass filter to run one frame at a time.
+//
+static const int LIMITER_BLOCK = 256;
+
+template<int N, int C>
+class LimiterT : public LimiterImpl {
 
     MinFilter<N> _filter;
-    QuadDelay<N> _delay;
+    BlockDelay<N, C> _delay;
 
 public:
-    LimiterQuad(int sampleRate) : LimiterImpl(sampleRate) {}
+    LimiterT(int sampleRate) : LimiterImpl(sampleRate) {}
 
-    // interleaved quad input/output
     void process(float* input, int16_t* output, int numFrames) override;
 };
 
-template<int N>
-void LimiterQuad<N>::process(float* input, int16_t* output, int numFrames) {
+template<int N, int C>
+void LimiterT<N, C>::process(float* input, int16_t* output, int numFrames) {
 
-    for (int n = 0; n < numFrames; n++) {
+    int32_t attn[LIMITER_BLOCK];
+    float gain[LIMITER_BLOCK];
+    float noise[LIMITER_BLOCK];
+    float delayed[C * LIMITER_BLOCK];
 
-        // peak detect and convert to log2 domain
-        int32_t peak = peaklog2(&input[4*n+0], &input[4*n+1], &input[4*n+2], &input[4*n+3]);
+    for (int i = 0; i < numFrames; i += LIMITER_BLOCK) {
 
-        // compute limiter attenuation
-        int32_t attn = MAX(_threshold - peak, 0);
+        int blockFrames = MIN(numFrames - i, LIMITER_BLOCK);
+
+        // peak detect and compute limiter attenuation
+        limiterPeaks(&input[C * i], _threshold, attn, C, blockFrames);
 
-        // apply envelope
-        attn = envelope(attn);
+        for (int n = 0; n < blockFrames; n++) {
 
-        // convert from log2 domain
-        attn = fixexp2(attn);
+            // apply envelope
+            int32_t a = envelope(attn[n]);
 
-        // lowpass filter
-        attn = _filter.process(attn);
-        float gain = attn * _outGain;
+            // convert from log2 domain
+            a = fixexp2(a);
+
+            // lowpass filter
+            a = _filter.process(a);
+            gain[n] = a * _outGain;
+
+            noise[n] = dither();
+        }
 
         // delay audio
-        float x0 = input[4*n+0];
-        float x1 = input[4*n+1];
-        float x2 = input[4*n+2];
-        float x3 = input[4*n+3];
-        _delay.process(x0, x1, x2, x3);
-
-        // apply gain
-        x0 *= gain;
-        x1 *= gain;
-        x2 *= gain;
-        x3 *= gain;
-
-        // apply dither
-        float d = dither();
-        x0 += d;
-        x1 += d;
-        x2 += d;
-        x3 += d;
-
-        // store 16-bit output
-        output[4*n+0] = (int16_t)floatToInt(x0);
-        output[4*n+1] = (int16_t)floatToInt(x1);
-        output[4*n+2] = (int16_t)floatToInt(x2);
-        output[4*n+3] = (int16_t)floatToInt(x3);
+        _delay.process(&input[C * i], delayed, blockFrames);
+
+        // apply gain and dither, and store 16-bit output
+        limiterOutput(delayed, gain, noise, &output[C * i], C, blockFrames);
     }
 }
 
+template<int N> using LimiterMono = LimiterT<N, 1>;
+template<int N> using LimiterStereo = LimiterT<N, 2>;     // interleaved stereo input/output
+template<int N> using LimiterQuad = LimiterT<N, 4>;       // interleaved quad input/output
+
 //
 // Public API
 //
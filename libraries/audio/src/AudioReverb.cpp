@@ -1577,93 +1577,135 @@ void ReverbImpl::setParameters(ReverbParameters *p) {
     _wetDryMix = MIN(MAX(_wetDryMix, 0.0f), 1.0f);
 }
 
-void ReverbImpl::process(float** inputs, float** outputs, int numFrames) {
+// wet/dry mix
+void reverbMix_ref(const float* dry, const float* wet, float mix, float* output, int numFrames) {
 
     for (int i = 0; i < numFrames; i++) {
-        float x0, x1, y0, y1, y2, y3;
-
-        // Preprocess
-        x0 = inputs[0][i];
-        x1 = inputs[1][i];
-        _bw.process(x0, x1, x0, x1);
-
-        float preL, preR;
-        _dl0.process(x0, preL);
-        _dl1.process(x1, preR);
-
-        // Early Left
-        float early0L, early1L, early2L, earlyOutL;
-        _mt0.process(preL, x0, x1, y0);
-        _ap0.process(x0 + x1, y1);
-        _mt1.process(y1, x0, x1, early0L);
-        _ap1.process(x0 + x1, y2);
-        _ap2.process(y2, x0);
-        _mt2.process(x0, early1L, early2L);
-
-        earlyOutL = (y0 + y1 * _earlyMix1L + y2 * _earlyMix2L) * _earlyGain;
-
-        // Early Right
-        float early0R, early1R, early2R, earlyOutR;
-        _mt3.process(preR, x0, x1, y0);
-        _ap3.process(x0 + x1, y1);
-        _mt4.process(y1, x0, x1, early0R);
-        _ap4.process(x0 + x1, y2);
-        _ap5.process(y2, x0);
-        _mt5.process(x0, early1R, early2R);
-
-        earlyOutR = (y0 + y1 * _earlyMix1R + y2 * _earlyMix2R) * _earlyGain;
-
-        // LFO update
-        int32_t lfoSin, lfoCos;
-        _lfo.process(lfoSin, lfoCos);
-
-        // Late
-        float lateOut0;
-        _ap6.getOutput(x0);
-        _ap7.process(x0, lfoSin, x0);
-        _eq0.process(-early0L + x0, x0);
-        _mt6.process(x0, y0, lateOut0);
-
-        float lateOut1;
-        _ap8.getOutput(x0);
-        _ap9.process(x0, lfoCos, x0);
-        _eq1.process(-early0R + x0, x0);
-        _mt7.process(x0, y1, lateOut1);
-
-        float lateOut2;
-        _ap10.getOutput(x0);
-        _ap11.process(-early2L + x0, x0);
-        _ap12.process(x0, x0);
-        _ap13.process(-early2L - x0, x0);
-        _mt8.process(-early0L + x0, x0, lateOut2);
-        _lp0.process(x0, y2);
-
-        float lateOut3;
-        _ap14.getOutput(x0);
-        _ap15.process(-early2R + x0, x0);
-        _ap16.process(x0, x0);
-        _ap17.process(-early2R - x0, x0);
-        _mt9.process(-early0R + x0, x0, lateOut3);
-        _lp1.process(x0, y3);
-
-        // Feedback matrix
-        _ap6.process(early1L + y2 - y3, x0);
-        _ap8.process(early1R - y2 - y3, x0);
-        _ap10.process(-early2R + y0 + y1, x0);
-        _ap14.process(-early2L - y0 + y1, x0);
-
-        // Output Left
-        _ap18.process(-earlyOutL + lateOut0 + lateOut3, x0);
-        _ap19.process(x0, y0);
-
-        // Output Right
-        _ap20.process(-earlyOutR + lateOut1 + lateOut2, x1);
-        _ap21.process(x1, y1);
-
-        x0 = inputs[0][i];
-        x1 = inputs[1][i];
-        outputs[0][i] = x0 + (y0 - x0) * _wetDryMix;
-        outputs[1][i] = x1 + (y1 - x1) * _wetDryMix;
+        float x = dry[i];
+        float y = wet[i];
+        output[i] = x + (y - x) * mix;
+    }
+}
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+
+//
+// Runtime CPU dispatch
+//
+
+#include "CPUDetect.h"
+
+void reverbMix_AVX2(const float* dry, const float* wet, float mix, float* output, int numFrames);
+
+static void reverbMix(const float* dry, const float* wet, float mix, float* output, int numFrames) {
+    static auto f = cpuSupportsAVX2() ? reverbMix_AVX2 : reverbMix_ref;
+    (*f)(dry, wet, mix, output, numFrames); // dispatch
+}
+
+#else   // portable reference code
+
+static auto& reverbMix = reverbMix_ref;
+
+#endif
+
+// the wet output is mixed after each block, so that inputs and outputs can be the same buffers
+static const int REVERB_MIX_BLOCK = 64;
+
+void ReverbImpl::process(float** inputs, float** outputs, int numFrames) {
+
+    float wet[2][REVERB_MIX_BLOCK];
+
+    for (int i = 0; i < numFrames; i += REVERB_MIX_BLOCK) {
+
+        int blockFrames = MIN(numFrames - i, REVERB_MIX_BLOCK);
+
+        for (int j = 0; j < blockFrames; j++) {
+            float x0, x1, y0, y1, y2, y3;
+
+            // Preprocess
+            x0 = inputs[0][i + j];
+            x1 = inputs[1][i + j];
+            _bw.process(x0, x1, x0, x1);
+
+            float preL, preR;
+            _dl0.process(x0, preL);
+            _dl1.process(x1, preR);
+
+            // Early Left
+            float early0L, early1L, early2L, earlyOutL;
+            _mt0.process(preL, x0, x1, y0);
+            _ap0.process(x0 + x1, y1);
+            _mt1.process(y1, x0, x1, early0L);
+            _ap1.process(x0 + x1, y2);
+            _ap2.process(y2, x0);
+            _mt2.process(x0, early1L, early2L);
+
+            earlyOutL = (y0 + y1 * _earlyMix1L + y2 * _earlyMix2L) * _earlyGain;
+
+            // Early Right
+            float early0R, early1R, early2R, earlyOutR;
+            _mt3.process(preR, x0, x1, y0);
+            _ap3.process(x0 + x1, y1);
+            _mt4.process(y1, x0, x1, early0R);
+            _ap4.process(x0 + x1, y2);
+            _ap5.process(y2, x0);
+            _mt5.process(x0, early1R, early2R);
+
+            earlyOutR = (y0 + y1 * _earlyMix1R + y2 * _earlyMix2R) * _earlyGain;
+
+            // LFO update
+            int32_t lfoSin, lfoCos;
+            _lfo.process(lfoSin, lfoCos);
+
+            // Late
+            float lateOut0;
+            _ap6.getOutput(x0);
+            _ap7.process(x0, lfoSin, x0);
+            _eq0.process(-early0L + x0, x0);
+            _mt6.process(x0, y0, lateOut0);
+
+            float lateOut1;
+            _ap8.getOutput(x0);
+            _ap9.process(x0, lfoCos, x0);
+            _eq1.process(-early0R + x0, x0);
+            _mt7.process(x0, y1, lateOut1);
+
+            float lateOut2;
+            _ap10.getOutput(x0);
+            _ap11.process(-early2L + x0, x0);
+            _ap12.process(x0, x0);
+            _ap13.process(-early2L - x0, x0);
+            _mt8.process(-early0L + x0, x0, lateOut2);
+            _lp0.process(x0, y2);
+
+            float lateOut3;
+            _ap14.getOutput(x0);
+            _ap15.process(-early2R + x0, x0);
+            _ap16.process(x0, x0);
+            _ap17.process(-early2R - x0, x0);
+            _mt9.process(-early0R + x0, x0, lateOut3);
+            _lp1.process(x0, y3);
+
+            // Feedback matrix
+            _ap6.process(early1L + y2 - y3, x0);
+            _ap8.process(early1R - y2 - y3, x0);
+            _ap10.process(-early2R + y0 + y1, x0);
+            _ap14.process(-early2L - y0 + y1, x0);
+
+            // Output Left
+            _ap18.process(-earlyOutL + lateOut0 + lateOut3, x0);
+            _ap19.process(x0, y0);
+
+            // Output Right
+            _ap20.process(-earlyOutR + lateOut1 + lateOut2, x1);
+            _ap21.process(x1, y1);
+
+            wet[0][j] = y0;
+            wet[1][j] = y1;
+        }
+
+        reverbMix(&inputs[0][i], wet[0], _wetDryMix, &outputs[0][i], blockFrames);
+        reverbMix(&inputs[1][i], wet[1], _wetDryMix, &outputs[1][i], blockFrames);
     }
 }
 
@@ -126,6 +126,14 @@ int InboundAudioStream::parseData(ReceivedMessage& message) {
         _incomingSequenceNumberStats.sequenceNumberReceived(sequence, message.getSourceID());
     QString codecInPacket = message.readString();
 
+    // pick up the audio decoded ahead of this packet, if any
+    bool isPredecoded = !_predecodedAudio.empty() && _predecodedAudio.front().message == &message;
+    QByteArray predecodedBuffer;
+    if (isPredecoded) {
+        predecodedBuffer = std::move(_predecodedAudio.front().decodedBuffer);
+        _predecodedAudio.pop_front();
+    }
+
     packetReceivedUpdateTimingStats();
 
     int networkFrames;
@@ -166,8 +174,12 @@ int InboundAudioStream::parseData(ReceivedMessage& message) {
                 bool selectedPCM = _selectedCodecName == "pcm" || _selectedCodecName == "";
                 bool packetPCM = codecInPacket == "pcm" || codecInPacket == "";
                 if (codecInPacket == _selectedCodecName || (packetPCM && selectedPCM)) {
-                    auto afterProperties = message.readWithoutCopy(message.getBytesLeftToRead());
-                    parseAudioData(afterProperties);
+                    if (isPredecoded) {
+                        _ringBuffer.writeData(predecodedBuffer.data(), predecodedBuffer.size());
+                    } else {
+                        auto afterProperties = message.readWithoutCopy(message.getBytesLeftToRead());
+                        parseAudioData(afterProperties);
+                    }
                     _mismatchedAudioCodecCount = 0;
 
                 } else {
@@ -231,6 +243,49 @@ int InboundAudioStream::parseData(ReceivedMessage& message) {
     return message.getPosition();
 }
 
+bool InboundAudioStream::predecodeAudioData(ReceivedMessage& message) {
+    message.seek(0);
+
+    quint16 sequence;
+    message.readPrimitive(&sequence);
+
+    // the packet must be the next on time packet after the ones already parsed or predecoded
+    bool isOnTime;
+    if (_predecodedAudio.empty()) {
+        isOnTime = _incomingSequenceNumberStats.isOnTime(sequence, message.getSourceID());
+    } else {
+        const auto& lastPredecoded = _predecodedAudio.back();
+        isOnTime = message.getSourceID() == lastPredecoded.message->getSourceID()
+            && sequence == (quint16)(lastPredecoded.sequence + 1);
+    }
+
+    // in the selected codec, with stream properties that leave the decoder alone
+    // note: PCM and no codec are identical, as in parseData
+    int propertyBytes = -1;
+    QString codecInPacket = isOnTime ? message.readString() : QString();
+    bool isPCM = (codecInPacket == "pcm" || codecInPacket == "") && (_selectedCodecName == "pcm" || _selectedCodecName == "");
+    if (isOnTime && (codecInPacket == _selectedCodecName || isPCM)) {
+        int prePropertyPosition = message.getPosition();
+        propertyBytes = getStreamPropertiesSize(message.getType(), message.readWithoutCopy(message.getBytesLeftToRead()));
+        message.seek(prePropertyPosition + std::max(propertyBytes, 0));
+    }
+
+    bool isPredecoded = false;
+    if (propertyBytes >= 0) {
+        QMutexLocker lock(&_decoderMutex);
+        if (_decoder) {
+            QByteArray decodedBuffer;
+            _decoder->decode(message.readWithoutCopy(message.getBytesLeftToRead()), decodedBuffer);
+            _predecodedAudio.push_back({ &message, sequence, decodedBuffer });
+            isPredecoded = true;
+        }
+    }
+
+    // seek to the beginning of the packet so that the next reader is in the right spot
+    message.seek(0);
+    return isPredecoded;
+}
+
 int InboundAudioStream::parseStreamProperties(PacketType type, const QByteArray& packetAfterSeqNum, int& numAudioSamples) {
     if (type == PacketType::SilentAudioFrame) {
         quint16 numSilentSamples = 0;
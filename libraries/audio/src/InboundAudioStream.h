@@ -12,6 +12,8 @@
 #ifndef hifi_InboundAudioStream_h
 #define hifi_InboundAudioStream_h
 
+#include <deque>
+
 #include <Node.h>
 #include <NodeData.h>
 #include <NumericalConstants.h>
@@ -105,6 +107,14 @@ public:
     void setupCodec(CodecPluginPointer codec, const QString& codecName, int numChannels);
     void cleanupCodec();
 
+    /// decodes the audio data of a queued packet ahead of parseData, when parseData would decode it right after the
+    /// packets already predecoded, and returns true. returns false without touching the decoder otherwise.
+    /// must not run at the same time as parseData, or as another call for this stream.
+    bool predecodeAudioData(ReceivedMessage& message);
+
+    /// drops the audio predecoded for packets that were not parsed
+    void clearPredecodedAudio() { _predecodedAudio.clear(); }
+
 signals:
     void mismatchedAudioCodec(SharedNodePointer sendingNode, const QString& currentCodec, const QString& recievedCodec);
 
@@ -130,6 +140,11 @@ protected:
     /// default implementation assumes no stream properties and raw audio samples after stream propertiess
     virtual int parseStreamProperties(PacketType type, const QByteArray& packetAfterSeqNum, int& networkSamples);
 
+    /// returns the number of bytes parseStreamProperties would parse, without parsing them, or -1 if parsing them
+    /// could change the decoder or keep the audio data from being decoded.
+    /// default implementation doesn't allow predecoding
+    virtual int getStreamPropertiesSize(PacketType type, const QByteArray& packetAfterSeqNum) const { return -1; }
+
     /// parses the audio data in the network packet.
     /// default implementation assumes packet contains raw audio samples after stream properties
     virtual int parseAudioData(const QByteArray& packetAfterStreamProperties);
@@ -190,6 +205,13 @@ protected:
     QMutex _decoderMutex;
     Decoder* _decoder { nullptr };
     int _mismatchedAudioCodecCount { 0 };
+
+    struct PredecodedAudio {
+        const ReceivedMessage* message;
+        quint16 sequence;
+        QByteArray decodedBuffer;
+    };
+    std::deque<PredecodedAudio> _predecodedAudio;
 };
 
 float calculateRepeatedFrameFadeFactor(int indexOfRepeat);
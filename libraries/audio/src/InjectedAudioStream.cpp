@@ -72,6 +72,35 @@ int InjectedAudioStream::parseStreamProperties(PacketType type,
     return packetStream.device()->pos();
 }
 
+int InjectedAudioStream::getStreamPropertiesSize(PacketType type, const QByteArray& packetAfterSeqNum) const {
+    QDataStream packetStream(packetAfterSeqNum);
+    packetStream.skipRawData(NUM_BYTES_RFC4122_UUID);
+
+    // a change of channel flag restarts the ring buffer
+    bool isStereo;
+    LoopbackFlag shouldLoopback;
+    packetStream >> isStereo >> shouldLoopback;
+    if (packetStream.status() != QDataStream::Ok || isStereo != _isStereo) {
+        return -1;
+    }
+
+    int positionalBytes = getPositionalDataSize(packetAfterSeqNum.mid(packetStream.device()->pos()));
+    if (positionalBytes < 0) {
+        return -1;
+    }
+    packetStream.skipRawData(positionalBytes);
+
+    float radius;
+    quint8 attenuationByte;
+    bool ignorePenumbra;
+    packetStream >> radius >> attenuationByte >> ignorePenumbra;
+    if (packetStream.status() != QDataStream::Ok) {
+        return -1;
+    }
+
+    return packetStream.device()->pos();
+}
+
 AudioStreamStats InjectedAudioStream::getAudioStreamStats() const {
     AudioStreamStats streamStats = PositionalAudioStream::getAudioStreamStats();
     streamStats._streamIdentifier = _streamIdentifier;
@@ -32,6 +32,7 @@ private:
 
     AudioStreamStats getAudioStreamStats() const override;
     int parseStreamProperties(PacketType type, const QByteArray& packetAfterSeqNum, int& numAudioSamples) override;
+    int getStreamPropertiesSize(PacketType type, const QByteArray& packetAfterSeqNum) const override;
 
     const QUuid _streamIdentifier;
     float _radius;
@@ -0,0 +1,39 @@
+//
+//  MixedAudioPacket.cpp
+//  libraries/audio/src
+//
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "MixedAudioPacket.h"
+
+#include <algorithm>
+
+#include <plugins/CodecPlugin.h>
+
+std::unique_ptr<NLPacket> createMixedAudioPacket(NLPacketArena& arena, PacketType type, quint16 sequence,
+                                                 const QByteArray& codec) {
+    auto audioPacket = arena.acquire(type);
+    audioPacket->writePrimitive(sequence);
+
+    // same layout as writeString
+    audioPacket->writePrimitive((uint32_t)codec.size());
+    audioPacket->write(codec.constData(), codec.size());
+    return audioPacket;
+}
+
+int encodeMixedAudioFrame(Encoder* encoder, const char* decodedBuffer, int decodedSize, char* encodedBuffer,
+                          int encodedCapacity) {
+    int encodedSize = -1;
+    if (encoder) {
+        encodedSize = encoder->encodeInto(decodedBuffer, decodedSize, encodedBuffer, encodedCapacity);
+    } else if (decodedSize <= encodedCapacity) {
+        memcpy(encodedBuffer, decodedBuffer, decodedSize);
+        encodedSize = decodedSize;
+    }
+
+    return std::max(encodedSize, 0);
+}
@@ -0,0 +1,31 @@
+//
+//  MixedAudioPacket.h
+//  libraries/audio/src
+//
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_MixedAudioPacket_h
+#define hifi_MixedAudioPacket_h
+
+#include <memory>
+
+#include <NLPacket.h>
+#include <NLPacketArena.h>
+
+class Encoder;
+
+// Returns a packet from the arena that starts with the sequence number and codec name of a mixed audio or silent frame
+// packet, as InboundAudioStream reads them. The codec name is given as UTF-8, so that it isn't converted for every packet.
+std::unique_ptr<NLPacket> createMixedAudioPacket(NLPacketArena& arena, PacketType type, quint16 sequence,
+                                                 const QByteArray& codec);
+
+// Encodes a frame straight into a caller-owned buffer, such as the payload of an outgoing packet, or copies it as it is
+// if there is no encoder. Returns the number of bytes written; a frame that could not be encoded is written empty.
+int encodeMixedAudioFrame(Encoder* encoder, const char* decodedBuffer, int decodedSize, char* encodedBuffer,
+                          int encodedCapacity);
+
+#endif // hifi_MixedAudioPacket_h
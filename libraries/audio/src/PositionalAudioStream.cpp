@@ -96,6 +96,22 @@ int PositionalAudioStream::parsePositionalData(const QByteArray& positionalByteA
     return packetStream.device()->pos();
 }
 
+int PositionalAudioStream::getPositionalDataSize(const QByteArray& positionalByteArray) const {
+    const int POSITIONAL_DATA_BYTES = sizeof(_position) + sizeof(_orientation)
+        + sizeof(_avatarBoundingBoxCorner) + sizeof(_avatarBoundingBoxScale);
+    if (positionalByteArray.size() < POSITIONAL_DATA_BYTES) {
+        return -1;
+    }
+
+    glm::quat orientation;
+    memcpy(&orientation, positionalByteArray.constData() + sizeof(_position), sizeof(orientation));
+    if (glm::isnan(orientation.x)) {
+        return -1;
+    }
+
+    return POSITIONAL_DATA_BYTES;
+}
+
 AudioStreamStats PositionalAudioStream::getAudioStreamStats() const {
     AudioStreamStats streamStats = InboundAudioStream::getAudioStreamStats();
     streamStats._streamType = _type;
@@ -85,6 +85,8 @@ protected:
     PositionalAudioStream& operator= (const PositionalAudioStream&);
 
     int parsePositionalData(const QByteArray& positionalByteArray);
+    // the number of bytes parsePositionalData would parse, or -1 if it would reject them
+    int getPositionalDataSize(const QByteArray& positionalByteArray) const;
 
 protected:
     void calculateIgnoreBox();
@@ -75,8 +75,10 @@ void Sound::downloadFinished(const QByteArray& data) {
         return;
     }
 
+    auto artifactCache = _cache ? _cache->getArtifactCache() : nullptr;
+
     // this is a QRunnable, will delete itself after it has finished running
-    auto soundProcessor = new SoundProcessor(_self, data);
+    auto soundProcessor = new SoundProcessor(_self, data, artifactCache);
     connect(soundProcessor, &SoundProcessor::onSuccess, this, &Sound::soundProcessSuccess);
     connect(soundProcessor, &SoundProcessor::onError, this, &Sound::soundProcessError);
     QThreadPool::globalInstance()->start(soundProcessor);
@@ -98,12 +100,47 @@ void Sound::soundProcessError(int error, QString str) {
 }
 
 
-SoundProcessor::SoundProcessor(QWeakPointer<Resource> sound, QByteArray data) :
+SoundProcessor::SoundProcessor(QWeakPointer<Resource> sound, QByteArray data,
+                               std::shared_ptr<cache::ContentCache> artifactCache) :
     _sound(sound),
-    _data(data)
+    _data(data),
+    _artifactCache(artifactCache)
 {
 }
 
+// Decoded audio is cached as a header followed by the samples, at AudioConstants::SAMPLE_RATE.
+// Increment this when the decoding or the layout changes, so older artifacts are not used.
+static const int PCM_ARTIFACT_VERSION = 1;
+
+struct PCMArtifactHeader {
+    uint32_t numChannels;
+    uint32_t numSamples;
+};
+
+static AudioDataPointer readPCMArtifact(const QByteArray& artifact) {
+    PCMArtifactHeader header;
+    if (artifact.size() < (int)sizeof(header)) {
+        return AudioDataPointer();
+    }
+    memcpy(&header, artifact.constData(), sizeof(header));
+
+    qint64 expectedSize = (qint64)sizeof(header) + (qint64)header.numSamples * sizeof(AudioSample);
+    if (header.numChannels == 0 || artifact.size() != expectedSize) {
+        return AudioDataPointer();
+    }
+    return AudioData::make(header.numSamples, header.numChannels,
+                           reinterpret_cast<const AudioSample*>(artifact.constData() + sizeof(header)));
+}
+
+static QByteArray writePCMArtifact(const AudioData& audioData) {
+    PCMArtifactHeader header { audioData.getNumChannels(), audioData.getNumSamples() };
+    QByteArray artifact;
+    artifact.reserve(sizeof(header) + audioData.getNumBytes());
+    artifact.append(reinterpret_cast<const char*>(&header), sizeof(header));
+    artifact.append(audioData.rawData(), audioData.getNumBytes());
+    return artifact;
+}
+
 void SoundProcessor::run() {
     auto sound = qSharedPointerCast<Sound>(_sound.lock());
     if (!sound) {
@@ -119,18 +156,50 @@ void SoundProcessor::run() {
     static const QString MP3_EXTENSION = ".mp3";
     static const QString RAW_EXTENSION = ".raw";
     static const QString STEREO_RAW_EXTENSION = ".stereo.raw";
-    QString fileType;
+
+    // how the file is decoded, which is part of the cached artifact's type since the same bytes decode differently
+    // depending on the file's extension
+    QString decodeType;
+    if (fileName.endsWith(WAV_EXTENSION)) {
+        decodeType = "wav";
+    } else if (fileName.endsWith(MP3_EXTENSION)) {
+        decodeType = "mp3";
+    } else if (fileName.endsWith(STEREO_RAW_EXTENSION)) {
+        decodeType = "stereo.raw";
+    } else if (fileName.endsWith(RAW_EXTENSION)) {
+        decodeType = "raw";
+    } else {
+        qCWarning(audio) << "Unknown sound file type";
+        emit onError(300, "Failed to load sound file, reason: unknown sound file type");
+        return;
+    }
+
+    cache::FileCache::Key artifactKey;
+    if (_artifactCache) {
+        artifactKey = sound->getArtifactKey(_data, "pcm." + decodeType, PCM_ARTIFACT_VERSION);
+
+        QByteArray artifact;
+        if (_artifactCache->load(artifactKey, artifact)) {
+            auto audioData = readPCMArtifact(artifact);
+            if (audioData) {
+                emit onSuccess(audioData);
+                return;
+            }
+            qCWarning(audio) << "Ignoring invalid cached audio for" << fileName;
+        }
+    }
 
     QByteArray outputAudioByteArray;
     AudioProperties properties;
+    QString fileType;
 
-    if (fileName.endsWith(WAV_EXTENSION)) {
+    if (decodeType == "wav") {
         fileType = "WAV";
         properties = interpretAsWav(_data, outputAudioByteArray);
-    } else if (fileName.endsWith(MP3_EXTENSION)) {
+    } else if (decodeType == "mp3") {
         fileType = "MP3";
         properties = interpretAsMP3(_data, outputAudioByteArray);
-    } else if (fileName.endsWith(STEREO_RAW_EXTENSION)) {
+    } else if (decodeType == "stereo.raw") {
         // check if this was a stereo raw file
         // since it's raw the only way for us to know that is if the file was called .stereo.raw
         qCDebug(audio) << "Processing sound of" << _data.size() << "bytes from" << fileName << "as stereo audio file.";
@@ -138,15 +207,11 @@ void SoundProcessor::run() {
         properties.numChannels = 2;
         properties.sampleRate = 48000;
         outputAudioByteArray = _data;
-    } else if (fileName.endsWith(RAW_EXTENSION)) {
+    } else {
         // Process as 48khz RAW file
         properties.numChannels = 1;
         properties.sampleRate = 48000;
         outputAudioByteArray = _data;
-    } else {
-        qCWarning(audio) << "Unknown sound file type";
-        emit onError(300, "Failed to load sound file, reason: unknown sound file type");
-        return;
     }
 
     if (properties.sampleRate == 0) {
@@ -160,6 +225,9 @@ void SoundProcessor::run() {
     int numSamples = data.size() / AudioConstants::SAMPLE_SIZE;
     auto audioData = AudioData::make(numSamples, properties.numChannels,
                                      (const AudioSample*)data.constData());
+    if (_artifactCache && numSamples > 0) {
+        _artifactCache->store(artifactKey, writePCMArtifact(*audioData));
+    }
     emit onSuccess(audioData);
 }
 
@@ -99,7 +99,8 @@ public:
         uint32_t sampleRate { 0 };
     };
 
-    SoundProcessor(QWeakPointer<Resource> sound, QByteArray data);
+    SoundProcessor(QWeakPointer<Resource> sound, QByteArray data,
+                   std::shared_ptr<cache::ContentCache> artifactCache = nullptr);
 
     virtual void run() override;
 
@@ -117,6 +118,7 @@ signals:
 private:
     const QWeakPointer<Resource> _sound;
     const QByteArray _data;
+    const std::shared_ptr<cache::ContentCache> _artifactCache;
 };
 
 typedef QSharedPointer<Sound> SharedSoundPointer;
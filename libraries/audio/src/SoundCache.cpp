@@ -18,6 +18,7 @@
 #include "AudioLogging.h"
 
 static const int SOUNDS_LOADING_PRIORITY { -7 }; // Make sure sounds load after the low rez texture mips
+static const std::string SOUND_ARTIFACT_CACHE_DIRNAME { "sound_cache" };
 
 int soundPointerMetaTypeId = qRegisterMetaType<SharedSoundPointer>();
 
@@ -26,6 +27,10 @@ SoundCache::SoundCache(QObject* parent) :
 {
     const qint64 SOUND_DEFAULT_UNUSED_MAX_SIZE = 50 * BYTES_PER_MEGABYTES;
     setUnusedResourceCacheSize(SOUND_DEFAULT_UNUSED_MAX_SIZE);
+
+    // keep decoded audio across sessions, so sounds don't have to be decoded and resampled again
+    const size_t SOUND_ARTIFACT_CACHE_MAX_SIZE = 1 * BYTES_PER_GIGABYTES;
+    enableArtifactCache(SOUND_ARTIFACT_CACHE_DIRNAME, SOUND_ARTIFACT_CACHE_MAX_SIZE);
     setObjectName("SoundCache");
 }
 
@@ -0,0 +1,256 @@
+//
+//  AudioDynamics_avx2.cpp
+//  libraries/audio/src
+//
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifdef __AVX2__
+
+#include <immintrin.h>
+
+#include "../AudioDynamics.h"
+
+#if defined(__GNUC__) && !defined(__clang__)
+// results must match the reference code exactly
+#pragma GCC optimize("fp-contract=off")
+#endif
+
+void limiterPeaks_ref(const float* input, int32_t threshold, int32_t* attn, int numChannels, int numFrames);
+void limiterOutput_ref(const float* input, const float* gain, const float* noise, int16_t* output,
+                       int numChannels, int numFrames);
+void gatePeaks_ref(const int32_t* input, int32_t* peaks, int numChannels, int numFrames);
+bool gateOutput_ref(const int32_t* input, const int32_t* attn, int16_t* output, int numChannels, int numFrames);
+void reverbMix_ref(const float* dry, const float* wet, float mix, float* output, int numFrames);
+
+// same as MULHI(), for each lane
+static inline __m256i mulhi_epi32(__m256i a, __m256i b) {
+    __m256i even = _mm256_srli_epi64(_mm256_mul_epi32(a, b), 32);
+    __m256i odd = _mm256_mul_epi32(_mm256_srli_epi64(a, 32), _mm256_srli_epi64(b, 32));
+    return _mm256_blend_epi32(even, odd, 0xaa);
+}
+
+// same as MULQ31(), for each lane
+static inline __m256i mulq31_epi32(__m256i a, __m256i b) {
+    __m256i even = _mm256_srli_epi64(_mm256_mul_epi32(a, b), 31);
+    __m256i odd = _mm256_slli_epi64(_mm256_mul_epi32(_mm256_srli_epi64(a, 32), _mm256_srli_epi64(b, 32)), 1);
+    return _mm256_blend_epi32(even, odd, 0xaa);
+}
+
+// max of adjacent pairs of a and b, in order
+static inline __m256i maxPairs(__m256i a, __m256i b) {
+    __m256 fa = _mm256_castsi256_ps(a);
+    __m256 fb = _mm256_castsi256_ps(b);
+    __m256i lo = _mm256_castps_si256(_mm256_shuffle_ps(fa, fb, _MM_SHUFFLE(2,0,2,0)));
+    __m256i hi = _mm256_castps_si256(_mm256_shuffle_ps(fa, fb, _MM_SHUFFLE(3,1,3,1)));
+    return _mm256_permute4x64_epi64(_mm256_max_epi32(lo, hi), _MM_SHUFFLE(3,1,2,0));
+}
+
+// the max of each frame, for 8 frames of 1, 2 or 4 channels
+static inline __m256i maxFrames(const __m256i* x, int numChannels) {
+    if (numChannels == 1) {
+        return x[0];
+    } else if (numChannels == 2) {
+        return maxPairs(x[0], x[1]);
+    } else {
+        return maxPairs(maxPairs(x[0], x[1]), maxPairs(x[2], x[3]));
+    }
+}
+
+// the permutation that repeats the value of each frame for its channels, for vector j of 8 frames
+static inline __m256i frameIndex(int numChannels, int j) {
+    __m256i lane = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+    int shift = (numChannels == 1) ? 0 : (numChannels == 2) ? 1 : 2;
+    return _mm256_add_epi32(_mm256_srli_epi32(lane, shift), _mm256_set1_epi32(j * (8 / numChannels)));
+}
+
+// polynomial for log2(1+x) over x=[0,1], result in Q26
+static inline __m256i log2Poly(__m256i e, __m256i x) {
+
+    __m256i k = _mm256_srli_epi32(x, 31 - LOG2_TABBITS);
+    k = _mm256_add_epi32(k, _mm256_add_epi32(k, k));    // row of log2Table
+
+    const int* table = (const int*)&log2Table[0][0];
+    __m256i c0 = _mm256_i32gather_epi32(table + 0, k, 4);
+    __m256i c1 = _mm256_i32gather_epi32(table + 1, k, 4);
+    __m256i c2 = _mm256_i32gather_epi32(table + 2, k, 4);
+
+    c1 = _mm256_add_epi32(c1, mulhi_epi32(c0, x));
+    c2 = _mm256_add_epi32(c2, mulhi_epi32(c1, x));
+
+    // reconstruct result in Q26
+    return _mm256_sub_epi32(_mm256_slli_epi32(e, LOG2_FRACBITS), _mm256_srai_epi32(c2, 3));
+}
+
+// same as peaklog2(), for the absolute float bits of each lane
+static inline __m256i peaklog2_AVX2(__m256i peak) {
+
+    // split into e and x - 1.0
+    __m256i e = _mm256_sub_epi32(_mm256_set1_epi32(IEEE754_EXPN_BIAS + LOG2_HEADROOM),
+                                 _mm256_srli_epi32(peak, IEEE754_MANT_BITS));
+    __m256i x = _mm256_and_si256(_mm256_slli_epi32(peak, IEEE754_EXPN_BITS), _mm256_set1_epi32(0x7fffffff));
+
+    __m256i result = log2Poly(e, x);
+
+    // saturate when e > 31 or e < 0
+    __m256i inRange = _mm256_cmpeq_epi32(_mm256_min_epu32(e, _mm256_set1_epi32(31)), e);
+    __m256i saturated = _mm256_andnot_si256(_mm256_srai_epi32(e, 31), _mm256_set1_epi32(0x7fffffff));
+    return _mm256_blendv_epi8(saturated, result, inRange);
+}
+
+// same as fixlog2(), for each lane
+static inline __m256i fixlog2_AVX2(__m256i x) {
+
+    __m256i isPositive = _mm256_cmpgt_epi32(x, _mm256_setzero_si256());
+
+    // leading zeros from the float exponent, corrected when the conversion rounds up
+    __m256i expn = _mm256_srli_epi32(_mm256_castps_si256(_mm256_cvtepi32_ps(x)), IEEE754_MANT_BITS);
+    expn = _mm256_sub_epi32(expn, _mm256_set1_epi32(IEEE754_EXPN_BIAS));
+    __m256i pow2 = _mm256_sllv_epi32(_mm256_set1_epi32(1), expn);
+    __m256i isBelow = _mm256_cmpeq_epi32(_mm256_max_epu32(pow2, x), x);
+    expn = _mm256_add_epi32(expn, _mm256_andnot_si256(isBelow, _mm256_set1_epi32(-1)));
+    __m256i e = _mm256_sub_epi32(_mm256_set1_epi32(31), expn);
+
+    // split into e and x - 1.0
+    __m256i u = _mm256_and_si256(_mm256_sllv_epi32(x, e), _mm256_set1_epi32(0x7fffffff));
+
+    __m256i result = log2Poly(e, u);
+
+    // x <= 0 returns 0x7fffffff
+    return _mm256_blendv_epi8(_mm256_set1_epi32(0x7fffffff), result, isPositive);
+}
+
+void limiterPeaks_AVX2(const float* input, int32_t threshold, int32_t* attn, int numChannels, int numFrames) {
+
+    const __m256i fabsMask = _mm256_set1_epi32(IEEE754_FABS_MASK);
+
+    int n = 0;
+    for (; n < numFrames - 7; n += 8) {
+
+        // absolute value, as integer bits
+        __m256i x[4];
+        for (int j = 0; j < numChannels; j++) {
+            x[j] = _mm256_loadu_si256((const __m256i*)&input[numChannels * n + 8 * j]);
+            x[j] = _mm256_and_si256(x[j], fabsMask);
+        }
+
+        // peak detect and convert to log2 domain
+        __m256i peak = peaklog2_AVX2(maxFrames(x, numChannels));
+
+        // compute limiter attenuation
+        __m256i a = _mm256_max_epi32(_mm256_sub_epi32(_mm256_set1_epi32(threshold), peak), _mm256_setzero_si256());
+        _mm256_storeu_si256((__m256i*)&attn[n], a);
+    }
+
+    limiterPeaks_ref(&input[numChannels * n], threshold, &attn[n], numChannels, numFrames - n);
+
+    _mm256_zeroupper();
+}
+
+void limiterOutput_AVX2(const float* input, const float* gain, const float* noise, int16_t* output,
+                        int numChannels, int numFrames) {
+
+    int n = 0;
+    for (; n < numFrames - 7; n += 8) {
+
+        __m256 g = _mm256_loadu_ps(&gain[n]);
+        __m256 d = _mm256_loadu_ps(&noise[n]);
+
+        for (int j = 0; j < numChannels; j++) {
+
+            __m256i index = frameIndex(numChannels, j);
+            __m256 x = _mm256_loadu_ps(&input[numChannels * n + 8 * j]);
+
+            // apply gain
+            x = _mm256_mul_ps(x, _mm256_permutevar8x32_ps(g, index));
+
+            // apply dither
+            x = _mm256_add_ps(x, _mm256_permutevar8x32_ps(d, index));
+
+            // store 16-bit output, wrapping the same as the int16_t cast
+            __m256i y = _mm256_and_si256(_mm256_cvtps_epi32(x), _mm256_set1_epi32(0xffff));
+            y = _mm256_permute4x64_epi64(_mm256_packus_epi32(y, y), _MM_SHUFFLE(3,1,2,0));
+            _mm_storeu_si128((__m128i*)&output[numChannels * n + 8 * j], _mm256_castsi256_si128(y));
+        }
+    }
+
+    limiterOutput_ref(&input[numChannels * n], &gain[n], &noise[n], &output[numChannels * n], numChannels, numFrames - n);
+
+    _mm256_zeroupper();
+}
+
+void gatePeaks_AVX2(const int32_t* input, int32_t* peaks, int numChannels, int numFrames) {
+
+    int n = 0;
+    for (; n < numFrames - 7; n += 8) {
+
+        // absolute value
+        __m256i x[4];
+        for (int j = 0; j < numChannels; j++) {
+            x[j] = _mm256_loadu_si256((const __m256i*)&input[numChannels * n + 8 * j]);
+            x[j] = _mm256_abs_epi32(x[j]);
+        }
+
+        // peak detect and convert to log2 domain
+        __m256i peak = fixlog2_AVX2(maxFrames(x, numChannels));
+        _mm256_storeu_si256((__m256i*)&peaks[n], peak);
+    }
+
+    gatePeaks_ref(&input[numChannels * n], &peaks[n], numChannels, numFrames - n);
+
+    _mm256_zeroupper();
+}
+
+bool gateOutput_AVX2(const int32_t* input, const int32_t* attn, int16_t* output, int numChannels, int numFrames) {
+
+    __m256i mask = _mm256_setzero_si256();
+
+    int n = 0;
+    for (; n < numFrames - 7; n += 8) {
+
+        __m256i a = _mm256_loadu_si256((const __m256i*)&attn[n]);
+
+        for (int j = 0; j < numChannels; j++) {
+
+            __m256i x = _mm256_loadu_si256((const __m256i*)&input[numChannels * n + 8 * j]);
+
+            // apply gain
+            x = mulq31_epi32(x, _mm256_permutevar8x32_epi32(a, frameIndex(numChannels, j)));
+
+            // store 16-bit output, with saturation
+            x = _mm256_srai_epi32(_mm256_add_epi32(x, _mm256_set1_epi32(1 << 14)), 15);
+            x = _mm256_permute4x64_epi64(_mm256_packs_epi32(x, x), _MM_SHUFFLE(3,1,2,0));
+            _mm_storeu_si128((__m128i*)&output[numChannels * n + 8 * j], _mm256_castsi256_si128(x));
+
+            mask = _mm256_or_si256(mask, x);
+        }
+    }
+
+    bool isNonZero = !_mm256_testz_si256(mask, mask);
+
+    isNonZero |= gateOutput_ref(&input[numChannels * n], &attn[n], &output[numChannels * n], numChannels, numFrames - n);
+
+    _mm256_zeroupper();
+    return isNonZero;
+}
+
+void reverbMix_AVX2(const float* dry, const float* wet, float mix, float* output, int numFrames) {
+
+    __m256 m = _mm256_set1_ps(mix);
+
+    int i = 0;
+    for (; i < numFrames - 7; i += 8) {
+        __m256 x = _mm256_loadu_ps(&dry[i]);
+        __m256 y = _mm256_loadu_ps(&wet[i]);
+        _mm256_storeu_ps(&output[i], _mm256_add_ps(x, _mm256_mul_ps(_mm256_sub_ps(y, x), m)));
+    }
+
+    reverbMix_ref(&dry[i], &wet[i], mix, &output[i], numFrames - i);
+
+    _mm256_zeroupper();
+}
+
+#endif
@@ -35,6 +35,8 @@
 #pragma GCC diagnostic pop
 #endif
 
+#include <task/Parallel.h>
+
 #include "ModelBakerLogging.h"
 #include "ModelMath.h"
 
@@ -221,24 +223,23 @@ void BuildDracoMeshTask::run(const baker::BakeContextPointer& context, const Inp
     auto& dracoErrorsPerMesh = output.edit1();
     auto& materialLists = output.edit2();
 
-    dracoBytesPerMesh.reserve(meshes.size());
+    dracoBytesPerMesh.resize(meshes.size());
+    materialLists.resize(meshes.size());
     // vector<bool> is an exception to the std::vector conventions as it is a bit field
-    // So a bool reference to an element doesn't work
-    dracoErrorsPerMesh.resize(meshes.size());
-    materialLists.reserve(meshes.size());
-    for (size_t i = 0; i < meshes.size(); i++) {
+    // So a bool reference to an element doesn't work, and neighbouring elements can't be written from different threads
+    std::vector<char> dracoErrors(meshes.size(), false);
+    task::parallelFor((int)meshes.size(), [&](int i) {
         const auto& mesh = meshes[i];
         const auto& normals = baker::safeGet(normalsPerMesh, i);
         const auto& tangents = baker::safeGet(tangentsPerMesh, i);
-        dracoBytesPerMesh.emplace_back();
-        auto& dracoBytes = dracoBytesPerMesh.back();
-        materialLists.push_back(createMaterialList(mesh));
-        const auto& materialList = materialLists.back();
+        auto& dracoBytes = dracoBytesPerMesh[i];
+        materialLists[i] = createMaterialList(mesh);
+        const auto& materialList = materialLists[i];
 
         bool dracoError;
         std::unique_ptr<draco::Mesh> dracoMesh;
         std::tie(dracoMesh, dracoError) = createDracoMesh(mesh, normals, tangents, materialList);
-        dracoErrorsPerMesh[i] = dracoError;
+        dracoErrors[i] = dracoError;
 
         if (dracoMesh) {
             draco::Encoder encoder;
@@ -253,6 +254,7 @@ void BuildDracoMeshTask::run(const baker::BakeContextPointer& context, const Inp
 
             dracoBytes = hifi::ByteArray(buffer.data(), (int)buffer.size());
         }
-    }
+    });
+    dracoErrorsPerMesh.assign(dracoErrors.begin(), dracoErrors.end());
 #endif // not Q_OS_ANDROID
 }
@@ -14,6 +14,8 @@
 #include <glm/gtc/packing.hpp>
 
 #include <LogHandler.h>
+#include <task/Parallel.h>
+
 #include "ModelBakerLogging.h"
 #include "ModelMath.h"
 
@@ -381,10 +383,10 @@ void BuildGraphicsMeshTask::run(const baker::BakeContextPointer& context, const
     auto& graphicsMeshes = output;
 
     int n = (int)meshes.size();
-    for (int i = 0; i < n; i++) {
-        graphicsMeshes.emplace_back();
+    graphicsMeshes.resize(n);
+    task::parallelFor(n, [&](int i) {
         auto& graphicsMesh = graphicsMeshes[i];
-        
+
         // Try to create the graphics::Mesh
         buildGraphicsMesh(meshes[i], graphicsMesh, baker::safeGet(normalsPerMesh, i), baker::safeGet(tangentsPerMesh, i));
 
@@ -395,5 +397,5 @@ void BuildGraphicsMeshTask::run(const baker::BakeContextPointer& context, const
                 graphicsMesh->modelName = meshIndicesToModelNames[i].toStdString();
             }
         }
-    }
+    });
 }
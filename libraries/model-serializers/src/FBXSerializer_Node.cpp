@@ -20,6 +20,12 @@
 #include <QtCore/QDebug>
 #include <QtCore/QtEndian>
 #include <QtCore/QFileInfo>
+#include <QtConcurrent/QtConcurrentMap>
+
+#include <atomic>
+#include <vector>
+
+#include <zlib.h>
 
 #include <shared/NsightHelpers.h>
 #include <hfm/ModelFormatLogging.h>
@@ -34,8 +40,44 @@ int streamSize() {
     return 1;
 }
 
+// Compressed arrays at least this big are inflated once the whole node tree has been read, in parallel with each other
+static const uLong MIN_DEFERRED_INFLATE_SIZE = 256 * 1024;
+
+// A compressed array whose typed storage has been allocated, but not yet filled
+struct FBXArrayInflation {
+    hifi::ByteArray compressed;
+    char* destination;
+    uLong size;
+};
+
+using FBXArrayInflations = std::vector<FBXArrayInflation>;
+
+bool inflateArray(const FBXArrayInflation& inflation) {
+    uLongf size = inflation.size;
+    int result = uncompress(reinterpret_cast<Bytef*>(inflation.destination), &size,
+                            reinterpret_cast<const Bytef*>(inflation.compressed.constData()),
+                            (uLong)inflation.compressed.size());
+    return result == Z_OK && size == inflation.size;
+}
+
+void inflateArrays(const FBXArrayInflations& inflations) {
+    if (inflations.empty()) {
+        return;
+    }
+    PROFILE_RANGE_EX(resource_parse, __FUNCTION__, 0xff0000ff, (uint64_t)inflations.size());
+    std::atomic<bool> corrupt { false };
+    QtConcurrent::blockingMap(inflations, [&corrupt](const FBXArrayInflation& inflation) {
+        if (!inflateArray(inflation)) {
+            corrupt = true;
+        }
+    });
+    if (corrupt) {
+        throw QString("corrupt fbx file");
+    }
+}
+
 template<class T>
-QVariant readBinaryArray(QDataStream& in, int& position) {
+QVariant readBinaryArray(QDataStream& in, int& position, FBXArrayInflations& inflations) {
     quint32 arrayLength;
     quint32 encoding;
     quint32 compressedLength;
@@ -53,38 +95,35 @@ QVariant readBinaryArray(QDataStream& in, int& position) {
 
     QVector<T> values;
     if ((int)QSysInfo::ByteOrder == (int)in.byteOrder()) {
+        // the file layout matches ours, so the data goes straight into the typed storage that the node will share
         values.resize(arrayLength);
-        hifi::ByteArray arrayData;
+        char* destination = reinterpret_cast<char*>(values.data());
+        uLong size = sizeof(T) * arrayLength;
         if (encoding == FBX_PROPERTY_COMPRESSED_FLAG) {
-            // preface encoded data with uncompressed length
-            hifi::ByteArray compressed(sizeof(quint32) + compressedLength, 0);
-            *((quint32*)compressed.data()) = qToBigEndian<quint32>(arrayLength * sizeof(T));
-            in.readRawData(compressed.data() + sizeof(quint32), compressedLength);
+            FBXArrayInflation inflation { hifi::ByteArray(compressedLength, Qt::Uninitialized), destination, size };
+            if (in.readRawData(inflation.compressed.data(), compressedLength) != (int)compressedLength) {
+                throw QString("corrupt fbx file");
+            }
             position += compressedLength;
-            arrayData = qUncompress(compressed);
-            if (arrayData.isEmpty() ||
-                (unsigned int)arrayData.size() != (sizeof(T) * arrayLength)) { // answers empty byte array if corrupt
+            if (size >= MIN_DEFERRED_INFLATE_SIZE) {
+                inflations.push_back(inflation);
+            } else if (size > 0 && !inflateArray(inflation)) {
                 throw QString("corrupt fbx file");
             }
         } else {
-            arrayData.resize(sizeof(T) * arrayLength);
-            position += sizeof(T) * arrayLength;
-            in.readRawData(arrayData.data(), arrayData.size());
-        }
-
-        if (arrayData.size() > 0) {
-            memcpy(&values[0], arrayData.constData(), arrayData.size());
+            position += size;
+            in.readRawData(destination, size);
         }
     } else {
         values.reserve(arrayLength);
         if (encoding == FBX_PROPERTY_COMPRESSED_FLAG) {
-            // preface encoded data with uncompressed length
-            hifi::ByteArray compressed(sizeof(quint32) + compressedLength, 0);
-            *((quint32*)compressed.data()) = qToBigEndian<quint32>(arrayLength * sizeof(T));
-            in.readRawData(compressed.data() + sizeof(quint32), compressedLength);
+            FBXArrayInflation inflation { hifi::ByteArray(compressedLength, Qt::Uninitialized), nullptr,
+                                          (uLong)(sizeof(T) * arrayLength) };
+            in.readRawData(inflation.compressed.data(), compressedLength);
             position += compressedLength;
-            hifi::ByteArray uncompressed = qUncompress(compressed);
-            if (uncompressed.isEmpty()) { // answers empty byte array if corrupt
+            hifi::ByteArray uncompressed(inflation.size, Qt::Uninitialized);
+            inflation.destination = uncompressed.data();
+            if (!inflateArray(inflation)) {
                 throw QString("corrupt fbx file");
             }
             QDataStream uncompressedIn(uncompressed);
@@ -104,10 +143,11 @@ QVariant readBinaryArray(QDataStream& in, int& position) {
             }
         }
     }
+    // the variant shares the storage allocated above, which deferred inflations still point into
     return QVariant::fromValue(values);
 }
 
-QVariant parseBinaryFBXProperty(QDataStream& in, int& position) {
+QVariant parseBinaryFBXProperty(QDataStream& in, int& position, FBXArrayInflations& inflations) {
     char ch;
     in.device()->getChar(&ch);
     position++;
@@ -149,19 +189,19 @@ QVariant parseBinaryFBXProperty(QDataStream& in, int& position) {
             return QVariant::fromValue(value);
         }
         case 'f': {
-            return readBinaryArray<float>(in, position);
+            return readBinaryArray<float>(in, position, inflations);
         }
         case 'd': {
-            return readBinaryArray<double>(in, position);
+            return readBinaryArray<double>(in, position, inflations);
         }
         case 'l': {
-            return readBinaryArray<qint64>(in, position);
+            return readBinaryArray<qint64>(in, position, inflations);
         }
         case 'i': {
-            return readBinaryArray<qint32>(in, position);
+            return readBinaryArray<qint32>(in, position, inflations);
         }
         case 'b': {
-            return readBinaryArray<bool>(in, position);
+            return readBinaryArray<bool>(in, position, inflations);
         }
         case 'S':
         case 'R': {
@@ -175,7 +215,8 @@ QVariant parseBinaryFBXProperty(QDataStream& in, int& position) {
     }
 }
 
-FBXNode parseBinaryFBXNode(QDataStream& in, int& position, bool has64BitPositions = false) {
+FBXNode parseBinaryFBXNode(QDataStream& in, int& position, FBXArrayInflations& inflations,
+                           bool has64BitPositions = false) {
     qint64 endOffset;
     quint64 propertyCount;
     quint64 propertyListLength;
@@ -215,11 +256,11 @@ FBXNode parseBinaryFBXNode(QDataStream& in, int& position, bool has64BitPosition
     position += nameLength;
 
     for (quint32 i = 0; i < propertyCount; i++) {
-        node.properties.append(parseBinaryFBXProperty(in, position));
+        node.properties.append(parseBinaryFBXProperty(in, position, inflations));
     }
 
     while (endOffset > position) {
-        FBXNode child = parseBinaryFBXNode(in, position, has64BitPositions);
+        FBXNode child = parseBinaryFBXNode(in, position, inflations, has64BitPositions);
         if (!child.name.isNull()) {
             node.children.append(child);
         }
@@ -389,15 +430,17 @@ FBXNode FBXSerializer::parseFBX(QIODevice* device) {
 
     // parse the top-level node
     FBXNode top;
+    FBXArrayInflations inflations;
     while (device->bytesAvailable()) {
-        FBXNode next = parseBinaryFBXNode(in, position, has64BitPositions);
+        FBXNode next = parseBinaryFBXNode(in, position, inflations, has64BitPositions);
         if (next.name.isNull()) {
-            return top;
+            break;
 
         } else {
             top.children.append(next);
         }
     }
+    inflateArrays(inflations);
 
     return top;
 }
@@ -409,28 +452,21 @@ glm::vec3 FBXSerializer::getVec3(const QVariantList& properties, int index) {
 }
 
 QVector<glm::vec4> FBXSerializer::createVec4Vector(const QVector<double>& doubleVector) {
-    QVector<glm::vec4> values;
-    for (const double* it = doubleVector.constData(), *end = it + ((doubleVector.size() / 4) * 4); it != end; ) {
-        float x = *it++;
-        float y = *it++;
-        float z = *it++;
-        float w = *it++;
-        values.append(glm::vec4(x, y, z, w));
+    QVector<glm::vec4> values(doubleVector.size() / 4);
+    const double* it = doubleVector.constData();
+    for (glm::vec4* value = values.data(), *end = value + values.size(); value != end; value++, it += 4) {
+        *value = glm::vec4(it[0], it[1], it[2], it[3]);
     }
     return values;
 }
 
 
 QVector<glm::vec4> FBXSerializer::createVec4VectorRGBA(const QVector<double>& doubleVector, glm::vec4& average) {
-    QVector<glm::vec4> values;
-    for (const double* it = doubleVector.constData(), *end = it + ((doubleVector.size() / 4) * 4); it != end; ) {
-        float x = *it++;
-        float y = *it++;
-        float z = *it++;
-        float w = *it++;
-        auto val = glm::vec4(x, y, z, w);
-        values.append(val);
-        average += val;
+    QVector<glm::vec4> values(doubleVector.size() / 4);
+    const double* it = doubleVector.constData();
+    for (glm::vec4* value = values.data(), *end = value + values.size(); value != end; value++, it += 4) {
+        *value = glm::vec4(it[0], it[1], it[2], it[3]);
+        average += *value;
     }
     if (!values.isEmpty()) {
         average *= (1.0f / float(values.size()));
@@ -439,22 +475,19 @@ QVector<glm::vec4> FBXSerializer::createVec4VectorRGBA(const QVector<double>& do
 }
 
 QVector<glm::vec3> FBXSerializer::createVec3Vector(const QVector<double>& doubleVector) {
-    QVector<glm::vec3> values;
-    for (const double* it = doubleVector.constData(), *end = it + ((doubleVector.size() / 3) * 3); it != end; ) {
-        float x = *it++;
-        float y = *it++;
-        float z = *it++;
-        values.append(glm::vec3(x, y, z));
+    QVector<glm::vec3> values(doubleVector.size() / 3);
+    const double* it = doubleVector.constData();
+    for (glm::vec3* value = values.data(), *end = value + values.size(); value != end; value++, it += 3) {
+        *value = glm::vec3(it[0], it[1], it[2]);
     }
     return values;
 }
 
 QVector<glm::vec2> FBXSerializer::createVec2Vector(const QVector<double>& doubleVector) {
-    QVector<glm::vec2> values;
-    for (const double* it = doubleVector.constData(), *end = it + ((doubleVector.size() / 2) * 2); it != end; ) {
-        float s = *it++;
-        float t = *it++;
-        values.append(glm::vec2(s, -t));
+    QVector<glm::vec2> values(doubleVector.size() / 2);
+    const double* it = doubleVector.constData();
+    for (glm::vec2* value = values.data(), *end = value + values.size(); value != end; value++, it += 2) {
+        *value = glm::vec2(it[0], -it[1]);
     }
     return values;
 }
@@ -479,6 +512,7 @@ QVector<int> FBXSerializer::getIntVector(const FBXNode& node) {
     if (!vector.isEmpty()) {
         return vector;
     }
+    vector.reserve(node.properties.size());
     for (int i = 0; i < node.properties.size(); i++) {
         vector.append(node.properties.at(i).toInt());
     }
@@ -498,6 +532,7 @@ QVector<float> FBXSerializer::getFloatVector(const FBXNode& node) {
     if (!vector.isEmpty()) {
         return vector;
     }
+    vector.reserve(node.properties.size());
     for (int i = 0; i < node.properties.size(); i++) {
         vector.append(node.properties.at(i).toFloat());
     }
@@ -517,6 +552,7 @@ QVector<double> FBXSerializer::getDoubleVector(const FBXNode& node) {
     if (!vector.isEmpty()) {
         return vector;
     }
+    vector.reserve(node.properties.size());
     for (int i = 0; i < node.properties.size(); i++) {
         vector.append(node.properties.at(i).toDouble());
     }
@@ -11,9 +11,12 @@
 
 #include "GLTFSerializer.h"
 
+#include <type_traits>
+
 #include <QtCore/QBuffer>
 #include <QtCore/QIODevice>
 #include <QtCore/QEventLoop>
+#include <QtCore/QtEndian>
 #include <QtCore/qjsondocument.h>
 #include <QtCore/qjsonobject.h>
 #include <QtCore/qjsonarray.h>
@@ -112,6 +115,7 @@ bool GLTFSerializer::getIntArrayVal(const QJsonObject& object, const QString& fi
     bool _defined = (object.contains(fieldname) && object[fieldname].isArray());
     if (_defined) {
         QJsonArray arr = object[fieldname].toArray();
+        values.reserve(values.size() + arr.size());
         foreach(const QJsonValue & v, arr) {
             if (!v.isNull()) {
                 values.push_back(v.toInt());
@@ -127,6 +131,7 @@ bool GLTFSerializer::getDoubleArrayVal(const QJsonObject& object, const QString&
     bool _defined = (object.contains(fieldname) && object[fieldname].isArray());
     if (_defined) {
         QJsonArray arr = object[fieldname].toArray();
+        values.reserve(values.size() + arr.size());
         foreach(const QJsonValue & v, arr) {
             if (v.isDouble()) {
                 values.push_back(v.toDouble());
@@ -148,26 +153,30 @@ bool GLTFSerializer::getObjectArrayVal(const QJsonObject& object, const QString&
 }
 
 hifi::ByteArray GLTFSerializer::setGLBChunks(const hifi::ByteArray& data) {
-    int byte = 4;
-    int jsonStart = data.indexOf("JSON", Qt::CaseSensitive);
-    int binStart = data.indexOf("BIN", Qt::CaseSensitive);
-    int jsonLength, binLength;
-    hifi::ByteArray jsonLengthChunk, binLengthChunk;
-
-    jsonLengthChunk = data.mid(jsonStart - byte, byte);
-    QDataStream tempJsonLen(jsonLengthChunk);
-    tempJsonLen.setByteOrder(QDataStream::LittleEndian);
-    tempJsonLen >> jsonLength;
-    hifi::ByteArray jsonChunk = data.mid(jsonStart + byte, jsonLength);
-
-    if (binStart != -1) {
-        binLengthChunk = data.mid(binStart - byte, byte);
-
-        QDataStream tempBinLen(binLengthChunk);
-        tempBinLen.setByteOrder(QDataStream::LittleEndian);
-        tempBinLen >> binLength;
+    // see https://github.com/KhronosGroup/glTF/tree/master/specification/2.0#glb-file-format-specification
+    // The chunks are referenced in place rather than copied out of data, which outlives the parse.
+    const int GLB_HEADER_SIZE = 12;
+    const int GLB_CHUNK_HEADER_SIZE = 8;
+    const quint32 GLB_CHUNK_TYPE_JSON = 0x4E4F534A;
+    const quint32 GLB_CHUNK_TYPE_BIN = 0x004E4942;
+
+    hifi::ByteArray jsonChunk;
+    int position = GLB_HEADER_SIZE;
+    while (position + GLB_CHUNK_HEADER_SIZE <= data.size()) {
+        quint32 chunkLength = qFromLittleEndian<quint32>(data.constData() + position);
+        quint32 chunkType = qFromLittleEndian<quint32>(data.constData() + position + sizeof(quint32));
+        position += GLB_CHUNK_HEADER_SIZE;
+        if (chunkLength > (quint32)(data.size() - position)) {
+            qWarning(modelformat) << "Truncated GLB chunk for model " << _url;
+            break;
+        }
 
-        _glbBinary = data.mid(binStart + byte, binLength);
+        if (chunkType == GLB_CHUNK_TYPE_JSON && jsonChunk.isNull()) {
+            jsonChunk = hifi::ByteArray::fromRawData(data.constData() + position, chunkLength);
+        } else if (chunkType == GLB_CHUNK_TYPE_BIN && _glbBinary.isNull()) {
+            _glbBinary = hifi::ByteArray::fromRawData(data.constData() + position, chunkLength);
+        }
+        position += chunkLength;
     }
     return jsonChunk;
 }
@@ -386,6 +395,7 @@ bool GLTFSerializer::addBufferView(const QJsonObject& object) {
     getIntVal(object, "buffer", bufferview.buffer, bufferview.defined);
     getIntVal(object, "byteLength", bufferview.byteLength, bufferview.defined);
     getIntVal(object, "byteOffset", bufferview.byteOffset, bufferview.defined);
+    getIntVal(object, "byteStride", bufferview.byteStride, bufferview.defined);
     getIntVal(object, "target", bufferview.target, bufferview.defined);
 
     _file.bufferviews.push_back(bufferview);
@@ -648,7 +658,7 @@ bool GLTFSerializer::parseGLTF(const hifi::ByteArray& data) {
 
     hifi::ByteArray jsonChunk = data;
 
-    if (_url.path().endsWith("glb") && data.indexOf("glTF") == 0 && data.contains("JSON")) {
+    if (_url.path().endsWith("glb") && data.startsWith("glTF")) {
         jsonChunk = setGLBChunks(data);
     }
 
@@ -1360,10 +1370,12 @@ bool GLTFSerializer::buildGeometry(HFMModel& hfmModel, const hifi::VariantHash&
 
                 part.triangleIndices.append(validatedIndices);
 
+                mesh.vertices.reserve(mesh.vertices.size() + vertices.size() / verticesStride);
                 for (int n = 0; n + verticesStride - 1 < vertices.size(); n = n + verticesStride) {
                     mesh.vertices.push_back(glm::vec3(vertices[n], vertices[n + 1], vertices[n + 2]));
                 }
 
+                mesh.normals.reserve(mesh.normals.size() + normals.size() / normalStride);
                 for (int n = 0; n + normalStride - 1 < normals.size(); n = n + normalStride) {
                     mesh.normals.push_back(glm::vec3(normals[n], normals[n + 1], normals[n + 2]));
                 }
@@ -1701,21 +1713,26 @@ HFMModel::Pointer GLTFSerializer::read(const hifi::ByteArray& data, const hifi::
         _url = hifi::URL(QFileInfo(localFileName).absoluteFilePath());
     }
 
+    HFMModel::Pointer hfmModelPtr;
     if (parseGLTF(data)) {
         //_file.dump();
-        auto hfmModelPtr = std::make_shared<HFMModel>();
+        hfmModelPtr = std::make_shared<HFMModel>();
         HFMModel& hfmModel = *hfmModelPtr;
         buildGeometry(hfmModel, mapping, _url);
 
         //hfmModel.debugDump();
         //glTFDebugDump();
-
-        return hfmModelPtr;
     } else {
         qCDebug(modelformat) << "Error parsing GLTF file.";
     }
 
-    return nullptr;
+    // the GLB binary chunk and the buffers that share it point into data, which the caller owns
+    _glbBinary.clear();
+    for (auto& buffer : _file.buffers) {
+        buffer.blob.clear();
+    }
+
+    return hfmModelPtr;
 }
 
 bool GLTFSerializer::readBinary(const QString& url, hifi::ByteArray& outdata) {
@@ -1810,6 +1827,7 @@ HFMTexture GLTFSerializer::getHFMTexture(const GLTFTexture& texture) {
             int length = imagesBufferview.byteLength;
 
             fbxtex.content = _glbBinary.mid(offset, length);
+            fbxtex.content.detach(); // _glbBinary only references the data being read
             fbxtex.filename = textureUrl.toEncoded().append(texture.source);
         }
 
@@ -1892,15 +1910,8 @@ void GLTFSerializer::setHFMMaterial(HFMMaterial& hfmMat, const GLTFMaterial& mat
 }
 
 template<typename T, typename L>
-bool GLTFSerializer::readArray(const hifi::ByteArray& bin, int byteOffset, int count,
-                           QVector<L>& outarray, int accessorType, bool normalized) {
-
-    QDataStream blobstream(bin);
-    blobstream.setByteOrder(QDataStream::LittleEndian);
-    blobstream.setVersion(QDataStream::Qt_5_9);
-    blobstream.setFloatingPointPrecision(QDataStream::FloatingPointPrecision::SinglePrecision);
-    blobstream.skipRawData(byteOffset);
-
+bool GLTFSerializer::readArray(const hifi::ByteArray& bin, int byteOffset, int byteStride, int count,
+                               QVector<L>& outarray, int accessorType, bool normalized) {
     int bufferCount = 0;
     switch (accessorType) {
     case GLTFAccessorType::SCALAR:
@@ -1926,7 +1937,18 @@ bool GLTFSerializer::readArray(const hifi::ByteArray& bin, int byteOffset, int c
         break;
     default:
         qWarning(modelformat) << "Unknown accessorType: " << accessorType;
-        blobstream.setDevice(nullptr);
+        return false;
+    }
+
+    // elements are tightly packed unless the buffer view interleaves them with other attributes
+    const int elementSize = (int)sizeof(T) * bufferCount;
+    const int stride = byteStride > 0 ? byteStride : elementSize;
+    if (count <= 0) {
+        return count == 0;
+    }
+    if (byteOffset < 0 || stride < elementSize ||
+        (qint64)byteOffset + (qint64)stride * (count - 1) + elementSize > (qint64)bin.size() ||
+        (qint64)outarray.size() + (qint64)count * bufferCount > std::numeric_limits<int>::max()) {
         return false;
     }
 
@@ -1935,46 +1957,48 @@ bool GLTFSerializer::readArray(const hifi::ByteArray& bin, int byteOffset, int c
         scale = (float)(std::numeric_limits<T>::max)();
     }
 
-    for (int i = 0; i < count; ++i) {
+    int start = outarray.size();
+    outarray.resize(start + count * bufferCount);
+    L* out = outarray.data() + start;
+    const char* in = bin.constData() + byteOffset;
+
+    if (std::is_same<T, L>::value && !normalized && stride == elementSize && Q_BYTE_ORDER == Q_LITTLE_ENDIAN) {
+        memcpy(out, in, (size_t)count * elementSize);
+        return true;
+    }
+
+    for (int i = 0; i < count; ++i, in += stride) {
         for (int j = 0; j < bufferCount; ++j) {
-            if (!blobstream.atEnd()) {
-                T value;
-                blobstream >> value;
-                if (normalized) {
-                    outarray.push_back(std::max((float)value / scale, -1.0f));
-                } else {
-                    outarray.push_back(value);
-                }
+            T value = qFromLittleEndian<T>(in + j * sizeof(T));
+            if (normalized) {
+                *out++ = static_cast<L>(std::max((float)value / scale, -1.0f));
             } else {
-                blobstream.setDevice(nullptr);
-                return false;
+                *out++ = static_cast<L>(value);
             }
         }
     }
-
-    blobstream.setDevice(nullptr);
     return true;
 }
 template<typename T>
-bool GLTFSerializer::addArrayOfType(const hifi::ByteArray& bin, int byteOffset, int count,
-                                QVector<T>& outarray, int accessorType, int componentType, bool normalized) {
+bool GLTFSerializer::addArrayOfType(const hifi::ByteArray& bin, int byteOffset, int byteStride, int count,
+                                    QVector<T>& outarray, int accessorType, int componentType, bool normalized) {
 
     switch (componentType) {
     case GLTFAccessorComponentType::BYTE: {}
     case GLTFAccessorComponentType::UNSIGNED_BYTE: {
-        return readArray<uchar>(bin, byteOffset, count, outarray, accessorType, normalized);
+        return readArray<uchar>(bin, byteOffset, byteStride, count, outarray, accessorType, normalized);
     }
     case GLTFAccessorComponentType::SHORT: {
-        return readArray<short>(bin, byteOffset, count, outarray, accessorType, normalized);
+        return readArray<short>(bin, byteOffset, byteStride, count, outarray, accessorType, normalized);
     }
     case GLTFAccessorComponentType::UNSIGNED_INT: {
-        return readArray<uint>(bin, byteOffset, count, outarray, accessorType, normalized);
+        return readArray<uint>(bin, byteOffset, byteStride, count, outarray, accessorType, normalized);
     }
     case GLTFAccessorComponentType::UNSIGNED_SHORT: {
-        return readArray<ushort>(bin, byteOffset, count, outarray, accessorType, normalized);
+        return readArray<ushort>(bin, byteOffset, byteStride, count, outarray, accessorType, normalized);
     }
     case GLTFAccessorComponentType::FLOAT: {
-        return readArray<float>(bin, byteOffset, count, outarray, accessorType, normalized);
+        return readArray<float>(bin, byteOffset, byteStride, count, outarray, accessorType, normalized);
     }
     }
     return false;
@@ -1990,8 +2014,10 @@ bool GLTFSerializer::addArrayFromAccessor(GLTFAccessor& accessor, QVector<T>& ou
 
         int accBoffset = accessor.defined["byteOffset"] ? accessor.byteOffset : 0;
 
-        success = addArrayOfType(buffer.blob, bufferview.byteOffset + accBoffset, accessor.count, outarray, accessor.type,
-                                 accessor.componentType, accessor.normalized);
+        int byteStride = bufferview.defined["byteStride"] ? bufferview.byteStride : 0;
+
+        success = addArrayOfType(buffer.blob, bufferview.byteOffset + accBoffset, byteStride, accessor.count, outarray,
+                                 accessor.type, accessor.componentType, accessor.normalized);
     } else {
         for (int i = 0; i < accessor.count; ++i) {
             T value;
@@ -2009,7 +2035,7 @@ bool GLTFSerializer::addArrayFromAccessor(GLTFAccessor& accessor, QVector<T>& ou
 
             int accSIBoffset = accessor.sparse.indices.defined["byteOffset"] ? accessor.sparse.indices.byteOffset : 0;
 
-            success = addArrayOfType(sparseIndicesBuffer.blob, sparseIndicesBufferview.byteOffset + accSIBoffset,
+            success = addArrayOfType(sparseIndicesBuffer.blob, sparseIndicesBufferview.byteOffset + accSIBoffset, 0,
                                      accessor.sparse.count, out_sparse_indices_array, GLTFAccessorType::SCALAR,
                                      accessor.sparse.indices.componentType, false);
             if (success) {
@@ -2020,7 +2046,7 @@ bool GLTFSerializer::addArrayFromAccessor(GLTFAccessor& accessor, QVector<T>& ou
 
                 int accSVBoffset = accessor.sparse.values.defined["byteOffset"] ? accessor.sparse.values.byteOffset : 0;
 
-                success = addArrayOfType(sparseValuesBuffer.blob, sparseValuesBufferview.byteOffset + accSVBoffset,
+                success = addArrayOfType(sparseValuesBuffer.blob, sparseValuesBufferview.byteOffset + accSVBoffset, 0,
                                          accessor.sparse.count, out_sparse_values_array, accessor.type, accessor.componentType,
                                          accessor.normalized);
 
@@ -0,0 +1,54 @@
+//
+//  AssetHasher.cpp
+//  libraries/networking/src
+//
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AssetHasher.h"
+
+#include <openssl/opensslv.h>
+#include <openssl/evp.h>
+
+#include "AssetUtils.h"
+
+#if OPENSSL_VERSION_NUMBER >= 0x10100000
+AssetHasher::AssetHasher() : _context(EVP_MD_CTX_new()) {
+    reset();
+}
+
+AssetHasher::~AssetHasher() {
+    EVP_MD_CTX_free(_context);
+}
+
+#else
+
+AssetHasher::AssetHasher() : _context(EVP_MD_CTX_create()) {
+    reset();
+}
+
+AssetHasher::~AssetHasher() {
+    EVP_MD_CTX_destroy(_context);
+}
+#endif
+
+void AssetHasher::reset() {
+    EVP_DigestInit_ex(_context, EVP_sha256(), nullptr);
+}
+
+void AssetHasher::addData(const char* data, qint64 size) {
+    if (size > 0) {
+        EVP_DigestUpdate(_context, data, (size_t)size);
+    }
+}
+
+QByteArray AssetHasher::result() {
+    QByteArray hash(AssetUtils::SHA256_HASH_LENGTH, Qt::Uninitialized);
+    unsigned int hashLength = 0;
+    EVP_DigestFinal_ex(_context, reinterpret_cast<unsigned char*>(hash.data()), &hashLength);
+    reset();
+    return hash;
+}
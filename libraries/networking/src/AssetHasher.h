@@ -0,0 +1,38 @@
+//
+//  AssetHasher.h
+//  libraries/networking/src
+//
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AssetHasher_h
+#define hifi_AssetHasher_h
+
+#include <QtCore/QByteArray>
+
+// Incremental SHA-256 of asset contents, so that data can be hashed as it is streamed instead of in one buffer.
+// Backed by OpenSSL, which picks SHA-NI / AVX2 implementations at runtime when the CPU supports them.
+class AssetHasher {
+public:
+    AssetHasher();
+    ~AssetHasher();
+
+    AssetHasher(const AssetHasher&) = delete;
+    AssetHasher& operator=(const AssetHasher&) = delete;
+
+    void addData(const char* data, qint64 size);
+    void addData(const QByteArray& data) { addData(data.constData(), data.size()); }
+
+    // Returns the raw hash of the data added so far and resets the hasher.
+    QByteArray result();
+
+private:
+    void reset();
+
+    struct evp_md_ctx_st* _context;
+};
+
+#endif // hifi_AssetHasher_h
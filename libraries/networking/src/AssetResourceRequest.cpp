@@ -150,7 +150,7 @@ void AssetResourceRequest::requestHash(const AssetUtils::AssetHash& hash) {
     _assetRequest = assetClient->createRequest(hash, _byteRange);
 
     connect(_assetRequest, &AssetRequest::progress, this, &AssetResourceRequest::onDownloadProgress);
-    connect(_assetRequest, &AssetRequest::finished, this, [this](AssetRequest* req) {
+    connect(_assetRequest, &AssetRequest::finished, this, [this, hash](AssetRequest* req) {
         Q_ASSERT(_state == InProgress);
         Q_ASSERT(req == _assetRequest);
         Q_ASSERT(req->getState() == AssetRequest::Finished);
@@ -159,6 +159,9 @@ void AssetResourceRequest::requestHash(const AssetUtils::AssetHash& hash) {
             case AssetRequest::Error::NoError:
                 _data = req->getData();
                 _result = Success;
+                if (!_byteRange.isSet()) {
+                    _contentID = hash.toUtf8();
+                }
                 recordBytesDownloadedInStats(STAT_ATP_RESOURCE_TOTAL_BYTES, _data.size());
                 break;
             case AssetRequest::InvalidHash:
@@ -13,11 +13,11 @@
 
 #include <memory>
 
-#include <QtCore/QCryptographicHash>
 #include <QtCore/QDateTime>
 #include <QtCore/QFileInfo> // for baseName
 #include <QtNetwork/QAbstractNetworkCache>
 
+#include "AssetHasher.h"
 #include "NetworkAccessManager.h"
 #include "NetworkLogging.h"
 #include "NetworkingConstants.h"
@@ -60,7 +60,9 @@ QUrl getATPUrl(const QString& input) {
 }
 
 QByteArray hashData(const QByteArray& data) {
-    return QCryptographicHash::hash(data, QCryptographicHash::Sha256);
+    AssetHasher hasher;
+    hasher.addData(data);
+    return hasher.result();
 }
 
 QByteArray loadFromCache(const QUrl& url) {
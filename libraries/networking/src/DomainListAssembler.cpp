@@ -0,0 +1,54 @@
+//
+//  DomainListAssembler.cpp
+//  libraries/networking/src
+//
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "DomainListAssembler.h"
+
+void DomainListAssembler::beginPacket(quint32 version, quint32 baseVersion, quint32 numEntries) {
+    if (version != _pendingVersion || baseVersion != _pendingBaseVersion) {
+        _pendingVersion = version;
+        _pendingBaseVersion = baseVersion;
+        _listedNodes.clear();
+        _removedNodes.clear();
+    }
+    _numPendingEntries = numEntries;
+}
+
+void DomainListAssembler::addEntry(const QUuid& nodeUUID, bool isRemoved) {
+    // a node can be both removed and listed again under the same ID, so those count as two entries
+    if (isRemoved) {
+        _removedNodes.insert(nodeUUID);
+    } else {
+        _listedNodes.insert(nodeUUID);
+    }
+}
+
+bool DomainListAssembler::endPacket() {
+    if ((quint32)(_listedNodes.size() + _removedNodes.size()) < _numPendingEntries) {
+        return false;
+    }
+
+    // the changes since a version are only complete on top of that version
+    quint32 ackedVersion = _ackedVersion;
+    bool isComplete = _pendingBaseVersion == 0 || (ackedVersion != 0 && _pendingBaseVersion <= ackedVersion &&
+                                                   _pendingVersion > ackedVersion);
+    if (isComplete) {
+        _ackedVersion = _pendingVersion;
+    }
+    return isComplete;
+}
+
+void DomainListAssembler::reset() {
+    _ackedVersion = 0;
+    _pendingVersion = 0;
+    _pendingBaseVersion = 0;
+    _numPendingEntries = 0;
+    _listedNodes.clear();
+    _removedNodes.clear();
+}
@@ -0,0 +1,65 @@
+//
+//  DomainListAssembler.h
+//  libraries/networking/src
+//
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_DomainListAssembler_h
+#define hifi_DomainListAssembler_h
+
+#include <atomic>
+
+#include <QtCore/QSet>
+#include <QtCore/QUuid>
+
+/// @addtogroup Networking
+/// @{
+
+/// @brief Keeps track of which domain list version a client has received in full, for the domain-server to send the
+/// changes since.
+/// @details A domain list is sent as unreliable packets that can be lost, and the domain-server answers every
+/// check-in, so the packets of the same list can arrive more than once. A list is complete once each of its entries has
+/// arrived, counted once per node however many times it was sent, and its changes apply on top of the version acked.
+///
+/// The acked version may be read and reset from any thread; the entries of a list are added from the thread that
+/// processes domain list packets.
+class DomainListAssembler {
+public:
+    /// @brief Starts on a domain list packet, with the list version, base version and total number of entries that
+    /// every packet of the list carries.
+    void beginPacket(quint32 version, quint32 baseVersion, quint32 numEntries);
+
+    /// @brief Counts an entry of the packet, either a node in the list or a node removed since the base version.
+    void addEntry(const QUuid& nodeUUID, bool isRemoved);
+
+    /// @brief Acks the list if the packet completed it.
+    /// @returns <code>true</code> if the list is complete and its version is now the acked version.
+    bool endPacket();
+
+    /// @brief The version of the last list received in full, or 0 if the next list must be a full list.
+    quint32 getAckedVersion() const { return _ackedVersion; }
+
+    /// @brief Asks for a full list with the next check-in, e.g. after killing a node that only a full list brings back.
+    void resetAckedVersion() { _ackedVersion = 0; }
+
+    /// @brief Forgets the acked version and the list being received.
+    void reset();
+
+private:
+    std::atomic<quint32> _ackedVersion { 0 };
+
+    // the list being received, and the nodes of it that have arrived
+    quint32 _pendingVersion { 0 };
+    quint32 _pendingBaseVersion { 0 };
+    quint32 _numPendingEntries { 0 };
+    QSet<QUuid> _listedNodes;
+    QSet<QUuid> _removedNodes;
+};
+
+/// @}
+
+#endif // hifi_DomainListAssembler_h
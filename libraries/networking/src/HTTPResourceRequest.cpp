@@ -161,6 +161,14 @@ void HTTPResourceRequest::onRequestFinished() {
                 }
             }
 
+            // a strong ETag identifies these exact bytes, a weak one only equivalent content
+            if (!_byteRange.isSet()) {
+                auto etag = _reply->rawHeader("ETag");
+                if (!etag.isEmpty() && !etag.startsWith("W/")) {
+                    _contentID = _url.toEncoded() + ' ' + etag;
+                }
+            }
+
             recordBytesDownloadedInStats(STAT_HTTP_RESOURCE_TOTAL_BYTES, _data.size());
 
             break;
@@ -473,22 +473,26 @@ qint64 LimitedNodeList::sendPacket(std::unique_ptr<NLPacket> packet, const SockA
     } else {
         auto size = sendUnreliablePacket(*packet, sockAddr, hmacAuth);
         if (size < 0) {
-            auto now = usecTimestampNow();
-            if (now - _sendErrorStatsTime > ERROR_STATS_PERIOD_US) {
-                _sendErrorStatsTime = now;
-                eachNode([now](const SharedNodePointer& node) {
-                    qCDebug(networking) << "Stats for " << node->getPublicSocket() << "\n"
-                        << "    Last Heard Microstamp: " << node->getLastHeardMicrostamp() << " (" << (now - node->getLastHeardMicrostamp()) << "usec ago)\n"
-                        << "    Outbound Kbps: " << node->getOutboundKbps() << "\n"
-                        << "    Inbound Kbps: " << node->getInboundKbps() << "\n"
-                        << "    Ping: " << node->getPingMs();
-                });
-            }
+            logSendError();
         }
         return size;
     }
 }
 
+void LimitedNodeList::logSendError() {
+    auto now = usecTimestampNow();
+    if (now - _sendErrorStatsTime > ERROR_STATS_PERIOD_US) {
+        _sendErrorStatsTime = now;
+        eachNode([now](const SharedNodePointer& node) {
+            qCDebug(networking) << "Stats for " << node->getPublicSocket() << "\n"
+                << "    Last Heard Microstamp: " << node->getLastHeardMicrostamp() << " (" << (now - node->getLastHeardMicrostamp()) << "usec ago)\n"
+                << "    Outbound Kbps: " << node->getOutboundKbps() << "\n"
+                << "    Inbound Kbps: " << node->getInboundKbps() << "\n"
+                << "    Ping: " << node->getPingMs();
+        });
+    }
+}
+
 qint64 LimitedNodeList::sendUnreliableUnorderedPacketList(NLPacketList& packetList, const Node& destinationNode) {
     auto activeSocket = destinationNode.getActiveSocket();
 
@@ -160,6 +160,10 @@ public:
     qint64 sendPacket(std::unique_ptr<NLPacket> packet, const Node& destinationNode);
     qint64 sendPacket(std::unique_ptr<NLPacket> packet, const SockAddr& sockAddr, HMACAuth* hmacAuth = nullptr);
 
+    // logs the stats of each node, at most once a second, when an unreliable send fails
+    // (sendPacket does this itself; callers of sendUnreliablePacket check its return value)
+    void logSendError();
+
     // use sendUnreliableUnorderedPacketList to unreliably send separate packets from the packet list
     // either to a node's active socket or to a manual sockaddr
     qint64 sendUnreliableUnorderedPacketList(NLPacketList& packetList, const Node& destinationNode);
@@ -0,0 +1,59 @@
+//
+//  NLPacketArena.cpp
+//  libraries/networking/src
+//
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "NLPacketArena.h"
+
+#include "LimitedNodeList.h"
+
+NLPacketArena::NLPacketArena(int maxPooledPackets) :
+    _maxPooledPackets(maxPooledPackets)
+{
+    // reserve up front so that recycling never grows the pool
+    _pool.reserve(_maxPooledPackets);
+}
+
+std::unique_ptr<NLPacket> NLPacketArena::acquire(PacketType type) {
+    // the most recently recycled packet of this type is the one most likely to still be in cache
+    for (auto it = _pool.rbegin(); it != _pool.rend(); ++it) {
+        if ((*it)->getType() == type) {
+            auto packet = std::move(*it);
+            _pool.erase(std::next(it).base());
+
+            // rewind to an empty payload; the header is rewritten when the packet is sent
+            packet->reset();
+            return packet;
+        }
+    }
+
+    ++_numCreated;
+    return NLPacket::create(type);
+}
+
+void NLPacketArena::recycle(std::unique_ptr<NLPacket> packet) {
+    if (!packet) {
+        return;
+    }
+
+    Q_ASSERT_X(!packet->isReliable() && !packet->isPartOfMessage(), "NLPacketArena::recycle",
+               "Only unreliable single packets can be recycled");
+
+    if ((int)_pool.size() < _maxPooledPackets) {
+        _pool.push_back(std::move(packet));
+    }
+}
+
+qint64 NLPacketArena::send(LimitedNodeList& nodeList, std::unique_ptr<NLPacket> packet, const Node& node) {
+    auto size = nodeList.sendUnreliablePacket(*packet, node);
+    if (size < 0) {
+        nodeList.logSendError();
+    }
+    recycle(std::move(packet));
+    return size;
+}
@@ -0,0 +1,63 @@
+//
+//  NLPacketArena.h
+//  libraries/networking/src
+//
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_NLPacketArena_h
+#define hifi_NLPacketArena_h
+
+#include <memory>
+#include <vector>
+
+#include "NLPacket.h"
+
+class LimitedNodeList;
+class Node;
+
+/// @addtogroup Networking
+/// @{
+
+/// @brief Recycles unreliable NLPackets, so that code which builds and sends packets every frame does not allocate a new
+/// packet and MTU buffer for each one.
+/// @details Acquire a packet, write it, and send it with send, which hands it back to the arena: an unreliable send is
+/// done with the packet when the call returns. Reliable packets are owned by their
+/// connection's send queue once sent and are not pooled.
+///
+/// An arena is not thread-safe; each thread that builds packets should own its own.
+class NLPacketArena {
+public:
+    static const int DEFAULT_MAX_POOLED_PACKETS = 16;
+
+    NLPacketArena(int maxPooledPackets = DEFAULT_MAX_POOLED_PACKETS);
+
+    NLPacketArena(const NLPacketArena&) = delete;
+    NLPacketArena& operator=(const NLPacketArena&) = delete;
+
+    /// @brief Returns an empty, writable packet of the given type, with room for the largest payload that type allows.
+    std::unique_ptr<NLPacket> acquire(PacketType type);
+
+    /// @brief Returns a sent packet to the arena, to be handed out again by acquire.
+    void recycle(std::unique_ptr<NLPacket> packet);
+
+    /// @brief Sends a packet unreliably to a node's active socket and returns it to the arena.
+    /// @details A failed send is logged with the stats of each node, as LimitedNodeList::sendPacket does.
+    /// @returns The number of bytes sent, or a negative value if the send failed.
+    qint64 send(LimitedNodeList& nodeList, std::unique_ptr<NLPacket> packet, const Node& node);
+
+    int getNumPooled() const { return (int)_pool.size(); }
+    quint64 getNumCreated() const { return _numCreated; }
+
+private:
+    const int _maxPooledPackets;
+    std::vector<std::unique_ptr<NLPacket>> _pool;
+    quint64 _numCreated { 0 };
+};
+
+/// @}
+
+#endif // hifi_NLPacketArena_h
@@ -126,6 +126,13 @@ NodeList::NodeList(char newOwnerType, int socketListenPort, int dtlsListenPort)
     // anytime we get a new node we may need to re-send our set of ignored node IDs to it
     connect(this, &LimitedNodeList::nodeActivated, this, &NodeList::maybeSendIgnoreSetToNode);
 
+    // the changes the domain-server sends won't bring back a node we killed ourselves, so ask for a full list instead
+    connect(this, &LimitedNodeList::nodeKilled, this, [this] {
+        if (!_isRemovingDomainListNode) {
+            _domainListAssembler.resetAckedVersion();
+        }
+    }, Qt::DirectConnection);
+
     // setup our timer to send keepalive pings (it's started and stopped on domain connect/disconnect)
     _keepAlivePingTimer.setInterval(KEEPALIVE_PING_INTERVAL_MS); // 1s, Qt::CoarseTimer acceptable
     connect(&_keepAlivePingTimer, &QTimer::timeout, this, &NodeList::sendKeepAlivePings);
@@ -318,6 +325,8 @@ void NodeList::reset(QString reason, bool skipDomainHandlerReset) {
     setSessionUUID(QUuid());
     setSessionLocalID(Node::NULL_LOCAL_ID);
 
+    _domainListAssembler.reset();
+
     // if we setup the DTLS socket, also disconnect from the DTLS socket readyRead() so it can handle handshaking
     if (_dtlsSocket) {
         disconnect(_dtlsSocket, 0, this, 0);
@@ -500,6 +509,10 @@ void NodeList::sendDomainServerCheckIn() {
             << localSockAddr << _nodeTypesOfInterest.values();
         packetStream << DependencyManager::get<AddressManager>()->getPlaceName();
 
+        if (domainPacketType == PacketType::DomainListRequest) {
+            packetStream << _domainListAssembler.getAckedVersion();
+        }
+
         if (!domainIsConnected) {
 
             // Metaverse account.
@@ -761,6 +774,14 @@ void NodeList::processDomainList(QSharedPointer<ReceivedMessage> message) {
     bool newConnection;
     packetStream >> newConnection;
 
+    // lists with a base version only carry the changes since that version
+    quint32 domainListVersion;
+    packetStream >> domainListVersion;
+    quint32 domainListBaseVersion;
+    packetStream >> domainListBaseVersion;
+    quint32 numDomainListEntries;
+    packetStream >> numDomainListEntries;
+
     if (newConnection) {
         _nodeConnectTimestamp = usecTimestampNow();
         _connectReason = Connect;
@@ -857,10 +878,24 @@ void NodeList::processDomainList(QSharedPointer<ReceivedMessage> message) {
     setPermissions(newPermissions);
     setAuthenticatePackets(isAuthenticated);
 
+    // the entries of a list can come in several packets, keep track of which have arrived
+    _domainListAssembler.beginPacket(domainListVersion, domainListBaseVersion, numDomainListEntries);
+
     // pull each node in the packet
     while (packetStream.device()->pos() < message->getSize()) {
-        parseNodeFromPacketStream(packetStream);
+        bool isRemoved;
+        packetStream >> isRemoved;
+        if (isRemoved) {
+            QUuid nodeUUID;
+            packetStream >> nodeUUID;
+            removeNodeFromDomainList(nodeUUID);
+            _domainListAssembler.addEntry(nodeUUID, true);
+        } else {
+            _domainListAssembler.addEntry(parseNodeFromPacketStream(packetStream), false);
+        }
     }
+
+    _domainListAssembler.endPacket();
 }
 
 void NodeList::processDomainServerAddedNode(QSharedPointer<ReceivedMessage> message) {
@@ -875,11 +910,17 @@ void NodeList::processDomainServerRemovedNode(QSharedPointer<ReceivedMessage> me
     // read the UUID from the packet, remove it if it exists
     QUuid nodeUUID = QUuid::fromRfc4122(message->readWithoutCopy(NUM_BYTES_RFC4122_UUID));
     qCDebug(networking) << "Received packet from domain-server to remove node with UUID" << uuidStringWithoutCurlyBraces(nodeUUID);
+    removeNodeFromDomainList(nodeUUID);
+}
+
+void NodeList::removeNodeFromDomainList(const QUuid& nodeUUID) {
+    _isRemovingDomainListNode = true;
     killNodeWithUUID(nodeUUID);
     removeDelayedAdd(nodeUUID);
+    _isRemovingDomainListNode = false;
 }
 
-void NodeList::parseNodeFromPacketStream(QDataStream& packetStream) {
+QUuid NodeList::parseNodeFromPacketStream(QDataStream& packetStream) {
     NewNodeInfo info;
 
     SocketType publicSocketType, localSocketType;
@@ -903,6 +944,8 @@ void NodeList::parseNodeFromPacketStream(QDataStream& packetStream) {
     }
 
     addNewNode(info);
+
+    return info.uuid;
 }
 
 void NodeList::sendAssignment(Assignment& assignment) {
@@ -34,6 +34,7 @@
 #include <SettingHandle.h>
 
 #include "DomainHandler.h"
+#include "DomainListAssembler.h"
 #include "LimitedNodeList.h"
 #include "Node.h"
 
@@ -169,7 +170,8 @@ private:
 
     void sendDSPathQuery(const QString& newPath);
 
-    void parseNodeFromPacketStream(QDataStream& packetStream);
+    QUuid parseNodeFromPacketStream(QDataStream& packetStream);
+    void removeNodeFromDomainList(const QUuid& nodeUUID);
 
     void pingPunchForInactiveNode(const SharedNodePointer& node);
 
@@ -186,6 +188,11 @@ private:
     bool _sendDomainServerCheckInEnabled { true };
     bool _domainPortAutoDiscovery { true };
 
+    // the last domain list received in full, which the domain-server sends the changes since
+    DomainListAssembler _domainListAssembler;
+    // set while the domain list removes nodes, which unlike the nodes we kill ourselves don't need a full list
+    std::atomic<bool> _isRemovingDomainListNode { false };
+
     mutable QReadWriteLock _ignoredSetLock;
     tbb::concurrent_unordered_set<QUuid, UUIDHasher> _ignoredNodeIDs;
     mutable QReadWriteLock _personalMutedSetLock;
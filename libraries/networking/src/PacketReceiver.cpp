@@ -164,7 +164,7 @@ void PacketReceiver::handleVerifiedMessagePacket(std::unique_ptr<udt::Packet> pa
         handleVerifiedMessage(message, true);  // Handler may handle first message packet immediately when it arrives.
     } else {
         message = it->second;
-        message->appendPacket(*nlPacket);
+        message->appendPacket(std::move(nlPacket));
 
         if (message->isComplete()) {
             _pendingMessages.erase(it);
@@ -184,8 +184,13 @@ void PacketReceiver::handleMessageFailure(SockAddr from, udt::Packet::MessageNum
 }
 
 void PacketReceiver::handleVerifiedMessage(QSharedPointer<ReceivedMessage> receivedMessage, bool justReceived) {
-    auto nodeList = DependencyManager::get<LimitedNodeList>();
-    
+    // look up the source in the node list that owns this receiver, which isn't the global one for tools that run
+    // several node lists in one process
+    LimitedNodeList* nodeList = qobject_cast<LimitedNodeList*>(parent());
+    if (!nodeList) {
+        nodeList = DependencyManager::get<LimitedNodeList>().data();
+    }
+
     SharedNodePointer matchingNode;
     
     if (receivedMessage->getSourceID() != Node::NULL_LOCAL_ID) {
@@ -23,34 +23,36 @@ static const int HEAD_DATA_SIZE = 512;
 using namespace std::chrono;
 
 ReceivedMessage::ReceivedMessage(const NLPacketList& packetList)
-    : _data(packetList.getMessage()),
-      _headData(_data.mid(0, HEAD_DATA_SIZE)),
-      _numPackets(packetList.getNumPackets()),
+    : _numPackets(packetList.getNumPackets()),
       _sourceID(packetList.getSourceID()),
       _packetType(packetList.getType()),
       _packetVersion(packetList.getVersion()),
       _senderSockAddr(packetList.getSenderSockAddr())
 {
+    Segment segment;
+    segment.bytes = packetList.getMessage();
+    appendSegment(std::move(segment));
+
     _firstPacketReceiveTime = duration_cast<microseconds>(packetList.getFirstPacketReceiveTime().time_since_epoch()).count();
 }
 
 ReceivedMessage::ReceivedMessage(NLPacket& packet)
-    : _data(packet.readAll()),
-      _headData(_data.mid(0, HEAD_DATA_SIZE)),
-      _numPackets(1),
+    : _numPackets(1),
       _sourceID(packet.getSourceID()),
       _packetType(packet.getType()),
       _packetVersion(packet.getVersion()),
       _senderSockAddr(packet.getSenderSockAddr()),
       _isComplete(packet.getPacketPosition() == NLPacket::ONLY)
 {
+    Segment segment;
+    segment.bytes = packet.readAll();
+    appendSegment(std::move(segment));
+
     _firstPacketReceiveTime = duration_cast<microseconds>(packet.getReceiveTime().time_since_epoch()).count();
 }
 
 ReceivedMessage::ReceivedMessage(QByteArray byteArray, PacketType packetType, PacketVersion packetVersion,
                 const SockAddr& senderSockAddr, NLPacket::LocalID sourceID) :
-    _data(byteArray),
-    _headData(_data.mid(0, HEAD_DATA_SIZE)),
     _numPackets(1),
     _firstPacketReceiveTime(0),
     _sourceID(sourceID),
@@ -59,6 +61,9 @@ ReceivedMessage::ReceivedMessage(QByteArray byteArray, PacketType packetType, Pa
     _senderSockAddr(senderSockAddr),
     _isComplete(true)
 {
+    Segment segment;
+    segment.bytes = byteArray;
+    appendSegment(std::move(segment));
 }
 
 void ReceivedMessage::setFailed() {
@@ -67,17 +72,60 @@ void ReceivedMessage::setFailed() {
     emit completed();
 }
 
+void ReceivedMessage::appendSegment(Segment&& segment) {
+    if (segment.bytes.size() > 0) {
+        segment.data = segment.bytes.constData();
+        segment.size = segment.bytes.size();
+    }
+
+    if (segment.size <= 0) {
+        return;
+    }
+
+    if (_segments.empty()) {
+        // only the first packet is used for the head, it is read from other threads while later packets are appended
+        _headData = QByteArray(segment.data, std::min((qint64)HEAD_DATA_SIZE, segment.size));
+    }
+
+    std::lock_guard<std::mutex> lock(_segmentsMutex);
+    segment.offset = _size;
+    _segments.push_back(std::move(segment));
+    _size += _segments.back().size;
+}
+
 void ReceivedMessage::appendPacket(NLPacket& packet) {
     Q_ASSERT_X(!_isComplete, "ReceivedMessage::appendPacket", 
                "We should not be appending to a complete message");
 
+    // the caller keeps ownership of the packet, so its payload has to be copied
+    Segment segment;
+    segment.bytes = QByteArray(packet.getPayload(), packet.getPayloadSize());
+    appendSegment(std::move(segment));
+
+    updateForPacket(packet);
+}
+
+void ReceivedMessage::appendPacket(std::unique_ptr<NLPacket> packet) {
+    Q_ASSERT_X(!_isComplete, "ReceivedMessage::appendPacket", 
+               "We should not be appending to a complete message");
+
+    // keep the packet buffer alive and reference its payload in place
+    const NLPacket& packetRef = *packet;
+    Segment segment;
+    segment.data = packet->getPayload();
+    segment.size = packet->getPayloadSize();
+    segment.packet = std::move(packet);
+    appendSegment(std::move(segment));
+
+    updateForPacket(packetRef);
+}
+
+void ReceivedMessage::updateForPacket(const NLPacket& packet) {
     // Limit progress signal to every X packets
     const int EMIT_PROGRESS_EVERY_X_PACKETS = 50;
 
     ++_numPackets;
 
-    _data.append(packet.getPayload(), packet.getPayloadSize());
-
     if (_numPackets % EMIT_PROGRESS_EVERY_X_PACKETS == 0) {
         emit progress(getSize());
     }
@@ -94,17 +142,97 @@ void ReceivedMessage::appendPacket(NLPacket& packet) {
     }
 }
 
+std::unique_lock<std::mutex> ReceivedMessage::lockSegmentsIfIncomplete() const {
+    // _isComplete is set after the last segment is appended, so seeing it set means seeing every segment
+    if (_isComplete) {
+        return std::unique_lock<std::mutex>(_segmentsMutex, std::defer_lock);
+    }
+    return std::unique_lock<std::mutex>(_segmentsMutex);
+}
+
+int ReceivedMessage::getNumSegments() const {
+    auto lock = lockSegmentsIfIncomplete();
+    return (int)_segments.size();
+}
+
+QByteArray ReceivedMessage::getMessage() const {
+    {
+        auto lock = lockSegmentsIfIncomplete();
+        if (_segments.size() == 1 && !_segments.front().packet) {
+            return _segments.front().bytes;
+        }
+    }
+    // flattening builds a copy that is shared between threads, so it always takes the lock
+    std::lock_guard<std::mutex> lock(_segmentsMutex);
+    return flatten();
+}
+
+const char* ReceivedMessage::getRawMessage() const {
+    {
+        auto lock = lockSegmentsIfIncomplete();
+        if (_segments.size() == 1) {
+            return _segments.front().data;
+        }
+    }
+    Q_ASSERT_X(_isComplete, "ReceivedMessage::getRawMessage",
+               "The raw data of a multi-packet message is reallocated as packets arrive");
+    std::lock_guard<std::mutex> lock(_segmentsMutex);
+    return flatten().constData();
+}
+
+const QByteArray& ReceivedMessage::flatten() const {
+    if (_flattenedData.size() != _size) {
+        _flattenedData.resize(_size);
+        copyRange(_flattenedData.data(), 0, _size);
+    }
+    return _flattenedData;
+}
+
+std::vector<ReceivedMessage::Segment>::const_iterator ReceivedMessage::findSegment(qint64 position) const {
+    // first segment that starts after position, the one before it contains position
+    auto it = std::upper_bound(_segments.cbegin(), _segments.cend(), position, [](qint64 value, const Segment& segment) {
+        return value < segment.offset;
+    });
+    if (it == _segments.cbegin()) {
+        return _segments.cend();
+    }
+    --it;
+    return (position < it->offset + it->size) ? it : _segments.cend();
+}
+
+qint64 ReceivedMessage::copyRange(char* data, qint64 position, qint64 size) const {
+    qint64 copied = 0;
+    for (auto it = findSegment(position); it != _segments.cend() && copied < size; ++it) {
+        qint64 segmentPosition = position + copied - it->offset;
+        qint64 toCopy = std::min(size - copied, it->size - segmentPosition);
+        memcpy(data + copied, it->data + segmentPosition, toCopy);
+        copied += toCopy;
+    }
+    return copied;
+}
+
+QByteArray ReceivedMessage::copyRange(qint64 position, qint64 size) const {
+    if (position < 0 || size <= 0) {
+        return QByteArray();
+    }
+    auto lock = lockSegmentsIfIncomplete();
+    size = std::min(size, _size - position);
+    if (size <= 0) {
+        return QByteArray();
+    }
+    QByteArray data(size, Qt::Uninitialized);
+    copyRange(data.data(), position, size);
+    return data;
+}
+
 qint64 ReceivedMessage::peek(char* data, qint64 size) {
-    size_t bytesLeft = _data.size() - _position;
-    size_t sizeRead = std::min((size_t)size, bytesLeft);
-    memcpy(data, _data.constData() + _position, sizeRead);
-    return sizeRead;
+    auto lock = lockSegmentsIfIncomplete();
+    return copyRange(data, _position, std::min(size, _size - _position));
 }
 
 qint64 ReceivedMessage::read(char* data, qint64 size) {
-    size_t bytesLeft = _data.size() - _position;
-    size_t sizeRead = std::min((size_t)size, bytesLeft);
-    memcpy(data, _data.constData() + _position, sizeRead);
+    auto lock = lockSegmentsIfIncomplete();
+    qint64 sizeRead = copyRange(data, _position, std::min(size, _size - _position));
     _position += sizeRead;
     return sizeRead;
 }
@@ -118,11 +246,11 @@ qint64 ReceivedMessage::readHead(char* data, qint64 size) {
 }
 
 QByteArray ReceivedMessage::peek(qint64 size) {
-    return _data.mid(_position, size);
+    return copyRange(_position, size);
 }
 
 QByteArray ReceivedMessage::read(qint64 size) {
-    auto data = _data.mid(_position, size);
+    auto data = copyRange(_position, size);
     _position += size;
     return data;
 }
@@ -141,17 +269,40 @@ QString ReceivedMessage::readString() {
     uint32_t size;
     readPrimitive(&size);
     //Q_ASSERT(size <= _size - _position);
-    auto string = QString::fromUtf8(_data.constData() + _position, size);
-    _position += size;
-    return string;
+    return QString::fromUtf8(readWithoutCopy(size));
 }
 
 QByteArray ReceivedMessage::readWithoutCopy(qint64 size) {
-    QByteArray data { QByteArray::fromRawData(_data.constData() + _position, size) };
+    QByteArray data;
+    bool isInOneSegment = false;
+    {
+        auto lock = lockSegmentsIfIncomplete();
+        auto it = findSegment(_position);
+        if (it != _segments.cend() && _position + size <= it->offset + it->size) {
+            data = QByteArray::fromRawData(it->data + (_position - it->offset), size);
+            isInOneSegment = true;
+        }
+    }
+    if (!isInOneSegment) {
+        // the range spans several segments, fall back to a copy
+        data = copyRange(_position, size);
+    }
     _position += size;
     return data;
 }
 
+QByteArray ReceivedMessage::readChunkWithoutCopy(qint64 maxSize) {
+    auto lock = lockSegmentsIfIncomplete();
+    auto it = findSegment(_position);
+    if (it == _segments.cend() || maxSize <= 0) {
+        return QByteArray();
+    }
+    qint64 segmentPosition = _position - it->offset;
+    qint64 size = std::min(maxSize, it->size - segmentPosition);
+    _position += size;
+    return QByteArray::fromRawData(it->data + segmentPosition, size);
+}
+
 void ReceivedMessage::onComplete() {
     _isComplete = true;
     emit completed();
@@ -18,6 +18,10 @@
 #include <QtCore/QSharedPointer>
 
 #include <atomic>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <vector>
 
 #include "NLPacketList.h"
 
@@ -29,8 +33,13 @@ public:
     ReceivedMessage(QByteArray byteArray, PacketType packetType, PacketVersion packetVersion,
                     const SockAddr& senderSockAddr, NLPacket::LocalID sourceID = NLPacket::NULL_LOCAL_ID);
 
-    QByteArray getMessage() const { return _data; }
-    const char* getRawMessage() const { return _data.constData(); }
+    // The payload of a multi-packet message is held as a list of segments that reference the original packet buffers.
+    // getMessage and getRawMessage need contiguous data and so flatten the segments into a single copy the first time
+    // they are called on such a message - prefer the read/readChunkWithoutCopy methods for large messages.
+    QByteArray getMessage() const;
+    // The pointer into a multi-packet message is only valid once the message is complete, since the flattened copy is
+    // rebuilt as further packets arrive.
+    const char* getRawMessage() const;
 
     PacketType getType() const { return _packetType; }
     PacketVersion getVersion() const { return _packetVersion; }
@@ -38,6 +47,7 @@ public:
     void setFailed();
 
     void appendPacket(NLPacket& packet);
+    void appendPacket(std::unique_ptr<NLPacket> packet);
 
     bool failed() const { return _failed; }
     bool isComplete() const { return _isComplete; }
@@ -52,9 +62,12 @@ public:
 
     qint64 getFirstPacketReceiveTime() const { return _firstPacketReceiveTime; }
 
-    qint64 getSize() const { return _data.size(); }
+    qint64 getSize() const { return _size; }
 
-    qint64 getBytesLeftToRead() const { return _data.size() -  _position; }
+    qint64 getBytesLeftToRead() const { return _size - _position; }
+
+    // Number of segments currently backing this message, one per received packet for messages built with appendPacket.
+    int getNumSegments() const;
 
     void seek(qint64 position) { _position = position; }
 
@@ -76,8 +89,15 @@ public:
     // This will return a QByteArray referencing the underlying data _without_ refcounting that data.
     // Be careful when using this method, only use it when the lifetime of the returned QByteArray will not
     // exceed that of the ReceivedMessage.
+    // If the requested range spans more than one segment a (refcounted) copy is returned instead.
     QByteArray readWithoutCopy(qint64 size);
 
+    // Streaming, zero-copy access to the message: returns a QByteArray referencing at most maxSize bytes of the segment
+    // at the current position and advances past them. The same lifetime rules as readWithoutCopy apply. Returns an empty
+    // QByteArray once all the bytes received so far have been read, so a consumer can drain a message as it arrives:
+    //     while (message->getBytesLeftToRead() > 0) { auto chunk = message->readChunkWithoutCopy(); ... }
+    QByteArray readChunkWithoutCopy(qint64 maxSize = std::numeric_limits<qint64>::max());
+
     template<typename T> qint64 peekPrimitive(T* data);
     template<typename T> qint64 readPrimitive(T* data);
 
@@ -91,7 +111,34 @@ private slots:
     void onComplete();
 
 private:
-    QByteArray _data;
+    struct Segment {
+        const char* data { nullptr };
+        qint64 size { 0 };
+        qint64 offset { 0 }; // offset of the first byte of this segment in the message
+
+        // one of these owns the bytes referenced by data
+        QByteArray bytes;
+        std::unique_ptr<NLPacket> packet;
+    };
+
+    void appendSegment(Segment&& segment);
+    void updateForPacket(const NLPacket& packet);
+
+    QByteArray copyRange(qint64 position, qint64 size) const;
+
+    // Segments are only appended while the message is incomplete, so readers of a complete message skip the lock.
+    std::unique_lock<std::mutex> lockSegmentsIfIncomplete() const;
+
+    // these must be called with _segmentsMutex held, or on a complete message
+    std::vector<Segment>::const_iterator findSegment(qint64 position) const;
+    qint64 copyRange(char* data, qint64 position, qint64 size) const;
+    const QByteArray& flatten() const;
+
+    mutable std::mutex _segmentsMutex;
+    std::vector<Segment> _segments;
+    std::atomic<qint64> _size { 0 };
+
+    mutable QByteArray _flattenedData; // built on demand for getMessage/getRawMessage on multi-segment messages
     QByteArray _headData;
 
     std::atomic<qint64> _position { 0 };
@@ -10,8 +10,10 @@
 //
 
 #include "ResourceCache.h"
+#include "ResourceCacheTrace.h"
 #include "ResourceRequestObserver.h"
 
+#include <algorithm>
 #include <cfloat>
 #include <cmath>
 #include <assert.h>
@@ -25,6 +27,7 @@
 #include <Trace.h>
 #include <Profile.h>
 
+#include "AssetUtils.h"
 #include "NetworkAccessManager.h"
 #include "NetworkLogging.h"
 #include "NodeList.h"
@@ -35,7 +38,7 @@ bool ResourceCacheSharedItems::appendRequest(QWeakPointer<Resource> resource) {
         _loadingRequests.append(resource);
         return true;
     } else {
-        _pendingRequests.append(resource);
+        pushPendingRequest(resource);
         return false;
     }
 }
@@ -54,8 +57,8 @@ QList<QSharedPointer<Resource>> ResourceCacheSharedItems::getPendingRequests() c
     QList<QSharedPointer<Resource>> result;
     Lock lock(_mutex);
 
-    foreach (QWeakPointer<Resource> resource, _pendingRequests) {
-        auto locked = resource.lock();
+    for (const auto& request : _pendingRequests) {
+        auto locked = request.resource.lock();
         if (locked) {
             result.append(locked);
         }
@@ -66,7 +69,7 @@ QList<QSharedPointer<Resource>> ResourceCacheSharedItems::getPendingRequests() c
 
 uint32_t ResourceCacheSharedItems::getPendingRequestsCount() const {
     Lock lock(_mutex);
-    return _pendingRequests.size();
+    return (uint32_t)_pendingRequests.size();
 }
 
 QList<QSharedPointer<Resource>> ResourceCacheSharedItems::getLoadingRequests() const {
@@ -105,45 +108,185 @@ void ResourceCacheSharedItems::removeRequest(QWeakPointer<Resource> resource) {
     }
 }
 
+static const quint64 PENDING_REQUESTS_REKEY_INTERVAL_USECS = USECS_PER_SECOND / 60;
+
 QSharedPointer<Resource> ResourceCacheSharedItems::getHighestPendingRequest() {
-    // look for the highest priority pending request
-    int highestIndex = -1;
-    float highestPriority = -FLT_MAX;
-    QSharedPointer<Resource> highestResource;
     Lock lock(_mutex);
 
-    bool currentHighestIsFile = false;
+    // owners that are destroyed don't tell the queue, so every entry is re-keyed once a frame
+    quint64 now = usecTimestampNow();
+    if (now - _lastPendingRequestsRekey >= PENDING_REQUESTS_REKEY_INTERVAL_USECS) {
+        rekeyPendingRequests();
+        _lastPendingRequestsRekey = now;
+    } else {
+        refreshPendingRequestPriorities();
+    }
 
-    for (int i = 0; i < _pendingRequests.size();) {
-        // Clear any freed resources
-        auto resource = _pendingRequests.at(i).lock();
+    // take the highest priority pending request, clearing any freed resources on the way
+    while (!_pendingRequests.empty()) {
+        auto resource = _pendingRequests.front().resource.lock();
         if (!resource) {
-            _pendingRequests.removeAt(i);
+            removePendingRequestAt(0);
             continue;
         }
 
-        // Check load priority
+        // an owner of the top request may have been destroyed since it was keyed, check it before taking it
         float priority = resource->getLoadPriority();
-        bool isFile = resource->getURL().scheme() == HIFI_URL_SCHEME_FILE;
-        if (priority >= highestPriority && (isFile || !currentHighestIsFile)) {
-            highestPriority = priority;
-            highestIndex = i;
-            highestResource = resource;
-            currentHighestIsFile = isFile;
+        if (priority != _pendingRequests.front().priority) {
+            _pendingRequests.front().priority = priority;
+            siftPendingRequestDown(0);
+            continue;
         }
-        i++;
+
+        removePendingRequestAt(0);
+        return resource;
+    }
+
+    return QSharedPointer<Resource>();
+}
+
+void ResourceCacheSharedItems::updateRequestPriority(QWeakPointer<Resource> request) {
+    Lock lock(_mutex);
+    auto key = request.data();
+    if (_pendingRequestIndices.contains(key)) {
+        _dirtyPendingRequests.insert(key);
+    }
+}
+
+bool ResourceCacheSharedItems::PendingRequest::isHigherThan(const PendingRequest& other) const {
+    if (isFile != other.isFile) {
+        return isFile;
+    }
+    if (priority != other.priority) {
+        return priority > other.priority;
+    }
+    return sequenceNumber > other.sequenceNumber;
+}
+
+void ResourceCacheSharedItems::pushPendingRequest(const QWeakPointer<Resource>& resource) {
+    auto locked = resource.lock();
+    if (!locked) {
+        return;
+    }
+
+    auto key = locked.data();
+    auto it = _pendingRequestIndices.find(key);
+    if (it != _pendingRequestIndices.end()) {
+        // either a repeated request or a new resource at the address of a freed one, replace the entry
+        removePendingRequestAt(it.value());
+    }
+
+    PendingRequest request { resource, key, locked->getLoadPriority(),
+                             locked->getURL().scheme() == HIFI_URL_SCHEME_FILE, _nextPendingSequenceNumber++ };
+    _pendingRequests.push_back(request);
+    int index = (int)_pendingRequests.size() - 1;
+    _pendingRequestIndices[key] = index;
+    siftPendingRequestUp(index);
+}
+
+void ResourceCacheSharedItems::removePendingRequestAt(int index) {
+    int lastIndex = (int)_pendingRequests.size() - 1;
+    _pendingRequestIndices.remove(_pendingRequests[index].key);
+    _dirtyPendingRequests.remove(_pendingRequests[index].key);
+
+    if (index != lastIndex) {
+        _pendingRequests[index] = _pendingRequests[lastIndex];
+        _pendingRequestIndices[_pendingRequests[index].key] = index;
+        _pendingRequests.pop_back();
+        siftPendingRequestDown(index);
+        siftPendingRequestUp(index);
+    } else {
+        _pendingRequests.pop_back();
     }
+}
 
-    if (highestIndex >= 0) {
-        _pendingRequests.takeAt(highestIndex);
+void ResourceCacheSharedItems::siftPendingRequestUp(int index) {
+    while (index > 0) {
+        int parent = (index - 1) / 2;
+        if (!_pendingRequests[index].isHigherThan(_pendingRequests[parent])) {
+            break;
+        }
+        swapPendingRequests(index, parent);
+        index = parent;
     }
+}
 
-    return highestResource;
+void ResourceCacheSharedItems::siftPendingRequestDown(int index) {
+    int size = (int)_pendingRequests.size();
+    while (true) {
+        int highest = index;
+        int left = 2 * index + 1;
+        int right = left + 1;
+        if (left < size && _pendingRequests[left].isHigherThan(_pendingRequests[highest])) {
+            highest = left;
+        }
+        if (right < size && _pendingRequests[right].isHigherThan(_pendingRequests[highest])) {
+            highest = right;
+        }
+        if (highest == index) {
+            break;
+        }
+        swapPendingRequests(index, highest);
+        index = highest;
+    }
+}
+
+void ResourceCacheSharedItems::swapPendingRequests(int first, int second) {
+    std::swap(_pendingRequests[first], _pendingRequests[second]);
+    _pendingRequestIndices[_pendingRequests[first].key] = first;
+    _pendingRequestIndices[_pendingRequests[second].key] = second;
+}
+
+void ResourceCacheSharedItems::refreshPendingRequestPriorities() {
+    for (auto key : _dirtyPendingRequests) {
+        auto it = _pendingRequestIndices.find(key);
+        if (it == _pendingRequestIndices.end()) {
+            continue;
+        }
+
+        int index = it.value();
+        auto resource = _pendingRequests[index].resource.lock();
+        if (!resource) {
+            continue;
+        }
+
+        float priority = resource->getLoadPriority();
+        if (priority != _pendingRequests[index].priority) {
+            _pendingRequests[index].priority = priority;
+            siftPendingRequestUp(index);
+            siftPendingRequestDown(_pendingRequestIndices[key]);
+        }
+    }
+    _dirtyPendingRequests.clear();
+}
+
+void ResourceCacheSharedItems::rekeyPendingRequests() {
+    // drop freed resources and recompute every priority, which also prunes destroyed owners
+    auto end = std::remove_if(_pendingRequests.begin(), _pendingRequests.end(), [](PendingRequest& request) {
+        auto resource = request.resource.lock();
+        if (!resource) {
+            return true;
+        }
+        request.priority = resource->getLoadPriority();
+        return false;
+    });
+    _pendingRequests.erase(end, _pendingRequests.end());
+
+    _pendingRequestIndices.clear();
+    for (int i = 0; i < (int)_pendingRequests.size(); i++) {
+        _pendingRequestIndices[_pendingRequests[i].key] = i;
+    }
+    for (int i = (int)_pendingRequests.size() / 2 - 1; i >= 0; i--) {
+        siftPendingRequestDown(i);
+    }
+    _dirtyPendingRequests.clear();
 }
 
 void ResourceCacheSharedItems::clear() {
     Lock lock(_mutex);
     _pendingRequests.clear();
+    _pendingRequestIndices.clear();
+    _dirtyPendingRequests.clear();
     _loadingRequests.clear();
 }
 
@@ -252,7 +395,17 @@ ScriptableResource* ResourceCache::prefetch(const QUrl& url, void* extra, size_t
     return result;
 }
 
+static const char* EVICTION_POLICY_ENV_VARIABLE = "VIRCADIA_RESOURCE_CACHE_EVICTION_POLICY";
+
 ResourceCache::ResourceCache(QObject* parent) : QObject(parent) {
+    auto evictionPolicy = ResourceEvictionPolicy::Type::LRU;
+    QString evictionPolicyName = qEnvironmentVariable(EVICTION_POLICY_ENV_VARIABLE);
+    if (!evictionPolicyName.isEmpty() && !ResourceEvictionPolicy::getTypeFromName(evictionPolicyName, evictionPolicy)) {
+        qCWarning(networking) << "Unknown resource cache eviction policy" << evictionPolicyName << "- expected one of"
+                              << ResourceEvictionPolicy::getTypeNames();
+    }
+    _unusedResourcesPolicy = ResourceEvictionPolicy::create(evictionPolicy);
+
     if (DependencyManager::isSet<NodeList>()) {
         auto nodeList = DependencyManager::get<NodeList>();
         auto& domainHandler = nodeList->getDomainHandler();
@@ -288,6 +441,7 @@ void ResourceCache::clearATPAssets() {
         for (auto& resource : _unusedResources.values()) {
             if (resource->getURL().scheme() == URL_SCHEME_ATP) {
                 _unusedResources.remove(resource->getLRUKey());
+                _unusedResourcesPolicy->remove(resource->getLRUKey());
                 _unusedResourcesSize -= resource->getBytes();
             }
         }
@@ -379,6 +533,15 @@ QSharedPointer<Resource> ResourceCache::getResource(const QUrl& url, const QUrl&
         removeUnusedResource(resource);
     }
 
+    {
+        QWriteLocker locker(&_unusedResourcesLock);
+        _unusedResourcesPolicy->recordAccess(getEvictionKey(url, extraHash));
+    }
+    if (ResourceCacheTrace::isRecording()) {
+        ResourceCacheTrace::record(ResourceCacheTrace::Event::Get, metaObject()->className(),
+                                   getEvictionKey(url, extraHash), resource ? resource->getBytes() : 0, url);
+    }
+
     if (!resource && (!url.isValid() || url.isEmpty()) && fallback.isValid()) {
         resource = getResource(fallback, QUrl(), extra, extraHash);
     }
@@ -409,7 +572,52 @@ void ResourceCache::setUnusedResourceCacheSize(qint64 unusedResourcesMaxSize) {
     resetUnusedResourceCounter();
 }
 
+void ResourceCache::setUnusedResourceEvictionPolicy(ResourceEvictionPolicy::Type type) {
+    QWriteLocker locker(&_unusedResourcesLock);
+    if (_unusedResourcesPolicy->getType() == type) {
+        return;
+    }
+
+    // the access history is lost, but the unused resources carry over, oldest first
+    _unusedResourcesPolicy = ResourceEvictionPolicy::create(type);
+    auto lruKeys = _unusedResources.keys();
+    std::sort(lruKeys.begin(), lruKeys.end());
+    for (auto lruKey : lruKeys) {
+        auto& resource = _unusedResources[lruKey];
+        _unusedResourcesPolicy->insert(lruKey, getEvictionKey(resource->getURL(), resource->getExtraHash()),
+                                       resource->getBytes(), ResourceEvictionPolicy::estimateReloadCost(
+                                           resource->getBytes(), resource->getURL().isLocalFile()));
+    }
+}
+
+ResourceEvictionPolicy::Type ResourceCache::getUnusedResourceEvictionPolicy() const {
+    QReadLocker locker(&_unusedResourcesLock);
+    return _unusedResourcesPolicy->getType();
+}
+
+uint64_t ResourceCache::getNumEvictedResources() const {
+    QReadLocker locker(&_unusedResourcesLock);
+    return _unusedResourcesPolicy->getEvictionCount();
+}
+
+void ResourceCache::enableArtifactCache(const std::string& dirname, size_t maxSize) {
+    _artifactCache = std::make_shared<cache::ContentCache>(dirname);
+    _artifactCache->initialize();
+    _artifactCache->setMaxSize(maxSize);
+    connect(_artifactCache.get(), &cache::FileCache::dirty, this, &ResourceCache::dirty);
+}
+
+uint64_t ResourceCache::getEvictionKey(const QUrl& url, size_t extraHash) {
+    return ((uint64_t)qHash(url) << 32) | (uint64_t)qHash((quint64)extraHash);
+}
+
 void ResourceCache::addUnusedResource(const QSharedPointer<Resource>& resource) {
+    if (ResourceCacheTrace::isRecording()) {
+        ResourceCacheTrace::record(ResourceCacheTrace::Event::Release, metaObject()->className(),
+                                   getEvictionKey(resource->getURL(), resource->getExtraHash()), resource->getBytes(),
+                                   resource->getURL());
+    }
+
     // If it doesn't fit or its size is unknown, remove it from the cache.
     if (resource->getBytes() == 0 || resource->getBytes() > _unusedResourcesMaxSize) {
         resource->setCache(nullptr);
@@ -417,16 +625,21 @@ void ResourceCache::addUnusedResource(const QSharedPointer<Resource>& resource)
         resetTotalResourceCounter();
         return;
     }
-    reserveUnusedResource(resource->getBytes());
 
     resource->setLRUKey(++_lastLRUKey);
 
     {
         QWriteLocker locker(&_unusedResourcesLock);
         _unusedResources.insert(resource->getLRUKey(), resource);
+        _unusedResourcesPolicy->insert(resource->getLRUKey(), getEvictionKey(resource->getURL(), resource->getExtraHash()),
+                                       resource->getBytes(), ResourceEvictionPolicy::estimateReloadCost(
+                                           resource->getBytes(), resource->getURL().isLocalFile()));
         _unusedResourcesSize += resource->getBytes();
     }
 
+    // make room after inserting, so the eviction policy can turn down the new resource itself
+    reserveUnusedResource(0);
+
     resetUnusedResourceCounter();
 }
 
@@ -434,6 +647,7 @@ void ResourceCache::removeUnusedResource(const QSharedPointer<Resource>& resourc
     QWriteLocker locker(&_unusedResourcesLock);
     if (_unusedResources.contains(resource->getLRUKey())) {
         _unusedResources.remove(resource->getLRUKey());
+        _unusedResourcesPolicy->remove(resource->getLRUKey());
         _unusedResourcesSize -= resource->getBytes();
 
         locker.unlock();
@@ -445,18 +659,18 @@ void ResourceCache::reserveUnusedResource(qint64 resourceSize) {
     QWriteLocker locker(&_unusedResourcesLock);
     while (!_unusedResources.empty() &&
            _unusedResourcesSize + resourceSize > _unusedResourcesMaxSize) {
-        // unload the oldest resource
-        QMap<int, QSharedPointer<Resource> >::iterator it = _unusedResources.begin();
+        // unload the resource picked by the eviction policy
+        int lruKey = _unusedResourcesPolicy->selectVictim();
+        _unusedResourcesPolicy->evict(lruKey);
+        QSharedPointer<Resource> resource = _unusedResources.take(lruKey);
 
-        it.value()->setCache(nullptr);
-        auto size = it.value()->getBytes();
+        resource->setCache(nullptr);
+        auto size = resource->getBytes();
+        _unusedResourcesSize -= size;
 
         locker.unlock();
-        removeResource(it.value()->getURL(), it.value()->getExtraHash(), size);
+        removeResource(resource->getURL(), resource->getExtraHash(), size);
         locker.relock();
-
-        _unusedResourcesSize -= size;
-        _unusedResources.erase(it);
     }
 }
 
@@ -470,6 +684,7 @@ void ResourceCache::clearUnusedResources() {
         }
         _unusedResources.clear();
     }
+    _unusedResourcesPolicy->clear();
     _unusedResourcesSize = 0;
 }
 
@@ -575,6 +790,7 @@ Resource::Resource(const Resource& other) :
     _bytesTotal(other._bytesTotal),
     _bytes(other._bytes),
     _requestID(++requestID),
+    _contentID(other._contentID),
     _extraHash(other._extraHash) {
     if (!other._loaded) {
         _startedLoading = false;
@@ -606,7 +822,11 @@ void Resource::ensureLoading() {
 
 void Resource::setLoadPriority(const QPointer<QObject>& owner, float priority) {
     if (!_failedToLoad) {
-        _loadPriorities.insert(owner, priority);
+        auto it = _loadPriorities.find(owner);
+        if (it == _loadPriorities.end() || it.value() != priority) {
+            _loadPriorities.insert(owner, priority);
+            loadPriorityChanged();
+        }
     }
 }
 
@@ -618,11 +838,31 @@ void Resource::setLoadPriorities(const QHash<QPointer<QObject>, float>& prioriti
             it != priorities.constEnd(); it++) {
         _loadPriorities.insert(it.key(), it.value());
     }
+    loadPriorityChanged();
 }
 
 void Resource::clearLoadPriority(const QPointer<QObject>& owner) {
-    if (!_failedToLoad) {
-        _loadPriorities.remove(owner);
+    if (!_failedToLoad && _loadPriorities.remove(owner) > 0) {
+        loadPriorityChanged();
+    }
+}
+
+cache::FileCache::Key Resource::getArtifactKey(const QByteArray& data, const QString& artifactType,
+                                               int artifactVersion) const {
+    QByteArray contentID = _contentID;
+    if (contentID.isEmpty()) {
+        contentID = AssetUtils::hashData(data).toHex();
+    }
+    return cache::ContentCache::makeKey(contentID, artifactType, artifactVersion);
+}
+
+void Resource::loadPriorityChanged() {
+    // only requests waiting in the pending queue care about their priority
+    if (_startedLoading && !_request && !_loaded) {
+        auto sharedItems = DependencyManager::get<ResourceCacheSharedItems>();
+        if (sharedItems) {
+            sharedItems->updateRequestPriority(_self);
+        }
     }
 }
 
@@ -814,6 +1054,8 @@ void Resource::handleReplyFinished() {
             _bytesTotal = data.length();
         }
 
+        _contentID = _request->getContentID();
+
         setSize(_bytesTotal);
         emit loaded(data);
         downloadFinished(data);
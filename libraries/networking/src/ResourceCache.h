@@ -14,6 +14,7 @@
 
 #include <atomic>
 #include <mutex>
+#include <vector>
 
 #include <QtCore/QHash>
 #include <QtCore/QList>
@@ -24,6 +25,7 @@
 #include <QtCore/QWeakPointer>
 #include <QtCore/QReadWriteLock>
 #include <QtCore/QQueue>
+#include <QtCore/QSet>
 
 #include <QtNetwork/QNetworkReply>
 #include <QtNetwork/QNetworkRequest>
@@ -31,7 +33,9 @@
 #include <QScriptEngine>
 
 #include <DependencyManager.h>
+#include <shared/ContentCache.h>
 
+#include "ResourceEvictionPolicy.h"
 #include "ResourceManager.h"
 
 Q_DECLARE_METATYPE(size_t)
@@ -77,11 +81,40 @@ public:
     uint32_t getLoadingRequestsCount() const;
     void clear();
 
+    /// Flags a pending request whose load priority changed. Priorities of flagged requests are recomputed together,
+    /// the next time the highest pending request is taken.
+    void updateRequestPriority(QWeakPointer<Resource> request);
+
 private:
     ResourceCacheSharedItems() = default;
 
+    // Entry of the pending request max-heap: file requests come first, then higher priorities,
+    // and requests appended later win ties.
+    struct PendingRequest {
+        QWeakPointer<Resource> resource;
+        Resource* key;
+        float priority;
+        bool isFile;
+        uint64_t sequenceNumber;
+
+        bool isHigherThan(const PendingRequest& other) const;
+    };
+
+    // these must be called with _mutex held
+    void pushPendingRequest(const QWeakPointer<Resource>& resource);
+    void removePendingRequestAt(int index);
+    void siftPendingRequestUp(int index);
+    void siftPendingRequestDown(int index);
+    void swapPendingRequests(int first, int second);
+    void refreshPendingRequestPriorities();
+    void rekeyPendingRequests();
+
     mutable Mutex _mutex;
-    QList<QWeakPointer<Resource>> _pendingRequests;
+    std::vector<PendingRequest> _pendingRequests;
+    QHash<Resource*, int> _pendingRequestIndices;
+    QSet<Resource*> _dirtyPendingRequests;
+    uint64_t _nextPendingSequenceNumber { 0 };
+    quint64 _lastPendingRequestsRekey { 0 };
     QList<QWeakPointer<Resource>> _loadingRequests;
     const uint32_t DEFAULT_REQUEST_LIMIT = 10;
     uint32_t _requestLimit { DEFAULT_REQUEST_LIMIT };
@@ -200,6 +233,10 @@ class ResourceCache : public QObject {
     Q_PROPERTY(size_t numCached READ getNumCachedResources NOTIFY dirty)
     Q_PROPERTY(size_t sizeTotal READ getSizeTotalResources NOTIFY dirty)
     Q_PROPERTY(size_t sizeCached READ getSizeCachedResources NOTIFY dirty)
+    Q_PROPERTY(size_t numArtifactHits READ getNumArtifactHits NOTIFY dirty)
+    Q_PROPERTY(size_t numArtifactMisses READ getNumArtifactMisses NOTIFY dirty)
+    Q_PROPERTY(size_t sizeArtifacts READ getSizeArtifacts NOTIFY dirty)
+    Q_PROPERTY(size_t maxSizeArtifacts READ getMaxSizeArtifacts NOTIFY dirty)
 
 public:
 
@@ -208,6 +245,14 @@ public:
     size_t getNumCachedResources() const { return _numUnusedResources; }
     size_t getSizeCachedResources() const { return _unusedResourcesSize; }
 
+    size_t getNumArtifactHits() const { return _artifactCache ? _artifactCache->getNumHits() : 0; }
+    size_t getNumArtifactMisses() const { return _artifactCache ? _artifactCache->getNumMisses() : 0; }
+    size_t getSizeArtifacts() const { return _artifactCache ? _artifactCache->getSizeTotalFiles() : 0; }
+    size_t getMaxSizeArtifacts() const { return _artifactCache ? _artifactCache->getMaxSize() : 0; }
+
+    /// The persistent store of processed resources, or null if this cache doesn't keep one.
+    std::shared_ptr<cache::ContentCache> getArtifactCache() const { return _artifactCache; }
+
     Q_INVOKABLE QVariantList getResourceList();
 
     static void setRequestLimit(uint32_t limit);
@@ -216,6 +261,11 @@ public:
     void setUnusedResourceCacheSize(qint64 unusedResourcesMaxSize);
     qint64 getUnusedResourceCacheSize() const { return _unusedResourcesMaxSize; }
 
+    /// Sets how unused resources are chosen for eviction once they exceed the unused resource cache size.
+    void setUnusedResourceEvictionPolicy(ResourceEvictionPolicy::Type type);
+    ResourceEvictionPolicy::Type getUnusedResourceEvictionPolicy() const;
+    uint64_t getNumEvictedResources() const;
+
     static QList<QSharedPointer<Resource>> getLoadingRequests();
     static uint32_t getPendingRequestCount();
     static uint32_t getLoadingRequestCount();
@@ -266,6 +316,10 @@ protected:
     void addUnusedResource(const QSharedPointer<Resource>& resource);
     void removeUnusedResource(const QSharedPointer<Resource>& resource);
 
+    /// Keeps processed resources on disk under dirname, using at most maxSize bytes, so that resources whose content
+    /// hasn't changed can be restored without processing them again. Must be called from the constructor.
+    void enableArtifactCache(const std::string& dirname, size_t maxSize);
+
     /// Attempt to load a resource if requests are below the limit, otherwise queue the resource for loading
     /// \return true if the resource began loading, otherwise false if the resource is in the pending queue
     static bool attemptRequest(QSharedPointer<Resource> resource);
@@ -283,6 +337,9 @@ private:
     void resetUnusedResourceCounter();
     void resetResourceCounters();
 
+    // Identifies a resource across loads, for the eviction policy's access history and for traces
+    static uint64_t getEvictionKey(const QUrl& url, size_t extraHash);
+
     // Resources
     QHash<QUrl, QMultiHash<size_t, QWeakPointer<Resource>>> _resources;
     QReadWriteLock _resourcesLock { QReadWriteLock::Recursive };
@@ -292,12 +349,15 @@ private:
     std::atomic<qint64> _totalResourcesSize { 0 };
 
     // Cached resources
-    QMap<int, QSharedPointer<Resource>> _unusedResources;
-    QReadWriteLock _unusedResourcesLock { QReadWriteLock::Recursive };
+    QHash<int, QSharedPointer<Resource>> _unusedResources;
+    mutable QReadWriteLock _unusedResourcesLock { QReadWriteLock::Recursive };
     qint64 _unusedResourcesMaxSize = DEFAULT_UNUSED_MAX_SIZE;
+    ResourceEvictionPolicy::Pointer _unusedResourcesPolicy;
 
     std::atomic<size_t> _numUnusedResources { 0 };
     std::atomic<qint64> _unusedResourcesSize { 0 };
+
+    std::shared_ptr<cache::ContentCache> _artifactCache;
 };
 
 /// Wrapper to expose resource caches to JS/QML
@@ -312,11 +372,22 @@ class ScriptableResourceCache : public QObject {
      * @property {number} numCached - Total number of cached resource. <em>Read-only.</em>
      * @property {number} sizeTotal - Size in bytes of all resources. <em>Read-only.</em>
      * @property {number} sizeCached - Size in bytes of all cached resources. <em>Read-only.</em>
+     * @property {number} numArtifactHits - Number of resources restored from the disk cache of processed resources.
+     *     <em>Read-only.</em>
+     * @property {number} numArtifactMisses - Number of resources not found in the disk cache of processed resources.
+     *     <em>Read-only.</em>
+     * @property {number} sizeArtifacts - Size in bytes of the disk cache of processed resources. <em>Read-only.</em>
+     * @property {number} maxSizeArtifacts - Maximum size in bytes of the disk cache of processed resources, or
+     *     <code>0</code> if the cache doesn't keep processed resources on disk. <em>Read-only.</em>
      */
     Q_PROPERTY(size_t numTotal READ getNumTotalResources NOTIFY dirty)
     Q_PROPERTY(size_t numCached READ getNumCachedResources NOTIFY dirty)
     Q_PROPERTY(size_t sizeTotal READ getSizeTotalResources NOTIFY dirty)
     Q_PROPERTY(size_t sizeCached READ getSizeCachedResources NOTIFY dirty)
+    Q_PROPERTY(size_t numArtifactHits READ getNumArtifactHits NOTIFY dirty)
+    Q_PROPERTY(size_t numArtifactMisses READ getNumArtifactMisses NOTIFY dirty)
+    Q_PROPERTY(size_t sizeArtifacts READ getSizeArtifacts NOTIFY dirty)
+    Q_PROPERTY(size_t maxSizeArtifacts READ getMaxSizeArtifacts NOTIFY dirty)
 
     /*@jsdoc
      * @property {number} numGlobalQueriesPending - Total number of global queries pending (across all resource cache managers).
@@ -400,6 +471,10 @@ private:
     size_t getSizeTotalResources() const { return _resourceCache->getSizeTotalResources(); }
     size_t getNumCachedResources() const { return _resourceCache->getNumCachedResources(); }
     size_t getSizeCachedResources() const { return _resourceCache->getSizeCachedResources(); }
+    size_t getNumArtifactHits() const { return _resourceCache->getNumArtifactHits(); }
+    size_t getNumArtifactMisses() const { return _resourceCache->getNumArtifactMisses(); }
+    size_t getSizeArtifacts() const { return _resourceCache->getSizeArtifacts(); }
+    size_t getMaxSizeArtifacts() const { return _resourceCache->getMaxSizeArtifacts(); }
 
     size_t getNumGlobalQueriesPending() const { return ResourceCache::getPendingRequestCount(); }
     size_t getNumGlobalQueriesLoading() const { return ResourceCache::getLoadingRequestCount(); }
@@ -460,6 +535,10 @@ public:
 
     void setCache(ResourceCache* cache) { _cache = cache; }
 
+    /// Returns the artifact cache key for an artifact processed from data, the content of this resource.
+    /// The content is identified by its ATP hash or ETag when the request provided one, otherwise by hashing the data.
+    cache::FileCache::Key getArtifactKey(const QByteArray& data, const QString& artifactType, int artifactVersion) const;
+
     virtual void deleter() { allReferencesCleared(); }
 
     const QUrl& getURL() const { return _url; }
@@ -524,6 +603,9 @@ protected:
     /// Return true if the resource will be retried
     virtual bool handleFailedRequest(ResourceRequest::Result result);
 
+    /// Lets the pending request queue know that the result of getLoadPriority may have changed.
+    void loadPriorityChanged();
+
     QUrl _url;
     QUrl _effectiveBaseURL { _url };
     QUrl _activeUrl;
@@ -547,6 +629,7 @@ protected:
 
     int _requestID;
     ResourceRequest* _request { nullptr };
+    QByteArray _contentID;
 
     size_t _extraHash { std::numeric_limits<size_t>::max() };
 
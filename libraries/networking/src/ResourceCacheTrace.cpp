@@ -0,0 +1,182 @@
+//
+//  ResourceCacheTrace.cpp
+//  libraries/networking/src
+//
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ResourceCacheTrace.h"
+
+#include <mutex>
+
+#include <QtCore/QDateTime>
+#include <QtCore/QFile>
+#include <QtCore/QHash>
+
+#include "NetworkLogging.h"
+
+static const char* TRACE_FILE_ENV_VARIABLE = "VIRCADIA_RESOURCE_CACHE_TRACE";
+
+static const char* GET_EVENT_NAME = "get";
+static const char* RELEASE_EVENT_NAME = "release";
+
+namespace {
+
+struct TraceFile {
+    TraceFile() {
+        QString path = qEnvironmentVariable(TRACE_FILE_ENV_VARIABLE);
+        if (!path.isEmpty()) {
+            file.setFileName(path);
+            if (!file.open(QIODevice::WriteOnly | QIODevice::Append)) {
+                qCWarning(networking) << "Could not open resource cache trace" << path << file.errorString();
+            }
+        }
+    }
+
+    std::mutex mutex;
+    QFile file;
+};
+
+TraceFile& getTraceFile() {
+    static TraceFile traceFile;
+    return traceFile;
+}
+
+bool isLocalURL(const QString& url) {
+    return url.startsWith("file:") || url.startsWith("qrc:");
+}
+
+}
+
+bool ResourceCacheTrace::isRecording() {
+    return getTraceFile().file.isOpen();
+}
+
+void ResourceCacheTrace::record(Event::Type type, const QString& cache, uint64_t key, qint64 bytes, const QUrl& url) {
+    auto& traceFile = getTraceFile();
+    if (!traceFile.file.isOpen()) {
+        return;
+    }
+
+    QByteArray line = QByteArray::number(QDateTime::currentMSecsSinceEpoch()) + ' ' + cache.toUtf8() + ' ' +
+        (type == Event::Get ? GET_EVENT_NAME : RELEASE_EVENT_NAME) + ' ' + QByteArray::number((qulonglong)key, 16) + ' ' +
+        QByteArray::number(bytes) + ' ' + url.toEncoded() + '\n';
+
+    std::lock_guard<std::mutex> lock(traceFile.mutex);
+    traceFile.file.write(line);
+}
+
+bool ResourceCacheTrace::read(QIODevice& device, std::vector<Event>& events) {
+    if (!device.isOpen() && !device.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    const int NUM_FIELDS = 6;
+    while (!device.atEnd()) {
+        auto fields = device.readLine().trimmed().split(' ');
+        if (fields.size() < NUM_FIELDS) {
+            continue;
+        }
+
+        Event event;
+        if (fields[2] == GET_EVENT_NAME) {
+            event.type = Event::Get;
+        } else if (fields[2] == RELEASE_EVENT_NAME) {
+            event.type = Event::Release;
+        } else {
+            continue;
+        }
+
+        bool keyValid = false;
+        bool bytesValid = false;
+        event.cache = QString::fromUtf8(fields[1]);
+        event.key = fields[3].toULongLong(&keyValid, 16);
+        event.bytes = fields[4].toLongLong(&bytesValid);
+        event.isLocal = isLocalURL(QString::fromUtf8(fields[5]));
+        if (keyValid && bytesValid) {
+            events.push_back(event);
+        }
+    }
+    return true;
+}
+
+ResourceCacheTrace::SimulationResult ResourceCacheTrace::simulate(const std::vector<Event>& events,
+                                                                  ResourceEvictionPolicy::Type policyType,
+                                                                  qint64 capacity, const QString& cache) {
+    struct ResourceState {
+        bool inUse { false };
+        bool seen { false };
+        int unusedID { -1 };
+        qint64 bytes { 0 };
+    };
+
+    SimulationResult result;
+    result.policy = policyType;
+    result.capacity = capacity;
+
+    auto policy = ResourceEvictionPolicy::create(policyType);
+    QHash<uint64_t, ResourceState> states;
+    QHash<int, uint64_t> unusedKeys;
+    qint64 unusedSize = 0;
+    int nextUnusedID = 0;
+
+    for (const auto& event : events) {
+        if (!cache.isEmpty() && event.cache != cache) {
+            continue;
+        }
+
+        auto& state = states[event.key];
+        if (event.type == Event::Get) {
+            policy->recordAccess(event.key);
+            if (state.inUse) {
+                result.sharedRequests++;
+                continue;
+            }
+
+            result.requests++;
+            if (state.unusedID >= 0) {
+                result.hits++;
+                policy->remove(state.unusedID);
+                unusedKeys.remove(state.unusedID);
+                unusedSize -= state.bytes;
+                state.unusedID = -1;
+            } else if (!state.seen) {
+                result.compulsoryMisses++;
+            } else {
+                result.bytesRefetched += state.bytes;
+            }
+            state.inUse = true;
+            state.seen = true;
+        } else {
+            state.inUse = false;
+            state.seen = true;
+            if (event.bytes > 0) {
+                state.bytes = event.bytes;
+            }
+            if (state.bytes == 0 || state.bytes > capacity || state.unusedID >= 0) {
+                continue;
+            }
+
+            state.unusedID = nextUnusedID++;
+            unusedKeys[state.unusedID] = event.key;
+            unusedSize += state.bytes;
+            policy->insert(state.unusedID, event.key, state.bytes,
+                           ResourceEvictionPolicy::estimateReloadCost(state.bytes, event.isLocal));
+
+            // the policy may reject the released resource itself
+            while (!policy->isEmpty() && unusedSize > capacity) {
+                int victim = policy->selectVictim();
+                auto& victimState = states.find(unusedKeys.take(victim)).value();
+                unusedSize -= victimState.bytes;
+                victimState.unusedID = -1;
+                policy->evict(victim);
+                result.evictions++;
+            }
+        }
+    }
+
+    return result;
+}
@@ -0,0 +1,70 @@
+//
+//  ResourceCacheTrace.h
+//  libraries/networking/src
+//
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_ResourceCacheTrace_h
+#define hifi_ResourceCacheTrace_h
+
+#include <cstdint>
+#include <vector>
+
+#include <QtCore/QString>
+#include <QtCore/QUrl>
+
+#include "ResourceEvictionPolicy.h"
+
+class QIODevice;
+
+// Records the getResource / release sequence of every ResourceCache, so that eviction policies can be compared
+// offline by replaying it. Recording is enabled by pointing the VIRCADIA_RESOURCE_CACHE_TRACE environment variable
+// at the file to write.
+//
+// Each line of a trace is: <msecs since epoch> <cache> <get|release> <key> <bytes> <url>
+namespace ResourceCacheTrace {
+
+    struct Event {
+        enum Type {
+            Get,
+            Release
+        };
+
+        Type type;
+        QString cache;
+        uint64_t key;
+        qint64 bytes;
+        bool isLocal;
+    };
+
+    bool isRecording();
+    void record(Event::Type type, const QString& cache, uint64_t key, qint64 bytes, const QUrl& url);
+
+    /// Parses a recorded trace, skipping malformed lines. Returns false if the device can't be read.
+    bool read(QIODevice& device, std::vector<Event>& events);
+
+    struct SimulationResult {
+        ResourceEvictionPolicy::Type policy;
+        qint64 capacity { 0 };
+
+        uint64_t requests { 0 };            // requests for resources that were not in use
+        uint64_t hits { 0 };                // requests served from the unused resources
+        uint64_t compulsoryMisses { 0 };    // first requests, which no policy can serve
+        uint64_t sharedRequests { 0 };      // requests for resources that were still in use
+        uint64_t evictions { 0 };
+        qint64 bytesRefetched { 0 };        // bytes loaded again for resources that had been evicted
+
+        float getHitRatio() const { return requests > 0 ? (float)hits / (float)requests : 0.0f; }
+    };
+
+    /// Replays the events of one cache (or of all of them if cache is empty) against an unused resource cache
+    /// of the given byte budget, as ResourceCache would manage it.
+    SimulationResult simulate(const std::vector<Event>& events, ResourceEvictionPolicy::Type policy, qint64 capacity,
+                              const QString& cache = QString());
+}
+
+#endif // hifi_ResourceCacheTrace_h
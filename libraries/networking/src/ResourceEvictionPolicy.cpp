@@ -0,0 +1,279 @@
+//
+//  ResourceEvictionPolicy.cpp
+//  libraries/networking/src
+//
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ResourceEvictionPolicy.h"
+
+#include <algorithm>
+#include <limits>
+#include <list>
+#include <set>
+
+ResourceFrequencySketch::ResourceFrequencySketch() :
+    _counters(DEPTH * WIDTH, 0),
+    _sampleSize(10 * WIDTH)
+{
+}
+
+int ResourceFrequencySketch::indexOf(uint64_t key, int row) const {
+    static const uint64_t SEEDS[DEPTH] = {
+        0x9E3779B97F4A7C15ULL, 0xC2B2AE3D27D4EB4FULL, 0x165667B19E3779F9ULL, 0xD6E8FEB86659FD93ULL
+    };
+    uint64_t hash = (key + SEEDS[row]) * SEEDS[(row + 1) % DEPTH];
+    hash ^= hash >> 32;
+    return row * WIDTH + (int)(hash % WIDTH);
+}
+
+void ResourceFrequencySketch::increment(uint64_t key) {
+    const uint8_t MAX_COUNT = 15;
+    for (int row = 0; row < DEPTH; row++) {
+        auto& counter = _counters[indexOf(key, row)];
+        if (counter < MAX_COUNT) {
+            counter++;
+        }
+    }
+    if (++_additions >= _sampleSize) {
+        age();
+    }
+}
+
+int ResourceFrequencySketch::estimate(uint64_t key) const {
+    int result = std::numeric_limits<int>::max();
+    for (int row = 0; row < DEPTH; row++) {
+        result = std::min(result, (int)_counters[indexOf(key, row)]);
+    }
+    return result;
+}
+
+void ResourceFrequencySketch::age() {
+    for (auto& counter : _counters) {
+        counter >>= 1;
+    }
+    _additions /= 2;
+}
+
+void ResourceFrequencySketch::clear() {
+    std::fill(_counters.begin(), _counters.end(), 0);
+    _additions = 0;
+}
+
+namespace {
+
+class LRUEvictionPolicy : public ResourceEvictionPolicy {
+public:
+    Type getType() const override { return Type::LRU; }
+
+protected:
+    void onInsert(int id, const Entry& entry) override {
+        _order.push_front(id);
+        _positions[id] = _order.begin();
+    }
+
+    void onRemove(int id, const Entry& entry) override {
+        auto it = _positions.find(id);
+        _order.erase(it.value());
+        _positions.erase(it);
+    }
+
+    int chooseVictim() override { return _order.back(); }
+
+    void onClear() override {
+        _order.clear();
+        _positions.clear();
+    }
+
+private:
+    // most recently released first
+    std::list<int> _order;
+    QHash<int, std::list<int>::iterator> _positions;
+};
+
+class GDSFEvictionPolicy : public ResourceEvictionPolicy {
+public:
+    Type getType() const override { return Type::GDSF; }
+
+protected:
+    void onInsert(int id, const Entry& entry) override {
+        // H = L + frequency * cost / size, where L is the value of the last victim, so that entries which are not
+        // requested again age out relative to newer ones
+        double value = (double)(1 + getFrequency(entry.key)) * entry.cost / (double)std::max(entry.size, (qint64)1);
+        double priority = _inflation + value;
+        _queue.emplace(priority, id);
+        _priorities[id] = priority;
+    }
+
+    void onRemove(int id, const Entry& entry) override {
+        auto it = _priorities.find(id);
+        _queue.erase({ it.value(), id });
+        _priorities.erase(it);
+    }
+
+    int chooseVictim() override {
+        auto victim = _queue.begin();
+        _inflation = victim->first;
+        return victim->second;
+    }
+
+    void onClear() override {
+        _queue.clear();
+        _priorities.clear();
+    }
+
+private:
+    std::set<std::pair<double, int>> _queue;
+    QHash<int, double> _priorities;
+    double _inflation { 0.0 };
+};
+
+class TinyLFUEvictionPolicy : public ResourceEvictionPolicy {
+public:
+    Type getType() const override { return Type::TinyLFU; }
+
+protected:
+    void onInsert(int id, const Entry& entry) override {
+        _order.push_front(id);
+        _positions[id] = _order.begin();
+        _candidate = id;
+    }
+
+    void onRemove(int id, const Entry& entry) override {
+        auto it = _positions.find(id);
+        _order.erase(it.value());
+        _positions.erase(it);
+        if (_candidate == id) {
+            _candidate = -1;
+        }
+    }
+
+    int chooseVictim() override {
+        int victim = _order.back();
+        if (_candidate < 0 || _candidate == victim) {
+            return victim;
+        }
+
+        // the entry that pushed the cache over its budget is only admitted if it is requested more often than
+        // the entry it would displace, or if it was evicted recently and came back
+        int candidate = _candidate;
+        _candidate = -1;
+        uint64_t candidateKey = getEntry(candidate).key;
+        if (wasRecentlyEvicted(candidateKey) || getFrequency(candidateKey) > getFrequency(getEntry(victim).key)) {
+            return victim;
+        }
+        return candidate;
+    }
+
+    void onClear() override {
+        _order.clear();
+        _positions.clear();
+        _candidate = -1;
+    }
+
+private:
+    // most recently released first
+    std::list<int> _order;
+    QHash<int, std::list<int>::iterator> _positions;
+
+    // most recent entry, until it has been admitted
+    int _candidate { -1 };
+};
+
+}
+
+ResourceEvictionPolicy::Pointer ResourceEvictionPolicy::create(Type type) {
+    Pointer policy;
+    switch (type) {
+        case Type::GDSF:
+            policy.reset(new GDSFEvictionPolicy());
+            break;
+        case Type::TinyLFU:
+            policy.reset(new TinyLFUEvictionPolicy());
+            break;
+        case Type::LRU:
+        default:
+            policy.reset(new LRUEvictionPolicy());
+            break;
+    }
+    return policy;
+}
+
+QString ResourceEvictionPolicy::getTypeName(Type type) {
+    switch (type) {
+        case Type::GDSF:
+            return "gdsf";
+        case Type::TinyLFU:
+            return "tinylfu";
+        case Type::LRU:
+        default:
+            return "lru";
+    }
+}
+
+bool ResourceEvictionPolicy::getTypeFromName(const QString& name, Type& type) {
+    for (auto candidate : { Type::LRU, Type::GDSF, Type::TinyLFU }) {
+        if (name.compare(getTypeName(candidate), Qt::CaseInsensitive) == 0) {
+            type = candidate;
+            return true;
+        }
+    }
+    return false;
+}
+
+QStringList ResourceEvictionPolicy::getTypeNames() {
+    return { getTypeName(Type::LRU), getTypeName(Type::GDSF), getTypeName(Type::TinyLFU) };
+}
+
+float ResourceEvictionPolicy::estimateReloadCost(qint64 size, bool isLocal) {
+    // a round trip costs 1, and every BYTES_PER_ROUND_TRIP transferred costs as much again;
+    // local files are an order of magnitude cheaper to reload than network resources
+    const float BYTES_PER_ROUND_TRIP = 256.0f * 1024.0f;
+    const float LOCAL_COST_SCALE = 0.1f;
+    float cost = 1.0f + (float)size / BYTES_PER_ROUND_TRIP;
+    return isLocal ? cost * LOCAL_COST_SCALE : cost;
+}
+
+void ResourceEvictionPolicy::insert(int id, uint64_t key, qint64 size, float cost) {
+    remove(id);
+    Entry entry { key, size, cost };
+    _entries.insert(id, entry);
+    onInsert(id, entry);
+}
+
+void ResourceEvictionPolicy::remove(int id) {
+    auto it = _entries.find(id);
+    if (it != _entries.end()) {
+        onRemove(id, it.value());
+        _entries.erase(it);
+    }
+}
+
+void ResourceEvictionPolicy::evict(int id) {
+    auto it = _entries.find(id);
+    if (it == _entries.end()) {
+        return;
+    }
+
+    uint64_t key = it.value().key;
+    remove(id);
+    _evictionCount++;
+
+    _ghosts[key]++;
+    _ghostOrder.push_back(key);
+    if ((int)_ghostOrder.size() > MAX_GHOSTS) {
+        auto ghost = _ghosts.find(_ghostOrder.front());
+        if (--ghost.value() == 0) {
+            _ghosts.erase(ghost);
+        }
+        _ghostOrder.pop_front();
+    }
+}
+
+void ResourceEvictionPolicy::clear() {
+    _entries.clear();
+    onClear();
+}
@@ -0,0 +1,121 @@
+//
+//  ResourceEvictionPolicy.h
+//  libraries/networking/src
+//
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_ResourceEvictionPolicy_h
+#define hifi_ResourceEvictionPolicy_h
+
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <vector>
+
+#include <QtCore/QHash>
+#include <QtCore/QString>
+#include <QtCore/QStringList>
+
+// Approximate access counts for a large key space in a fixed amount of memory (4-bit count-min sketch).
+// Counts are halved periodically so that the history favours recent popularity.
+class ResourceFrequencySketch {
+public:
+    ResourceFrequencySketch();
+
+    void increment(uint64_t key);
+    int estimate(uint64_t key) const;
+    void clear();
+
+private:
+    int indexOf(uint64_t key, int row) const;
+    void age();
+
+    static const int DEPTH = 4;
+    static const int WIDTH = 4096;
+
+    std::vector<uint8_t> _counters;
+    int _additions { 0 };
+    int _sampleSize;
+};
+
+// Decides which unused resource a ResourceCache evicts when it goes over its byte budget.
+//
+// Entries are identified by an id that is unique while the entry is tracked, and carry a key that is stable for
+// a given resource across loads, so access history survives a resource being evicted and requested again.
+class ResourceEvictionPolicy {
+public:
+    enum class Type {
+        LRU,        // least recently released first
+        GDSF,       // greedy dual size frequency: keeps small, popular and expensive to reload resources
+        TinyLFU     // LRU with a frequency based admission filter, which lets recently evicted resources back in
+    };
+
+    using Pointer = std::unique_ptr<ResourceEvictionPolicy>;
+
+    static Pointer create(Type type);
+    static QString getTypeName(Type type);
+    static bool getTypeFromName(const QString& name, Type& type);
+    static QStringList getTypeNames();
+
+    /// Estimates what reloading a resource costs, in units of one network round trip.
+    static float estimateReloadCost(qint64 size, bool isLocal);
+
+    virtual ~ResourceEvictionPolicy() = default;
+
+    virtual Type getType() const = 0;
+
+    /// Called for every request of a resource, cached or not.
+    void recordAccess(uint64_t key) { _sketch.increment(key); }
+
+    void insert(int id, uint64_t key, qint64 size, float cost);
+    void remove(int id);
+
+    /// Returns the id of the entry that should be evicted next, which may be the entry that was just inserted.
+    /// Must not be called when empty.
+    int selectVictim() { return chooseVictim(); }
+
+    /// Removes an entry that was chosen as a victim, remembering it in the ghost history.
+    void evict(int id);
+
+    bool contains(int id) const { return _entries.contains(id); }
+    bool isEmpty() const { return _entries.isEmpty(); }
+
+    /// Forgets all entries, but keeps the access history.
+    void clear();
+
+    uint64_t getEvictionCount() const { return _evictionCount; }
+
+protected:
+    struct Entry {
+        uint64_t key;
+        qint64 size;
+        float cost;
+    };
+
+    virtual void onInsert(int id, const Entry& entry) = 0;
+    virtual void onRemove(int id, const Entry& entry) = 0;
+    virtual int chooseVictim() = 0;
+    virtual void onClear() = 0;
+
+    const Entry& getEntry(int id) const { return _entries.find(id).value(); }
+    int getFrequency(uint64_t key) const { return _sketch.estimate(key); }
+    bool wasRecentlyEvicted(uint64_t key) const { return _ghosts.contains(key); }
+
+private:
+    static const int MAX_GHOSTS = 4096;
+
+    QHash<int, Entry> _entries;
+    ResourceFrequencySketch _sketch;
+
+    // keys of recently evicted entries, oldest first
+    QHash<uint64_t, int> _ghosts;
+    std::deque<uint64_t> _ghostOrder;
+
+    uint64_t _evictionCount { 0 };
+};
+
+#endif // hifi_ResourceEvictionPolicy_h
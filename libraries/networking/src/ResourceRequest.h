@@ -85,6 +85,8 @@ public:
     bool getRangeRequestSuccessful() const { return _rangeRequestSuccessful; }
     bool getTotalSizeOfResource() const { return _totalSizeOfResource; }
     QString getWebMediaType() const { return _webMediaType; }
+    // Identifies the exact content that was received (an ATP hash or an HTTP ETag), or is empty if it isn't known
+    QByteArray getContentID() const { return _contentID; }
     void setFailOnRedirect(bool failOnRedirect) { _failOnRedirect = failOnRedirect; }
 
     void setCacheEnabled(bool value) { _cacheEnabled = value; }
@@ -114,6 +116,7 @@ protected:
     bool _rangeRequestSuccessful { false };
     uint64_t _totalSizeOfResource { 0 };
     QString _webMediaType;
+    QByteArray _contentID;
     int64_t _lastRecordedBytesDownloaded { 0 };
     bool _isObservable;
     qint64 _callerId;
@@ -169,6 +169,14 @@ SequenceNumberStats::ArrivalInfo SequenceNumberStats::sequenceNumberReceived(qui
     return arrivalInfo;
 }
 
+bool SequenceNumberStats::isOnTime(quint16 incoming, NetworkLocalID senderID) const {
+    // a new sender resets the stats, and the first sequence number received is always on time
+    if (senderID != _lastSenderID || _stats._received == 0) {
+        return true;
+    }
+    return incoming == (quint16)(_lastReceivedSequence + (quint16)1);
+}
+
 void SequenceNumberStats::receivedUnreasonable(quint16 incoming) {
 
     const int CONSECUTIVE_UNREASONABLE_ON_TIME_THRESHOLD = 8;
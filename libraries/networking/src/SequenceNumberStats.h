@@ -74,6 +74,8 @@ public:
 
     void reset();
     ArrivalInfo sequenceNumberReceived(quint16 incoming, NetworkLocalID senderID = NULL_LOCAL_ID, const bool wantExtraDebugging = false);
+    // whether sequenceNumberReceived would find this sequence number on time
+    bool isOnTime(quint16 incoming, NetworkLocalID senderID = NULL_LOCAL_ID) const;
     void pruneMissingSet(const bool wantExtraDebugging = false);
     void pushStatsToHistory() { _statsHistory.insert(_stats); }
 
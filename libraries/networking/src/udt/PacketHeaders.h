@@ -374,7 +374,8 @@ enum class DomainConnectRequestVersion : PacketVersion {
 
 enum class DomainListRequestVersion : PacketVersion {
     PreSocketTypes = 22,
-    SocketTypes
+    SocketTypes,
+    HasDomainListVersion
 };
 
 enum class DomainConnectionDeniedVersion : PacketVersion {
@@ -397,7 +398,8 @@ enum class DomainListVersion : PacketVersion {
     AuthenticationOptional,
     HasTimestamp,
     HasConnectReason,
-    SocketTypes
+    SocketTypes,
+    DeltaUpdates
 };
 
 enum class AudioVersion : PacketVersion {
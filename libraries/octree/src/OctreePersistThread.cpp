@@ -110,13 +110,11 @@ void OctreePersistThread::handleOctreeDataFileReply(QSharedPointer<ReceivedMessa
 
     bool includesNewData;
     message->readPrimitive(&includesNewData);
-    QByteArray replacementData;
     OctreeUtils::RawOctreeData data;
     bool hasValidOctreeData { false };
     if (includesNewData) {
         _cachedJSONData.clear();
-        replacementData = message->readAll();
-        replaceData(replacementData);
+        replaceData(*message);
         hasValidOctreeData = data.readOctreeDataInfoFromFile(_filename);
         qDebug() << "Got OctreeDataFileReply, new data sent";
     } else {
@@ -192,7 +190,7 @@ void OctreePersistThread::handleOctreeDataFileReply(QSharedPointer<ReceivedMessa
     // Since we just loaded the persistent file, we can consider ourselves as having just persisted
     _lastPersistCheck = std::chrono::steady_clock::now();
 
-    if (replacementData.isNull()) {
+    if (!includesNewData) {
         sendLatestEntityDataToDS();
     }
 
@@ -211,12 +209,19 @@ QString OctreePersistThread::getPersistFileMimeType() const {
     return "";
 }
 
-void OctreePersistThread::replaceData(QByteArray data) {
+void OctreePersistThread::replaceData(ReceivedMessage& message) {
     backupCurrentFile();
 
     QFile currentFile { _filename };
     if (currentFile.open(QIODevice::WriteOnly)) {
-        currentFile.write(data);
+        // write the replacement data straight from the received packets, without assembling it in memory first
+        while (message.getBytesLeftToRead() > 0) {
+            auto chunk = message.readChunkWithoutCopy();
+            if (chunk.isEmpty()) {
+                break;
+            }
+            currentFile.write(chunk);
+        }
         qDebug() << "Wrote replacement data";
     } else {
         qWarning() << "Failed to write replacement data";
@@ -63,7 +63,7 @@ protected:
     bool backupCurrentFile();
     void cleanupOldReplacementBackups();
 
-    void replaceData(QByteArray data);
+    void replaceData(ReceivedMessage& message);
     void sendLatestEntityDataToDS();
 
 private:
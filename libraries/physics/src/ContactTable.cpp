@@ -0,0 +1,107 @@
+//
+//  ContactTable.cpp
+//  libraries/physics/src
+//
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ContactTable.h"
+
+#include <assert.h>
+
+static const int MIN_CONTACT_TABLE_CAPACITY = 256;
+
+ContactTable::ContactTable() {
+    rebuild(MIN_CONTACT_TABLE_CAPACITY);
+}
+
+uint32_t ContactTable::hash(void* a, void* b) {
+    uint64_t hashA = (uint64_t)(uintptr_t)a * 0x9E3779B97F4A7C15ULL;
+    uint64_t hashB = (uint64_t)(uintptr_t)b * 0xC2B2AE3D27D4EB4FULL;
+    uint64_t result = hashA ^ (hashB + (hashA >> 29));
+    return (uint32_t)(result ^ (result >> 32));
+}
+
+ContactInfo& ContactTable::operator[](const ContactKey& key) {
+    uint32_t index = hash(key._a, key._b) & _mask;
+    Slot* firstRemoved = nullptr;
+    while (_slots[index].state != SlotState::Empty) {
+        Slot& slot = _slots[index];
+        if (slot.state == SlotState::Occupied) {
+            if (slot.a == key._a && slot.b == key._b) {
+                return slot.info;
+            }
+        } else if (!firstRemoved) {
+            firstRemoved = &slot;
+        }
+        index = (index + 1) & _mask;
+    }
+
+    Slot* slot = firstRemoved;
+    if (slot) {
+        --_numRemoved;
+    } else {
+        // keep a quarter of the slots empty, so that probes stay short
+        int capacity = getCapacity();
+        if (4 * (_numEntries + _numRemoved + 1) > 3 * capacity) {
+            rebuild(2 * (_numEntries + 1) > capacity ? 2 * capacity : capacity);
+            return (*this)[key];
+        }
+        slot = &_slots[index];
+    }
+    slot->a = key._a;
+    slot->b = key._b;
+    slot->info = ContactInfo();
+    slot->state = SlotState::Occupied;
+    ++_numEntries;
+    return slot->info;
+}
+
+void ContactTable::clear() {
+    for (auto& slot : _slots) {
+        slot.state = SlotState::Empty;
+    }
+    _numEntries = 0;
+    _numRemoved = 0;
+}
+
+void ContactTable::afterRemoving() {
+    if (_numEntries == 0) {
+        clear();
+    } else if (4 * _numRemoved > getCapacity()) {
+        rebuild(getCapacity());
+    }
+}
+
+void ContactTable::rebuild(int capacity) {
+    assert((capacity & (capacity - 1)) == 0);
+    if ((int)_spareSlots.size() != capacity) {
+        _spareSlots.assign(capacity, Slot());
+    } else {
+        for (auto& slot : _spareSlots) {
+            slot.state = SlotState::Empty;
+        }
+    }
+
+    uint32_t mask = (uint32_t)capacity - 1;
+    for (auto& slot : _slots) {
+        if (slot.state == SlotState::Occupied) {
+            uint32_t index = hash(slot.a, slot.b) & mask;
+            while (_spareSlots[index].state != SlotState::Empty) {
+                index = (index + 1) & mask;
+            }
+            _spareSlots[index] = slot;
+        }
+    }
+
+    // the old slots become the spare storage, at the new size so that rebuilding again doesn't allocate
+    _slots.swap(_spareSlots);
+    if ((int)_spareSlots.size() != capacity) {
+        _spareSlots.resize(capacity);
+    }
+    _mask = mask;
+    _numRemoved = 0;
+}
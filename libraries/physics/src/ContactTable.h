@@ -0,0 +1,91 @@
+//
+//  ContactTable.h
+//  libraries/physics/src
+//
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_ContactTable_h
+#define hifi_ContactTable_h
+
+#include <stdint.h>
+#include <vector>
+
+#include "ContactInfo.h"
+
+// simple class for keeping track of contacts
+class ContactKey {
+public:
+    ContactKey() = delete;
+    ContactKey(void* a, void* b) : _a(a), _b(b) {}
+    bool operator<(const ContactKey& other) const { return _a < other._a || (_a == other._a && _b < other._b); }
+    bool operator==(const ContactKey& other) const { return _a == other._a && _b == other._b; }
+    void* _a; // ObjectMotionState pointer
+    void* _b; // ObjectMotionState pointer
+};
+
+// Flat hash table of the contacts between pairs of objects, with open addressing and linear probing.
+//
+// Removed entries are left behind as tombstones, which lets entries be removed while the table is walked, and are
+// cleared in bulk by rebuilding the table into spare storage of the same size.  Once the table has grown to fit the
+// scene, finding, adding and removing contacts doesn't allocate.
+class ContactTable {
+public:
+    ContactTable();
+
+    /// Returns the contact between the objects of key, adding a new one if there is none.
+    ContactInfo& operator[](const ContactKey& key);
+
+    /// Calls shouldRemove(const ContactKey&, ContactInfo&) for every contact, and removes the contacts it returns
+    /// true for.
+    template <typename F>
+    void removeIf(F shouldRemove);
+
+    void clear();
+
+    int size() const { return _numEntries; }
+    bool isEmpty() const { return _numEntries == 0; }
+    int getCapacity() const { return (int)_slots.size(); }
+
+private:
+    enum class SlotState : uint8_t {
+        Empty,
+        Occupied,
+        Removed
+    };
+
+    struct Slot {
+        void* a { nullptr };
+        void* b { nullptr };
+        ContactInfo info;
+        SlotState state { SlotState::Empty };
+    };
+
+    static uint32_t hash(void* a, void* b);
+
+    void afterRemoving();
+    void rebuild(int capacity);
+
+    std::vector<Slot> _slots;
+    std::vector<Slot> _spareSlots;
+    uint32_t _mask { 0 };
+    int _numEntries { 0 };
+    int _numRemoved { 0 };
+};
+
+template <typename F>
+void ContactTable::removeIf(F shouldRemove) {
+    for (auto& slot : _slots) {
+        if (slot.state == SlotState::Occupied && shouldRemove(ContactKey(slot.a, slot.b), slot.info)) {
+            slot.state = SlotState::Removed;
+            --_numEntries;
+            ++_numRemoved;
+        }
+    }
+    afterRemoving();
+}
+
+#endif // hifi_ContactTable_h
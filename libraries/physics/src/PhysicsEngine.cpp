@@ -11,7 +11,9 @@
 
 #include "PhysicsEngine.h"
 
+#include <algorithm>
 #include <functional>
+#include <mutex>
 
 #include <QFile>
 
@@ -20,6 +22,11 @@
 #include <Profile.h>
 #include <BulletCollision/CollisionShapes/btTriangleShape.h>
 
+#if BT_THREADSAFE
+#include <BulletCollision/CollisionDispatch/btCollisionDispatcherMt.h>
+#include <BulletDynamics/ConstraintSolver/btSequentialImpulseConstraintSolverMt.h>
+#endif
+
 #include "CharacterController.h"
 #include "ObjectMotionState.h"
 #include "PhysicsHelpers.h"
@@ -27,6 +34,61 @@
 #include "ThreadSafeDynamicsWorld.h"
 #include "PhysicsLogging.h"
 
+namespace {
+
+// With more than one thread new contact points are created on the task scheduler's workers, and contact added
+// callbacks aren't written to be thread safe, so they are called one at a time.
+std::mutex contactAddedMutex;
+PhysicsEngine::ContactAddedCallback serializedContactAddedCallback = nullptr;
+
+bool callContactAddedCallbackSerialized(btManifoldPoint& cp,
+        const btCollisionObjectWrapper* colObj0Wrap, int partId0, int index0,
+        const btCollisionObjectWrapper* colObj1Wrap, int partId1, int index1) {
+    std::lock_guard<std::mutex> lock(contactAddedMutex);
+    return serializedContactAddedCallback(cp, colObj0Wrap, partId0, index0, colObj1Wrap, partId1, index1);
+}
+
+// Orders manifolds by the objects they connect, then by their contacts, independently of the order in which they were
+// created.  Manifolds this can't tell apart have the same bodies and contacts, so their order doesn't change the results.
+bool isManifoldBefore(const btPersistentManifold* manifoldA, const btPersistentManifold* manifoldB) {
+    int a0 = manifoldA->getBody0()->getWorldArrayIndex();
+    int b0 = manifoldB->getBody0()->getWorldArrayIndex();
+    if (a0 != b0) {
+        return a0 < b0;
+    }
+    int a1 = manifoldA->getBody1()->getWorldArrayIndex();
+    int b1 = manifoldB->getBody1()->getWorldArrayIndex();
+    if (a1 != b1) {
+        return a1 < b1;
+    }
+    // compound shapes have a manifold per pair of child shapes
+    if (manifoldA->getNumContacts() != manifoldB->getNumContacts()) {
+        return manifoldA->getNumContacts() < manifoldB->getNumContacts();
+    }
+    for (int i = 0; i < manifoldA->getNumContacts(); ++i) {
+        const btManifoldPoint& pointA = manifoldA->getContactPoint(i);
+        const btManifoldPoint& pointB = manifoldB->getContactPoint(i);
+        const int partsA[] = { pointA.m_partId0, pointA.m_index0, pointA.m_partId1, pointA.m_index1 };
+        const int partsB[] = { pointB.m_partId0, pointB.m_index0, pointB.m_partId1, pointB.m_index1 };
+        for (int j = 0; j < 4; ++j) {
+            if (partsA[j] != partsB[j]) {
+                return partsA[j] < partsB[j];
+            }
+        }
+        for (int j = 0; j < 3; ++j) {
+            if (pointA.m_localPointA[j] != pointB.m_localPointA[j]) {
+                return pointA.m_localPointA[j] < pointB.m_localPointA[j];
+            }
+            if (pointA.m_localPointB[j] != pointB.m_localPointB[j]) {
+                return pointA.m_localPointB[j] < pointB.m_localPointB[j];
+            }
+        }
+    }
+    return false;
+}
+
+}
+
 PhysicsEngine::PhysicsEngine(const glm::vec3& offset) :
         _originOffset(offset),
         _myAvatarController(nullptr) {
@@ -38,6 +100,7 @@ PhysicsEngine::~PhysicsEngine() {
     delete _collisionDispatcher;
     delete _broadphaseFilter;
     delete _constraintSolver;
+    delete _largeIslandSolver;
     delete _dynamicsWorld;
     delete _ghostPairCallback;
 }
@@ -45,10 +108,32 @@ PhysicsEngine::~PhysicsEngine() {
 void PhysicsEngine::init() {
     if (!_dynamicsWorld) {
         _collisionConfig = new btDefaultCollisionConfiguration();
+#if BT_THREADSAFE
+        // Bullet has a single, global task scheduler, which must be set before the world is created, and which every
+        // multithreaded engine shares (see PhysicsTaskScheduler)
+        _numThreads = glm::clamp(_numThreads, 1, PhysicsTaskScheduler::getMaxThreadCount());
+        if (_numThreads > 1) {
+            btSetTaskScheduler(PhysicsTaskScheduler::getInstance());
+            _collisionDispatcher = new btCollisionDispatcherMt(_collisionConfig);
+            _constraintSolver = new btConstraintSolverPoolMt(_numThreads);
+            _largeIslandSolver = new btSequentialImpulseConstraintSolverMt();
+        } else {
+            // one thread steps exactly as without multithreading
+            btSetTaskScheduler(btGetSequentialTaskScheduler());
+            _collisionDispatcher = new btCollisionDispatcher(_collisionConfig);
+            _constraintSolver = new btSequentialImpulseConstraintSolver;
+        }
+#else
+        if (_numThreads > 1) {
+            qCWarning(physics) << "Bullet was built without multithreading, the simulation will use one thread";
+        }
+        _numThreads = 1;
         _collisionDispatcher = new btCollisionDispatcher(_collisionConfig);
-        _broadphaseFilter = new btDbvtBroadphase();
         _constraintSolver = new btSequentialImpulseConstraintSolver;
-        _dynamicsWorld = new ThreadSafeDynamicsWorld(_collisionDispatcher, _broadphaseFilter, _constraintSolver, _collisionConfig);
+#endif
+        _broadphaseFilter = new btDbvtBroadphase();
+        _dynamicsWorld = new ThreadSafeDynamicsWorld(_collisionDispatcher, _broadphaseFilter, _constraintSolver,
+                                                     _largeIslandSolver, _collisionConfig, _numThreads);
         _physicsDebugDraw.reset(new PhysicsDebugDraw());
 
         // hook up debug draw renderer
@@ -182,9 +267,7 @@ QList<EntityDynamicPointer> PhysicsEngine::removeDynamicsForBody(btRigidBody* bo
 
 void PhysicsEngine::removeObjects(const VectorOfMotionStates& objects) {
     // bump and prune contacts for all objects in the list
-    for (auto object : objects) {
-        bumpAndPruneContacts(object);
-    }
+    bumpAndPruneContacts(objects);
 
     if (_activeStaticBodies.size() > 0) {
         // _activeStaticBodies was not cleared last frame.
@@ -241,7 +324,11 @@ void PhysicsEngine::addObjects(const VectorOfMotionStates& objects) {
 
 void PhysicsEngine::reinsertObject(ObjectMotionState* object) {
     // remove object from DynamicsWorld
-    bumpAndPruneContacts(object);
+    bumpAndPruneContacts(VectorOfMotionStates { object });
+    reinsertBody(object);
+}
+
+void PhysicsEngine::reinsertBody(ObjectMotionState* object) {
     btRigidBody* body = object->getRigidBody();
     if (body) {
         _dynamicsWorld->removeRigidBody(body);
@@ -252,8 +339,8 @@ void PhysicsEngine::reinsertObject(ObjectMotionState* object) {
 
 void PhysicsEngine::processTransaction(PhysicsEngine::Transaction& transaction) {
     // removes
+    bumpAndPruneContacts(transaction.objectsToRemove);
     for (auto object : transaction.objectsToRemove) {
-        bumpAndPruneContacts(object);
         btRigidBody* body = object->getRigidBody();
         if (body) {
             if (body->isStaticObject() && _activeStaticBodies.size() > 0) {
@@ -278,8 +365,9 @@ void PhysicsEngine::processTransaction(PhysicsEngine::Transaction& transaction)
     }
 
     // reinserts
+    bumpAndPruneContacts(transaction.objectsToReinsert);
     for (auto object : transaction.objectsToReinsert) {
-        reinsertObject(object);
+        reinsertBody(object);
     }
 
     for (auto object : transaction.activeStaticObjects) {
@@ -291,14 +379,9 @@ void PhysicsEngine::processTransaction(PhysicsEngine::Transaction& transaction)
 
 void PhysicsEngine::removeContacts(ObjectMotionState* motionState) {
     // trigger events for new/existing/old contacts
-    ContactMap::iterator contactItr = _contactMap.begin();
-    while (contactItr != _contactMap.end()) {
-        if (contactItr->first._a == motionState || contactItr->first._b == motionState) {
-            contactItr = _contactMap.erase(contactItr);
-        } else {
-            ++contactItr;
-        }
-    }
+    _contactMap.removeIf([motionState](const ContactKey& key, ContactInfo& contact) {
+        return key._a == motionState || key._b == motionState;
+    });
 }
 
 void PhysicsEngine::stepSimulation() {
@@ -470,8 +553,16 @@ void PhysicsEngine::updateContactMap() {
 
     // update all contacts every frame
     int numManifolds = _collisionDispatcher->getNumManifolds();
+    btPersistentManifold** manifolds = numManifolds > 0 ? _collisionDispatcher->getInternalManifoldPointer() : nullptr;
+    if (_numThreads > 1 && numManifolds > 0) {
+        // Manifolds made on worker threads are added in the order the workers got to them.  Sort them so that contact
+        // info, where a later manifold of a pair replaces an earlier one, doesn't depend on scheduling.
+        _sortedManifolds.assign(manifolds, manifolds + numManifolds);
+        std::sort(_sortedManifolds.begin(), _sortedManifolds.end(), isManifoldBefore);
+        manifolds = _sortedManifolds.data();
+    }
     for (int i = 0; i < numManifolds; ++i) {
-        btPersistentManifold* contactManifold =  _collisionDispatcher->getManifoldByIndexInternal(i);
+        btPersistentManifold* contactManifold = manifolds[i];
         if (contactManifold->getNumContacts() > 0) {
             // TODO: require scripts to register interest in callbacks for specific objects
             // so we can filter out most collision events right here.
@@ -491,6 +582,7 @@ void PhysicsEngine::updateContactMap() {
                 _contactMap[ContactKey(a, b)].update(_numContactFrames, contactManifold->getContactPoint(0));
             }
 
+            // bump() keeps the highest priority it is given, so infection doesn't depend on the manifold order either
             if (!Physics::getSessionUUID().isNull()) {
                 doOwnershipInfection(objectA, objectB);
             }
@@ -549,18 +641,15 @@ void PhysicsEngine::doOwnershipInfectionForConstraints() {
 const CollisionEvents& PhysicsEngine::getCollisionEvents() {
     _collisionEvents.clear();
 
-    // scan known contacts and trigger events
-    ContactMap::iterator contactItr = _contactMap.begin();
-
-    while (contactItr != _contactMap.end()) {
-        ContactInfo& contact = contactItr->second;
+    // scan known contacts and trigger events, and remove the contacts that ended in the same pass
+    _contactMap.removeIf([this](const ContactKey& key, ContactInfo& contact) {
         ContactEventType type = contact.computeType(_numContactFrames);
         const btScalar SIGNIFICANT_DEPTH = -0.002f; // penetrations have negative distance
         if (type != CONTACT_EVENT_TYPE_CONTINUE ||
                 (contact.distance < SIGNIFICANT_DEPTH &&
                  contact.readyForContinue(_numContactFrames))) {
-            ObjectMotionState* motionStateA = static_cast<ObjectMotionState*>(contactItr->first._a);
-            ObjectMotionState* motionStateB = static_cast<ObjectMotionState*>(contactItr->first._b);
+            ObjectMotionState* motionStateA = static_cast<ObjectMotionState*>(key._a);
+            ObjectMotionState* motionStateB = static_cast<ObjectMotionState*>(key._b);
 
             // NOTE: the MyAvatar RigidBody is the only object in the simulation that does NOT have a MotionState
             // which means should we ever want to report ALL collision events against the avatar we can
@@ -594,12 +683,8 @@ const CollisionEvents& PhysicsEngine::getCollisionEvents() {
             }
         }
 
-        if (type == CONTACT_EVENT_TYPE_END) {
-            contactItr = _contactMap.erase(contactItr);
-        } else {
-            ++contactItr;
-        }
-    }
+        return type == CONTACT_EVENT_TYPE_END;
+    });
     return _collisionEvents;
 }
 
@@ -653,12 +738,18 @@ void PhysicsEngine::saveNextPhysicsStats(QString filename) {
 // CF_DISABLE_VISUALIZE_OBJECT = 32, //disable debug drawing
 // CF_DISABLE_SPU_COLLISION_PROCESSING = 64//disable parallel/SPU processing
 
-void PhysicsEngine::bumpAndPruneContacts(ObjectMotionState* motionState) {
-    // Find all objects that touch the object corresponding to motionState and flag the other objects
-    // for simulation ownership by the local simulation.
-
-    assert(motionState);
-    btCollisionObject* object = motionState->getRigidBody();
+void PhysicsEngine::bumpAndPruneContacts(const VectorOfMotionStates& objects) {
+    // Find all objects that touch the objects corresponding to these motionStates and flag the other objects
+    // for simulation ownership by the local simulation.  All of the objects are handled in one pass over the
+    // manifolds and one over the contacts.
+    if (objects.empty()) {
+        return;
+    }
+    _prunedObjects.assign(objects.begin(), objects.end());
+    std::sort(_prunedObjects.begin(), _prunedObjects.end());
+    auto isPruned = [this](const void* motionState) {
+        return motionState && std::binary_search(_prunedObjects.begin(), _prunedObjects.end(), motionState);
+    };
 
     int numManifolds = _collisionDispatcher->getNumManifolds();
     for (int i = 0; i < numManifolds; ++i) {
@@ -666,26 +757,25 @@ void PhysicsEngine::bumpAndPruneContacts(ObjectMotionState* motionState) {
         if (contactManifold->getNumContacts() > 0) {
             const btCollisionObject* objectA = static_cast<const btCollisionObject*>(contactManifold->getBody0());
             const btCollisionObject* objectB = static_cast<const btCollisionObject*>(contactManifold->getBody1());
-            if (objectB == object) {
-                if (!objectA->isStaticOrKinematicObject()) {
-                    ObjectMotionState* motionStateA = static_cast<ObjectMotionState*>(objectA->getUserPointer());
-                    if (motionStateA) {
-                        motionStateA->bump(VOLUNTEER_SIMULATION_PRIORITY);
-                        objectA->setActivationState(ACTIVE_TAG);
-                    }
+            ObjectMotionState* motionStateA = static_cast<ObjectMotionState*>(objectA->getUserPointer());
+            ObjectMotionState* motionStateB = static_cast<ObjectMotionState*>(objectB->getUserPointer());
+            if (isPruned(motionStateB)) {
+                if (!objectA->isStaticOrKinematicObject() && motionStateA) {
+                    motionStateA->bump(VOLUNTEER_SIMULATION_PRIORITY);
+                    objectA->setActivationState(ACTIVE_TAG);
                 }
-            } else if (objectA == object) {
-                if (!objectB->isStaticOrKinematicObject()) {
-                    ObjectMotionState* motionStateB = static_cast<ObjectMotionState*>(objectB->getUserPointer());
-                    if (motionStateB) {
-                        motionStateB->bump(VOLUNTEER_SIMULATION_PRIORITY);
-                        objectB->setActivationState(ACTIVE_TAG);
-                    }
+            } else if (isPruned(motionStateA)) {
+                if (!objectB->isStaticOrKinematicObject() && motionStateB) {
+                    motionStateB->bump(VOLUNTEER_SIMULATION_PRIORITY);
+                    objectB->setActivationState(ACTIVE_TAG);
                 }
             }
         }
     }
-    removeContacts(motionState);
+
+    _contactMap.removeIf([&isPruned](const ContactKey& key, ContactInfo& contact) {
+        return isPruned(key._a) || isPruned(key._b);
+    });
 }
 
 void PhysicsEngine::setCharacterController(CharacterController* character) {
@@ -823,7 +913,12 @@ void PhysicsEngine::setContactAddedCallback(PhysicsEngine::ContactAddedCallback
     // gContactAddedCallback is a special feature hook in Bullet
     // if non-null AND one of the colliding objects has btCollisionObject::CF_CUSTOM_MATERIAL_CALLBACK flag set
     // then it is called whenever a new candidate contact point is created
-    gContactAddedCallback = newCb;
+    if (_numThreads > 1 && newCb) {
+        serializedContactAddedCallback = newCb;
+        gContactAddedCallback = callContactAddedCallbackSerialized;
+    } else {
+        gContactAddedCallback = newCb;
+    }
 }
 
 struct AllContactsCallback : public btCollisionWorld::ContactResultCallback {
@@ -22,27 +22,18 @@
 
 #include "BulletUtil.h"
 #include "ContactInfo.h"
+#include "ContactTable.h"
 #include "ObjectMotionState.h"
 #include "ThreadSafeDynamicsWorld.h"
 #include "ObjectAction.h"
 #include "ObjectConstraint.h"
+#include "PhysicsTaskScheduler.h"
 
 const float HALF_SIMULATION_EXTENT = 512.0f; // meters
 
 class CharacterController;
 class PhysicsDebugDraw;
 
-// simple class for keeping track of contacts
-class ContactKey {
-public:
-    ContactKey() = delete;
-    ContactKey(void* a, void* b) : _a(a), _b(b) {}
-    bool operator<(const ContactKey& other) const { return _a < other._a || (_a == other._a && _b < other._b); }
-    bool operator==(const ContactKey& other) const { return _a == other._a && _b == other._b; }
-    void* _a; // ObjectMotionState pointer
-    void* _b; // ObjectMotionState pointer
-};
-
 struct ContactTestResult {
     ContactTestResult() = delete;
 
@@ -69,7 +60,6 @@ struct ContactTestResult {
     glm::vec3 collisionNormal;
 };
 
-using ContactMap = std::map<ContactKey, ContactInfo>;
 using CollisionEvents = std::vector<Collision>;
 
 class PhysicsEngine {
@@ -94,6 +84,11 @@ public:
 
     PhysicsEngine(const glm::vec3& offset);
     ~PhysicsEngine();
+    /// Sets the number of threads, including the calling thread, that step the simulation.  Only has an effect before
+    /// init(), and only if Bullet was built with multithreading.
+    void setNumThreads(int numThreads) { _numThreads = numThreads; }
+    int getNumThreads() const { return _numThreads; }
+
     void init();
 
     uint32_t getNumSubsteps() const;
@@ -162,9 +157,10 @@ public:
 private:
     QList<EntityDynamicPointer> removeDynamicsForBody(btRigidBody* body);
     void addObjectToDynamicsWorld(ObjectMotionState* motionState);
+    void reinsertBody(ObjectMotionState* motionState);
 
-    /// \brief bump any objects that touch this one, then remove contact info
-    void bumpAndPruneContacts(ObjectMotionState* motionState);
+    /// \brief bump any objects that touch these ones, then remove their contact info
+    void bumpAndPruneContacts(const VectorOfMotionStates& objects);
 
     void doOwnershipInfection(const btCollisionObject* objectA, const btCollisionObject* objectB);
 
@@ -172,12 +168,15 @@ private:
     btDefaultCollisionConfiguration* _collisionConfig = NULL;
     btCollisionDispatcher* _collisionDispatcher = NULL;
     btBroadphaseInterface* _broadphaseFilter = NULL;
-    btSequentialImpulseConstraintSolver* _constraintSolver = NULL;
+    btConstraintSolver* _constraintSolver = NULL;
+    btConstraintSolver* _largeIslandSolver = NULL;
     ThreadSafeDynamicsWorld* _dynamicsWorld = NULL;
     btGhostPairCallback* _ghostPairCallback = NULL;
     std::unique_ptr<PhysicsDebugDraw> _physicsDebugDraw;
+    std::vector<btPersistentManifold*> _sortedManifolds;
+    std::vector<const void*> _prunedObjects;
 
-    ContactMap _contactMap;
+    ContactTable _contactMap;
     CollisionEvents _collisionEvents;
     QHash<QUuid, EntityDynamicPointer> _objectDynamics;
     QHash<btRigidBody*, QSet<QUuid>> _objectDynamicsByBody;
@@ -189,6 +188,7 @@ private:
     CharacterController* _myAvatarController;
 
     uint32_t _numContactFrames { 0 };
+    int _numThreads { 1 };
 
     bool _dumpNextStats { false };
     bool _saveNextStats { false };
@@ -0,0 +1,148 @@
+//
+//  PhysicsTaskScheduler.cpp
+//  libraries/physics/src
+//
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "PhysicsTaskScheduler.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <QtCore/QRunnable>
+#include <QtCore/QThread>
+
+namespace {
+
+// Shared between the caller and the pool workers. Workers that only start once every chunk has been claimed find
+// nothing to do, so the caller can return without waiting for them.
+struct ChunkedRange {
+    ChunkedRange(int begin, int end, int grainSize, const std::function<void(int, int, int)>& runChunk) :
+        runChunk(runChunk), begin(begin), end(end), grainSize(grainSize), remaining(end - begin) {}
+
+    // Returns false once every chunk has been claimed.
+    bool runNextChunk() {
+        int chunk = nextChunk.fetch_add(1);
+        int chunkBegin = begin + chunk * grainSize;
+        if (chunkBegin >= end) {
+            return false;
+        }
+        int chunkEnd = std::min(chunkBegin + grainSize, end);
+        runChunk(chunkBegin, chunkEnd, chunk);
+
+        if (remaining.fetch_sub(chunkEnd - chunkBegin) == chunkEnd - chunkBegin) {
+            std::lock_guard<std::mutex> lock(mutex);
+            finished.notify_all();
+        }
+        return true;
+    }
+
+    void waitUntilFinished() {
+        std::unique_lock<std::mutex> lock(mutex);
+        finished.wait(lock, [this] { return remaining.load() == 0; });
+    }
+
+    const std::function<void(int, int, int)> runChunk;
+    const int begin;
+    const int end;
+    const int grainSize;
+    std::atomic<int> nextChunk { 0 };
+    std::atomic<int> remaining;
+    std::mutex mutex;
+    std::condition_variable finished;
+};
+
+class ChunkedRangeWorker : public QRunnable {
+public:
+    ChunkedRangeWorker(const std::shared_ptr<ChunkedRange>& range) : _range(range) {}
+
+    void run() override {
+        while (_range->runNextChunk()) {
+        }
+    }
+
+private:
+    std::shared_ptr<ChunkedRange> _range;
+};
+
+}
+
+PhysicsTaskScheduler* PhysicsTaskScheduler::getInstance() {
+    static PhysicsTaskScheduler instance;
+    return &instance;
+}
+
+PhysicsTaskScheduler::PhysicsTaskScheduler() : btITaskScheduler("Vircadia") {
+    // never let pool threads expire, so that Bullet doesn't run out of thread indices
+    _threadPool.setExpiryTimeout(-1);
+    _threadPool.setMaxThreadCount(std::max(getMaxThreadCount() - 1, 1));
+}
+
+PhysicsTaskScheduler::~PhysicsTaskScheduler() {
+    _threadPool.waitForDone();
+}
+
+int PhysicsTaskScheduler::getMaxThreadCount() {
+    // the thread that creates the world is one of Bullet's threads too
+    return std::max(std::min(QThread::idealThreadCount(), BT_MAX_THREAD_COUNT - 1), 1);
+}
+
+void PhysicsTaskScheduler::setNumThreads(int numThreads) {
+    _numThreads = std::max(std::min(numThreads, getMaxThreadCount()), 1);
+}
+
+void PhysicsTaskScheduler::runChunks(int iBegin, int iEnd, int grainSize,
+                                     const std::function<void(int, int, int)>& runChunk) {
+    grainSize = std::max(grainSize, 1);
+    int numChunks = (iEnd - iBegin + grainSize - 1) / grainSize;
+    int numWorkers = std::min(numChunks, _numThreads.load()) - 1;
+    if (numWorkers <= 0) {
+        for (int chunk = 0; chunk < numChunks; ++chunk) {
+            int chunkBegin = iBegin + chunk * grainSize;
+            runChunk(chunkBegin, std::min(chunkBegin + grainSize, iEnd), chunk);
+        }
+        return;
+    }
+
+    auto range = std::make_shared<ChunkedRange>(iBegin, iEnd, grainSize, runChunk);
+    for (int i = 0; i < numWorkers; ++i) {
+        _threadPool.start(new ChunkedRangeWorker(range));
+    }
+    while (range->runNextChunk()) {
+    }
+    range->waitUntilFinished();
+}
+
+void PhysicsTaskScheduler::parallelFor(int iBegin, int iEnd, int grainSize, const btIParallelForBody& body) {
+    if (iEnd <= iBegin) {
+        return;
+    }
+    runChunks(iBegin, iEnd, grainSize, [&body](int begin, int end, int chunk) {
+        body.forLoop(begin, end);
+    });
+}
+
+btScalar PhysicsTaskScheduler::parallelSum(int iBegin, int iEnd, int grainSize, const btIParallelSumBody& body) {
+    if (iEnd <= iBegin) {
+        return btScalar(0);
+    }
+    grainSize = std::max(grainSize, 1);
+    std::vector<btScalar> sums((iEnd - iBegin + grainSize - 1) / grainSize, btScalar(0));
+    runChunks(iBegin, iEnd, grainSize, [&body, &sums](int begin, int end, int chunk) {
+        sums[chunk] = body.sumLoop(begin, end);
+    });
+
+    btScalar sum = btScalar(0);
+    for (auto chunkSum : sums) {
+        sum += chunkSum;
+    }
+    return sum;
+}
@@ -0,0 +1,54 @@
+//
+//  PhysicsTaskScheduler.h
+//  libraries/physics/src
+//
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_PhysicsTaskScheduler_h
+#define hifi_PhysicsTaskScheduler_h
+
+#include <atomic>
+#include <functional>
+
+#include <LinearMath/btThreads.h>
+
+#include <QtCore/QThreadPool>
+
+// Runs Bullet's parallel loops on a thread pool of its own, with the calling thread working alongside the pool.
+//
+// Bullet gives every thread that ever runs a loop a permanent index from one global counter, supports no more than
+// BT_MAX_THREAD_COUNT of them, and sizes per-thread arrays from getNumThreads().  So there is one scheduler for the
+// whole process, whose pool is made once with a thread for every core and never lets its threads expire, and
+// setNumThreads() only caps how many of them work on a loop.  Any pool thread may pick up a loop, so getNumThreads()
+// is always the size of the pool plus the main thread, which is the one that steps the worlds.
+// Sums are added up per chunk in a fixed order, so that they don't depend on how the chunks were scheduled.
+class PhysicsTaskScheduler : public btITaskScheduler {
+public:
+    static PhysicsTaskScheduler* getInstance();
+
+    /// The largest number of threads, including the caller, that a physics engine may use on this machine.
+    static int getMaxThreadCount();
+
+    int getMaxNumThreads() const override { return getMaxThreadCount(); }
+    int getNumThreads() const override { return getMaxThreadCount(); }
+    void setNumThreads(int numThreads) override;
+    int getNumWorkingThreads() const { return _numThreads; }
+
+    void parallelFor(int iBegin, int iEnd, int grainSize, const btIParallelForBody& body) override;
+    btScalar parallelSum(int iBegin, int iEnd, int grainSize, const btIParallelSumBody& body) override;
+
+private:
+    PhysicsTaskScheduler();
+    ~PhysicsTaskScheduler() override;
+
+    void runChunks(int iBegin, int iEnd, int grainSize, const std::function<void(int, int, int)>& runChunk);
+
+    QThreadPool _threadPool;
+    std::atomic<int> _numThreads { 1 };
+};
+
+#endif // hifi_PhysicsTaskScheduler_h
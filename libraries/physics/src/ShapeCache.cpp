@@ -0,0 +1,116 @@
+//
+//  ShapeCache.cpp
+//  libraries/physics/src
+//
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ShapeCache.h"
+
+#include <mutex>
+
+#include <QtCore/QCryptographicHash>
+#include <QtCore/QtEndian>
+
+#include <LinearMath/btScalar.h>
+
+// bump this whenever the ShapeFactory changes how it builds or serializes cached shapes
+static const int SHAPE_CACHE_VERSION = 1;
+
+// below these sizes hashing and reading the cached shape costs about as much as building it
+static const int MIN_CACHED_MESH_TRIANGLES = 4096;
+static const int MIN_CACHED_HULL_POINTS = 4096;
+
+namespace {
+
+std::mutex cacheMutex;
+std::shared_ptr<cache::ContentCache> shapeCache;
+
+std::shared_ptr<cache::ContentCache> getCache() {
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    return shapeCache;
+}
+
+bool isWorthCaching(const ShapeInfo& info) {
+    switch (info.getType()) {
+        case SHAPE_TYPE_STATIC_MESH:
+            return info.getTriangleIndices().size() / 3 >= MIN_CACHED_MESH_TRIANGLES;
+        case SHAPE_TYPE_SIMPLE_HULL:
+        case SHAPE_TYPE_COMPOUND:
+        case SHAPE_TYPE_SIMPLE_COMPOUND: {
+            int numPoints = 0;
+            for (const auto& points : info.getPointCollection()) {
+                numPoints += points.size();
+            }
+            return numPoints >= MIN_CACHED_HULL_POINTS;
+        }
+        default:
+            return false;
+    }
+}
+
+}
+
+void ShapeCache::enable(const std::string& dirname, size_t maxSize) {
+    auto newCache = std::make_shared<cache::ContentCache>(dirname);
+    newCache->initialize();
+    newCache->setMaxSize(maxSize);
+
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    shapeCache = newCache;
+}
+
+void ShapeCache::disable() {
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    shapeCache.reset();
+}
+
+bool ShapeCache::isEnabled() {
+    return (bool)getCache();
+}
+
+ShapeCache::Key ShapeCache::getKey(const ShapeInfo& info) {
+    if (!isEnabled() || !isWorthCaching(info)) {
+        return Key();
+    }
+
+    // the offset is applied after the shape is built, so it isn't part of the key
+    QCryptographicHash hasher(QCryptographicHash::Sha256);
+    for (const auto& points : info.getPointCollection()) {
+        quint32 numPoints = qToLittleEndian((quint32)points.size());
+        hasher.addData((const char*)&numPoints, sizeof(numPoints));
+        hasher.addData((const char*)points.constData(), points.size() * (int)sizeof(glm::vec3));
+    }
+    const auto& triangleIndices = info.getTriangleIndices();
+    hasher.addData((const char*)triangleIndices.constData(), triangleIndices.size() * (int)sizeof(int32_t));
+
+    // serialized Bullet data depends on the precision and byte order it was written with
+    QString artifactType = QString("shape-%1-%2-%3")
+        .arg(ShapeInfo::getNameForShapeType(info.getType()))
+        .arg(sizeof(btScalar) * 8)
+        .arg(QSysInfo::ByteOrder == QSysInfo::LittleEndian ? "le" : "be");
+    return cache::ContentCache::makeKey(hasher.result().toHex(), artifactType, SHAPE_CACHE_VERSION);
+}
+
+bool ShapeCache::load(const Key& key, QByteArray& data) {
+    auto cache = getCache();
+    return cache && cache->load(key, data);
+}
+
+bool ShapeCache::store(const Key& key, const QByteArray& data) {
+    auto cache = getCache();
+    return cache && cache->store(key, data);
+}
+
+size_t ShapeCache::getNumHits() {
+    auto cache = getCache();
+    return cache ? cache->getNumHits() : 0;
+}
+
+size_t ShapeCache::getNumMisses() {
+    auto cache = getCache();
+    return cache ? cache->getNumMisses() : 0;
+}
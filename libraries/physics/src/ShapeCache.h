@@ -0,0 +1,48 @@
+//
+//  ShapeCache.h
+//  libraries/physics/src
+//
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_ShapeCache_h
+#define hifi_ShapeCache_h
+
+#include <memory>
+#include <string>
+
+#include <QtCore/QByteArray>
+
+#include <ShapeInfo.h>
+#include <shared/ContentCache.h>
+
+// Keeps the expensive parts of collision shapes built by the ShapeFactory on disk: the BVHs of static meshes and the
+// convex hulls of compound shapes, so that they don't have to be built again every time a domain is loaded.
+//
+// Entries are keyed by a hash of the geometry the shape is built from, rather than by ShapeInfo::getHash(), which
+// only covers the URL and extents of mesh shapes and so can't tell an edited model from the original.
+// All methods are thread safe.
+class ShapeCache {
+public:
+    using Key = cache::FileCache::Key;
+
+    /// Starts caching shapes in dirname, which is relative to the application's local data unless it is absolute.
+    static void enable(const std::string& dirname, size_t maxSize);
+    static void disable();
+    static bool isEnabled();
+
+    /// Returns the key of the shape built from info, or an empty key if caching is disabled or the shape is too
+    /// simple to be worth caching.
+    static Key getKey(const ShapeInfo& info);
+
+    static bool load(const Key& key, QByteArray& data);
+    static bool store(const Key& key, const QByteArray& data);
+
+    static size_t getNumHits();
+    static size_t getNumMisses();
+};
+
+#endif // hifi_ShapeCache_h
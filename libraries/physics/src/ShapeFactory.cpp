@@ -13,9 +13,12 @@
 
 #include <glm/gtx/norm.hpp>
 
+#include <QtCore/QDataStream>
+
 #include <SharedUtil.h> // for MILLIMETERS_PER_METER
 
 #include "BulletUtil.h"
+#include "ShapeCache.h"
 
 
 class StaticMeshShape : public btBvhTriangleMeshShape {
@@ -27,7 +30,21 @@ public:
         assert(_dataArray);
     }
 
+    // takes ownership of a BVH that was deserialized in place, instead of building one
+    StaticMeshShape(btTriangleIndexVertexArray* dataArray, btOptimizedBvh* serializedBvh)
+    :   btBvhTriangleMeshShape(dataArray, true, false), _dataArray(dataArray), _serializedBvh(serializedBvh) {
+        assert(_dataArray);
+        assert(_serializedBvh);
+        setOptimizedBvh(_serializedBvh);
+    }
+
     ~StaticMeshShape() {
+        if (_serializedBvh) {
+            // the BVH lives in the buffer it was deserialized from
+            _serializedBvh->~btOptimizedBvh();
+            btAlignedFree(_serializedBvh);
+            _serializedBvh = nullptr;
+        }
         assert(_dataArray);
         IndexedMeshArray& meshes = _dataArray->getIndexedMeshArray();
         for (int32_t i = 0; i < meshes.size(); ++i) {
@@ -47,6 +64,7 @@ public:
 private:
     // the StaticMeshShape owns its vertex/index data
     btTriangleIndexVertexArray* _dataArray;
+    btOptimizedBvh* _serializedBvh { nullptr };
 };
 
 // the dataArray must be created before we create the StaticMeshShape
@@ -270,7 +288,8 @@ btTriangleIndexVertexArray* createStaticMeshArray(const ShapeInfo& info) {
     return dataArray;
 }
 
-const btCollisionShape* ShapeFactory::createShapeFromInfo(const ShapeInfo& info) {
+// util method
+btCollisionShape* createShapeWithoutOffset(const ShapeInfo& info) {
     btCollisionShape* shape = nullptr;
     int type = info.getType();
     switch(type) {
@@ -433,6 +452,154 @@ const btCollisionShape* ShapeFactory::createShapeFromInfo(const ShapeInfo& info)
         default:
         break;
     }
+    return shape;
+}
+
+// Cached static meshes hold the serialized BVH, which is the expensive part to build. The vertices and indices are
+// copied from the ShapeInfo as usual.
+QByteArray serializeStaticMesh(btBvhTriangleMeshShape* mesh) {
+    QByteArray data;
+    btOptimizedBvh* bvh = mesh->getOptimizedBvh();
+    if (bvh) {
+        // Bullet requires 16 byte aligned buffers, which a QByteArray doesn't guarantee
+        unsigned int size = bvh->calculateSerializeBufferSize();
+        void* buffer = btAlignedAlloc(size, 16);
+        if (bvh->serializeInPlace(buffer, size, false)) {
+            data = QByteArray((const char*)buffer, (int)size);
+        }
+        btAlignedFree(buffer);
+    }
+    return data;
+}
+
+btCollisionShape* deserializeStaticMesh(const ShapeInfo& info, const QByteArray& data) {
+    if (data.size() < (int)sizeof(btOptimizedBvh)) {
+        return nullptr;
+    }
+    void* buffer = btAlignedAlloc((size_t)data.size(), 16);
+    memcpy(buffer, data.constData(), (size_t)data.size());
+    btOptimizedBvh* bvh = btOptimizedBvh::deSerializeInPlace(buffer, (unsigned int)data.size(), false);
+    if (!bvh) {
+        btAlignedFree(buffer);
+        return nullptr;
+    }
+    btTriangleIndexVertexArray* dataArray = createStaticMeshArray(info);
+    if (!dataArray) {
+        bvh->~btOptimizedBvh();
+        btAlignedFree(buffer);
+        return nullptr;
+    }
+    return new StaticMeshShape(dataArray, bvh);
+}
+
+// Cached hulls hold the points that are left after createConvexHull() has corrected them for the margin and
+// reduced them, so the hulls can be rebuilt without either step.
+QByteArray serializeConvexHulls(btCollisionShape* shape) {
+    std::vector<const btConvexHullShape*> hulls;
+    bool isCompound = shape->getShapeType() == (int)COMPOUND_SHAPE_PROXYTYPE;
+    if (isCompound) {
+        btCompoundShape* compound = static_cast<btCompoundShape*>(shape);
+        for (int i = 0; i < compound->getNumChildShapes(); ++i) {
+            hulls.push_back(static_cast<const btConvexHullShape*>(compound->getChildShape(i)));
+        }
+    } else {
+        hulls.push_back(static_cast<const btConvexHullShape*>(shape));
+    }
+
+    QByteArray data;
+    QDataStream stream(&data, QIODevice::WriteOnly);
+    stream.setFloatingPointPrecision(QDataStream::SinglePrecision);
+    stream << isCompound << (quint32)hulls.size();
+    for (auto hull : hulls) {
+        if (!hull || hull->getShapeType() != (int)CONVEX_HULL_SHAPE_PROXYTYPE) {
+            return QByteArray();
+        }
+        int numPoints = hull->getNumPoints();
+        const btVector3* points = hull->getUnscaledPoints();
+        stream << (float)hull->getMargin() << (quint32)numPoints;
+        for (int i = 0; i < numPoints; ++i) {
+            stream << (float)points[i].getX() << (float)points[i].getY() << (float)points[i].getZ();
+        }
+    }
+    return data;
+}
+
+btCollisionShape* deserializeConvexHulls(const QByteArray& data) {
+    QDataStream stream(data);
+    stream.setFloatingPointPrecision(QDataStream::SinglePrecision);
+    bool isCompound = false;
+    quint32 numHulls = 0;
+    stream >> isCompound >> numHulls;
+
+    std::vector<btConvexHullShape*> hulls;
+    for (quint32 i = 0; i < numHulls && stream.status() == QDataStream::Ok; ++i) {
+        float margin = 0.0f;
+        quint32 numPoints = 0;
+        stream >> margin >> numPoints;
+        btConvexHullShape* hull = new btConvexHullShape();
+        hull->setMargin(margin);
+        for (quint32 j = 0; j < numPoints && stream.status() == QDataStream::Ok; ++j) {
+            float x, y, z;
+            stream >> x >> y >> z;
+            hull->addPoint(btVector3(x, y, z), false);
+        }
+        hull->recalcLocalAabb();
+        hulls.push_back(hull);
+    }
+
+    if (stream.status() != QDataStream::Ok || hulls.empty() || (!isCompound && hulls.size() != 1)) {
+        for (auto hull : hulls) {
+            delete hull;
+        }
+        return nullptr;
+    }
+    if (!isCompound) {
+        return hulls[0];
+    }
+    auto compound = new btCompoundShape();
+    btTransform trans;
+    trans.setIdentity();
+    for (auto hull : hulls) {
+        compound->addChildShape(trans, hull);
+    }
+    return compound;
+}
+
+btCollisionShape* loadCachedShape(const ShapeInfo& info, const ShapeCache::Key& key) {
+    QByteArray data;
+    if (!ShapeCache::load(key, data)) {
+        return nullptr;
+    }
+    if (info.getType() == SHAPE_TYPE_STATIC_MESH) {
+        return deserializeStaticMesh(info, data);
+    }
+    return deserializeConvexHulls(data);
+}
+
+void storeCachedShape(const ShapeInfo& info, const ShapeCache::Key& key, btCollisionShape* shape) {
+    QByteArray data;
+    if (info.getType() == SHAPE_TYPE_STATIC_MESH) {
+        data = serializeStaticMesh(static_cast<btBvhTriangleMeshShape*>(shape));
+    } else {
+        data = serializeConvexHulls(shape);
+    }
+    if (!data.isEmpty()) {
+        ShapeCache::store(key, data);
+    }
+}
+
+const btCollisionShape* ShapeFactory::createShapeFromInfo(const ShapeInfo& info) {
+    btCollisionShape* shape = nullptr;
+    ShapeCache::Key cacheKey = ShapeCache::getKey(info);
+    if (!cacheKey.empty()) {
+        shape = loadCachedShape(info, cacheKey);
+    }
+    if (!shape) {
+        shape = createShapeWithoutOffset(info);
+        if (shape && !cacheKey.empty()) {
+            storeCachedShape(info, cacheKey, shape);
+        }
+    }
     if (shape) {
         if (glm::length2(info.getOffset()) > MIN_SHAPE_OFFSET * MIN_SHAPE_OFFSET) {
             // we need to apply an offset
@@ -19,15 +19,71 @@
 
 #include <LinearMath/btQuickprof.h>
 
+#include "PhysicsTaskScheduler.h"
 #include "Profile.h"
 
 ThreadSafeDynamicsWorld::ThreadSafeDynamicsWorld(
         btDispatcher* dispatcher,
         btBroadphaseInterface* pairCache,
         btConstraintSolver* constraintSolver,
-        btCollisionConfiguration* collisionConfiguration)
+        btConstraintSolver* largeIslandSolver,
+        btCollisionConfiguration* collisionConfiguration,
+        int numThreads)
+#if BT_THREADSAFE
+    :   btDiscreteDynamicsWorldMt(dispatcher, pairCache,
+                                  numThreads > 1 ? static_cast<btConstraintSolverPoolMt*>(constraintSolver) : nullptr,
+                                  largeIslandSolver, collisionConfiguration),
+        _numThreads(numThreads) {
+    if (!isMultithreaded()) {
+        // put back the island manager and solver that btDiscreteDynamicsWorld would have
+        if (m_ownsIslandManager) {
+            m_islandManager->~btSimulationIslandManager();
+            btAlignedFree(m_islandManager);
+        }
+        void* memory = btAlignedAlloc(sizeof(btSimulationIslandManager), 16);
+        m_islandManager = new (memory) btSimulationIslandManager();
+        m_ownsIslandManager = true;
+        btDiscreteDynamicsWorld::setConstraintSolver(constraintSolver);
+    }
+}
+#else
     :   btDiscreteDynamicsWorld(dispatcher, pairCache, constraintSolver, collisionConfiguration) {
 }
+#endif
+
+#if BT_THREADSAFE
+void ThreadSafeDynamicsWorld::solveConstraints(btContactSolverInfo& solverInfo) {
+    if (isMultithreaded()) {
+        btDiscreteDynamicsWorldMt::solveConstraints(solverInfo);
+    } else {
+        btDiscreteDynamicsWorld::solveConstraints(solverInfo);
+    }
+}
+
+void ThreadSafeDynamicsWorld::predictUnconstraintMotion(btScalar timeStep) {
+    if (isMultithreaded()) {
+        btDiscreteDynamicsWorldMt::predictUnconstraintMotion(timeStep);
+    } else {
+        btDiscreteDynamicsWorld::predictUnconstraintMotion(timeStep);
+    }
+}
+
+void ThreadSafeDynamicsWorld::createPredictiveContacts(btScalar timeStep) {
+    if (isMultithreaded()) {
+        btDiscreteDynamicsWorldMt::createPredictiveContacts(timeStep);
+    } else {
+        btDiscreteDynamicsWorld::createPredictiveContacts(timeStep);
+    }
+}
+
+void ThreadSafeDynamicsWorld::integrateTransforms(btScalar timeStep) {
+    if (isMultithreaded()) {
+        btDiscreteDynamicsWorldMt::integrateTransforms(timeStep);
+    } else {
+        btDiscreteDynamicsWorld::integrateTransforms(timeStep);
+    }
+}
+#endif
 
 int ThreadSafeDynamicsWorld::stepSimulationWithSubstepCallback(btScalar timeStep, int maxSubSteps,
                                                                btScalar fixedTimeStep, SubStepCallback onSubStep) {
@@ -60,6 +116,18 @@ int ThreadSafeDynamicsWorld::stepSimulationWithSubstepCallback(btScalar timeStep
     }
 
     if (subSteps) {
+#if BT_THREADSAFE
+        // the scheduler is shared by every world, so each one applies its own number of threads
+        btITaskScheduler* scheduler = btGetSequentialTaskScheduler();
+        if (isMultithreaded()) {
+            PhysicsTaskScheduler::getInstance()->setNumThreads(_numThreads);
+            scheduler = PhysicsTaskScheduler::getInstance();
+        }
+        if (btGetTaskScheduler() != scheduler) {
+            btSetTaskScheduler(scheduler);
+        }
+#endif
+
         //clamp the number of substeps, to prevent simulation grinding spiralling down to a halt
         int clampedSimulationSteps = (subSteps > maxSubSteps)? maxSubSteps : subSteps;
         _numSubsteps += clampedSimulationSteps;
@@ -21,21 +21,42 @@
 #include <BulletDynamics/Dynamics/btRigidBody.h>
 #include <BulletDynamics/Dynamics/btDiscreteDynamicsWorld.h>
 
+#if BT_THREADSAFE
+#include <BulletDynamics/Dynamics/btDiscreteDynamicsWorldMt.h>
+#endif
+
 #include "ObjectMotionState.h"
 
 #include <functional>
 
 using SubStepCallback = std::function<void()>;
 
-ATTRIBUTE_ALIGNED16(class) ThreadSafeDynamicsWorld : public btDiscreteDynamicsWorld {
+#if BT_THREADSAFE
+// Bullet was built with multithreading, so islands, narrowphase and integration can run on the task scheduler
+// (see PhysicsEngine::setNumThreads).  Unless the world is multithreaded it steps exactly like btDiscreteDynamicsWorld,
+// with Bullet's sequential island manager, since the multithreaded one batches islands differently.
+using DynamicsWorldBase = btDiscreteDynamicsWorldMt;
+#else
+using DynamicsWorldBase = btDiscreteDynamicsWorld;
+#endif
+
+ATTRIBUTE_ALIGNED16(class) ThreadSafeDynamicsWorld : public DynamicsWorldBase {
 public:
     BT_DECLARE_ALIGNED_ALLOCATOR();
 
+    // A world with more than one thread takes a btConstraintSolverPoolMt as its constraintSolver, and largeIslandSolver
+    // solves islands too big to be worth giving to a single solver of the pool, and may be null.  Both are ignored
+    // unless Bullet was built with multithreading.  Every step caps the shared PhysicsTaskScheduler at numThreads.
     ThreadSafeDynamicsWorld(
             btDispatcher* dispatcher,
             btBroadphaseInterface* pairCache,
             btConstraintSolver* constraintSolver,
-            btCollisionConfiguration* collisionConfiguration);
+            btConstraintSolver* largeIslandSolver,
+            btCollisionConfiguration* collisionConfiguration,
+            int numThreads = 1);
+
+    bool isMultithreaded() const { return _numThreads > 1; }
+    int getNumThreads() const { return _numThreads; }
 
     int getNumSubsteps() const { return _numSubsteps; }
     int stepSimulationWithSubstepCallback(btScalar timeStep, int maxSubSteps = 1,
@@ -55,6 +76,15 @@ public:
     void addChangedMotionState(ObjectMotionState* motionState) { _changedMotionStates.push_back(motionState); }
     virtual void debugDrawObject(const btTransform& worldTransform, const btCollisionShape* shape, const btVector3& color) override;
 
+protected:
+#if BT_THREADSAFE
+    // unless multithreaded, these skip btDiscreteDynamicsWorldMt's versions for btDiscreteDynamicsWorld's
+    virtual void solveConstraints(btContactSolverInfo& solverInfo) override;
+    virtual void predictUnconstraintMotion(btScalar timeStep) override;
+    virtual void createPredictiveContacts(btScalar timeStep) override;
+    virtual void integrateTransforms(btScalar timeStep) override;
+#endif
+
 private:
     // call this instead of non-virtual btDiscreteDynamicsWorld::synchronizeSingleMotionState()
     void synchronizeMotionState(btRigidBody* body);
@@ -66,6 +96,7 @@ private:
     SetOfMotionStates _activeStates;
     SetOfMotionStates _lastActiveStates;
     int _numSubsteps { 0 };
+    int _numThreads { 1 };
 };
 
 #endif // hifi_ThreadSafeDynamicsWorld_h
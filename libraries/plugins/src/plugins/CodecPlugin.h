@@ -16,6 +16,19 @@ class Encoder {
 public:
     virtual ~Encoder() { }
     virtual void encode(const QByteArray& decodedBuffer, QByteArray& encodedBuffer) = 0;
+
+    // Encodes straight into a caller-owned buffer, such as the payload of an outgoing packet. Returns the number of bytes
+    // written, or -1 if the frame could not be encoded or does not fit. Encoders should override this so that their
+    // frames are encoded without the allocations and copies made here.
+    virtual int encodeInto(const char* decodedBuffer, int decodedSize, char* encodedBuffer, int encodedCapacity) {
+        QByteArray encoded;
+        encode(QByteArray::fromRawData(decodedBuffer, decodedSize), encoded);
+        if (encoded.size() > encodedCapacity) {
+            return -1;
+        }
+        memcpy(encodedBuffer, encoded.constData(), encoded.size());
+        return encoded.size();
+    }
 };
 
 class Decoder {
@@ -0,0 +1,227 @@
+//
+//  FrameTracer.cpp
+//  libraries/shared/src
+//
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "FrameTracer.h"
+
+#include <chrono>
+
+#ifndef Q_OS_WIN
+#include <csignal>
+#endif
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QDateTime>
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+#include <QtCore/QTextStream>
+#include <QtCore/QThread>
+
+#include "PathUtils.h"
+#include "PortableHighResolutionClock.h"
+#include "SharedLogging.h"
+
+using namespace tracing;
+
+std::atomic<uint32_t> FrameTracer::_numDumpAllRequests { 0 };
+
+static std::atomic<uint64_t> nextTracerID { 1 };
+
+// the buffer this thread records into, for the tracer it last recorded for
+static thread_local uint64_t threadBufferTracerID = 0;
+static thread_local void* threadBuffer = nullptr;
+
+static QString escapeJson(const QString& string) {
+    QString escaped = string;
+    escaped.replace('\\', "\\\\").replace('"', "\\\"");
+    return escaped;
+}
+
+#ifndef Q_OS_WIN
+static void dumpSignalHandler(int param) {
+    FrameTracer::requestDumpAll();
+}
+#endif
+
+FrameTracer::FrameTracer(const QString& name, int eventsPerThread) :
+    _name(name),
+    _eventsPerThread(std::max(eventsPerThread, 1)),
+    _id(nextTracerID++),
+    _lastDumpAllRequest(_numDumpAllRequests)
+{
+}
+
+uint64_t FrameTracer::now() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        p_high_resolution_clock::now().time_since_epoch()).count();
+}
+
+void FrameTracer::installDumpSignalHandler() {
+#ifndef Q_OS_WIN
+    signal(SIGUSR1, dumpSignalHandler);
+#endif
+}
+
+void FrameTracer::beginFrame(uint32_t frame) {
+    _frame.store(frame, std::memory_order_relaxed);
+    _frameBeginUsecs = now();
+
+    bool isSampled = _isEnabled && (frame % (uint32_t)_sampleInterval.load()) == 0;
+    _isActive.store(isSampled, std::memory_order_relaxed);
+}
+
+void FrameTracer::endFrame(uint64_t deadlineUsecs) {
+    uint64_t endUsecs = now();
+    bool wasActive = isActive();
+    if (wasActive) {
+        record("frame", _frameBeginUsecs, endUsecs);
+    }
+    _isActive.store(false, std::memory_order_relaxed);
+
+    // the workers are done with the frame, so the buffers can be read
+    bool missedDeadline = endUsecs - _frameBeginUsecs > deadlineUsecs;
+    if (missedDeadline) {
+        ++_numDeadlineMisses;
+    }
+
+    uint32_t numDumpAllRequests = _numDumpAllRequests;
+    bool isDumpRequested = _isDumpRequested.exchange(false) || numDumpAllRequests != _lastDumpAllRequest;
+    _lastDumpAllRequest = numDumpAllRequests;
+
+    if (isDumpRequested) {
+        if (_isEnabled) {
+            dump("requested");
+        } else {
+            qCInfo(shared) << "Not writing a" << _name << "frame trace, since frame tracing is disabled";
+        }
+    } else if (missedDeadline && wasActive && _dumpOnDeadlineMiss &&
+               (_lastDeadlineDumpUsecs == 0 || endUsecs - _lastDeadlineDumpUsecs > MIN_DEADLINE_DUMP_INTERVAL_USECS)) {
+        // don't let a run of slow frames, made slower by writing traces, fill the disk
+        _lastDeadlineDumpUsecs = endUsecs;
+        dump(QString("frame %1 took %2 us").arg(_frame.load()).arg((quint64)(endUsecs - _frameBeginUsecs)));
+    }
+}
+
+FrameTracer::ThreadBuffer* FrameTracer::getThreadBuffer() {
+    if (threadBufferTracerID == _id) {
+        return static_cast<ThreadBuffer*>(threadBuffer);
+    }
+
+    // this thread last recorded for another tracer, or hasn't recorded for this one yet
+    int64_t threadID = int64_t(QThread::currentThreadId());
+    ThreadBuffer* threadBufferPointer = nullptr;
+    {
+        std::lock_guard<std::mutex> guard(_buffersMutex);
+        auto it = std::find_if(_buffers.begin(), _buffers.end(), [threadID](const std::unique_ptr<ThreadBuffer>& buffer) {
+            return buffer->threadID == threadID;
+        });
+        if (it != _buffers.end()) {
+            threadBufferPointer = it->get();
+        } else {
+            auto buffer = std::make_unique<ThreadBuffer>();
+            QThread* thread = QThread::currentThread();
+            buffer->threadName = thread->objectName().isEmpty() ? thread->metaObject()->className() : thread->objectName();
+            buffer->threadID = threadID;
+            buffer->events.resize(_eventsPerThread);
+            threadBufferPointer = buffer.get();
+            _buffers.push_back(std::move(buffer));
+        }
+    }
+
+    threadBufferTracerID = _id;
+    threadBuffer = threadBufferPointer;
+    return threadBufferPointer;
+}
+
+void FrameTracer::record(const char* name, uint64_t beginUsecs, uint64_t endUsecs, int64_t arg) {
+    ThreadBuffer* buffer = getThreadBuffer();
+
+    Event& event = buffer->events[buffer->numRecorded % buffer->events.size()];
+    event.name = name;
+    event.beginUsecs = beginUsecs;
+    event.durationUsecs = (uint32_t)(endUsecs - beginUsecs);
+    event.frame = _frame.load(std::memory_order_relaxed);
+    event.arg = arg;
+
+    ++buffer->numRecorded;
+}
+
+QByteArray FrameTracer::getChromeTrace() const {
+    std::lock_guard<std::mutex> guard(_buffersMutex);
+
+    auto processID = QCoreApplication::applicationPid();
+
+    QByteArray data;
+    QTextStream out(&data);
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    out << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":" << processID
+        << ",\"args\":{\"name\":\"" << escapeJson(_name) << "\"}}";
+
+    for (const auto& buffer : _buffers) {
+        out << ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":" << processID << ",\"tid\":" << (qint64)buffer->threadID
+            << ",\"args\":{\"name\":\"" << escapeJson(buffer->threadName) << "\"}}";
+
+        // oldest first, from where the ring buffer has wrapped to
+        uint64_t size = buffer->events.size();
+        uint64_t first = buffer->numRecorded > size ? buffer->numRecorded - size : 0;
+        for (uint64_t i = first; i < buffer->numRecorded; i++) {
+            const Event& event = buffer->events[i % size];
+            out << ",\n{\"name\":\"" << event.name << "\",\"cat\":\"" << escapeJson(_name) << "\",\"ph\":\"X\""
+                << ",\"ts\":" << (quint64)event.beginUsecs << ",\"dur\":" << event.durationUsecs
+                << ",\"pid\":" << processID << ",\"tid\":" << (qint64)buffer->threadID
+                << ",\"args\":{\"frame\":" << event.frame;
+            if (event.arg != NO_ARG) {
+                out << ",\"arg\":" << (qint64)event.arg;
+            }
+            out << "}}";
+        }
+    }
+
+    out << "\n]}\n";
+    out.flush();
+    return data;
+}
+
+bool FrameTracer::dump(const QString& reason) {
+    if (_dumpDirectory.isEmpty()) {
+        _dumpDirectory = QDir(PathUtils::getAppLocalDataPath()).filePath("traces");
+    }
+
+    QDir directory(_dumpDirectory);
+    if (!directory.mkpath(".")) {
+        qCWarning(shared) << "Unable to create the frame trace directory" << _dumpDirectory;
+        return false;
+    }
+
+    QString fileName = QString("%1-%2-frame%3.json").arg(_name)
+        .arg(QDateTime::currentDateTime().toString("yyyy-MM-dd_hh-mm-ss-zzz")).arg(_frame.load());
+    QString path = directory.filePath(fileName);
+
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qCWarning(shared) << "Unable to write the frame trace" << path;
+        return false;
+    }
+    file.write(getChromeTrace());
+    file.close();
+
+    // start the next trace afresh, rather than repeating these frames in it
+    clear();
+    ++_numDumps;
+
+    qCInfo(shared).noquote() << "Wrote" << _name << "frame trace to" << path << "-" << reason;
+    return true;
+}
+
+void FrameTracer::clear() {
+    std::lock_guard<std::mutex> guard(_buffersMutex);
+    for (auto& buffer : _buffers) {
+        buffer->numRecorded = 0;
+    }
+}
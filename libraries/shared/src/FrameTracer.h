@@ -0,0 +1,152 @@
+//
+//  FrameTracer.h
+//  libraries/shared/src
+//
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+#ifndef hifi_FrameTracer_h
+#define hifi_FrameTracer_h
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <QtCore/QByteArray>
+#include <QtCore/QString>
+
+namespace tracing {
+
+// Records where the threads of a fixed-rate loop, such as a mixer frame, spend their time, into a fixed-size ring buffer
+// per thread. The most recent frames are written out as Chrome trace JSON, which chrome://tracing and ui.perfetto.dev
+// load, when asked to or when a frame misses its deadline.
+//
+// The loop's thread brackets each frame with beginFrame and endFrame, and traced ranges may only be recorded in between,
+// by that thread or by workers that finish before endFrame, since the buffers are written out without locking. Recording
+// doesn't lock or allocate once a thread has its buffer. While tracing is disabled, or the frame isn't sampled, a traced
+// range costs a relaxed load and a predictable branch.
+class FrameTracer {
+public:
+    static const int DEFAULT_EVENTS_PER_THREAD = 16384;
+    static const uint64_t MIN_DEADLINE_DUMP_INTERVAL_USECS = 10 * 1000 * 1000;
+
+    static const int64_t NO_ARG = -1;
+
+    struct Event {
+        const char* name { nullptr }; // not copied, so must outlive the tracer
+        uint64_t beginUsecs { 0 };
+        uint32_t durationUsecs { 0 };
+        uint32_t frame { 0 };
+        int64_t arg { NO_ARG };
+    };
+
+    FrameTracer(const QString& name, int eventsPerThread = DEFAULT_EVENTS_PER_THREAD);
+
+    FrameTracer(const FrameTracer&) = delete;
+    FrameTracer& operator=(const FrameTracer&) = delete;
+
+    static uint64_t now();
+
+    void setEnabled(bool enabled) { _isEnabled = enabled; }
+    bool isEnabled() const { return _isEnabled; }
+
+    // trace one frame in every sampleInterval
+    void setSampleInterval(int sampleInterval) { _sampleInterval = std::max(sampleInterval, 1); }
+    int getSampleInterval() const { return _sampleInterval; }
+
+    void setDumpOnDeadlineMiss(bool dumpOnDeadlineMiss) { _dumpOnDeadlineMiss = dumpOnDeadlineMiss; }
+    // where traces are written, the traces folder of the app's local data by default
+    void setDumpDirectory(const QString& dumpDirectory) { _dumpDirectory = dumpDirectory; }
+
+    void beginFrame(uint32_t frame);
+    // ends the frame begun last, writing a trace if it took longer than deadlineUsecs or one was requested
+    void endFrame(uint64_t deadlineUsecs);
+
+    // whether ranges are being recorded for the current frame
+    bool isActive() const { return _isActive.load(std::memory_order_relaxed); }
+    void record(const char* name, uint64_t beginUsecs, uint64_t endUsecs, int64_t arg = NO_ARG);
+
+    // asks for a trace to be written at the end of the current frame
+    void requestDump() { _isDumpRequested = true; }
+    // asks every tracer in the process for a trace; safe to call from a signal handler
+    static void requestDumpAll() { _numDumpAllRequests++; }
+    // has SIGUSR1 ask every tracer for a trace, where there are signals
+    static void installDumpSignalHandler();
+
+    QByteArray getChromeTrace() const;
+    bool dump(const QString& reason);
+    void clear();
+
+    uint32_t getNumDeadlineMisses() const { return _numDeadlineMisses; }
+    uint32_t getNumDumps() const { return _numDumps; }
+
+private:
+    struct ThreadBuffer {
+        QString threadName;
+        int64_t threadID { 0 };
+        std::vector<Event> events;
+        uint64_t numRecorded { 0 };
+    };
+
+    ThreadBuffer* getThreadBuffer();
+
+    const QString _name;
+    const int _eventsPerThread;
+    const uint64_t _id;
+
+    std::atomic<bool> _isActive { false };
+    std::atomic<bool> _isEnabled { false };
+    std::atomic<bool> _isDumpRequested { false };
+    std::atomic<uint32_t> _frame { 0 };
+
+    std::atomic<int> _sampleInterval { 1 };
+    std::atomic<bool> _dumpOnDeadlineMiss { true };
+    QString _dumpDirectory;
+
+    uint64_t _frameBeginUsecs { 0 };
+    uint64_t _lastDeadlineDumpUsecs { 0 };
+    uint32_t _lastDumpAllRequest { 0 };
+    uint32_t _numDeadlineMisses { 0 };
+    uint32_t _numDumps { 0 };
+
+    mutable std::mutex _buffersMutex;
+    std::vector<std::unique_ptr<ThreadBuffer>> _buffers;
+
+    static std::atomic<uint32_t> _numDumpAllRequests;
+};
+
+// Records the time from its construction to its destruction, if the tracer is active when it is constructed.
+class FrameTraceRange {
+public:
+    FrameTraceRange(FrameTracer& tracer, const char* name, int64_t arg = FrameTracer::NO_ARG) :
+        _tracer(tracer.isActive() ? &tracer : nullptr), _name(name), _arg(arg) {
+        if (_tracer) {
+            _beginUsecs = FrameTracer::now();
+        }
+    }
+    ~FrameTraceRange() {
+        if (_tracer) {
+            _tracer->record(_name, _beginUsecs, FrameTracer::now(), _arg);
+        }
+    }
+
+private:
+    FrameTracer* const _tracer;
+    const char* const _name;
+    const int64_t _arg;
+    uint64_t _beginUsecs { 0 };
+};
+
+}
+
+#define FRAME_TRACE_RANGE(tracer, name) tracing::FrameTraceRange frameTraceRangeThis(tracer, name);
+#define FRAME_TRACE_RANGE_ARG(tracer, name, arg) tracing::FrameTraceRange frameTraceRangeThis(tracer, name, (int64_t)(arg));
+
+#endif // hifi_FrameTracer_h
@@ -0,0 +1,62 @@
+//
+//  ContentCache.cpp
+//  libraries/shared/src/shared
+//
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ContentCache.h"
+
+#include <QtCore/QCryptographicHash>
+#include <QtCore/QFile>
+
+using namespace cache;
+
+static const std::string ARTIFACT_EXT = "artifact";
+
+ContentCache::ContentCache(const std::string& dirname, QObject* parent) :
+    FileCache(dirname, ARTIFACT_EXT, parent) {
+}
+
+FileCache::Key ContentCache::makeKey(const QByteArray& contentID, const QString& artifactType, int artifactVersion) {
+    QCryptographicHash hasher(QCryptographicHash::Sha256);
+    hasher.addData(contentID);
+    hasher.addData("\n");
+    hasher.addData(artifactType.toUtf8());
+    hasher.addData("\n");
+    hasher.addData(QByteArray::number(artifactVersion));
+    return hasher.result().toHex().toStdString();
+}
+
+bool ContentCache::store(const Key& key, const QByteArray& artifact) {
+    // the same key always describes the same artifact, so an existing file is as good as a new one
+    if (getFile(key)) {
+        return true;
+    }
+    return (bool)writeFile(artifact.constData(), Metadata(key, artifact.size()));
+}
+
+bool ContentCache::load(const Key& key, QByteArray& artifact) {
+    // hold on to the file while reading it, so that it can't be ejected
+    auto file = getFile(key);
+    if (file) {
+        QFile artifactFile(QString::fromStdString(file->getFilepath()));
+        if (artifactFile.open(QIODevice::ReadOnly)) {
+            artifact = artifactFile.readAll();
+            if ((size_t)artifact.size() == file->getLength()) {
+                _numHits++;
+                emit dirty();
+                return true;
+            }
+        }
+        qCWarning(file_cache) << "Failed to read cached artifact" << file->getFilepath().c_str();
+    }
+
+    artifact.clear();
+    _numMisses++;
+    emit dirty();
+    return false;
+}
@@ -0,0 +1,51 @@
+//
+//  ContentCache.h
+//  libraries/shared/src/shared
+//
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_ContentCache_h
+#define hifi_ContentCache_h
+
+#include <atomic>
+
+#include <QtCore/QByteArray>
+#include <QtCore/QString>
+
+#include "FileCache.h"
+
+namespace cache {
+
+// Content addressed store for artifacts processed from resources, such as decoded audio.
+// Artifacts are keyed by the identity of the content they were made from (an ATP hash, an HTTP ETag or a hash of the
+// data) and by the type and version of the artifact, so they can be reused across sessions for as long as the content
+// doesn't change, and are never served for content that did.
+class ContentCache : public FileCache {
+    Q_OBJECT
+
+public:
+    ContentCache(const std::string& dirname, QObject* parent = nullptr);
+
+    static Key makeKey(const QByteArray& contentID, const QString& artifactType, int artifactVersion);
+
+    /// Stores an artifact on disk. Returns true if the artifact is stored, including by an earlier call.
+    bool store(const Key& key, const QByteArray& artifact);
+
+    /// Reads an artifact from disk. Returns false if there is none.
+    bool load(const Key& key, QByteArray& artifact);
+
+    size_t getNumHits() const { return _numHits; }
+    size_t getNumMisses() const { return _numMisses; }
+
+private:
+    std::atomic<size_t> _numHits { 0 };
+    std::atomic<size_t> _numMisses { 0 };
+};
+
+}
+
+#endif // hifi_ContentCache_h
@@ -0,0 +1,96 @@
+//
+//  Parallel.cpp
+//  task/src/task
+//
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "Parallel.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+
+#include <QtCore/QRunnable>
+#include <QtCore/QThreadPool>
+
+namespace {
+
+// Shared between the caller and the pool workers. Workers that only start once every chunk has been claimed find
+// nothing to do, so the caller can return without waiting for them.
+struct ParallelRange {
+    ParallelRange(int count, int grainSize, const std::function<void(int, int)>& rangeFunction) :
+        rangeFunction(rangeFunction), count(count), grainSize(grainSize), remaining(count) {}
+
+    // Returns false once every chunk has been claimed.
+    bool runNextChunk() {
+        int begin = nextBegin.fetch_add(grainSize);
+        if (begin >= count) {
+            return false;
+        }
+        int end = std::min(begin + grainSize, count);
+        rangeFunction(begin, end);
+
+        if (remaining.fetch_sub(end - begin) == end - begin) {
+            std::lock_guard<std::mutex> lock(mutex);
+            finished.notify_all();
+        }
+        return true;
+    }
+
+    void waitUntilFinished() {
+        std::unique_lock<std::mutex> lock(mutex);
+        finished.wait(lock, [this] { return remaining.load() == 0; });
+    }
+
+    const std::function<void(int, int)> rangeFunction;
+    const int count;
+    const int grainSize;
+    std::atomic<int> nextBegin { 0 };
+    std::atomic<int> remaining;
+    std::mutex mutex;
+    std::condition_variable finished;
+};
+
+class ParallelRangeWorker : public QRunnable {
+public:
+    ParallelRangeWorker(const std::shared_ptr<ParallelRange>& range) : _range(range) {}
+
+    void run() override {
+        while (_range->runNextChunk()) {
+        }
+    }
+
+private:
+    std::shared_ptr<ParallelRange> _range;
+};
+
+}
+
+void task::parallelForRange(int count, int grainSize, const std::function<void(int begin, int end)>& rangeFunction) {
+    if (count <= 0) {
+        return;
+    }
+    grainSize = std::max(grainSize, 1);
+
+    auto threadPool = QThreadPool::globalInstance();
+    int numChunks = (count + grainSize - 1) / grainSize;
+    int numWorkers = std::min(numChunks - 1, threadPool->maxThreadCount());
+    if (numWorkers <= 0) {
+        rangeFunction(0, count);
+        return;
+    }
+
+    auto range = std::make_shared<ParallelRange>(count, grainSize, rangeFunction);
+    for (int i = 0; i < numWorkers; i++) {
+        threadPool->start(new ParallelRangeWorker(range));
+    }
+    while (range->runNextChunk()) {
+    }
+    range->waitUntilFinished();
+}
@@ -0,0 +1,36 @@
+//
+//  Parallel.h
+//  task/src/task
+//
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_task_Parallel_h
+#define hifi_task_Parallel_h
+
+#include <functional>
+
+namespace task {
+
+// Calls rangeFunction(begin, end) on chunks of at least grainSize items covering [0, count), spread across the global
+// thread pool, and returns once every chunk is done.
+// The calling thread works through chunks too, so this is safe to call from a job already running on a pool thread.
+void parallelForRange(int count, int grainSize, const std::function<void(int begin, int end)>& rangeFunction);
+
+// Calls function(i) for every i in [0, count). Calls for different indices may run at the same time, so they must only
+// write to state owned by their index.
+template <class F>
+void parallelFor(int count, F function, int grainSize = 1) {
+    parallelForRange(count, grainSize, [&function](int begin, int end) {
+        for (int i = begin; i < end; i++) {
+            function(i);
+        }
+    });
+}
+
+}
+
+#endif // hifi_task_Parallel_h
@@ -13,8 +13,10 @@
 #define hifi_task_Task_h
 
 #include "Config.h"
+#include "Parallel.h"
 #include "Varying.h"
 
+#include <type_traits>
 #include <unordered_map>
 
 namespace task {
@@ -250,6 +252,11 @@ public:
         Varying _output;
         Jobs _jobs;
 
+        // For each job, the group of concurrent jobs it belongs to, or 0 if it runs on its own
+        std::vector<int> _jobGroups;
+        int _numJobGroups { 0 };
+        int _currentJobGroup { 0 };
+
         const Varying getInput() const override { return _input; }
         const Varying getOutput() const override { return _output; }
         Varying& editInput() override { return _input; }
@@ -259,6 +266,7 @@ public:
         // Create a new job in the container's queue; returns the job's output
         template <class NT, class... NA> const Varying addJob(std::string name, const Varying& input, NA&&... args) {
             _jobs.emplace_back((NT::JobModel::create(name, input, std::forward<NA>(args)...)));
+            _jobGroups.push_back(_currentJobGroup);
 
             // Conect the child config to this task's config
             std::static_pointer_cast<JobConfig>(Concept::getConfiguration())->connectChildConfig(_jobs.back().getConfiguration(), name);
@@ -269,6 +277,11 @@ public:
             const auto input = Varying(typename NT::JobModel::Input());
             return addJob<NT>(name, input, std::forward<NA>(args)...);
         }
+
+        // Jobs added between beginConcurrentJobs and endConcurrentJobs run at the same time on the thread pool, each with
+        // its own copy of the context. They must not consume each other's outputs.
+        void beginConcurrentJobs() { _currentJobGroup = ++_numJobGroups; }
+        void endConcurrentJobs() { _currentJobGroup = 0; }
     };
 
     template <class T, class C = Config, class I = None, class O = None> class TaskModel : public TaskConcept {
@@ -330,8 +343,20 @@ public:
         void run(const ContextPointer& jobContext) override {
             auto config = std::static_pointer_cast<C>(Concept::_config);
             if (config->isEnabled()) {
-                for (auto job : TaskConcept::_jobs) {
-                    job.run(jobContext);
+                const auto& jobGroups = TaskConcept::_jobGroups;
+                size_t numJobs = TaskConcept::_jobs.size();
+                for (size_t begin = 0; begin < numJobs; ) {
+                    size_t end = begin + 1;
+                    while (jobGroups[begin] != 0 && end < numJobs && jobGroups[end] == jobGroups[begin]) {
+                        end++;
+                    }
+                    if (end - begin > 1) {
+                        runConcurrently(jobContext, begin, end);
+                    } else {
+                        TaskConcept::_jobs[begin].run(jobContext);
+                    }
+                    begin = end;
+
                     if (jobContext->taskFlow.doAbortTask()) {
                         jobContext->taskFlow.reset();
                         return;
@@ -339,6 +364,34 @@ public:
                 }
             }
         }
+
+    protected:
+        // Each concurrent job gets a copy of the context, since running a job sets the context's current config
+        template <class CT = Context>
+        typename std::enable_if<std::is_copy_constructible<CT>::value>::type runConcurrently(const ContextPointer& jobContext, size_t begin, size_t end) {
+            std::vector<ContextPointer> jobContexts;
+            for (size_t i = begin; i < end; i++) {
+                jobContexts.push_back(std::make_shared<Context>(*jobContext));
+            }
+            parallelFor((int)(end - begin), [&](int i) {
+                TaskConcept::_jobs[begin + i].run(jobContexts[i]);
+            });
+            for (auto& context : jobContexts) {
+                if (context->taskFlow.doAbortTask()) {
+                    jobContext->taskFlow.abortTask();
+                }
+            }
+        }
+
+        template <class CT = Context>
+        typename std::enable_if<!std::is_copy_constructible<CT>::value>::type runConcurrently(const ContextPointer& jobContext, size_t begin, size_t end) {
+            for (size_t i = begin; i < end; i++) {
+                TaskConcept::_jobs[i].run(jobContext);
+                if (jobContext->taskFlow.doAbortTask()) {
+                    return;
+                }
+            }
+        }
     };
     template <class T, class C = Config> using Model = TaskModel<T, C, None, None>;
     template <class T, class I, class C = Config> using ModelI = TaskModel<T, C, I, None>;
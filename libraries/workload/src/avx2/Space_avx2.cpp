@@ -0,0 +1,90 @@
+//
+//  Space_avx2.cpp
+//  libraries/workload/src
+//
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifdef __AVX2__
+
+// keep multiplies and adds separate, so that the results match the scalar kernels exactly
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC optimize("fp-contract=off")
+#endif
+
+#include <stdint.h>
+#include <immintrin.h>
+
+#include "../workload/Region.h"
+
+using namespace workload;
+
+// classifies 8 proxies, returning their regions in the low byte of each 32-bit lane
+static inline __m256i classifyProxies8(__m256 x, __m256 y, __m256 z, __m256 radius, const float* regionX,
+                                       const float* regionY, const float* regionZ, const float* regionRadius,
+                                       int numViews) {
+    __m256i regions = _mm256_set1_epi32(Region::R4);
+    __m256 unassigned = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+
+    for (int k = 0; k < (int)Region::NUM_TRACKED_REGIONS; k++) {
+        __m256 touches = _mm256_setzero_ps();
+        for (int j = k * numViews; j < (k + 1) * numViews; j++) {
+            __m256 dx = _mm256_sub_ps(x, _mm256_broadcast_ss(&regionX[j]));
+            __m256 dy = _mm256_sub_ps(y, _mm256_broadcast_ss(&regionY[j]));
+            __m256 dz = _mm256_sub_ps(z, _mm256_broadcast_ss(&regionZ[j]));
+            __m256 distance2 = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy)),
+                                             _mm256_mul_ps(dz, dz));
+            __m256 touchDistance = _mm256_add_ps(radius, _mm256_broadcast_ss(&regionRadius[j]));
+            touches = _mm256_or_ps(touches, _mm256_cmp_ps(distance2, _mm256_mul_ps(touchDistance, touchDistance),
+                                                          _CMP_LT_OQ));
+        }
+
+        // lanes take the first region they touch
+        __m256 entered = _mm256_and_ps(touches, unassigned);
+        regions = _mm256_castps_si256(_mm256_blendv_ps(_mm256_castsi256_ps(regions),
+                                                       _mm256_castsi256_ps(_mm256_set1_epi32(k)), entered));
+        unassigned = _mm256_andnot_ps(touches, unassigned);
+        if (_mm256_testz_ps(unassigned, unassigned)) {
+            break;
+        }
+    }
+    return regions;
+}
+
+void classifyProxies_AVX2(const float* x, const float* y, const float* z, const float* radius, uint8_t* regions,
+                          int numProxies, const float* regionX, const float* regionY, const float* regionZ,
+                          const float* regionRadius, int numViews) {
+    alignas(32) int32_t result[8];
+
+    int i = 0;
+    for (; i < numProxies - 7; i += 8) {  // blocks of 8
+        __m256i r = classifyProxies8(_mm256_loadu_ps(&x[i]), _mm256_loadu_ps(&y[i]), _mm256_loadu_ps(&z[i]),
+                                     _mm256_loadu_ps(&radius[i]), regionX, regionY, regionZ, regionRadius, numViews);
+        _mm256_store_si256((__m256i*)result, r);
+        for (int j = 0; j < 8; j++) {
+            regions[i + j] = (uint8_t)result[j];
+        }
+    }
+
+    if (i < numProxies) {   // remainder, padded with copies of the last proxy
+        alignas(32) float tail[4][8];
+        for (int j = 0; j < 8; j++) {
+            int src = (i + j < numProxies) ? i + j : numProxies - 1;
+            tail[0][j] = x[src];
+            tail[1][j] = y[src];
+            tail[2][j] = z[src];
+            tail[3][j] = radius[src];
+        }
+        __m256i r = classifyProxies8(_mm256_load_ps(tail[0]), _mm256_load_ps(tail[1]), _mm256_load_ps(tail[2]),
+                                     _mm256_load_ps(tail[3]), regionX, regionY, regionZ, regionRadius, numViews);
+        _mm256_store_si256((__m256i*)result, r);
+        for (int j = 0; i + j < numProxies; j++) {
+            regions[i + j] = (uint8_t)result[j];
+        }
+    }
+}
+
+#endif
@@ -46,7 +46,7 @@ public:
 
     Sphere sphere;
     uint8_t region{ Region::INVALID };
-    uint8_t prevRegion{ Region::INVALID };
+    uint8_t prevRegion{ Region::INVALID }; // the region before the last change
     uint16_t _padding;
     uint32_t _paddings[3];
 
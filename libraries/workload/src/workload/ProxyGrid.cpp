@@ -0,0 +1,195 @@
+//
+//  ProxyGrid.cpp
+//  libraries/workload/src/workload
+//
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ProxyGrid.h"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace workload;
+
+// large enough that most proxies fit well inside one cell, small enough that the region boundaries cut few cells
+const float ProxyGrid::CELL_SIZE = 64.0f;
+
+// cell coordinates are packed into 21 bits each
+static const float MAX_CELL_COORD = (float)((1 << 20) - 1);
+static const uint64_t CELL_COORD_MASK = (1 << 21) - 1;
+
+void ProxyGrid::Cell::refreshRadiusBounds() {
+    if (radius.empty()) {
+        minRadius = 0.0f;
+        maxRadius = 0.0f;
+    } else {
+        auto bounds = std::minmax_element(radius.begin(), radius.end());
+        minRadius = *bounds.first;
+        maxRadius = *bounds.second;
+    }
+    radiusBoundsDirty = false;
+}
+
+ProxyGrid::ProxyGrid() {
+    clear();
+}
+
+void ProxyGrid::insert(ProxyID id, const Sphere& sphere) {
+    if (id < 0) {
+        return;
+    }
+    if (contains(id)) {
+        removeFromCell(id);
+    } else if (id >= (ProxyID)_locations.size()) {
+        _locations.resize(id + 1);
+    }
+    addToCell(id, sphere, Region::UNKNOWN, findOrAddCell(sphere));
+}
+
+void ProxyGrid::update(ProxyID id, const Sphere& sphere) {
+    if (!contains(id)) {
+        return;
+    }
+    Location location = _locations[id];
+    uint32_t cellIndex = findOrAddCell(sphere);
+    if ((uint32_t)location.cell != cellIndex) {
+        uint8_t region = _cells[location.cell].regions[location.slot];
+        removeFromCell(id);
+        addToCell(id, sphere, region, cellIndex);
+        return;
+    }
+
+    Cell& cell = _cells[location.cell];
+    cell.x[location.slot] = sphere.x;
+    cell.y[location.slot] = sphere.y;
+    cell.z[location.slot] = sphere.z;
+    float oldRadius = cell.radius[location.slot];
+    cell.radius[location.slot] = sphere.w;
+    if (sphere.w != oldRadius) {
+        if (oldRadius == cell.minRadius || oldRadius == cell.maxRadius) {
+            cell.radiusBoundsDirty = true;
+        } else {
+            cell.minRadius = std::min(cell.minRadius, sphere.w);
+            cell.maxRadius = std::max(cell.maxRadius, sphere.w);
+        }
+    }
+}
+
+void ProxyGrid::remove(ProxyID id) {
+    if (contains(id)) {
+        removeFromCell(id);
+    }
+}
+
+void ProxyGrid::clear() {
+    _cells.clear();
+    _freeCells.clear();
+    _cellsByKey.clear();
+    _cellKeys.clear();
+    _locations.clear();
+
+    _cells.emplace_back();
+    _cellKeys.push_back(0);
+}
+
+uint32_t ProxyGrid::findOrAddCell(const Sphere& sphere) {
+    glm::vec3 coords = glm::floor(glm::vec3(sphere) / CELL_SIZE);
+    bool isBounded = std::isfinite(sphere.w) && sphere.w >= 0.0f;
+    for (int i = 0; i < 3; ++i) {
+        // also false for NaN
+        isBounded = isBounded && std::fabs(coords[i]) <= MAX_CELL_COORD;
+    }
+    if (!isBounded) {
+        return UNBOUNDED_CELL;
+    }
+
+    glm::ivec3 cellCoords(coords);
+    uint64_t key = ((uint64_t)(cellCoords.x & CELL_COORD_MASK) << 42) |
+        ((uint64_t)(cellCoords.y & CELL_COORD_MASK) << 21) | (uint64_t)(cellCoords.z & CELL_COORD_MASK);
+    auto itr = _cellsByKey.find(key);
+    if (itr != _cellsByKey.end()) {
+        return itr->second;
+    }
+
+    uint32_t cellIndex;
+    if (_freeCells.empty()) {
+        cellIndex = (uint32_t)_cells.size();
+        _cells.emplace_back();
+        _cellKeys.push_back(key);
+    } else {
+        cellIndex = _freeCells.back();
+        _freeCells.pop_back();
+        _cellKeys[cellIndex] = key;
+    }
+    Cell& cell = _cells[cellIndex];
+    cell.minCorner = coords * CELL_SIZE;
+    cell.maxCorner = (coords + glm::vec3(1.0f)) * CELL_SIZE;
+    cell.isBounded = true;
+    _cellsByKey[key] = cellIndex;
+    return cellIndex;
+}
+
+void ProxyGrid::addToCell(ProxyID id, const Sphere& sphere, uint8_t region, uint32_t cellIndex) {
+    Cell& cell = _cells[cellIndex];
+    if (cell.proxyIDs.empty()) {
+        cell.minRadius = sphere.w;
+        cell.maxRadius = sphere.w;
+        cell.radiusBoundsDirty = false;
+        cell.commonRegion = region;
+    } else {
+        if (!cell.radiusBoundsDirty) {
+            cell.minRadius = std::min(cell.minRadius, sphere.w);
+            cell.maxRadius = std::max(cell.maxRadius, sphere.w);
+        }
+        if (region != cell.commonRegion) {
+            cell.commonRegion = Region::INVALID;
+        }
+    }
+    _locations[id].cell = (int32_t)cellIndex;
+    _locations[id].slot = (int32_t)cell.proxyIDs.size();
+    cell.x.push_back(sphere.x);
+    cell.y.push_back(sphere.y);
+    cell.z.push_back(sphere.z);
+    cell.radius.push_back(sphere.w);
+    cell.regions.push_back(region);
+    cell.proxyIDs.push_back(id);
+}
+
+void ProxyGrid::removeFromCell(ProxyID id) {
+    Location location = _locations[id];
+    _locations[id] = Location();
+    uint32_t cellIndex = (uint32_t)location.cell;
+    Cell& cell = _cells[cellIndex];
+    float radius = cell.radius[location.slot];
+    if (radius == cell.minRadius || radius == cell.maxRadius) {
+        cell.radiusBoundsDirty = true;
+    }
+
+    // move the last proxy of the cell into the slot
+    int32_t lastSlot = (int32_t)cell.proxyIDs.size() - 1;
+    if (location.slot != lastSlot) {
+        ProxyID lastID = cell.proxyIDs[lastSlot];
+        cell.x[location.slot] = cell.x[lastSlot];
+        cell.y[location.slot] = cell.y[lastSlot];
+        cell.z[location.slot] = cell.z[lastSlot];
+        cell.radius[location.slot] = cell.radius[lastSlot];
+        cell.regions[location.slot] = cell.regions[lastSlot];
+        cell.proxyIDs[location.slot] = lastID;
+        _locations[lastID].slot = location.slot;
+    }
+    cell.x.pop_back();
+    cell.y.pop_back();
+    cell.z.pop_back();
+    cell.radius.pop_back();
+    cell.regions.pop_back();
+    cell.proxyIDs.pop_back();
+
+    if (cell.proxyIDs.empty() && cellIndex != UNBOUNDED_CELL) {
+        _cellsByKey.erase(_cellKeys[cellIndex]);
+        _freeCells.push_back(cellIndex);
+    }
+}
@@ -0,0 +1,89 @@
+//
+//  ProxyGrid.h
+//  libraries/workload/src/workload
+//
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_workload_ProxyGrid_h
+#define hifi_workload_ProxyGrid_h
+
+#include <unordered_map>
+#include <vector>
+#include <glm/glm.hpp>
+
+#include "Transaction.h"
+
+namespace workload {
+
+// Coarse uniform grid over the proxies of a Space, so that the proxies of a cell can be classified against the view
+// regions all at once when the whole cell is inside or outside of them.
+//
+// Each cell keeps the spheres and regions of its proxies in separate arrays, ready for the SIMD classification kernel
+// and without touching the proxies themselves unless their region changes.
+// Proxies with a center or radius the grid can't bound go to the first cell, which is never classified as a whole.
+class ProxyGrid {
+public:
+    static const float CELL_SIZE;
+    static const uint32_t UNBOUNDED_CELL = 0;
+
+    class Cell {
+    public:
+        void refreshRadiusBounds();
+
+        std::vector<float> x;
+        std::vector<float> y;
+        std::vector<float> z;
+        std::vector<float> radius;
+        std::vector<uint8_t> regions;
+        std::vector<ProxyID> proxyIDs;
+
+        glm::vec3 minCorner { 0.0f };
+        glm::vec3 maxCorner { 0.0f };
+        float minRadius { 0.0f };
+        float maxRadius { 0.0f };
+        // the region of every proxy in the cell, or INVALID when they may differ
+        uint8_t commonRegion { Region::INVALID };
+        bool radiusBoundsDirty { false };
+        bool isBounded { false };
+    };
+
+    ProxyGrid();
+
+    // adds the proxy in region UNKNOWN, or puts it back in region UNKNOWN if it is already in the grid
+    void insert(ProxyID id, const Sphere& sphere);
+    // moves the proxy, if it is in the grid
+    void update(ProxyID id, const Sphere& sphere);
+    void remove(ProxyID id);
+    void clear();
+
+    bool contains(ProxyID id) const { return id >= 0 && id < (ProxyID)_locations.size() && _locations[id].cell >= 0; }
+
+    // cells are never moved once created, and may be empty
+    uint32_t getNumCells() const { return (uint32_t)_cells.size(); }
+    Cell& getCell(uint32_t index) { return _cells[index]; }
+
+private:
+    class Location {
+    public:
+        int32_t cell { -1 };
+        int32_t slot { -1 };
+    };
+
+    uint32_t findOrAddCell(const Sphere& sphere);
+    void addToCell(ProxyID id, const Sphere& sphere, uint8_t region, uint32_t cellIndex);
+    void removeFromCell(ProxyID id);
+
+    std::vector<Cell> _cells;
+    std::vector<uint32_t> _freeCells;
+    std::unordered_map<uint64_t, uint32_t> _cellsByKey;
+    std::vector<uint64_t> _cellKeys;
+    std::vector<Location> _locations;
+};
+
+} // namespace workload
+
+#endif // hifi_workload_ProxyGrid_h
@@ -16,10 +16,59 @@
 #include <cstring>
 #include <algorithm>
 
+#include <glm/gtx/component_wise.hpp>
 #include <glm/gtx/quaternion.hpp>
 
+#include <task/Parallel.h>
+
 using namespace workload;
 
+// Sets each proxy's region to the smallest region of any view that its sphere touches, or to R4 when it touches none.
+// The region spheres are ordered by region and then by view.
+void classifyProxies_ref(const float* x, const float* y, const float* z, const float* radius, uint8_t* regions,
+                         int numProxies, const float* regionX, const float* regionY, const float* regionZ,
+                         const float* regionRadius, int numViews) {
+    for (int i = 0; i < numProxies; ++i) {
+        glm::vec3 proxyCenter(x[i], y[i], z[i]);
+        uint8_t region = Region::R4;
+        for (uint8_t k = 0; k < Region::NUM_TRACKED_REGIONS && region == Region::R4; ++k) {
+            for (int j = k * numViews; j < (k + 1) * numViews; ++j) {
+                float touchDistance = radius[i] + regionRadius[j];
+                if (distance2(proxyCenter, glm::vec3(regionX[j], regionY[j], regionZ[j])) < touchDistance * touchDistance) {
+                    region = k;
+                    break;
+                }
+            }
+        }
+        regions[i] = region;
+    }
+}
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+//
+// Runtime CPU dispatch
+//
+#include <CPUDetect.h>
+
+void classifyProxies_AVX2(const float* x, const float* y, const float* z, const float* radius, uint8_t* regions,
+                          int numProxies, const float* regionX, const float* regionY, const float* regionZ,
+                          const float* regionRadius, int numViews);
+
+static void classifyProxies(const float* x, const float* y, const float* z, const float* radius, uint8_t* regions,
+                            int numProxies, const float* regionX, const float* regionY, const float* regionZ,
+                            const float* regionRadius, int numViews) {
+    static auto f = cpuSupportsAVX2() ? classifyProxies_AVX2 : classifyProxies_ref;
+    (*f)(x, y, z, radius, regions, numProxies, regionX, regionY, regionZ, regionRadius, numViews);
+}
+
+#else   // portable reference code
+static auto& classifyProxies = classifyProxies_ref;
+#endif
+
+// spread the categorization over the thread pool only when there is enough to do
+static const uint32_t MIN_PROXIES_TO_CATEGORIZE_IN_PARALLEL = 8192;
+static const int CELLS_PER_CHUNK = 16;
+
 Space::Space() : Collection() {
 }
 
@@ -54,6 +103,7 @@ void Space::processResets(const Transaction::Resets& transactions) {
         // Reset the item with a new payload
         item.sphere = (std::get<1>(reset));
         item.prevRegion = item.region = Region::UNKNOWN;
+        _grid.insert(proxyID, item.sphere);
 
         _owners[proxyID] = (std::get<2>(reset));
     }
@@ -71,6 +121,7 @@ void Space::processRemoves(const Transaction::Removes& transactions) {
 
         // Kill it
         item.prevRegion = item.region = Region::INVALID;
+        _grid.remove(removedID);
         _owners[removedID] = Owner();
     }
 }
@@ -87,37 +138,124 @@ void Space::processUpdates(const Transaction::Updates& transactions) {
 
         // Update the item
         item.sphere = (std::get<1>(update));
+        _grid.update(updateID, item.sphere);
     }
 }
 
 void Space::categorizeAndGetChanges(std::vector<Space::Change>& changes) {
     std::unique_lock<std::mutex> lock(_proxiesMutex);
-    uint32_t numProxies = (uint32_t)_proxies.size();
+    updateRegionSpheres();
+
+    // Cells are categorized in chunks, each with its own list of changes, so the proxies can be categorized in
+    // parallel. The changes come out grouped by cell.
+    int numCells = (int)_grid.getNumCells();
+    int cellsPerChunk = (getNumObjects() < MIN_PROXIES_TO_CATEGORIZE_IN_PARALLEL) ? numCells : CELLS_PER_CHUNK;
+    size_t numChunks = (size_t)((numCells + cellsPerChunk - 1) / cellsPerChunk);
+    if (_chunkChanges.size() < numChunks) {
+        _chunkChanges.resize(numChunks);
+        _chunkRegions.resize(numChunks);
+    }
+    task::parallelForRange(numCells, cellsPerChunk, [&](int begin, int end) {
+        int chunk = begin / cellsPerChunk;
+        auto& chunkChanges = _chunkChanges[chunk];
+        chunkChanges.clear();
+        for (int i = begin; i < end; ++i) {
+            categorizeCell(_grid.getCell(i), _chunkRegions[chunk], chunkChanges);
+        }
+    });
+
+    for (size_t i = 0; i < numChunks; ++i) {
+        changes.insert(changes.end(), _chunkChanges[i].begin(), _chunkChanges[i].end());
+    }
+}
+
+void Space::updateRegionSpheres() {
     uint32_t numViews = (uint32_t)_views.size();
-    for (uint32_t i = 0; i < numProxies; ++i) {
-        Proxy& proxy = _proxies[i];
-        if (proxy.region < Region::INVALID) {
-            glm::vec3 proxyCenter = glm::vec3(proxy.sphere);
-            float proxyRadius = proxy.sphere.w;
-            uint8_t region = Region::R4;
-            for (uint32_t j = 0; j < numViews; ++j) {
-                auto& view = _views[j];
-                // for each 'view' we need only increment 'k' below the current value of 'region'
-                for (uint8_t k = 0; k < region; ++k) {
-                    float touchDistance = proxyRadius + view.regions[k].w;
-                    if (distance2(proxyCenter, glm::vec3(view.regions[k])) < touchDistance * touchDistance) {
-                        region = k;
+    size_t numSpheres = Region::NUM_TRACKED_REGIONS * numViews;
+    _regionX.resize(numSpheres);
+    _regionY.resize(numSpheres);
+    _regionZ.resize(numSpheres);
+    _regionRadius.resize(numSpheres);
+    for (uint32_t k = 0; k < Region::NUM_TRACKED_REGIONS; ++k) {
+        for (uint32_t j = 0; j < numViews; ++j) {
+            const Sphere& sphere = _views[j].regions[k];
+            size_t index = k * numViews + j;
+            _regionX[index] = sphere.x;
+            _regionY[index] = sphere.y;
+            _regionZ[index] = sphere.z;
+            _regionRadius[index] = sphere.w;
+        }
+    }
+}
+
+void Space::categorizeCell(ProxyGrid::Cell& cell, std::vector<uint8_t>& regions, std::vector<Change>& changes) {
+    uint32_t numProxies = (uint32_t)cell.proxyIDs.size();
+    if (numProxies == 0) {
+        return;
+    }
+
+    // Bound the region of every proxy in the cell from the distances between each region sphere and the cell's box,
+    // padded to cover the rounding in the per proxy distances.
+    uint8_t minRegion = Region::R4;
+    uint8_t maxRegion = Region::R4;
+    if (cell.isBounded) {
+        if (cell.radiusBoundsDirty) {
+            cell.refreshRadiusBounds();
+        }
+        glm::vec3 cellExtent = glm::max(glm::abs(cell.minCorner), glm::abs(cell.maxCorner));
+        uint32_t numViews = (uint32_t)_views.size();
+        for (uint8_t k = 0; k < Region::NUM_TRACKED_REGIONS && maxRegion == Region::R4; ++k) {
+            for (uint32_t j = k * numViews; j < (k + 1) * numViews; ++j) {
+                glm::vec3 center(_regionX[j], _regionY[j], _regionZ[j]);
+                float margin = 1.0e-3f + 1.0e-5f * (glm::compMax(glm::max(cellExtent, glm::abs(center))) +
+                                                    _regionRadius[j] + cell.maxRadius);
+                glm::vec3 nearest = glm::max(glm::max(cell.minCorner - center, center - cell.maxCorner), glm::vec3(0.0f));
+                glm::vec3 farthest = glm::max(glm::abs(center - cell.minCorner), glm::abs(center - cell.maxCorner));
+                if (glm::length(nearest) < cell.maxRadius + _regionRadius[j] + margin) {
+                    // some proxies may touch the region
+                    minRegion = std::min(minRegion, k);
+                    if (glm::length(farthest) + margin < cell.minRadius + _regionRadius[j]) {
+                        // every proxy touches the region
+                        maxRegion = k;
                         break;
                     }
                 }
             }
-            proxy.prevRegion = proxy.region;
-            proxy.region = region;
-            if (proxy.region != proxy.prevRegion) {
-                changes.emplace_back(Space::Change((int32_t)i, proxy.region, proxy.prevRegion));
+        }
+    } else {
+        minRegion = Region::R1;
+    }
+
+    if (minRegion == maxRegion) {
+        if (cell.commonRegion != minRegion) {
+            for (uint32_t i = 0; i < numProxies; ++i) {
+                if (cell.regions[i] != minRegion) {
+                    setRegion(cell, i, minRegion, changes);
+                }
             }
+            cell.commonRegion = minRegion;
+        }
+        return;
+    }
+
+    regions.resize(numProxies);
+    classifyProxies(cell.x.data(), cell.y.data(), cell.z.data(), cell.radius.data(), regions.data(), (int)numProxies,
+                    _regionX.data(), _regionY.data(), _regionZ.data(), _regionRadius.data(), (int)_views.size());
+    for (uint32_t i = 0; i < numProxies; ++i) {
+        if (cell.regions[i] != regions[i]) {
+            setRegion(cell, i, regions[i], changes);
         }
     }
+    cell.commonRegion = Region::INVALID;
+}
+
+void Space::setRegion(ProxyGrid::Cell& cell, uint32_t slot, uint8_t region, std::vector<Change>& changes) {
+    ProxyID proxyID = cell.proxyIDs[slot];
+    Proxy& proxy = _proxies[proxyID];
+    proxy.prevRegion = proxy.region;
+    proxy.region = region;
+    cell.regions[slot] = region;
+    changes.emplace_back(Space::Change((int32_t)proxyID, proxy.region, proxy.prevRegion));
 }
 
 uint32_t Space::copyProxyValues(Proxy* proxies, uint32_t numDestProxies) const {
@@ -161,6 +299,7 @@ void Space::clear() {
     _IDAllocator.clear();
     _proxies.clear();
     _owners.clear();
+    _grid.clear();
     _views.clear();
 }
 
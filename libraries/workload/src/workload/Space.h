@@ -19,6 +19,7 @@
 #include <vector>
 #include <glm/glm.hpp>
 
+#include "ProxyGrid.h"
 #include "Transaction.h"
 
 namespace workload {
@@ -60,12 +61,27 @@ private:
     void processRemoves(const Transaction::Removes& transactions);
     void processUpdates(const Transaction::Updates& transactions);
 
+    void updateRegionSpheres();
+    void categorizeCell(ProxyGrid::Cell& cell, std::vector<uint8_t>& regions, std::vector<Change>& changes);
+    void setRegion(ProxyGrid::Cell& cell, uint32_t slot, uint8_t region, std::vector<Change>& changes);
+
     // The database of proxies is protected for editing by a mutex
     mutable std::mutex _proxiesMutex;
     Proxy::Vector _proxies;
     std::vector<Owner> _owners;
+    ProxyGrid _grid;
 
     Views _views;
+
+    // the region spheres of all views, ordered by region and then by view, with their coordinates in separate arrays
+    std::vector<float> _regionX;
+    std::vector<float> _regionY;
+    std::vector<float> _regionZ;
+    std::vector<float> _regionRadius;
+
+    // per chunk of cells, so that they can be categorized in parallel
+    std::vector<std::vector<uint8_t>> _chunkRegions;
+    std::vector<std::vector<Change>> _chunkChanges;
 };
 
 using SpacePointer = std::shared_ptr<Space>;
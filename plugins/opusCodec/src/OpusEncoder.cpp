@@ -70,23 +70,27 @@ AthenaOpusEncoder::~AthenaOpusEncoder() {
 void AthenaOpusEncoder::encode(const QByteArray& decodedBuffer, QByteArray& encodedBuffer) {
 
     PerformanceTimer perfTimer("AthenaOpusEncoder::encode");
-    assert(_encoder);
 
     encodedBuffer.resize(decodedBuffer.size());
-    int frameSize = decodedBuffer.length() / _opusChannels / static_cast<int>(sizeof(opus_int16));
+    int bytes = encodeInto(decodedBuffer.constData(), decodedBuffer.size(), encodedBuffer.data(), encodedBuffer.size());
+    encodedBuffer.resize(bytes >= 0 ? bytes : 0);
+}
+
+int AthenaOpusEncoder::encodeInto(const char* decodedBuffer, int decodedSize, char* encodedBuffer, int encodedCapacity) {
+    assert(_encoder);
 
-    int bytes = opus_encode(_encoder, reinterpret_cast<const opus_int16*>(decodedBuffer.constData()), frameSize,
-        reinterpret_cast<unsigned char*>(encodedBuffer.data()), encodedBuffer.size() );
+    int frameSize = decodedSize / _opusChannels / static_cast<int>(sizeof(opus_int16));
 
-    if (bytes >= 0) {
-        encodedBuffer.resize(bytes);
-    } else {
-        encodedBuffer.resize(0);
+    int bytes = opus_encode(_encoder, reinterpret_cast<const opus_int16*>(decodedBuffer), frameSize,
+        reinterpret_cast<unsigned char*>(encodedBuffer), encodedCapacity);
 
-        qCWarning(encoder) << "Error when encoding " << decodedBuffer.length() << " bytes of audio: "
+    if (bytes < 0) {
+        qCWarning(encoder) << "Error when encoding " << decodedSize << " bytes of audio: "
             << errorToString(bytes);
+        return -1;
     }
 
+    return bytes;
 }
 
 int AthenaOpusEncoder::getComplexity() const {
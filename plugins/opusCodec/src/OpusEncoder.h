@@ -21,6 +21,7 @@ public:
     ~AthenaOpusEncoder() override;
 
     virtual void encode(const QByteArray& decodedBuffer, QByteArray& encodedBuffer) override;
+    virtual int encodeInto(const char* decodedBuffer, int decodedSize, char* encodedBuffer, int encodedCapacity) override;
 
 
     int getComplexity() const;
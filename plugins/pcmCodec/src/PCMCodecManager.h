@@ -40,6 +40,14 @@ public:
         encodedBuffer = decodedBuffer;
     }
 
+    virtual int encodeInto(const char* decodedBuffer, int decodedSize, char* encodedBuffer, int encodedCapacity) override {
+        if (decodedSize > encodedCapacity) {
+            return -1;
+        }
+        memcpy(encodedBuffer, decodedBuffer, decodedSize);
+        return decodedSize;
+    }
+
     virtual void decode(const QByteArray& encodedBuffer, QByteArray& decodedBuffer) override {
         decodedBuffer = encodedBuffer;
     }
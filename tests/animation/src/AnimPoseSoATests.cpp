@@ -0,0 +1,284 @@
+//
+//  AnimPoseSoATests.cpp
+//  tests/animation/src
+//
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AnimPoseSoATests.h"
+
+#include <string.h>
+
+#include <AnimPoseSoA.h>
+#include <AnimUtil.h>
+
+QTEST_MAIN(AnimPoseSoATests)
+
+// about as many joints as a typical avatar skeleton, and not a multiple of 8
+const int NUM_JOINTS = 67;
+const float POSE_EPSILON = 1.0e-5f;
+
+static float randomFloat(float min, float max) {
+    return min + (max - min) * ((float)rand() / (float)RAND_MAX);
+}
+
+static AnimPose randomPose(bool uniformScale) {
+    glm::vec3 scale(randomFloat(0.8f, 1.25f));
+    if (!uniformScale) {
+        scale.y = randomFloat(0.5f, 2.0f);
+        scale.z = randomFloat(0.5f, 2.0f);
+    }
+    glm::quat rot = glm::normalize(glm::quat(randomFloat(-1.0f, 1.0f), randomFloat(-1.0f, 1.0f),
+                                             randomFloat(-1.0f, 1.0f), randomFloat(-1.0f, 1.0f)));
+    glm::vec3 trans(randomFloat(-1.0f, 1.0f), randomFloat(-1.0f, 1.0f), randomFloat(-1.0f, 1.0f));
+    return AnimPose(scale, rot, trans);
+}
+
+static AnimPoseVec randomPoses(int numPoses, bool uniformScale) {
+    AnimPoseVec poses;
+    for (int i = 0; i < numPoses; ++i) {
+        poses.push_back(randomPose(uniformScale));
+    }
+    return poses;
+}
+
+// the largest difference between any two components of the poses, with q and -q being the same rotation
+static float getPoseError(const AnimPose& a, const AnimPose& b) {
+    glm::quat bRot = glm::dot(a.rot(), b.rot()) < 0.0f ? -b.rot() : b.rot();
+    float error = 0.0f;
+    for (int i = 0; i < 3; ++i) {
+        error = std::max(error, fabsf(a.scale()[i] - b.scale()[i]));
+        error = std::max(error, fabsf(a.trans()[i] - b.trans()[i]));
+    }
+    for (int i = 0; i < 4; ++i) {
+        error = std::max(error, fabsf(a.rot()[i] - bRot[i]));
+    }
+    return error;
+}
+
+static float getPosesError(const AnimPoseSoA& soaPoses, const AnimPoseVec& poses) {
+    AnimPoseVec stored;
+    soaPoses.store(stored);
+    float error = 0.0f;
+    for (size_t i = 0; i < poses.size(); ++i) {
+        error = std::max(error, getPoseError(stored[i], poses[i]));
+    }
+    return error;
+}
+
+// a tree of joints with three children per joint
+static std::vector<int> makeParentIndices(int numJoints) {
+    std::vector<int> parentIndices;
+    for (int i = 0; i < numJoints; ++i) {
+        parentIndices.push_back(i == 0 ? -1 : (i - 1) / 3);
+    }
+    return parentIndices;
+}
+
+void AnimPoseSoATests::testLoadStore() {
+    srand(1);
+    AnimPoseVec poses = randomPoses(NUM_JOINTS, false);
+    AnimPoseSoA soaPoses(poses);
+    QCOMPARE(soaPoses.size(), NUM_JOINTS);
+    QVERIFY(soaPoses.getStride() % 8 == 0);
+    QVERIFY(soaPoses.getStride() > NUM_JOINTS);
+    QCOMPARE(getPosesError(soaPoses, poses), 0.0f);
+
+    // the padding is identity poses
+    AnimPose padding = soaPoses.getPose(soaPoses.getStride() - 1);
+    QCOMPARE(getPoseError(padding, AnimPose::identity), 0.0f);
+
+    // reloading keeps the arrays and replaces every pose
+    const float* data = soaPoses.getData();
+    AnimPoseVec otherPoses = randomPoses(NUM_JOINTS, false);
+    soaPoses.load(otherPoses);
+    QCOMPARE(soaPoses.getData(), data);
+    QCOMPARE(getPosesError(soaPoses, otherPoses), 0.0f);
+}
+
+void AnimPoseSoATests::testBlend() {
+    srand(2);
+    AnimPoseVec a = randomPoses(NUM_JOINTS, false);
+    AnimPoseVec b = randomPoses(NUM_JOINTS, false);
+    AnimPoseSoA soaA(a);
+    AnimPoseSoA soaB(b);
+
+    for (float alpha : { 0.0f, 0.25f, 0.5f, 1.0f }) {
+        AnimPoseVec expected(NUM_JOINTS);
+        ::blend(NUM_JOINTS, a.data(), b.data(), alpha, expected.data());
+        AnimPoseSoA result;
+        blend(soaA, soaB, alpha, result);
+        QVERIFY(getPosesError(result, expected) < POSE_EPSILON);
+    }
+}
+
+void AnimPoseSoATests::testBlendAdd() {
+    srand(3);
+    AnimPoseVec a = randomPoses(NUM_JOINTS, false);
+    AnimPoseVec b = randomPoses(NUM_JOINTS, false);
+    AnimPoseSoA soaA(a);
+    AnimPoseSoA soaB(b);
+
+    for (float alpha : { 0.0f, 0.25f, 0.5f, 1.0f }) {
+        AnimPoseVec expected(NUM_JOINTS);
+        ::blendAdd(NUM_JOINTS, a.data(), b.data(), alpha, expected.data());
+        AnimPoseSoA result;
+        blendAdd(soaA, soaB, alpha, result);
+        QVERIFY(getPosesError(result, expected) < POSE_EPSILON);
+    }
+}
+
+void AnimPoseSoATests::testBuildAbsolutePoses() {
+    srand(4);
+    std::vector<int> parentIndices = makeParentIndices(NUM_JOINTS);
+    AnimJointLevels levels(parentIndices);
+    QCOMPARE(levels.getNumJoints(), NUM_JOINTS);
+    QCOMPARE(levels.getNumLevels(), 5);
+
+    // the matrix product of the poses, as Rig::buildAbsoluteRigPoses does it
+    AnimPoseVec relativePoses = randomPoses(NUM_JOINTS, true);
+    AnimPose rootPose = randomPose(true);
+    AnimPoseVec expected(NUM_JOINTS);
+    for (int i = 0; i < NUM_JOINTS; ++i) {
+        const AnimPose& parentPose = parentIndices[i] == -1 ? rootPose : expected[parentIndices[i]];
+        expected[i] = parentPose * relativePoses[i];
+    }
+
+    AnimPoseSoA absolutePoses;
+    buildAbsolutePoses(AnimPoseSoA(relativePoses), levels, rootPose, absolutePoses);
+    QCOMPARE(absolutePoses.size(), NUM_JOINTS);
+    QVERIFY(getPosesError(absolutePoses, expected) < 1.0e-4f);
+}
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+#include <CPUDetect.h>
+
+void blendPoses_ref(const float* a, const float* b, float alpha, float* result, int stride);
+void blendAddPoses_ref(const float* a, const float* b, float alpha, float* result, int stride);
+void composePoses_ref(const float* relative, float* absolute, int stride, const int* joints, const int* parents,
+                      int numEntries);
+void blendPoses_AVX2(const float* a, const float* b, float alpha, float* result, int stride);
+void blendAddPoses_AVX2(const float* a, const float* b, float alpha, float* result, int stride);
+void composePoses_AVX2(const float* relative, float* absolute, int stride, const int* joints, const int* parents,
+                       int numEntries);
+
+static bool isSame(const AnimPoseSoA& a, const AnimPoseSoA& b) {
+    return a.getStride() == b.getStride() &&
+        memcmp(a.getData(), b.getData(), AnimPoseSoA::NumComponents * a.getStride() * sizeof(float)) == 0;
+}
+
+void AnimPoseSoATests::testKernelsMatchReference() {
+    if (!cpuSupportsAVX2()) {
+        QSKIP("AVX2 not supported");
+    }
+
+    srand(5);
+    AnimPoseSoA a(randomPoses(NUM_JOINTS, false));
+    AnimPoseSoA b(randomPoses(NUM_JOINTS, false));
+    // a degenerate rotation, which normalizes to identity
+    b.setPose(1, AnimPose(glm::vec3(1.0f), glm::quat(0.0f, 0.0f, 0.0f, 0.0f), glm::vec3(0.0f)));
+    AnimPoseSoA expected(randomPoses(NUM_JOINTS, false));
+    AnimPoseSoA result(randomPoses(NUM_JOINTS, false));
+    int stride = a.getStride();
+
+    for (float alpha : { 0.0f, 0.3f, 0.5f, 0.9f, 1.0f }) {
+        blendPoses_ref(a.getData(), b.getData(), alpha, expected.getData(), stride);
+        blendPoses_AVX2(a.getData(), b.getData(), alpha, result.getData(), stride);
+        QVERIFY(isSame(result, expected));
+
+        blendAddPoses_ref(a.getData(), b.getData(), alpha, expected.getData(), stride);
+        blendAddPoses_AVX2(a.getData(), b.getData(), alpha, result.getData(), stride);
+        QVERIFY(isSame(result, expected));
+    }
+
+    AnimJointLevels levels(makeParentIndices(NUM_JOINTS));
+    AnimPose rootPose = randomPose(false);
+    expected.setPose(NUM_JOINTS, rootPose);
+    result.setPose(NUM_JOINTS, rootPose);
+    const auto& joints = levels.getJoints();
+    composePoses_ref(a.getData(), expected.getData(), stride, joints.data(), levels.getParents().data(), (int)joints.size());
+    composePoses_AVX2(a.getData(), result.getData(), stride, joints.data(), levels.getParents().data(), (int)joints.size());
+    QVERIFY(isSame(result, expected));
+}
+
+#else
+void AnimPoseSoATests::testKernelsMatchReference() {
+    QSKIP("no SIMD kernels on this architecture");
+}
+#endif
+
+void AnimPoseSoATests::benchmarkBlend_data() {
+    QTest::addColumn<bool>("soa");
+    QTest::addColumn<bool>("convert");
+
+    QTest::newRow("AnimPoseVec") << false << false;
+    QTest::newRow("AnimPoseSoA") << true << false;
+    // as AnimBlendLinear blends its children's AnimPoseVecs
+    QTest::newRow("AnimPoseVec through AnimPoseSoA") << true << true;
+}
+
+void AnimPoseSoATests::benchmarkBlend() {
+    QFETCH(bool, soa);
+    QFETCH(bool, convert);
+
+    srand(6);
+    AnimPoseVec a = randomPoses(NUM_JOINTS, true);
+    AnimPoseVec b = randomPoses(NUM_JOINTS, true);
+    AnimPoseVec result(NUM_JOINTS);
+    AnimPoseSoA soaA(a);
+    AnimPoseSoA soaB(b);
+    AnimPoseSoA soaResult(result);
+
+    if (soa && convert) {
+        QBENCHMARK {
+            soaA.load(a);
+            soaB.load(b);
+            blend(soaA, soaB, 0.3f, soaResult);
+            soaResult.store(result);
+        }
+    } else if (soa) {
+        QBENCHMARK {
+            blend(soaA, soaB, 0.3f, soaResult);
+        }
+    } else {
+        QBENCHMARK {
+            ::blend(NUM_JOINTS, a.data(), b.data(), 0.3f, result.data());
+        }
+    }
+}
+
+void AnimPoseSoATests::benchmarkBuildAbsolutePoses_data() {
+    QTest::addColumn<bool>("soa");
+
+    QTest::newRow("AnimPoseVec") << false;
+    QTest::newRow("AnimPoseSoA") << true;
+}
+
+void AnimPoseSoATests::benchmarkBuildAbsolutePoses() {
+    QFETCH(bool, soa);
+
+    srand(7);
+    std::vector<int> parentIndices = makeParentIndices(NUM_JOINTS);
+    AnimPoseVec relativePoses = randomPoses(NUM_JOINTS, true);
+    AnimPoseVec absolutePoses(NUM_JOINTS);
+    AnimPose rootPose = randomPose(true);
+    AnimJointLevels levels(parentIndices);
+    AnimPoseSoA soaRelativePoses(relativePoses);
+    AnimPoseSoA soaAbsolutePoses(absolutePoses);
+
+    if (soa) {
+        QBENCHMARK {
+            buildAbsolutePoses(soaRelativePoses, levels, rootPose, soaAbsolutePoses);
+        }
+    } else {
+        QBENCHMARK {
+            for (int i = 0; i < NUM_JOINTS; ++i) {
+                const AnimPose& parentPose = parentIndices[i] == -1 ? rootPose : absolutePoses[parentIndices[i]];
+                absolutePoses[i] = parentPose * relativePoses[i];
+            }
+        }
+    }
+}
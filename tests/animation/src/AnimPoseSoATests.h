@@ -0,0 +1,30 @@
+//
+//  AnimPoseSoATests.h
+//  tests/animation/src
+//
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AnimPoseSoATests_h
+#define hifi_AnimPoseSoATests_h
+
+#include <QtTest/QtTest>
+
+class AnimPoseSoATests : public QObject {
+    Q_OBJECT
+private slots:
+    void testLoadStore();
+    void testBlend();
+    void testBlendAdd();
+    void testBuildAbsolutePoses();
+    void testKernelsMatchReference();
+    void benchmarkBlend_data();
+    void benchmarkBlend();
+    void benchmarkBuildAbsolutePoses_data();
+    void benchmarkBuildAbsolutePoses();
+};
+
+#endif // hifi_AnimPoseSoATests_h
@@ -0,0 +1,193 @@
+//
+//  RigTests.cpp
+//  tests/animation/src
+//
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "RigTests.h"
+
+#include <memory>
+#include <vector>
+
+#include <QThreadPool>
+
+#include <glm/gtx/transform.hpp>
+
+#include <NumericalConstants.h>
+#include <Rig.h>
+#include <task/Parallel.h>
+
+QTEST_MAIN(RigTests)
+
+// about as many joints as a typical avatar skeleton
+const int NUM_JOINTS = 64;
+
+// a tree of joints with three children per joint, each a little further from the root
+static void makeSkeleton(HFMModel& hfmModel) {
+    for (int i = 0; i < NUM_JOINTS; ++i) {
+        HFMJoint joint;
+        joint.name = QString("joint%1").arg(i);
+        joint.parentIndex = (i == 0) ? -1 : (i - 1) / 3;
+        joint.translation = (i == 0) ? glm::vec3(0.0f) : glm::vec3(0.1f * (float)((i - 1) % 3 - 1), 0.1f, 0.0f);
+        joint.rotationMin = glm::vec3(-PI);
+        joint.rotationMax = glm::vec3(PI);
+        glm::mat4 parentTransform = (i == 0) ? glm::mat4() : hfmModel.joints[joint.parentIndex].transform;
+        joint.transform = parentTransform * glm::translate(joint.translation);
+        joint.bindTransform = joint.transform;
+        hfmModel.joints.push_back(joint);
+    }
+}
+
+// joints as an avatar mixer would send them, different for every seed
+static QVector<JointData> makeJointData(int seed) {
+    QVector<JointData> jointData(NUM_JOINTS);
+    for (int i = 0; i < NUM_JOINTS; ++i) {
+        float angle = 0.01f * (float)((seed * 31 + i * 7) % 100);
+        jointData[i].rotation = glm::angleAxis(angle, glm::normalize(glm::vec3(1.0f, (float)(i % 3), 0.5f)));
+        jointData[i].rotationIsDefaultPose = (i % 5 == 0);
+        jointData[i].translation = glm::vec3(0.0f, 0.1f + 0.001f * (float)seed, 0.0f);
+        jointData[i].translationIsDefaultPose = (i % 2 == 0);
+    }
+    return jointData;
+}
+
+static void makeRigs(int numRigs, std::vector<std::unique_ptr<Rig>>& rigs, std::vector<QVector<JointData>>& jointData) {
+    HFMModel hfmModel;
+    makeSkeleton(hfmModel);
+    std::vector<uint> remoteToLocalJointMap(NUM_JOINTS);
+    for (int i = 0; i < NUM_JOINTS; ++i) {
+        remoteToLocalJointMap[i] = i;
+    }
+
+    for (int i = 0; i < numRigs; ++i) {
+        rigs.push_back(std::make_unique<Rig>());
+        rigs.back()->initJointStates(hfmModel, glm::mat4());
+        rigs.back()->setSkeletonJointMap(remoteToLocalJointMap);
+        jointData.push_back(makeJointData(i));
+    }
+}
+
+// what OtherAvatar::updateJointsFromNetwork does to the rig of each avatar
+static void copyJoints(Rig& rig, const QVector<JointData>& jointData) {
+    rig.copyJointsFromJointData(jointData);
+    rig.computeExternalPoses(glm::scale(glm::vec3(1.0f)));
+}
+
+void RigTests::testCopyJointsInParallel() {
+    const int NUM_RIGS = 32;
+    std::vector<std::unique_ptr<Rig>> serialRigs;
+    std::vector<std::unique_ptr<Rig>> parallelRigs;
+    std::vector<QVector<JointData>> jointData;
+    makeRigs(NUM_RIGS, serialRigs, jointData);
+    jointData.clear();
+    makeRigs(NUM_RIGS, parallelRigs, jointData);
+
+    for (int i = 0; i < NUM_RIGS; ++i) {
+        copyJoints(*serialRigs[i], jointData[i]);
+    }
+    task::parallelFor(NUM_RIGS, [&](int i) {
+        copyJoints(*parallelRigs[i], jointData[i]);
+    });
+
+    int numMismatches = 0;
+    for (int i = 0; i < NUM_RIGS; ++i) {
+        QCOMPARE(parallelRigs[i]->getJointStateCount(), NUM_JOINTS);
+        for (int j = 0; j < NUM_JOINTS; ++j) {
+            if (parallelRigs[i]->getJointTransform(j) != serialRigs[i]->getJointTransform(j)) {
+                ++numMismatches;
+            }
+        }
+    }
+    QCOMPARE(numMismatches, 0);
+
+    // the joints moved away from the default pose
+    QVERIFY(parallelRigs[1]->getJointTransform(NUM_JOINTS - 1) != parallelRigs[2]->getJointTransform(NUM_JOINTS - 1));
+}
+
+void RigTests::testCopyReducedSkeleton() {
+    HFMModel hfmModel;
+    makeSkeleton(hfmModel);
+    const int HAND_INDEX = 2;
+    hfmModel.joints[HAND_INDEX].name = "RightHand";
+    std::vector<uint> remoteToLocalJointMap(NUM_JOINTS);
+    for (int i = 0; i < NUM_JOINTS; ++i) {
+        remoteToLocalJointMap[i] = i;
+    }
+
+    Rig rig;
+    rig.initJointStates(hfmModel, glm::mat4());
+    rig.setSkeletonJointMap(remoteToLocalJointMap);
+    Rig expectedRig;
+    expectedRig.initJointStates(hfmModel, glm::mat4());
+    expectedRig.setSkeletonJointMap(remoteToLocalJointMap);
+
+    QVector<JointData> firstJointData = makeJointData(1);
+    QVector<JointData> secondJointData = makeJointData(2);
+    rig.copyJointsFromJointData(firstJointData);
+    expectedRig.copyJointsFromJointData(secondJointData);
+    rig.copyJointsFromJointData(secondJointData, true);
+
+    // the joints below the hand keep the first poses, the others get the second ones
+    Rig firstRig;
+    firstRig.initJointStates(hfmModel, glm::mat4());
+    firstRig.setSkeletonJointMap(remoteToLocalJointMap);
+    firstRig.copyJointsFromJointData(firstJointData);
+
+    int numFingers = 0;
+    int numMismatches = 0;
+    for (int i = 0; i < NUM_JOINTS; ++i) {
+        bool isFinger = false;
+        for (int parent = hfmModel.joints[i].parentIndex; parent != -1; parent = hfmModel.joints[parent].parentIndex) {
+            isFinger = isFinger || parent == HAND_INDEX;
+        }
+        numFingers += isFinger ? 1 : 0;
+
+        glm::quat rotation;
+        glm::quat expectedRotation;
+        rig.getJointRotation(i, rotation);
+        (isFinger ? firstRig : expectedRig).getJointRotation(i, expectedRotation);
+        if (rotation != expectedRotation) {
+            ++numMismatches;
+        }
+    }
+    QVERIFY(numFingers > 0);
+    QCOMPARE(numMismatches, 0);
+}
+
+void RigTests::benchmarkCopyJoints_data() {
+    QTest::addColumn<int>("numRigs");
+    QTest::addColumn<int>("numThreads");
+
+    const int NUM_RIGS[] = { 16, 64, 256 };
+    for (int numRigs : NUM_RIGS) {
+        for (int numThreads = 1; numThreads <= std::max(QThread::idealThreadCount(), 1); numThreads *= 2) {
+            QTest::newRow(qPrintable(QString("%1 rigs, %2 threads").arg(numRigs).arg(numThreads))) << numRigs << numThreads;
+        }
+    }
+}
+
+void RigTests::benchmarkCopyJoints() {
+    QFETCH(int, numRigs);
+    QFETCH(int, numThreads);
+
+    std::vector<std::unique_ptr<Rig>> rigs;
+    std::vector<QVector<JointData>> jointData;
+    makeRigs(numRigs, rigs, jointData);
+
+    // the calling thread works too
+    QThreadPool* threadPool = QThreadPool::globalInstance();
+    int oldMaxThreadCount = threadPool->maxThreadCount();
+    threadPool->setMaxThreadCount(numThreads - 1);
+
+    QBENCHMARK {
+        task::parallelFor(numRigs, [&](int i) {
+            copyJoints(*rigs[i], jointData[i]);
+        });
+    }
+
+    threadPool->setMaxThreadCount(oldMaxThreadCount);
+}
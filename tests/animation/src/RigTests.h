@@ -0,0 +1,25 @@
+//
+//  RigTests.h
+//  tests/animation/src
+//
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_RigTests_h
+#define hifi_RigTests_h
+
+#include <QtTest/QtTest>
+
+class RigTests : public QObject {
+    Q_OBJECT
+private slots:
+    void testCopyJointsInParallel();
+    void testCopyReducedSkeleton();
+    void benchmarkCopyJoints_data();
+    void benchmarkCopyJoints();
+};
+
+#endif // hifi_RigTests_h
@@ -0,0 +1,88 @@
+//
+//  HotAssetCacheTests.cpp
+//  tests/assignment-client/src
+//
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "HotAssetCacheTests.h"
+
+#include <assets/HotAssetCache.h>
+
+QTEST_MAIN(HotAssetCacheTests)
+
+// 5% of it is the admission window, which no range fits in, so every range goes straight to the admission check.
+// The main region holds 15 ranges of RANGE_SIZE, and a range of LARGE_RANGE_SIZE has to displace two of them.
+static const qint64 CAPACITY = 1000;
+static const int RANGE_SIZE = 60;
+static const int LARGE_RANGE_SIZE = 120;
+static const int NUM_RANGES = 15;
+
+static QString rangeKey(int index) {
+    return HotAssetCache::makeKey("asset", index * RANGE_SIZE, RANGE_SIZE);
+}
+
+static const QString LARGE_RANGE_KEY = HotAssetCache::makeKey("large", 0, LARGE_RANGE_SIZE);
+
+// Fills the main region with ranges, least recently used first, where the second least recently used one has been
+// requested secondRangeRequests times.
+static void fillMainRegion(HotAssetCache& cache, int secondRangeRequests) {
+    for (int i = 0; i < NUM_RANGES; i++) {
+        int numRequests = i == 1 ? secondRangeRequests : 1;
+        for (int request = 0; request < numRequests; request++) {
+            cache.get(rangeKey(i), [] { return QByteArray(RANGE_SIZE, 'r'); });
+        }
+    }
+    QCOMPARE(cache.getStats().entries, NUM_RANGES);
+}
+
+// Requests the large range numRequests times, only returning data the last time so that it is only cached then.
+static void requestLargeRange(HotAssetCache& cache, int numRequests) {
+    for (int request = 0; request < numRequests - 1; request++) {
+        cache.get(LARGE_RANGE_KEY, [] { return QByteArray(); });
+    }
+    cache.get(LARGE_RANGE_KEY, [] { return QByteArray(LARGE_RANGE_SIZE, 'l'); });
+}
+
+static bool isCached(HotAssetCache& cache, const QString& key) {
+    bool wasLoaded = false;
+    cache.get(key, [&wasLoaded] {
+        wasLoaded = true;
+        return QByteArray();
+    });
+    return !wasLoaded;
+}
+
+void HotAssetCacheTests::admissionTest() {
+    HotAssetCache cache(CAPACITY);
+    fillMainRegion(cache, 1);
+    requestLargeRange(cache, 3);
+
+    auto stats = cache.getStats();
+    QCOMPARE(stats.evictions, (quint64)2);
+    QCOMPARE(stats.rejections, (quint64)0);
+    QCOMPARE(stats.entries, NUM_RANGES - 1);
+    QVERIFY(isCached(cache, LARGE_RANGE_KEY));
+    QVERIFY(!isCached(cache, rangeKey(0)));
+    QVERIFY(!isCached(cache, rangeKey(1)));
+    QVERIFY(isCached(cache, rangeKey(2)));
+}
+
+void HotAssetCacheTests::hotSecondVictimTest() {
+    // the least recently used range is colder than the candidate, but the next one is hotter
+    HotAssetCache cache(CAPACITY);
+    fillMainRegion(cache, 5);
+    requestLargeRange(cache, 3);
+
+    auto stats = cache.getStats();
+    QCOMPARE(stats.evictions, (quint64)0);
+    QCOMPARE(stats.rejections, (quint64)1);
+    QCOMPARE(stats.entries, NUM_RANGES);
+    QCOMPARE(stats.bytes, (qint64)(NUM_RANGES * RANGE_SIZE));
+    QVERIFY(isCached(cache, rangeKey(0)));
+    QVERIFY(isCached(cache, rangeKey(1)));
+    QVERIFY(!isCached(cache, LARGE_RANGE_KEY));
+}
@@ -0,0 +1,28 @@
+//
+//  HotAssetCacheTests.h
+//  tests/assignment-client/src
+//
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_HotAssetCacheTests_h
+#define hifi_HotAssetCacheTests_h
+
+#pragma once
+
+#include <QtTest/QtTest>
+
+class HotAssetCacheTests : public QObject {
+    Q_OBJECT
+private slots:
+    // Test that a range more popular than every range it would displace evicts them all
+    void admissionTest();
+
+    // Test that a range is rejected without evicting anything when any range it would displace is more popular
+    void hotSecondVictimTest();
+};
+
+#endif // hifi_HotAssetCacheTests_h
@@ -0,0 +1,590 @@
+//
+//  AudioDynamicsTests.cpp
+//  tests/audio/src
+//
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AudioDynamicsTests.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <functional>
+#include <vector>
+
+#include <AudioGate.h>
+#include <AudioLimiter.h>
+#include <AudioReverb.h>
+
+QTEST_MAIN(AudioDynamicsTests)
+
+const int SAMPLE_RATE = 48000;
+const float TWO_PI = 6.283185307f;
+// not a multiple of 8, so that the kernels also run their tails
+const int NUM_FRAMES = 237;
+const int BENCHMARK_FRAMES = 240;
+const qint64 BENCHMARK_MSECS = 200;
+
+static float randomFloat(float min, float max) {
+    return min + (max - min) * ((float)rand() / (float)RAND_MAX);
+}
+
+static int16_t randomSample(int amplitude) {
+    return (int16_t)(rand() % (2 * amplitude + 1) - amplitude);
+}
+
+// runs f on numFrames frames until BENCHMARK_MSECS have passed, and reports the time per frame
+static void reportTimePerFrame(int numFrames, std::function<void()> f) {
+    QElapsedTimer timer;
+    qint64 iterations = 0;
+    timer.start();
+    do {
+        f();
+        iterations++;
+    } while (timer.elapsed() < BENCHMARK_MSECS);
+    qInfo("%s: %.2f ns/frame", QTest::currentDataTag(), (double)timer.nsecsElapsed() / (iterations * numFrames));
+}
+
+void AudioDynamicsTests::testLimiter() {
+    const int NUM_CHANNELS = 2;
+    const float AMPLITUDE = 4.0f;   // +12dB
+    AudioLimiter limiter(SAMPLE_RATE, NUM_CHANNELS);
+
+    std::vector<float> input(NUM_CHANNELS * SAMPLE_RATE);
+    std::vector<int16_t> output(NUM_CHANNELS * SAMPLE_RATE);
+    for (int i = 0; i < SAMPLE_RATE; i++) {
+        float x = AMPLITUDE * sinf(TWO_PI * 1000.0f * i / SAMPLE_RATE);
+        input[NUM_CHANNELS * i + 0] = x;
+        input[NUM_CHANNELS * i + 1] = -x;
+    }
+    for (int i = 0; i < SAMPLE_RATE; i += NUM_FRAMES) {
+        int numFrames = std::min(NUM_FRAMES, SAMPLE_RATE - i);
+        limiter.render(&input[NUM_CHANNELS * i], &output[NUM_CHANNELS * i], numFrames);
+    }
+
+    // a limited sine reaches close to full scale, without ever wrapping around
+    int peak = 0;
+    int maxStep = 0;
+    for (int i = NUM_CHANNELS * SAMPLE_RATE / 2; i < NUM_CHANNELS * SAMPLE_RATE; i++) {
+        peak = std::max(peak, abs(output[i]));
+        maxStep = std::max(maxStep, abs(output[i] - output[i - NUM_CHANNELS]));
+    }
+    QVERIFY(peak > 29000);
+    QVERIFY(maxStep < 8000);
+}
+
+void AudioDynamicsTests::testGateInPlace() {
+    for (int numChannels : { 1, 2, 4 }) {
+        AudioGate gate(SAMPLE_RATE, numChannels);
+        AudioGate inPlaceGate(SAMPLE_RATE, numChannels);
+
+        srand(1);
+        std::vector<int16_t> input(numChannels * NUM_FRAMES);
+        std::vector<int16_t> output(numChannels * NUM_FRAMES);
+        for (int block = 0; block < 100; block++) {
+            // quiet noise with loud bursts
+            int amplitude = (block / 10) % 2 ? 16000 : 20;
+            for (auto& x : input) {
+                x = randomSample(amplitude);
+            }
+            bool isNonZero = gate.render(input.data(), output.data(), NUM_FRAMES);
+            QCOMPARE(inPlaceGate.render(input.data(), input.data(), NUM_FRAMES), isNonZero);
+            QVERIFY(input == output);
+        }
+
+        // silence stays silent
+        std::fill(input.begin(), input.end(), 0);
+        for (int block = 0; block < 100; block++) {
+            gate.render(input.data(), output.data(), NUM_FRAMES);
+        }
+        QVERIFY(!gate.render(input.data(), output.data(), NUM_FRAMES));
+    }
+}
+
+void AudioDynamicsTests::testReverbInPlace() {
+    AudioReverb reverb(SAMPLE_RATE);
+    AudioReverb inPlaceReverb(SAMPLE_RATE);
+    ReverbParameters parameters;
+    reverb.getParameters(&parameters);
+    parameters.wetDryMix = 30.0f;
+    reverb.setParameters(&parameters);
+    inPlaceReverb.setParameters(&parameters);
+
+    srand(2);
+    std::vector<float> input(2 * NUM_FRAMES);
+    std::vector<float> output(2 * NUM_FRAMES);
+    for (int block = 0; block < 20; block++) {
+        for (auto& x : input) {
+            x = randomFloat(-1.0f, 1.0f);
+        }
+        float* inputs[2] = { &input[0], &input[NUM_FRAMES] };
+        float* outputs[2] = { &output[0], &output[NUM_FRAMES] };
+        reverb.render(inputs, outputs, NUM_FRAMES);
+        inPlaceReverb.render(inputs, inputs, NUM_FRAMES);
+        QVERIFY(input == output);
+    }
+}
+
+//
+// Golden outputs. The samples below were rendered by the limiter, gate and reverb from before they processed audio
+// in blocks, from inputs that are the same on every platform. Block processing gives the same output bit for bit, but
+// the filter coefficients come from the platform's math library, so the samples are compared with a small tolerance.
+//
+
+const int GOLDEN_FRAMES = 4800;
+const int GOLDEN_BLOCK_FRAMES = 237;
+const int NUM_GOLDEN_SAMPLES = 24;
+const int GOLDEN_SAMPLE_TOLERANCE = 2;
+const float GOLDEN_FLOAT_TOLERANCE = 1.0e-4f;
+
+// a pseudo-random sequence that is the same on every platform, unlike rand()
+class GoldenNoise {
+public:
+    uint32_t next() {
+        _state = _state * 1664525u + 1013904223u;
+        return _state;
+    }
+
+    // in [-1, 1)
+    float nextFloat() { return (float)(int32_t)next() * (1.0f / 2147483648.0f); }
+
+    // in [-amplitude, amplitude]
+    int16_t nextSample(int amplitude) { return (int16_t)((int)(next() >> 8) % (2 * amplitude + 1) - amplitude); }
+
+private:
+    uint32_t _state { 12345 };
+};
+
+// noise whose level changes every block, from quiet to well past clipping
+static std::vector<float> goldenLimiterInput(int numChannels) {
+    const float LEVELS[] = { 0.25f, 1.0f, 4.0f, 0.5f, 8.0f, 0.0625f };
+    GoldenNoise noise;
+    std::vector<float> input(numChannels * GOLDEN_FRAMES);
+    for (int i = 0; i < (int)input.size(); i++) {
+        float level = LEVELS[(i / (numChannels * GOLDEN_BLOCK_FRAMES)) % 6];
+        input[i] = 32768.0f * level * noise.nextFloat();
+    }
+    return input;
+}
+
+// quiet noise with loud bursts, and a DC offset in some blocks
+static std::vector<int16_t> goldenGateInput(int numChannels) {
+    GoldenNoise noise;
+    std::vector<int16_t> input(numChannels * GOLDEN_FRAMES);
+    for (int i = 0; i < (int)input.size(); i++) {
+        int block = i / (numChannels * GOLDEN_BLOCK_FRAMES);
+        input[i] = noise.nextSample(block % 4 == 1 ? 16000 : 20) + (int16_t)(block % 3 == 0 ? 1000 : 0);
+    }
+    return input;
+}
+
+// stereo noise in one block out of four, so that the reverb's tail is heard on its own
+static std::vector<float> goldenReverbInput() {
+    GoldenNoise noise;
+    std::vector<float> input(2 * GOLDEN_FRAMES);
+    for (int i = 0; i < GOLDEN_FRAMES; i++) {
+        float level = (i / GOLDEN_BLOCK_FRAMES) % 4 == 0 ? 0.5f : 0.0f;
+        input[2 * i + 0] = level * noise.nextFloat();
+        input[2 * i + 1] = level * noise.nextFloat();
+    }
+    return input;
+}
+
+// calls render(offset, numFrames) for each block, with a short last block
+static void renderInBlocks(int numChannels, std::function<void(int, int)> render) {
+    for (int frame = 0; frame < GOLDEN_FRAMES; frame += GOLDEN_BLOCK_FRAMES) {
+        int numFrames = std::min(GOLDEN_BLOCK_FRAMES, GOLDEN_FRAMES - frame);
+        render(numChannels * frame, numFrames);
+    }
+}
+
+static void setGoldenReverbParameters(AudioReverb& reverb) {
+    ReverbParameters parameters;
+    reverb.getParameters(&parameters);
+    parameters.reverbTime = 2.0f;
+    parameters.wetDryMix = 50.0f;
+    reverb.setParameters(&parameters);
+}
+
+// evenly spaced samples of an output
+template <typename T>
+static std::vector<T> goldenSamples(const std::vector<T>& output) {
+    std::vector<T> samples;
+    int stride = (int)output.size() / NUM_GOLDEN_SAMPLES;
+    for (int i = 0; i < NUM_GOLDEN_SAMPLES; i++) {
+        samples.push_back(output[i * stride + stride / 2]);
+    }
+    return samples;
+}
+
+static bool matchesGolden(const std::vector<int16_t>& output, const int16_t* golden) {
+    std::vector<int16_t> samples = goldenSamples(output);
+    for (int i = 0; i < NUM_GOLDEN_SAMPLES; i++) {
+        if (abs(samples[i] - golden[i]) > GOLDEN_SAMPLE_TOLERANCE) {
+            qWarning("sample %d is %d, expected %d", i, samples[i], golden[i]);
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool matchesGolden(const std::vector<float>& output, const float* golden) {
+    std::vector<float> samples = goldenSamples(output);
+    for (int i = 0; i < NUM_GOLDEN_SAMPLES; i++) {
+        if (fabsf(samples[i] - golden[i]) > GOLDEN_FLOAT_TOLERANCE) {
+            qWarning("sample %d is %.9g, expected %.9g", i, samples[i], golden[i]);
+            return false;
+        }
+    }
+    return true;
+}
+
+// for 1, 2 and 4 channels
+const int NUM_GOLDEN_CHANNELS[] = { 1, 2, 4 };
+
+const int16_t GOLDEN_LIMITER[3][NUM_GOLDEN_SAMPLES] = {
+    {
+        -13940, 7194, -24397, 8908, 1083, -12365, 498, 28781, 5205, -8216, -20222, -7932, -31882, 662, 425, 9905,
+        -23472, -10949, -7240, -17084, -844, -4312, -11429, 20257
+    }, {
+        -29453, 5828, -3273, 32206, 7283, 6802, 821, -8439, -1058, -15295, -10672, 12337, 18767, 619, 6334, -25661,
+        20676, -16609, -6983, -31771, -806, 4700, -15847, -17825
+    }, {
+        -9481, 12285, -19942, -13560, -13352, 261, 873, -2005, -11167, 16373, -4473, -11184, -4708, -100, -5518, -12235,
+        31500, 10054, -7453, -32630, -1073, -3209, -15237, 27378
+    }
+};
+
+const int16_t GOLDEN_GATE[3][NUM_GOLDEN_SAMPLES] = {
+    {
+        0, 496, 15040, -45, 971, -65, -46, -6431, 920, -94, -116, -1835, -118, -99, -123, 882, 10500, -124, 856, 855,
+        -137, 4380, 812, -203
+    }, {
+        0, 489, 14302, 0, 970, -27, -10, -226, 946, -45, -53, 701, -59, -42, -67, 940, 2380, -55, 936, 923, -90, 13549,
+        916, -102
+    }, {
+        0, 501, -7454, -8, 1000, -16, -16, 11331, 981, -21, -22, -8078, -55, -63, -35, 963, -13843, -36, 937, 950, -45,
+        -9124, 922, -78
+    }
+};
+
+const int16_t GOLDEN_GATE_REMOVE_DC[3][NUM_GOLDEN_SAMPLES] = {
+    {
+        1006, 5866, -45, -31, 946, -62, 7265, 906, -117, -110, -111, -14418, -125, -107, 874, 11088, 10892, -147, 859,
+        -141, 2561, 815, 796, -206
+    }, {
+        1011, -7637, 8, -8, 993, -40, -14010, 953, -31, -43, -50, -1109, -44, -63, 922, 1195, -12732, -90, 921, -90,
+        -15451, 938, 894, -86
+    }, {
+        982, -270, -4, -4, 962, -43, -4063, 983, -20, -25, -46, -8970, -45, -43, 973, -12850, -9927, -29, 952, -54,
+        -12910, 926, 928, -73
+    }
+};
+
+const int16_t GOLDEN_REVERB_INT16[NUM_GOLDEN_SAMPLES] = {
+    3966, 0, 1, -1, 0, -3688, 2228, 326, -137, -5014, -88, -782, -1618, -1007, -5802, 320, -873, 538, -296, 6566, 1446,
+    1486, -334, 573
+};
+
+const float GOLDEN_REVERB_FLOAT[NUM_GOLDEN_SAMPLES] = {
+    0.121026166f, 0.0f, 0.0f, 0.0f, 0.0f, -0.112539798f, 0.0680234134f, 0.00994033925f, -0.00419249712f, -0.153040707f,
+    -0.00267574191f, -0.023885455f, -0.0493748412f, -0.0307303779f, -0.177074879f, 0.00975642726f, -0.026670374f,
+    0.0164282564f, -0.00904265977f, 0.20041959f, 0.0441169403f, 0.0453411788f, -0.0102119166f, 0.0174751729f
+};
+
+void AudioDynamicsTests::testLimiterGolden() {
+    for (int i = 0; i < 3; i++) {
+        int numChannels = NUM_GOLDEN_CHANNELS[i];
+        AudioLimiter limiter(SAMPLE_RATE, numChannels);
+        std::vector<float> input = goldenLimiterInput(numChannels);
+        std::vector<int16_t> output(input.size());
+        renderInBlocks(numChannels, [&](int offset, int numFrames) {
+            limiter.render(&input[offset], &output[offset], numFrames);
+        });
+        QVERIFY2(matchesGolden(output, GOLDEN_LIMITER[i]), qPrintable(QString("%1 channels").arg(numChannels)));
+    }
+}
+
+void AudioDynamicsTests::testGateGolden() {
+    for (int i = 0; i < 3; i++) {
+        int numChannels = NUM_GOLDEN_CHANNELS[i];
+        std::vector<int16_t> input = goldenGateInput(numChannels);
+        std::vector<int16_t> output(input.size());
+
+        AudioGate gate(SAMPLE_RATE, numChannels);
+        renderInBlocks(numChannels, [&](int offset, int numFrames) {
+            gate.render(&input[offset], &output[offset], numFrames);
+        });
+        QVERIFY2(matchesGolden(output, GOLDEN_GATE[i]), qPrintable(QString("%1 channels").arg(numChannels)));
+
+        AudioGate dcGate(SAMPLE_RATE, numChannels);
+        renderInBlocks(numChannels, [&](int offset, int numFrames) {
+            dcGate.removeDC(&input[offset], &output[offset], numFrames);
+        });
+        QVERIFY2(matchesGolden(output, GOLDEN_GATE_REMOVE_DC[i]),
+                 qPrintable(QString("removeDC, %1 channels").arg(numChannels)));
+    }
+}
+
+void AudioDynamicsTests::testReverbGolden() {
+    std::vector<float> input = goldenReverbInput();
+
+    // interleaved int16_t
+    std::vector<int16_t> sampleInput(input.size());
+    for (size_t i = 0; i < input.size(); i++) {
+        sampleInput[i] = (int16_t)(32767.0f * input[i]);
+    }
+    std::vector<int16_t> sampleOutput(input.size());
+    AudioReverb sampleReverb(SAMPLE_RATE);
+    setGoldenReverbParameters(sampleReverb);
+    renderInBlocks(2, [&](int offset, int numFrames) {
+        sampleReverb.render(&sampleInput[offset], &sampleOutput[offset], numFrames);
+    });
+    QVERIFY(matchesGolden(sampleOutput, GOLDEN_REVERB_INT16));
+
+    // interleaved float
+    std::vector<float> output(input.size());
+    AudioReverb reverb(SAMPLE_RATE);
+    setGoldenReverbParameters(reverb);
+    renderInBlocks(2, [&](int offset, int numFrames) {
+        reverb.render(&input[offset], &output[offset], numFrames);
+    });
+    QVERIFY(matchesGolden(output, GOLDEN_REVERB_FLOAT));
+}
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+#include <CPUDetect.h>
+
+void limiterPeaks_ref(const float* input, int32_t threshold, int32_t* attn, int numChannels, int numFrames);
+void limiterOutput_ref(const float* input, const float* gain, const float* noise, int16_t* output,
+                       int numChannels, int numFrames);
+void gatePeaks_ref(const int32_t* input, int32_t* peaks, int numChannels, int numFrames);
+bool gateOutput_ref(const int32_t* input, const int32_t* attn, int16_t* output, int numChannels, int numFrames);
+void reverbMix_ref(const float* dry, const float* wet, float mix, float* output, int numFrames);
+void limiterPeaks_AVX2(const float* input, int32_t threshold, int32_t* attn, int numChannels, int numFrames);
+void limiterOutput_AVX2(const float* input, const float* gain, const float* noise, int16_t* output,
+                        int numChannels, int numFrames);
+void gatePeaks_AVX2(const int32_t* input, int32_t* peaks, int numChannels, int numFrames);
+bool gateOutput_AVX2(const int32_t* input, const int32_t* attn, int16_t* output, int numChannels, int numFrames);
+void reverbMix_AVX2(const float* dry, const float* wet, float mix, float* output, int numFrames);
+
+// the kernel inputs for numFrames frames, including values at the edges of their ranges
+class KernelData {
+public:
+    KernelData(int numChannels, int numFrames) : numChannels(numChannels), numFrames(numFrames) {
+        int numSamples = numChannels * numFrames;
+        samples.resize(numSamples);
+        fixedSamples.resize(numSamples);
+        gain.resize(numFrames);
+        noise.resize(numFrames);
+        attn.resize(numFrames);
+        wet.resize(numSamples);
+
+        for (int i = 0; i < numSamples; i++) {
+            // log-uniform over the range of the limiter detector, and past it
+            samples[i] = powf(2.0f, randomFloat(-24.0f, 20.0f)) * (rand() % 2 ? 1.0f : -1.0f);
+            // Q30, like the output of the gate's DC-blocking filter
+            fixedSamples[i] = (int32_t)((uint32_t)rand() ^ ((uint32_t)rand() << 16)) >> (1 + rand() % 31);
+            wet[i] = randomFloat(-1.0f, 1.0f);
+        }
+        const float EDGE_SAMPLES[] = { 0.0f, -0.0f, 1.0f, -1.0f, 32768.0f, 1.0e-30f, 1.0e30f, INFINITY };
+        const int32_t EDGE_FIXED_SAMPLES[] = { 0, 1, -1, 0x3fffffff, -0x40000000, 0x01ffffff, 0x00ffffff, 0x00800000 };
+        for (int i = 0; i < 8; i++) {
+            samples[(i * 13) % numSamples] = EDGE_SAMPLES[i];
+            fixedSamples[(i * 13) % numSamples] = EDGE_FIXED_SAMPLES[i];
+        }
+
+        for (int n = 0; n < numFrames; n++) {
+            gain[n] = randomFloat(0.0f, 40000.0f);
+            noise[n] = randomFloat(-1.0f, 1.0f);
+            attn[n] = (int32_t)(((uint32_t)rand() ^ ((uint32_t)rand() << 16)) & 0x7fffffff);
+        }
+        attn[0] = 0x7fffffff;
+    }
+
+    int numChannels;
+    int numFrames;
+    std::vector<float> samples;
+    std::vector<int32_t> fixedSamples;
+    std::vector<float> gain;
+    std::vector<float> noise;
+    std::vector<int32_t> attn;
+    std::vector<float> wet;
+};
+
+void AudioDynamicsTests::testKernelsMatchReference() {
+    if (!cpuSupportsAVX2()) {
+        QSKIP("AVX2 not supported");
+    }
+
+    srand(3);
+    const int32_t THRESHOLD = 15 << 26;
+    for (int numChannels : { 1, 2, 4 }) {
+        for (int numFrames : { NUM_FRAMES, 8, 1 }) {
+            KernelData data(numChannels, numFrames);
+            int numSamples = numChannels * numFrames;
+
+            std::vector<int32_t> expectedPeaks(numFrames);
+            std::vector<int32_t> peaks(numFrames);
+            limiterPeaks_ref(data.samples.data(), THRESHOLD, expectedPeaks.data(), numChannels, numFrames);
+            limiterPeaks_AVX2(data.samples.data(), THRESHOLD, peaks.data(), numChannels, numFrames);
+            QVERIFY(peaks == expectedPeaks);
+
+            gatePeaks_ref(data.fixedSamples.data(), expectedPeaks.data(), numChannels, numFrames);
+            gatePeaks_AVX2(data.fixedSamples.data(), peaks.data(), numChannels, numFrames);
+            QVERIFY(peaks == expectedPeaks);
+
+            std::vector<int16_t> expectedOutput(numSamples);
+            std::vector<int16_t> output(numSamples);
+            limiterOutput_ref(data.samples.data(), data.gain.data(), data.noise.data(), expectedOutput.data(),
+                              numChannels, numFrames);
+            limiterOutput_AVX2(data.samples.data(), data.gain.data(), data.noise.data(), output.data(),
+                               numChannels, numFrames);
+            QVERIFY(output == expectedOutput);
+
+            bool expectedNonZero = gateOutput_ref(data.fixedSamples.data(), data.attn.data(), expectedOutput.data(),
+                                                  numChannels, numFrames);
+            bool isNonZero = gateOutput_AVX2(data.fixedSamples.data(), data.attn.data(), output.data(),
+                                             numChannels, numFrames);
+            QVERIFY(output == expectedOutput);
+            QCOMPARE(isNonZero, expectedNonZero);
+
+            std::vector<float> expectedMix(numSamples);
+            std::vector<float> mix(numSamples);
+            reverbMix_ref(data.samples.data(), data.wet.data(), 0.3f, expectedMix.data(), numSamples);
+            reverbMix_AVX2(data.samples.data(), data.wet.data(), 0.3f, mix.data(), numSamples);
+            QVERIFY(memcmp(mix.data(), expectedMix.data(), numSamples * sizeof(float)) == 0);
+        }
+    }
+
+    // silent output
+    KernelData data(2, NUM_FRAMES);
+    std::fill(data.attn.begin(), data.attn.end(), 0);
+    std::vector<int16_t> output(2 * NUM_FRAMES);
+    QVERIFY(!gateOutput_AVX2(data.fixedSamples.data(), data.attn.data(), output.data(), 2, NUM_FRAMES));
+}
+
+void AudioDynamicsTests::benchmarkKernels_data() {
+    QTest::addColumn<QString>("kernel");
+    QTest::addColumn<int>("numChannels");
+    QTest::addColumn<bool>("simd");
+
+    for (QString kernel : { "limiterPeaks", "limiterOutput", "gatePeaks", "gateOutput" }) {
+        for (int numChannels : { 1, 2, 4 }) {
+            for (bool simd : { false, true }) {
+                QString name = QString("%1 %2ch %3").arg(kernel).arg(numChannels).arg(simd ? "AVX2" : "ref");
+                QTest::newRow(qPrintable(name)) << kernel << numChannels << simd;
+            }
+        }
+    }
+    QTest::newRow("reverbMix ref") << QString("reverbMix") << 2 << false;
+    QTest::newRow("reverbMix AVX2") << QString("reverbMix") << 2 << true;
+}
+
+void AudioDynamicsTests::benchmarkKernels() {
+    QFETCH(QString, kernel);
+    QFETCH(int, numChannels);
+    QFETCH(bool, simd);
+    if (simd && !cpuSupportsAVX2()) {
+        QSKIP("AVX2 not supported");
+    }
+
+    srand(4);
+    KernelData data(numChannels, BENCHMARK_FRAMES);
+    std::vector<int32_t> peaks(BENCHMARK_FRAMES);
+    std::vector<int16_t> output(numChannels * BENCHMARK_FRAMES);
+    std::vector<float> mix(numChannels * BENCHMARK_FRAMES);
+    const int32_t THRESHOLD = 15 << 26;
+
+    if (kernel == "limiterPeaks") {
+        auto f = simd ? limiterPeaks_AVX2 : limiterPeaks_ref;
+        reportTimePerFrame(BENCHMARK_FRAMES, [&] {
+            f(data.samples.data(), THRESHOLD, peaks.data(), numChannels, BENCHMARK_FRAMES);
+        });
+    } else if (kernel == "limiterOutput") {
+        auto f = simd ? limiterOutput_AVX2 : limiterOutput_ref;
+        reportTimePerFrame(BENCHMARK_FRAMES, [&] {
+            f(data.samples.data(), data.gain.data(), data.noise.data(), output.data(), numChannels, BENCHMARK_FRAMES);
+        });
+    } else if (kernel == "gatePeaks") {
+        auto f = simd ? gatePeaks_AVX2 : gatePeaks_ref;
+        reportTimePerFrame(BENCHMARK_FRAMES, [&] {
+            f(data.fixedSamples.data(), peaks.data(), numChannels, BENCHMARK_FRAMES);
+        });
+    } else if (kernel == "gateOutput") {
+        auto f = simd ? gateOutput_AVX2 : gateOutput_ref;
+        reportTimePerFrame(BENCHMARK_FRAMES, [&] {
+            f(data.fixedSamples.data(), data.attn.data(), output.data(), numChannels, BENCHMARK_FRAMES);
+        });
+    } else {
+        // one call per channel, as the reverb mixes each deinterleaved channel
+        auto f = simd ? reverbMix_AVX2 : reverbMix_ref;
+        reportTimePerFrame(BENCHMARK_FRAMES, [&] {
+            f(data.samples.data(), data.wet.data(), 0.3f, mix.data(), BENCHMARK_FRAMES);
+            f(&data.samples[BENCHMARK_FRAMES], &data.wet[BENCHMARK_FRAMES], 0.3f, &mix[BENCHMARK_FRAMES],
+              BENCHMARK_FRAMES);
+        });
+    }
+}
+
+#else
+void AudioDynamicsTests::testKernelsMatchReference() {
+    QSKIP("no SIMD kernels on this architecture");
+}
+
+void AudioDynamicsTests::benchmarkKernels_data() {
+}
+
+void AudioDynamicsTests::benchmarkKernels() {
+    QSKIP("no SIMD kernels on this architecture");
+}
+#endif
+
+void AudioDynamicsTests::benchmarkRender_data() {
+    QTest::addColumn<QString>("processor");
+    QTest::addColumn<int>("numChannels");
+
+    for (int numChannels : { 1, 2, 4 }) {
+        QTest::newRow(qPrintable(QString("limiter %1ch").arg(numChannels))) << QString("limiter") << numChannels;
+    }
+    for (int numChannels : { 1, 2, 4 }) {
+        QTest::newRow(qPrintable(QString("gate %1ch").arg(numChannels))) << QString("gate") << numChannels;
+    }
+    QTest::newRow("reverb 2ch") << QString("reverb") << 2;
+}
+
+void AudioDynamicsTests::benchmarkRender() {
+    QFETCH(QString, processor);
+    QFETCH(int, numChannels);
+
+    srand(5);
+    std::vector<float> input(numChannels * BENCHMARK_FRAMES);
+    std::vector<int16_t> fixedInput(numChannels * BENCHMARK_FRAMES);
+    std::vector<int16_t> output(numChannels * BENCHMARK_FRAMES);
+    for (int i = 0; i < numChannels * BENCHMARK_FRAMES; i++) {
+        input[i] = randomFloat(-2.0f, 2.0f);
+        fixedInput[i] = randomSample(8000);
+    }
+
+    if (processor == "limiter") {
+        AudioLimiter limiter(SAMPLE_RATE, numChannels);
+        reportTimePerFrame(BENCHMARK_FRAMES, [&] {
+            limiter.render(input.data(), output.data(), BENCHMARK_FRAMES);
+        });
+    } else if (processor == "gate") {
+        AudioGate gate(SAMPLE_RATE, numChannels);
+        reportTimePerFrame(BENCHMARK_FRAMES, [&] {
+            gate.render(fixedInput.data(), output.data(), BENCHMARK_FRAMES);
+        });
+    } else {
+        AudioReverb reverb(SAMPLE_RATE);
+        reportTimePerFrame(BENCHMARK_FRAMES, [&] {
+            reverb.render(fixedInput.data(), output.data(), BENCHMARK_FRAMES);
+        });
+    }
+}
@@ -0,0 +1,32 @@
+//
+//  AudioDynamicsTests.h
+//  tests/audio/src
+//
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AudioDynamicsTests_h
+#define hifi_AudioDynamicsTests_h
+
+#include <QtTest/QtTest>
+
+class AudioDynamicsTests : public QObject {
+    Q_OBJECT
+private slots:
+    void testLimiter();
+    void testGateInPlace();
+    void testReverbInPlace();
+    void testLimiterGolden();
+    void testGateGolden();
+    void testReverbGolden();
+    void testKernelsMatchReference();
+    void benchmarkKernels_data();
+    void benchmarkKernels();
+    void benchmarkRender_data();
+    void benchmarkRender();
+};
+
+#endif // hifi_AudioDynamicsTests_h
@@ -0,0 +1,158 @@
+//
+//  InjectedAudioStreamTests.cpp
+//  tests/audio/src
+//
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "InjectedAudioStreamTests.h"
+
+#include <memory>
+#include <vector>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+#include <AudioConstants.h>
+#include <InjectedAudioStream.h>
+#include <ReceivedMessage.h>
+#include <plugins/CodecPlugin.h>
+
+QTEST_MAIN(InjectedAudioStreamTests)
+
+static const QString TEST_CODEC = "delta";
+static const int NUM_PACKETS = 8;
+static const int PACKETS_PER_BATCH = 4;
+static const int FRAME_SAMPLES = AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL;
+
+// Sends each sample as the difference from the one before, so that frames only decode right in order.
+class DeltaDecoder : public Decoder {
+public:
+    void decode(const QByteArray& encodedBuffer, QByteArray& decodedBuffer) override {
+        decodedBuffer.resize(encodedBuffer.size());
+        auto encoded = reinterpret_cast<const int16_t*>(encodedBuffer.constData());
+        auto decoded = reinterpret_cast<int16_t*>(decodedBuffer.data());
+        for (int i = 0; i < encodedBuffer.size() / (int)sizeof(int16_t); i++) {
+            _lastSample += encoded[i];
+            decoded[i] = _lastSample;
+        }
+    }
+
+    void lostFrame(QByteArray& decodedBuffer) override {
+        decodedBuffer.fill(0);
+    }
+
+private:
+    int16_t _lastSample { 0 };
+};
+
+class DeltaCodec : public CodecPlugin {
+public:
+    const QString getName() const override { return TEST_CODEC; }
+
+    Encoder* createEncoder(int sampleRate, int numChannels) override { return nullptr; }
+    Decoder* createDecoder(int sampleRate, int numChannels) override { return new DeltaDecoder(); }
+    void releaseEncoder(Encoder* encoder) override { delete encoder; }
+    void releaseDecoder(Decoder* decoder) override { delete decoder; }
+};
+
+// an InjectAudio packet laid out as AudioInjector writes it
+static QByteArray createInjectedPacket(const QUuid& streamID, quint16 sequence, bool isStereo, const QByteArray& audio) {
+    QByteArray payload;
+    QDataStream packetStream(&payload, QIODevice::WriteOnly);
+
+    packetStream.writeRawData(reinterpret_cast<const char*>(&sequence), sizeof(sequence));
+    QByteArray codec = TEST_CODEC.toUtf8();
+    uint32_t codecSize = codec.size();
+    packetStream.writeRawData(reinterpret_cast<const char*>(&codecSize), sizeof(codecSize));
+    packetStream.writeRawData(codec.constData(), codec.size());
+
+    packetStream << streamID;
+    packetStream << isStereo;
+    packetStream << (uchar)0;
+
+    glm::vec3 position(1.0f, 2.0f, 3.0f);
+    glm::quat orientation;
+    glm::vec3 boxCorner(0.0f);
+    packetStream.writeRawData(reinterpret_cast<const char*>(&position), sizeof(position));
+    packetStream.writeRawData(reinterpret_cast<const char*>(&orientation), sizeof(orientation));
+    packetStream.writeRawData(reinterpret_cast<const char*>(&position), sizeof(position));
+    packetStream.writeRawData(reinterpret_cast<const char*>(&boxCorner), sizeof(boxCorner));
+
+    float radius = 0.0f;
+    quint8 volume = 255;
+    bool ignorePenumbra = false;
+    packetStream << radius << volume << ignorePenumbra;
+
+    packetStream.writeRawData(audio.constData(), audio.size());
+    return payload;
+}
+
+static std::unique_ptr<ReceivedMessage> createMessage(const QByteArray& payload) {
+    const NLPacket::LocalID SOURCE_ID = 1;
+    return std::unique_ptr<ReceivedMessage>(new ReceivedMessage(payload, PacketType::InjectAudio,
+        versionForPacketType(PacketType::InjectAudio), SockAddr(), SOURCE_ID));
+}
+
+static QByteArray createFrame(int index) {
+    QByteArray audio(FRAME_SAMPLES * sizeof(int16_t), 0);
+    auto samples = reinterpret_cast<int16_t*>(audio.data());
+    for (int i = 0; i < FRAME_SAMPLES; i++) {
+        samples[i] = (int16_t)((index * 31 + i * 7) % 64 - 32);
+    }
+    return audio;
+}
+
+static std::vector<int16_t> popAllSamples(InboundAudioStream& stream) {
+    std::vector<int16_t> samples(stream.getSamplesAvailable());
+    if (stream.popSamples((int)samples.size(), true) == (int)samples.size()) {
+        stream.getLastPopOutput().readSamples(samples.data(), (int)samples.size());
+    }
+    return samples;
+}
+
+void InjectedAudioStreamTests::predecodeTest() {
+    auto codec = std::make_shared<DeltaCodec>();
+    QUuid streamID = QUuid::createUuid();
+    InjectedAudioStream predecodedStream(streamID, false);
+    InjectedAudioStream decodedStream(streamID, false);
+    predecodedStream.setupCodec(codec, TEST_CODEC, 1);
+    decodedStream.setupCodec(codec, TEST_CODEC, 1);
+
+    // queued packets are predecoded a batch at a time, then parsed, as the mixer does
+    for (int batch = 0; batch < NUM_PACKETS / PACKETS_PER_BATCH; batch++) {
+        std::vector<std::unique_ptr<ReceivedMessage>> predecodedMessages;
+        std::vector<std::unique_ptr<ReceivedMessage>> decodedMessages;
+        for (int i = 0; i < PACKETS_PER_BATCH; i++) {
+            quint16 sequence = batch * PACKETS_PER_BATCH + i;
+            auto payload = createInjectedPacket(streamID, sequence, false, createFrame(sequence));
+            predecodedMessages.push_back(createMessage(payload));
+            decodedMessages.push_back(createMessage(payload));
+            QVERIFY(predecodedStream.predecodeAudioData(*predecodedMessages.back()));
+        }
+        for (int i = 0; i < PACKETS_PER_BATCH; i++) {
+            predecodedStream.parseData(*predecodedMessages[i]);
+            decodedStream.parseData(*decodedMessages[i]);
+        }
+    }
+
+    QCOMPARE(predecodedStream.getSamplesAvailable(), NUM_PACKETS * FRAME_SAMPLES);
+    QCOMPARE(decodedStream.getSamplesAvailable(), NUM_PACKETS * FRAME_SAMPLES);
+    auto predecodedSamples = popAllSamples(predecodedStream);
+    auto decodedSamples = popAllSamples(decodedStream);
+    QVERIFY(predecodedSamples == decodedSamples);
+}
+
+void InjectedAudioStreamTests::stereoChangeTest() {
+    auto codec = std::make_shared<DeltaCodec>();
+    QUuid streamID = QUuid::createUuid();
+    InjectedAudioStream stream(streamID, false);
+    stream.setupCodec(codec, TEST_CODEC, 1);
+
+    auto message = createMessage(createInjectedPacket(streamID, 0, true, createFrame(0)));
+    QVERIFY(!stream.predecodeAudioData(*message));
+    QCOMPARE(message->getPosition(), (qint64)0);
+}
@@ -0,0 +1,28 @@
+//
+//  InjectedAudioStreamTests.h
+//  tests/audio/src
+//
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_InjectedAudioStreamTests_h
+#define hifi_InjectedAudioStreamTests_h
+
+#pragma once
+
+#include <QtTest/QtTest>
+
+class InjectedAudioStreamTests : public QObject {
+    Q_OBJECT
+private slots:
+    // Test that injected packets are predecoded, and parsed to the same samples as without predecoding
+    void predecodeTest();
+
+    // Test that a change of channel flag keeps a packet from being predecoded
+    void stereoChangeTest();
+};
+
+#endif // hifi_InjectedAudioStreamTests_h
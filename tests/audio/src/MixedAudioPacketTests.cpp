@@ -0,0 +1,140 @@
+//
+//  MixedAudioPacketTests.cpp
+//  tests/audio/src
+//
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "MixedAudioPacketTests.h"
+
+#include <cstdlib>
+#include <new>
+
+#include <AudioConstants.h>
+#include <DependencyManager.h>
+#include <MixedAudioPacket.h>
+#include <NLPacketArena.h>
+#include <NodeList.h>
+
+QTEST_MAIN(MixedAudioPacketTests)
+
+// count the heap allocations made on the test thread while counting is on
+static thread_local bool countAllocations = false;
+static thread_local int numAllocations = 0;
+
+void* operator new(std::size_t size) {
+    if (countAllocations) {
+        ++numAllocations;
+    }
+    void* pointer = std::malloc(size ? size : 1);
+    if (!pointer) {
+        throw std::bad_alloc();
+    }
+    return pointer;
+}
+
+void operator delete(void* pointer) noexcept {
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept {
+    std::free(pointer);
+}
+
+static const int NUM_TEST_FRAMES = 100;
+static const int FRAME_BYTES = AudioConstants::NETWORK_FRAME_BYTES_STEREO;
+
+// the codec clients without a codec plugin ask for, whose frames go out as they are
+static const QByteArray PCM_CODEC = "pcm";
+
+// a node at this node list's own socket, for the packets to really go out
+static SharedNodePointer createLoopbackNode() {
+    auto nodeList = DependencyManager::get<NodeList>();
+    SockAddr loopback(SocketType::UDP, QHostAddress::LocalHost, nodeList->getSocketLocalPort(SocketType::UDP));
+    auto node = nodeList->addOrUpdateNode(QUuid::createUuid(), NodeType::Agent, loopback, loopback);
+    node->activatePublicSocket();
+    return node;
+}
+
+// builds and sends a mixed audio frame the way AudioMixerSlave::sendMixPacket does
+static qint64 sendMixedFrame(NLPacketArena& arena, const Node& node, quint16 sequence, const char* frame) {
+    auto mixPacket = createMixedAudioPacket(arena, PacketType::MixedAudio, sequence, PCM_CODEC);
+    char* encodedBuffer = mixPacket->getPayload() + mixPacket->pos();
+    int encodedSize = encodeMixedAudioFrame(nullptr, frame, FRAME_BYTES, encodedBuffer,
+                                            (int)mixPacket->bytesAvailableForWrite());
+    mixPacket->setPayloadSize(mixPacket->pos() + encodedSize);
+    return arena.send(*DependencyManager::get<NodeList>(), std::move(mixPacket), node);
+}
+
+void MixedAudioPacketTests::initTestCase() {
+    DependencyManager::registerInheritance<LimitedNodeList, NodeList>();
+    DependencyManager::set<NodeList>(NodeType::AudioMixer, 0);
+}
+
+void MixedAudioPacketTests::layoutTest() {
+    NLPacketArena arena;
+    char frame[FRAME_BYTES];
+    for (int i = 0; i < FRAME_BYTES; i++) {
+        frame[i] = (char)i;
+    }
+
+    const quint16 SEQUENCE = 1234;
+    auto mixPacket = createMixedAudioPacket(arena, PacketType::MixedAudio, SEQUENCE, PCM_CODEC);
+    char* encodedBuffer = mixPacket->getPayload() + mixPacket->pos();
+    int encodedSize = encodeMixedAudioFrame(nullptr, frame, FRAME_BYTES, encodedBuffer,
+                                            (int)mixPacket->bytesAvailableForWrite());
+    QCOMPARE(encodedSize, FRAME_BYTES);
+    mixPacket->setPayloadSize(mixPacket->pos() + encodedSize);
+
+    mixPacket->seek(0);
+    quint16 sequence;
+    mixPacket->readPrimitive(&sequence);
+    QCOMPARE(sequence, SEQUENCE);
+    QCOMPARE(mixPacket->readString(), QString(PCM_CODEC));
+    QCOMPARE(mixPacket->bytesLeftToRead(), (qint64)FRAME_BYTES);
+    QCOMPARE(memcmp(mixPacket->getPayload() + mixPacket->pos(), frame, FRAME_BYTES), 0);
+}
+
+void MixedAudioPacketTests::frameTooLargeTest() {
+    char frame[FRAME_BYTES] = { 0 };
+    char encodedBuffer[FRAME_BYTES / 2];
+    QCOMPARE(encodeMixedAudioFrame(nullptr, frame, FRAME_BYTES, encodedBuffer, (int)sizeof(encodedBuffer)), 0);
+}
+
+// Covers building, encoding (with the PCM path) and sending a mixed frame once the arena is warm. It does not run
+// AudioMixerSlave::mix, so the mix itself and codec plugins' encoders are not counted here.
+void MixedAudioPacketTests::steadyStateAllocationTest() {
+    auto nodeList = DependencyManager::get<NodeList>();
+    auto node = createLoopbackNode();
+    NLPacketArena arena;
+    char frame[FRAME_BYTES] = { 0 };
+
+    // the first frame creates the packet and the socket's connection to the node
+    QVERIFY(sendMixedFrame(arena, *node, 0, frame) > 0);
+    QCOMPARE(arena.getNumCreated(), (quint64)1);
+
+    // what the socket itself allocates to write a packet, which is the same for any packet
+    auto referencePacket = NLPacket::create(PacketType::MixedAudio);
+    referencePacket->write(frame, FRAME_BYTES);
+    QVERIFY(nodeList->sendUnreliablePacket(*referencePacket, *node) > 0);
+    numAllocations = 0;
+    countAllocations = true;
+    for (int i = 0; i < NUM_TEST_FRAMES; i++) {
+        nodeList->sendUnreliablePacket(*referencePacket, *node);
+    }
+    countAllocations = false;
+    int numSendAllocations = numAllocations;
+
+    numAllocations = 0;
+    countAllocations = true;
+    for (int i = 1; i <= NUM_TEST_FRAMES; i++) {
+        sendMixedFrame(arena, *node, (quint16)i, frame);
+    }
+    countAllocations = false;
+
+    QCOMPARE(numAllocations, numSendAllocations);
+    QCOMPARE(arena.getNumCreated(), (quint64)1);
+}
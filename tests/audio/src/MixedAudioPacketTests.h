@@ -0,0 +1,33 @@
+//
+//  MixedAudioPacketTests.h
+//  tests/audio/src
+//
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_MixedAudioPacketTests_h
+#define hifi_MixedAudioPacketTests_h
+
+#pragma once
+
+#include <QtTest/QtTest>
+
+class MixedAudioPacketTests : public QObject {
+    Q_OBJECT
+private slots:
+    void initTestCase();
+
+    // Test that a mixed audio packet has the layout InboundAudioStream reads
+    void layoutTest();
+
+    // Test that a frame that doesn't fit is sent empty
+    void frameTooLargeTest();
+
+    // Test that building and sending mixed audio frames from a warm arena allocates nothing beyond the socket's own write
+    void steadyStateAllocationTest();
+};
+
+#endif // hifi_MixedAudioPacketTests_h
@@ -0,0 +1,260 @@
+//
+//  GLTFSerializerTests.cpp
+//  tests/model-serializers/src
+//
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "GLTFSerializerTests.h"
+
+#include <QtCore/QDir>
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+#include <QtCore/QtEndian>
+
+#include <DependencyManager.h>
+#include <GLTFSerializer.h>
+#include <ResourceManager.h>
+
+QTEST_MAIN(GLTFSerializerTests)
+
+static const char* BENCHMARK_DIR_ENV_VARIABLE = "VIRCADIA_GLTF_BENCHMARK_DIR";
+
+namespace {
+
+const int FLOAT_COMPONENT_TYPE = 5126;
+const int UNSIGNED_INT_COMPONENT_TYPE = 5125;
+const int FLOATS_PER_VERTEX = 3 + 3 + 2;
+
+void appendUInt32(QByteArray& data, quint32 value) {
+    char bytes[sizeof(quint32)];
+    qToLittleEndian(value, bytes);
+    data.append(bytes, sizeof(bytes));
+}
+
+void appendFloat(QByteArray& data, float value) {
+    char bytes[sizeof(float)];
+    qToLittleEndian(value, bytes);
+    data.append(bytes, sizeof(bytes));
+}
+
+glm::vec3 getGridPosition(int size, int vertex) {
+    return glm::vec3((float)(vertex % size), 0.0f, (float)(vertex / size));
+}
+
+glm::vec2 getGridTexCoord(int size, int vertex) {
+    float scale = 1.0f / (float)std::max(size - 1, 1);
+    return glm::vec2((float)(vertex % size) * scale, (float)(vertex / size) * scale);
+}
+
+QJsonObject createBufferView(int byteOffset, int byteLength, int byteStride = 0) {
+    QJsonObject bufferView {
+        { "buffer", 0 },
+        { "byteOffset", byteOffset },
+        { "byteLength", byteLength }
+    };
+    if (byteStride > 0) {
+        bufferView["byteStride"] = byteStride;
+    }
+    return bufferView;
+}
+
+QJsonObject createAccessor(int bufferView, int byteOffset, int componentType, int count, const QString& type) {
+    return QJsonObject {
+        { "bufferView", bufferView },
+        { "byteOffset", byteOffset },
+        { "componentType", componentType },
+        { "count", count },
+        { "type", type }
+    };
+}
+
+// A size x size grid of vertices in the y = 0 plane, with positions, normals, texture coordinates and indices either in
+// separate buffer views or interleaved in one.
+QByteArray createGridGLB(int size, bool interleaved) {
+    const int numVertices = size * size;
+
+    QByteArray binary;
+    QJsonArray bufferViews;
+    QJsonArray accessors;
+    if (interleaved) {
+        for (int i = 0; i < numVertices; i++) {
+            glm::vec3 position = getGridPosition(size, i);
+            glm::vec2 texCoord = getGridTexCoord(size, i);
+            for (float value : { position.x, position.y, position.z, 0.0f, 1.0f, 0.0f, texCoord.x, texCoord.y }) {
+                appendFloat(binary, value);
+            }
+        }
+        const int stride = FLOATS_PER_VERTEX * sizeof(float);
+        bufferViews.append(createBufferView(0, binary.size(), stride));
+        accessors.append(createAccessor(0, 0, FLOAT_COMPONENT_TYPE, numVertices, "VEC3"));
+        accessors.append(createAccessor(0, 3 * sizeof(float), FLOAT_COMPONENT_TYPE, numVertices, "VEC3"));
+        accessors.append(createAccessor(0, 6 * sizeof(float), FLOAT_COMPONENT_TYPE, numVertices, "VEC2"));
+    } else {
+        for (int i = 0; i < numVertices; i++) {
+            glm::vec3 position = getGridPosition(size, i);
+            appendFloat(binary, position.x);
+            appendFloat(binary, position.y);
+            appendFloat(binary, position.z);
+        }
+        bufferViews.append(createBufferView(0, binary.size()));
+        int offset = binary.size();
+        for (int i = 0; i < numVertices; i++) {
+            appendFloat(binary, 0.0f);
+            appendFloat(binary, 1.0f);
+            appendFloat(binary, 0.0f);
+        }
+        bufferViews.append(createBufferView(offset, binary.size() - offset));
+        offset = binary.size();
+        for (int i = 0; i < numVertices; i++) {
+            glm::vec2 texCoord = getGridTexCoord(size, i);
+            appendFloat(binary, texCoord.x);
+            appendFloat(binary, texCoord.y);
+        }
+        bufferViews.append(createBufferView(offset, binary.size() - offset));
+        for (int i = 0; i < 3; i++) {
+            accessors.append(createAccessor(i, 0, FLOAT_COMPONENT_TYPE, numVertices, i < 2 ? "VEC3" : "VEC2"));
+        }
+    }
+
+    int indicesOffset = binary.size();
+    int numIndices = 0;
+    for (int z = 0; z + 1 < size; z++) {
+        for (int x = 0; x + 1 < size; x++) {
+            quint32 corner = z * size + x;
+            for (quint32 index : { corner, corner + size, corner + 1, corner + 1, corner + size, corner + size + 1 }) {
+                appendUInt32(binary, index);
+                numIndices++;
+            }
+        }
+    }
+    bufferViews.append(createBufferView(indicesOffset, binary.size() - indicesOffset));
+    accessors.append(createAccessor(bufferViews.size() - 1, 0, UNSIGNED_INT_COMPONENT_TYPE, numIndices, "SCALAR"));
+
+    QJsonObject primitive {
+        { "attributes", QJsonObject { { "POSITION", 0 }, { "NORMAL", 1 }, { "TEXCOORD_0", 2 } } },
+        { "indices", accessors.size() - 1 }
+    };
+    QJsonObject document {
+        { "asset", QJsonObject { { "version", "2.0" } } },
+        { "buffers", QJsonArray { QJsonObject { { "byteLength", binary.size() } } } },
+        { "bufferViews", bufferViews },
+        { "accessors", accessors },
+        { "meshes", QJsonArray { QJsonObject { { "primitives", QJsonArray { primitive } } } } },
+        { "nodes", QJsonArray { QJsonObject { { "mesh", 0 } } } },
+        { "scenes", QJsonArray { QJsonObject { { "nodes", QJsonArray { 0 } } } } },
+        { "scene", 0 }
+    };
+
+    // chunks are 4 byte aligned: JSON is padded with spaces and binary data with zeros
+    QByteArray json = QJsonDocument(document).toJson(QJsonDocument::Compact);
+    json.append((4 - json.size() % 4) % 4, ' ');
+    binary.append((4 - binary.size() % 4) % 4, '\0');
+
+    const quint32 GLB_VERSION = 2;
+    const quint32 GLB_CHUNK_TYPE_JSON = 0x4E4F534A;
+    const quint32 GLB_CHUNK_TYPE_BIN = 0x004E4942;
+    const int GLB_HEADER_SIZE = 12;
+    const int GLB_CHUNK_HEADER_SIZE = 8;
+
+    QByteArray glb("glTF");
+    appendUInt32(glb, GLB_VERSION);
+    appendUInt32(glb, GLB_HEADER_SIZE + 2 * GLB_CHUNK_HEADER_SIZE + json.size() + binary.size());
+    appendUInt32(glb, json.size());
+    appendUInt32(glb, GLB_CHUNK_TYPE_JSON);
+    glb.append(json);
+    appendUInt32(glb, binary.size());
+    appendUInt32(glb, GLB_CHUNK_TYPE_BIN);
+    glb.append(binary);
+    return glb;
+}
+
+}
+
+void GLTFSerializerTests::initTestCase() {
+    DependencyManager::set<ResourceManager>(false);
+}
+
+void GLTFSerializerTests::cleanupTestCase() {
+    DependencyManager::get<ResourceManager>()->cleanup();
+    DependencyManager::destroy<ResourceManager>();
+}
+
+void GLTFSerializerTests::testGLBAccessors_data() {
+    QTest::addColumn<bool>("interleaved");
+
+    QTest::newRow("separate") << false;
+    QTest::newRow("interleaved") << true;
+}
+
+void GLTFSerializerTests::testGLBAccessors() {
+    QFETCH(bool, interleaved);
+
+    const int SIZE = 5;
+    QByteArray glb = createGridGLB(SIZE, interleaved);
+    auto model = GLTFSerializer().read(glb, hifi::VariantHash(), hifi::URL("file:///grid.glb"));
+    QVERIFY(model);
+    QCOMPARE(model->meshes.size(), 1);
+
+    const HFMMesh& mesh = model->meshes[0];
+    QCOMPARE(mesh.vertices.size(), SIZE * SIZE);
+    QCOMPARE(mesh.normals.size(), SIZE * SIZE);
+    QCOMPARE(mesh.texCoords.size(), SIZE * SIZE);
+    for (int i = 0; i < SIZE * SIZE; i++) {
+        QCOMPARE(mesh.vertices[i], getGridPosition(SIZE, i));
+        QCOMPARE(mesh.normals[i], glm::vec3(0.0f, 1.0f, 0.0f));
+        QCOMPARE(mesh.texCoords[i], getGridTexCoord(SIZE, i));
+    }
+
+    QCOMPARE(mesh.parts.size(), 1);
+    const int NUM_INDICES = (SIZE - 1) * (SIZE - 1) * 6;
+    QCOMPARE(mesh.parts[0].triangleIndices.size(), NUM_INDICES);
+    QCOMPARE(mesh.parts[0].triangleIndices[NUM_INDICES - 1], SIZE * SIZE - 1);
+}
+
+void GLTFSerializerTests::testTruncatedGLB() {
+    // the binary chunk claims more data than the file holds
+    QByteArray glb = createGridGLB(5, false);
+    glb.chop(64);
+    auto model = GLTFSerializer().read(glb, hifi::VariantHash(), hifi::URL("file:///truncated.glb"));
+    QVERIFY(!model);
+}
+
+void GLTFSerializerTests::benchmarkRead_data() {
+    QTest::addColumn<QByteArray>("data");
+    QTest::addColumn<QString>("url");
+
+    for (int size : { 64, 256, 512 }) {
+        for (bool interleaved : { false, true }) {
+            QString name = QString("grid %1x%1 %2").arg(size).arg(interleaved ? "interleaved" : "separate");
+            QTest::newRow(name.toUtf8().constData()) << createGridGLB(size, interleaved) << "file:///grid.glb";
+        }
+    }
+
+    QString benchmarkDir = qEnvironmentVariable(BENCHMARK_DIR_ENV_VARIABLE);
+    if (!benchmarkDir.isEmpty()) {
+        QDir dir(benchmarkDir);
+        for (auto& fileInfo : dir.entryInfoList({ "*.glb", "*.gltf" }, QDir::Files, QDir::Name)) {
+            QFile file(fileInfo.absoluteFilePath());
+            if (file.open(QIODevice::ReadOnly)) {
+                QTest::newRow(fileInfo.fileName().toUtf8().constData())
+                    << file.readAll() << QUrl::fromLocalFile(fileInfo.absoluteFilePath()).toString();
+            }
+        }
+    }
+}
+
+void GLTFSerializerTests::benchmarkRead() {
+    QFETCH(QByteArray, data);
+    QFETCH(QString, url);
+
+    HFMModel::Pointer model;
+    QBENCHMARK {
+        model = GLTFSerializer().read(data, hifi::VariantHash(), hifi::URL(url));
+    }
+    QVERIFY(model);
+}
@@ -0,0 +1,32 @@
+//
+//  GLTFSerializerTests.h
+//  tests/model-serializers/src
+//
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_GLTFSerializerTests_h
+#define hifi_GLTFSerializerTests_h
+
+#include <QtTest/QtTest>
+
+class GLTFSerializerTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+    void testGLBAccessors_data();
+    void testGLBAccessors();
+    void testTruncatedGLB();
+
+    // Loads generated grids of increasing size, plus every .glb / .gltf found in the directory named by the
+    // VIRCADIA_GLTF_BENCHMARK_DIR environment variable.
+    void benchmarkRead_data();
+    void benchmarkRead();
+};
+
+#endif // hifi_GLTFSerializerTests_h
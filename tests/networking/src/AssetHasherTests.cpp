@@ -0,0 +1,50 @@
+//
+//  AssetHasherTests.cpp
+//  tests/networking/src
+//
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AssetHasherTests.h"
+
+#include <algorithm>
+
+#include <AssetHasher.h>
+
+QTEST_MAIN(AssetHasherTests)
+
+static QByteArray hash(const QByteArray& data) {
+    AssetHasher hasher;
+    hasher.addData(data);
+    return hasher.result().toHex();
+}
+
+void AssetHasherTests::knownVectorsTest() {
+    QCOMPARE(hash(""), QByteArray("e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855"));
+    QCOMPARE(hash("abc"), QByteArray("ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad"));
+    QCOMPARE(hash("abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq"),
+             QByteArray("248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1"));
+    QCOMPARE(hash(QByteArray(1000000, 'a')),
+             QByteArray("cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0"));
+}
+
+void AssetHasherTests::chunkedTest() {
+    QByteArray data(100000, Qt::Uninitialized);
+    for (int i = 0; i < data.size(); i++) {
+        data[i] = (char)(i * 7 + i / 251);
+    }
+
+    // uneven chunks, so that they straddle SHA-256's 64 byte blocks
+    const int CHUNK_SIZE = 1000 + 37;
+    AssetHasher hasher;
+    for (int offset = 0; offset < data.size(); offset += CHUNK_SIZE) {
+        hasher.addData(data.constData() + offset, std::min(CHUNK_SIZE, data.size() - offset));
+    }
+    QCOMPARE(hasher.result().toHex(), hash(data));
+
+    hasher.addData(QByteArray("abc"));
+    QCOMPARE(hasher.result().toHex(), QByteArray("ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad"));
+}
@@ -0,0 +1,28 @@
+//
+//  AssetHasherTests.h
+//  tests/networking/src
+//
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AssetHasherTests_h
+#define hifi_AssetHasherTests_h
+
+#pragma once
+
+#include <QtTest/QtTest>
+
+class AssetHasherTests : public QObject {
+    Q_OBJECT
+private slots:
+    // Test against the SHA-256 vectors of FIPS 180-2
+    void knownVectorsTest();
+
+    // Test that data added in chunks hashes the same as in one piece, and that result() starts a new hash
+    void chunkedTest();
+};
+
+#endif // hifi_AssetHasherTests_h
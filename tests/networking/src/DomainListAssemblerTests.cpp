@@ -0,0 +1,159 @@
+//
+//  DomainListAssemblerTests.cpp
+//  tests/networking/src
+//
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "DomainListAssemblerTests.h"
+
+#include <algorithm>
+#include <vector>
+
+#include <DomainListAssembler.h>
+
+QTEST_MAIN(DomainListAssemblerTests)
+
+namespace {
+
+struct Entry {
+    QUuid uuid;
+    bool isRemoved;
+};
+
+// the domain list fields and entries of a domain list packet, as the domain-server writes them
+QByteArray createPacket(quint32 version, quint32 baseVersion, quint32 numEntries, const std::vector<Entry>& entries) {
+    QByteArray packet;
+    QDataStream packetStream(&packet, QIODevice::WriteOnly);
+    packetStream << version << baseVersion << numEntries;
+    for (const auto& entry : entries) {
+        packetStream << entry.isRemoved << entry.uuid;
+    }
+    return packet;
+}
+
+// splits a list into packets of at most entriesPerPacket entries
+std::vector<QByteArray> createList(quint32 version, quint32 baseVersion, const std::vector<Entry>& entries,
+                                   int entriesPerPacket) {
+    std::vector<QByteArray> packets;
+    for (size_t first = 0; first < entries.size(); first += entriesPerPacket) {
+        auto last = std::min(entries.size(), first + entriesPerPacket);
+        packets.push_back(createPacket(version, baseVersion, (quint32)entries.size(),
+                                       std::vector<Entry>(entries.begin() + first, entries.begin() + last)));
+    }
+    return packets;
+}
+
+std::vector<Entry> createEntries(int numListed, int numRemoved) {
+    std::vector<Entry> entries;
+    for (int i = 0; i < numRemoved; ++i) {
+        entries.push_back({ QUuid::createUuid(), true });
+    }
+    for (int i = 0; i < numListed; ++i) {
+        entries.push_back({ QUuid::createUuid(), false });
+    }
+    return entries;
+}
+
+// reads a packet the way NodeList::processDomainList does
+void receivePacket(DomainListAssembler& assembler, const QByteArray& packet) {
+    QDataStream packetStream(packet);
+    quint32 version, baseVersion, numEntries;
+    packetStream >> version >> baseVersion >> numEntries;
+    assembler.beginPacket(version, baseVersion, numEntries);
+    while (!packetStream.atEnd()) {
+        bool isRemoved;
+        QUuid uuid;
+        packetStream >> isRemoved >> uuid;
+        assembler.addEntry(uuid, isRemoved);
+    }
+    assembler.endPacket();
+}
+
+}
+
+void DomainListAssemblerTests::fullListTest() {
+    DomainListAssembler assembler;
+    auto packets = createList(7, 0, createEntries(10, 0), 4);
+    QCOMPARE(packets.size(), (size_t)3);
+
+    receivePacket(assembler, packets[2]);
+    receivePacket(assembler, packets[0]);
+    QCOMPARE(assembler.getAckedVersion(), (quint32)0);
+    receivePacket(assembler, packets[1]);
+    QCOMPARE(assembler.getAckedVersion(), (quint32)7);
+
+    // an empty list is one packet without entries
+    DomainListAssembler emptyAssembler;
+    receivePacket(emptyAssembler, createPacket(3, 0, 0, {}));
+    QCOMPARE(emptyAssembler.getAckedVersion(), (quint32)3);
+}
+
+void DomainListAssemblerTests::lostPacketTest() {
+    DomainListAssembler assembler;
+    for (const auto& packet : createList(5, 0, createEntries(4, 0), 4)) {
+        receivePacket(assembler, packet);
+    }
+    QCOMPARE(assembler.getAckedVersion(), (quint32)5);
+
+    // the domain-server sends the same changes in reply to each check-in until the node acks them
+    auto entries = createEntries(8, 4);
+    auto packets = createList(9, 5, entries, 4);
+    QCOMPARE(packets.size(), (size_t)3);
+
+    // the second packet is lost, and the other two arrive for three check-ins
+    const int NUM_CHECK_INS = 3;
+    for (int i = 0; i < NUM_CHECK_INS; ++i) {
+        receivePacket(assembler, packets[0]);
+        receivePacket(assembler, packets[2]);
+    }
+    QCOMPARE(assembler.getAckedVersion(), (quint32)5);
+
+    receivePacket(assembler, packets[1]);
+    QCOMPARE(assembler.getAckedVersion(), (quint32)9);
+
+    // packets of the acked list that arrive late change nothing
+    receivePacket(assembler, packets[0]);
+    QCOMPARE(assembler.getAckedVersion(), (quint32)9);
+}
+
+void DomainListAssemblerTests::baseVersionTest() {
+    DomainListAssembler assembler;
+    for (const auto& packet : createList(5, 0, createEntries(2, 0), 4)) {
+        receivePacket(assembler, packet);
+    }
+    QCOMPARE(assembler.getAckedVersion(), (quint32)5);
+
+    // the changes since a version newer than ours are missing the ones in between
+    receivePacket(assembler, createPacket(9, 6, 1, { { QUuid::createUuid(), false } }));
+    QCOMPARE(assembler.getAckedVersion(), (quint32)5);
+
+    // a node killed locally needs a full list, which a delta list doesn't stand in for
+    assembler.resetAckedVersion();
+    receivePacket(assembler, createPacket(10, 5, 1, { { QUuid::createUuid(), false } }));
+    QCOMPARE(assembler.getAckedVersion(), (quint32)0);
+
+    receivePacket(assembler, createPacket(10, 0, 1, { { QUuid::createUuid(), false } }));
+    QCOMPARE(assembler.getAckedVersion(), (quint32)10);
+
+    assembler.reset();
+    QCOMPARE(assembler.getAckedVersion(), (quint32)0);
+}
+
+void DomainListAssemblerTests::removedAndListedTest() {
+    DomainListAssembler assembler;
+    QUuid nodeUUID = QUuid::createUuid();
+    auto packets = createList(4, 0, { { nodeUUID, true }, { QUuid::createUuid(), false }, { nodeUUID, false } }, 1);
+
+    receivePacket(assembler, packets[0]);
+    receivePacket(assembler, packets[1]);
+    QCOMPARE(assembler.getAckedVersion(), (quint32)0);
+    receivePacket(assembler, packets[0]);
+    QCOMPARE(assembler.getAckedVersion(), (quint32)0);
+
+    receivePacket(assembler, packets[2]);
+    QCOMPARE(assembler.getAckedVersion(), (quint32)4);
+}
@@ -0,0 +1,34 @@
+//
+//  DomainListAssemblerTests.h
+//  tests/networking/src
+//
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_DomainListAssemblerTests_h
+#define hifi_DomainListAssemblerTests_h
+
+#pragma once
+
+#include <QtTest/QtTest>
+
+class DomainListAssemblerTests : public QObject {
+    Q_OBJECT
+private slots:
+    // Test that a full list split over several packets is acked once all of them arrive, in any order
+    void fullListTest();
+
+    // Test that a delta list missing a packet is not acked, however often the other packets are resent
+    void lostPacketTest();
+
+    // Test that a delta list is only acked on top of its base version
+    void baseVersionTest();
+
+    // Test that a node removed and listed again in the same list counts as two entries
+    void removedAndListedTest();
+};
+
+#endif // hifi_DomainListAssemblerTests_h
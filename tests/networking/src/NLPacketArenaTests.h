@@ -0,0 +1,31 @@
+//
+//  NLPacketArenaTests.h
+//  tests/networking/src
+//
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_NLPacketArenaTests_h
+#define hifi_NLPacketArenaTests_h
+
+#pragma once
+
+#include <QtTest/QtTest>
+
+class NLPacketArenaTests : public QObject {
+    Q_OBJECT
+private slots:
+    // Test that a recycled packet is handed out again, empty
+    void recycleTest();
+
+    // Test that packets are only handed out again for their own type
+    void packetTypeTest();
+
+    // Test that the arena holds no more than its limit
+    void poolLimitTest();
+};
+
+#endif // hifi_NLPacketArenaTests_h
@@ -0,0 +1,117 @@
+//
+//  ReceivedMessageTests.cpp
+//  tests/networking/src
+//
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ReceivedMessageTests.h"
+
+#include <NLPacket.h>
+#include <ReceivedMessage.h>
+
+QTEST_MAIN(ReceivedMessageTests)
+
+static const int NUM_TEST_PACKETS = 4;
+static const int TEST_PAYLOAD_SIZE = 1000;
+
+static std::unique_ptr<NLPacket> createMessagePacket(int partNumber) {
+    auto packet = NLPacket::create(PacketType::Unknown, -1, true, true);
+
+    QByteArray payload(TEST_PAYLOAD_SIZE, Qt::Uninitialized);
+    for (int i = 0; i < TEST_PAYLOAD_SIZE; i++) {
+        payload[i] = (char)(partNumber * TEST_PAYLOAD_SIZE + i);
+    }
+    packet->write(payload);
+
+    auto position = partNumber == 0 ? udt::Packet::PacketPosition::FIRST :
+        (partNumber == NUM_TEST_PACKETS - 1 ? udt::Packet::PacketPosition::LAST : udt::Packet::PacketPosition::MIDDLE);
+    packet->writeMessageNumber(1, position, partNumber);
+
+    // hand back a copy that looks like it came in off the wire, ready to be read from the start of its payload
+    auto size = packet->getDataSize();
+    auto data = std::unique_ptr<char[]>(new char[size]);
+    memcpy(data.get(), packet->getData(), size);
+    return NLPacket::fromReceivedPacket(std::move(data), size, SockAddr());
+}
+
+static QByteArray expectedMessage() {
+    QByteArray expected;
+    for (int i = 0; i < NUM_TEST_PACKETS; i++) {
+        auto packet = createMessagePacket(i);
+        expected.append(packet->getPayload(), packet->getPayloadSize());
+    }
+    return expected;
+}
+
+static QSharedPointer<ReceivedMessage> createMessage() {
+    auto firstPacket = createMessagePacket(0);
+    auto message = QSharedPointer<ReceivedMessage>::create(*firstPacket);
+    for (int i = 1; i < NUM_TEST_PACKETS; i++) {
+        message->appendPacket(createMessagePacket(i));
+    }
+    return message;
+}
+
+void ReceivedMessageTests::segmentTest() {
+    auto message = createMessage();
+
+    QVERIFY(message->isComplete());
+    QCOMPARE(message->getNumPackets(), (qint64)NUM_TEST_PACKETS);
+    QCOMPARE(message->getNumSegments(), NUM_TEST_PACKETS);
+    QCOMPARE(message->getSize(), (qint64)(NUM_TEST_PACKETS * TEST_PAYLOAD_SIZE));
+    QCOMPARE(message->getBytesLeftToRead(), message->getSize());
+}
+
+void ReceivedMessageTests::readAcrossSegmentsTest() {
+    auto message = createMessage();
+    auto expected = expectedMessage();
+
+    // start a few bytes before the first boundary so that every read below straddles two segments
+    const int READ_SIZE = TEST_PAYLOAD_SIZE / 2 + 7;
+    message->seek(TEST_PAYLOAD_SIZE - 3);
+    qint64 position = message->getPosition();
+    while (message->getBytesLeftToRead() > 0) {
+        auto bytes = message->read(READ_SIZE);
+        QCOMPARE(bytes, expected.mid(position, READ_SIZE));
+        position += bytes.size();
+    }
+    QCOMPARE(position, message->getSize());
+
+    message->seek(TEST_PAYLOAD_SIZE - 2);
+    uint32_t value;
+    QCOMPARE(message->readPrimitive(&value), (qint64)sizeof(value));
+    QCOMPARE(memcmp(&value, expected.constData() + TEST_PAYLOAD_SIZE - 2, sizeof(value)), 0);
+
+    message->seek(2 * TEST_PAYLOAD_SIZE - 10);
+    QCOMPARE(message->readWithoutCopy(20), expected.mid(2 * TEST_PAYLOAD_SIZE - 10, 20));
+}
+
+void ReceivedMessageTests::chunkedReadTest() {
+    auto message = createMessage();
+    auto expected = expectedMessage();
+
+    QByteArray assembled;
+    int numChunks = 0;
+    while (message->getBytesLeftToRead() > 0) {
+        auto chunk = message->readChunkWithoutCopy();
+        QVERIFY(!chunk.isEmpty());
+        assembled.append(chunk);
+        ++numChunks;
+    }
+    QCOMPARE(numChunks, NUM_TEST_PACKETS);
+    QCOMPARE(assembled, expected);
+    QVERIFY(message->readChunkWithoutCopy().isEmpty());
+}
+
+void ReceivedMessageTests::flattenTest() {
+    auto message = createMessage();
+    auto expected = expectedMessage();
+
+    QCOMPARE(message->getMessage(), expected);
+    QCOMPARE(memcmp(message->getRawMessage(), expected.constData(), expected.size()), 0);
+    QCOMPARE(message->readAll(), expected);
+}
@@ -0,0 +1,34 @@
+//
+//  ReceivedMessageTests.h
+//  tests/networking/src
+//
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_ReceivedMessageTests_h
+#define hifi_ReceivedMessageTests_h
+
+#pragma once
+
+#include <QtTest/QtTest>
+
+class ReceivedMessageTests : public QObject {
+    Q_OBJECT
+private slots:
+    // Test that a multi-packet message is held as one segment per packet
+    void segmentTest();
+
+    // Test reads that cross segment boundaries
+    void readAcrossSegmentsTest();
+
+    // Test draining a message with readChunkWithoutCopy
+    void chunkedReadTest();
+
+    // Test contiguous access to a multi-packet message
+    void flattenTest();
+};
+
+#endif // hifi_ReceivedMessageTests_h
@@ -0,0 +1,95 @@
+//
+//  ResourceEvictionTests.cpp
+//  tests/networking/src
+//
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ResourceEvictionTests.h"
+
+#include <QtCore/QBuffer>
+
+#include <ResourceCacheTrace.h>
+
+QTEST_MAIN(ResourceEvictionTests)
+
+static const qint64 BYTES_PER_MEGABYTE = 1024 * 1024;
+
+void ResourceEvictionTests::lruOrderTest() {
+    auto policy = ResourceEvictionPolicy::create(ResourceEvictionPolicy::Type::LRU);
+    for (int id = 0; id < 3; id++) {
+        policy->insert(id, id, BYTES_PER_MEGABYTE, 1.0f);
+    }
+    policy->remove(0);
+    policy->insert(0, 0, BYTES_PER_MEGABYTE, 1.0f);
+
+    QCOMPARE(policy->selectVictim(), 1);
+    policy->evict(1);
+    QCOMPARE(policy->selectVictim(), 2);
+    policy->evict(2);
+    QCOMPARE(policy->selectVictim(), 0);
+    policy->evict(0);
+    QVERIFY(policy->isEmpty());
+    QCOMPARE(policy->getEvictionCount(), (uint64_t)3);
+}
+
+void ResourceEvictionTests::largeResourceScanTest() {
+    // a scene of small textures that are released and requested again, and a large model that is loaded once per round
+    const int NUM_ROUNDS = 20;
+    const int NUM_TEXTURES = 100;
+    const qint64 TEXTURE_SIZE = BYTES_PER_MEGABYTE;
+    const qint64 MODEL_SIZE = 200 * BYTES_PER_MEGABYTE;
+    const qint64 BUDGET = 256 * BYTES_PER_MEGABYTE;
+
+    std::vector<ResourceCacheTrace::Event> events;
+    for (int round = 0; round < NUM_ROUNDS; round++) {
+        for (int texture = 0; texture < NUM_TEXTURES; texture++) {
+            events.push_back({ ResourceCacheTrace::Event::Get, "TextureCache", (uint64_t)texture, 0, false });
+            events.push_back({ ResourceCacheTrace::Event::Release, "TextureCache", (uint64_t)texture, TEXTURE_SIZE, false });
+        }
+        uint64_t modelKey = NUM_TEXTURES + round;
+        events.push_back({ ResourceCacheTrace::Event::Get, "TextureCache", modelKey, 0, false });
+        events.push_back({ ResourceCacheTrace::Event::Release, "TextureCache", modelKey, MODEL_SIZE, false });
+    }
+
+    auto lru = ResourceCacheTrace::simulate(events, ResourceEvictionPolicy::Type::LRU, BUDGET);
+    auto gdsf = ResourceCacheTrace::simulate(events, ResourceEvictionPolicy::Type::GDSF, BUDGET);
+    auto tinyLFU = ResourceCacheTrace::simulate(events, ResourceEvictionPolicy::Type::TinyLFU, BUDGET);
+
+    QCOMPARE(lru.requests, (uint64_t)(NUM_ROUNDS * (NUM_TEXTURES + 1)));
+    QCOMPARE(lru.compulsoryMisses, (uint64_t)(NUM_TEXTURES + NUM_ROUNDS));
+    QCOMPARE(gdsf.compulsoryMisses, lru.compulsoryMisses);
+
+    QVERIFY(gdsf.getHitRatio() > lru.getHitRatio());
+    QVERIFY(gdsf.bytesRefetched < lru.bytesRefetched);
+    QVERIFY(tinyLFU.getHitRatio() > lru.getHitRatio());
+    QVERIFY(tinyLFU.bytesRefetched < lru.bytesRefetched);
+}
+
+void ResourceEvictionTests::readTraceTest() {
+    QByteArray trace =
+        "1000 TextureCache get 1f 0 https://example.com/a.ktx\n"
+        "1001 TextureCache release 1f 4096 https://example.com/a.ktx\n"
+        "garbage\n"
+        "1002 ModelCache get 2a 0 file:///models/b.fst\n"
+        "1003 ModelCache unknown 2a 0 file:///models/b.fst\n";
+    QBuffer buffer(&trace);
+
+    std::vector<ResourceCacheTrace::Event> events;
+    QVERIFY(ResourceCacheTrace::read(buffer, events));
+    QCOMPARE((int)events.size(), 3);
+
+    QCOMPARE(events[0].type, ResourceCacheTrace::Event::Get);
+    QCOMPARE(events[0].cache, QString("TextureCache"));
+    QCOMPARE(events[0].key, (uint64_t)0x1f);
+    QVERIFY(!events[0].isLocal);
+
+    QCOMPARE(events[1].type, ResourceCacheTrace::Event::Release);
+    QCOMPARE(events[1].bytes, (qint64)4096);
+
+    QCOMPARE(events[2].cache, QString("ModelCache"));
+    QVERIFY(events[2].isLocal);
+}
@@ -0,0 +1,31 @@
+//
+//  ResourceEvictionTests.h
+//  tests/networking/src
+//
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_ResourceEvictionTests_h
+#define hifi_ResourceEvictionTests_h
+
+#pragma once
+
+#include <QtTest/QtTest>
+
+class ResourceEvictionTests : public QObject {
+    Q_OBJECT
+private slots:
+    // Test that the LRU policy evicts the least recently released entry
+    void lruOrderTest();
+
+    // Test that a large resource doesn't flush small, frequently requested ones under GDSF and TinyLFU
+    void largeResourceScanTest();
+
+    // Test parsing a recorded trace
+    void readTraceTest();
+};
+
+#endif // hifi_ResourceEvictionTests_h
@@ -9,6 +9,8 @@
 
 #include "ResourceTests.h"
 
+#include <cfloat>
+
 #include <QNetworkDiskCache>
 
 #include <ExternalResource.h>
@@ -94,3 +96,101 @@ void ResourceTests::downloadAgain() {
 
     QVERIFY(resource->isLoaded());
 }
+
+void ResourceTests::pendingRequestOrderTest() {
+    auto sharedItems = DependencyManager::get<ResourceCacheSharedItems>();
+    auto requestLimit = sharedItems->getRequestLimit();
+    sharedItems->setRequestLimit(0);
+
+    QObject owner;
+    QList<QSharedPointer<Resource>> resources;
+    const float priorities[] = { 2.0f, 5.0f, 1.0f, 5.0f, 3.0f };
+    for (float priority : priorities) {
+        auto pending = QSharedPointer<Resource>::create(QUrl("http://localhost/" + QString::number(resources.size())));
+        pending->setSelf(pending);
+        pending->setLoadPriority(&owner, priority);
+        resources.append(pending);
+        QVERIFY(!sharedItems->appendRequest(pending));
+    }
+    auto fileResource = QSharedPointer<Resource>::create(QUrl("file:///pending.fst"));
+    fileResource->setSelf(fileResource);
+    fileResource->setLoadPriority(&owner, 0.0f);
+    QVERIFY(!sharedItems->appendRequest(fileResource));
+    QCOMPARE(sharedItems->getPendingRequestsCount(), (uint32_t)6);
+
+    // freed resources are skipped
+    resources[4].reset();
+
+    // file requests come first, then by priority, with later requests winning ties
+    QCOMPARE(sharedItems->getHighestPendingRequest(), fileResource);
+    QCOMPARE(sharedItems->getHighestPendingRequest(), resources[3]);
+    QCOMPARE(sharedItems->getHighestPendingRequest(), resources[1]);
+    QCOMPARE(sharedItems->getHighestPendingRequest(), resources[0]);
+    QCOMPARE(sharedItems->getHighestPendingRequest(), resources[2]);
+    QVERIFY(sharedItems->getHighestPendingRequest().isNull());
+    QCOMPARE(sharedItems->getPendingRequestsCount(), (uint32_t)0);
+
+    sharedItems->setRequestLimit(requestLimit);
+}
+
+void ResourceTests::pendingRequestOwnerDestroyedTest() {
+    auto sharedItems = DependencyManager::get<ResourceCacheSharedItems>();
+    auto requestLimit = sharedItems->getRequestLimit();
+    sharedItems->setRequestLimit(0);
+
+    QObject owner;
+    auto closeOwner = new QObject();
+
+    // wanted urgently by an owner that goes away while the request waits
+    auto abandoned = QSharedPointer<Resource>::create(QUrl("http://localhost/abandoned"));
+    abandoned->setSelf(abandoned);
+    abandoned->setLoadPriority(&owner, 1.0f);
+    abandoned->setLoadPriority(closeOwner, 10.0f);
+    QVERIFY(!sharedItems->appendRequest(abandoned));
+
+    auto wanted = QSharedPointer<Resource>::create(QUrl("http://localhost/wanted"));
+    wanted->setSelf(wanted);
+    wanted->setLoadPriority(&owner, 5.0f);
+    QVERIFY(!sharedItems->appendRequest(wanted));
+
+    delete closeOwner;
+
+    QCOMPARE(sharedItems->getHighestPendingRequest(), wanted);
+    QCOMPARE(sharedItems->getHighestPendingRequest(), abandoned);
+    QCOMPARE(abandoned->getLoadPriority(), 1.0f);
+    QVERIFY(sharedItems->getHighestPendingRequest().isNull());
+
+    sharedItems->setRequestLimit(requestLimit);
+}
+
+void ResourceTests::pendingRequestBenchmark() {
+    auto sharedItems = DependencyManager::get<ResourceCacheSharedItems>();
+    auto requestLimit = sharedItems->getRequestLimit();
+    sharedItems->setRequestLimit(0);
+
+    const int NUM_PENDING_REQUESTS = 10000;
+    QObject owner;
+    QList<QSharedPointer<Resource>> resources;
+    for (int i = 0; i < NUM_PENDING_REQUESTS; i++) {
+        auto pending = QSharedPointer<Resource>::create(QUrl("http://localhost/" + QString::number(i)));
+        pending->setSelf(pending);
+        pending->setLoadPriority(&owner, (float)((i * 7919) % NUM_PENDING_REQUESTS));
+        resources.append(pending);
+    }
+
+    bool ordered = true;
+    QBENCHMARK {
+        for (const auto& pending : resources) {
+            sharedItems->appendRequest(pending);
+        }
+        float lastPriority = FLT_MAX;
+        while (auto next = sharedItems->getHighestPendingRequest()) {
+            float priority = next->getLoadPriority();
+            ordered = ordered && priority <= lastPriority;
+            lastPriority = priority;
+        }
+    }
+    QVERIFY(ordered);
+
+    sharedItems->setRequestLimit(requestLimit);
+}
@@ -18,6 +18,9 @@ private slots:
     void initTestCase();
     void downloadFirst();
     void downloadAgain();
+    void pendingRequestOrderTest();
+    void pendingRequestOwnerDestroyedTest();
+    void pendingRequestBenchmark();
     void cleanupTestCase();
 };
 
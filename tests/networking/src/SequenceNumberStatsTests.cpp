@@ -323,3 +323,34 @@ void SequenceNumberStatsTests::resyncTest() {
     }
     QCOMPARE_WITH_CAST(stats.getUnreasonable(), 0);
 }
+
+void SequenceNumberStatsTests::isOnTimeTest() {
+
+    SequenceNumberStats stats(0);
+
+    // in order, with rollover, gaps, duplicates, late and unreasonable sequence numbers, and a change of sender
+    quint16 sequence = 65530;
+    NetworkLocalID senderID = 1;
+    int numOnTime = 0;
+    for (int i = 0; i < 2000; i++) {
+        if (i % 97 == 0) {
+            sequence += (quint16)3;
+        } else if (i % 89 == 0) {
+            sequence -= (quint16)2;
+        } else if (i % 503 == 0) {
+            sequence += (quint16)20000;
+        } else if (i % 211 != 0) {
+            sequence += (quint16)1;
+        }
+        if (i == 1000) {
+            senderID = 2;
+        }
+
+        bool isOnTime = stats.isOnTime(sequence, senderID);
+        auto arrivalInfo = stats.sequenceNumberReceived(sequence, senderID);
+        QCOMPARE(isOnTime, arrivalInfo._status == SequenceNumberStats::OnTime);
+        numOnTime += isOnTime ? 1 : 0;
+    }
+
+    QVERIFY(numOnTime > 0 && numOnTime < 2000);
+}
@@ -25,6 +25,7 @@ private slots:
     void duplicateTest();
     void pruneTest();
     void resyncTest();
+    void isOnTimeTest();
 };
 
 #endif // hifi_SequenceNumberStatsTests_h
@@ -0,0 +1,118 @@
+//
+//  ContactTableTests.cpp
+//  tests/physics/src
+//
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ContactTableTests.h"
+
+#include <ContactTable.h>
+
+QTEST_MAIN(ContactTableTests)
+
+namespace {
+
+// fake object pointers, aligned like real motion states
+void* objectPointer(int i) {
+    return reinterpret_cast<void*>((uintptr_t)(i + 1) * 16);
+}
+
+ContactKey keyFor(int i) {
+    return ContactKey(objectPointer(i), objectPointer(i + 1));
+}
+
+}
+
+void ContactTableTests::testFindOrAdd() {
+    ContactTable table;
+    QVERIFY(table.isEmpty());
+
+    table[keyFor(0)].distance = 1.0f;
+    table[keyFor(1)].distance = 2.0f;
+    QCOMPARE(table.size(), 2);
+
+    // the same pair finds the same contact, and the reversed pair is a different one
+    QCOMPARE(table[keyFor(0)].distance, 1.0f);
+    QCOMPARE(table[keyFor(1)].distance, 2.0f);
+    QCOMPARE(table.size(), 2);
+    table[ContactKey(objectPointer(1), objectPointer(0))];
+    QCOMPARE(table.size(), 3);
+}
+
+void ContactTableTests::testRemoveIf() {
+    ContactTable table;
+    const int NUM_CONTACTS = 100;
+    for (int i = 0; i < NUM_CONTACTS; ++i) {
+        table[keyFor(i)].distance = (float)i;
+    }
+
+    // remove every contact that touches an odd object
+    int numVisited = 0;
+    int numMismatched = 0;
+    table.removeIf([&](const ContactKey& key, ContactInfo& contact) {
+        ++numVisited;
+        if (!(key == keyFor((int)contact.distance))) {
+            ++numMismatched;
+        }
+        return (int)contact.distance % 2 == 1;
+    });
+    QCOMPARE(numVisited, NUM_CONTACTS);
+    QCOMPARE(numMismatched, 0);
+    QCOMPARE(table.size(), NUM_CONTACTS / 2);
+
+    // the remaining contacts are still found, and removed ones come back as new contacts
+    for (int i = 0; i < NUM_CONTACTS; i += 2) {
+        QCOMPARE(table[keyFor(i)].distance, (float)i);
+    }
+    QCOMPARE(table.size(), NUM_CONTACTS / 2);
+    QCOMPARE(table[keyFor(1)].distance, 0.0f);
+    QCOMPARE(table.size(), NUM_CONTACTS / 2 + 1);
+
+    table.removeIf([](const ContactKey& key, ContactInfo& contact) { return true; });
+    QVERIFY(table.isEmpty());
+}
+
+void ContactTableTests::testGrowth() {
+    ContactTable table;
+    int initialCapacity = table.getCapacity();
+    const int NUM_CONTACTS = 10 * initialCapacity;
+    for (int i = 0; i < NUM_CONTACTS; ++i) {
+        table[keyFor(i)].distance = (float)i;
+    }
+    QCOMPARE(table.size(), NUM_CONTACTS);
+    QVERIFY(table.getCapacity() >= NUM_CONTACTS);
+
+    for (int i = 0; i < NUM_CONTACTS; ++i) {
+        QCOMPARE(table[keyFor(i)].distance, (float)i);
+    }
+    QCOMPARE(table.size(), NUM_CONTACTS);
+
+    table.clear();
+    QVERIFY(table.isEmpty());
+    QCOMPARE(table[keyFor(0)].distance, 0.0f);
+}
+
+void ContactTableTests::testChurnDoesNotGrow() {
+    // contacts that come and go at a steady count reuse the table rather than growing it
+    ContactTable table;
+    const int NUM_LIVE_CONTACTS = table.getCapacity() / 4;
+    const int NUM_ROUNDS = 100;
+    int next = 0;
+    for (int i = 0; i < NUM_LIVE_CONTACTS; ++i) {
+        table[keyFor(next++)];
+    }
+    int capacity = table.getCapacity();
+    for (int round = 0; round < NUM_ROUNDS; ++round) {
+        int oldest = next - NUM_LIVE_CONTACTS;
+        table.removeIf([oldest](const ContactKey& key, ContactInfo& contact) {
+            return key == keyFor(oldest);
+        });
+        table[keyFor(next++)];
+        QCOMPARE(table.size(), NUM_LIVE_CONTACTS);
+    }
+    QCOMPARE(table.getCapacity(), capacity);
+}
@@ -0,0 +1,270 @@
+//
+//  PhysicsEngineTests.cpp
+//  tests/physics/src
+//
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "PhysicsEngineTests.h"
+
+#include <memory>
+#include <mutex>
+#include <set>
+
+#include <PhysicsEngine.h>
+#include <PhysicsHelpers.h>
+
+QTEST_MAIN(PhysicsEngineTests)
+
+namespace {
+
+const int BODIES_PER_STACK = 8;
+const float BOX_HALF_EXTENT = 0.25f;
+
+// Stacks of dynamic boxes on a static floor, stepped at the engine's fixed substep without wall clock time.
+// Multithreaded scenes all step on the process's one PhysicsTaskScheduler, capped at their own number of threads.
+class StackScene {
+public:
+    StackScene(int numThreads, int numBodies) :
+        _engine(glm::vec3(0.0f)),
+        _boxShape(btVector3(BOX_HALF_EXTENT, BOX_HALF_EXTENT, BOX_HALF_EXTENT)),
+        _floorShape(btVector3(100.0f, 1.0f, 100.0f)) {
+        _engine.setNumThreads(numThreads);
+        _engine.init();
+        _world = static_cast<ThreadSafeDynamicsWorld*>(_engine.getDynamicsWorld());
+        _world->setGravity(btVector3(0.0f, -9.8f, 0.0f));
+
+        btTransform floorTransform;
+        floorTransform.setIdentity();
+        floorTransform.setOrigin(btVector3(0.0f, -1.0f, 0.0f));
+        addBody(0.0f, &_floorShape, floorTransform);
+
+        // stacks are spread out on a square grid, far enough apart to be separate islands
+        const float SPACING = 4.0f * BOX_HALF_EXTENT;
+        int numStacks = (numBodies + BODIES_PER_STACK - 1) / BODIES_PER_STACK;
+        int stacksPerRow = (int)ceilf(sqrtf((float)numStacks));
+        const float MASS = 1.0f;
+        for (int i = 0; i < numBodies; ++i) {
+            int stack = i / BODIES_PER_STACK;
+            int level = i % BODIES_PER_STACK;
+            btTransform transform;
+            transform.setIdentity();
+            transform.setOrigin(btVector3((float)(stack % stacksPerRow) * SPACING,
+                                          (2.0f * (float)level + 1.0f) * BOX_HALF_EXTENT,
+                                          (float)(stack / stacksPerRow) * SPACING));
+            addBody(MASS, &_boxShape, transform);
+        }
+    }
+
+    ~StackScene() {
+        for (auto body : _bodies) {
+            _world->removeRigidBody(body);
+            delete body;
+        }
+    }
+
+    void step() {
+        _world->stepSimulationWithSubstepCallback(PHYSICS_ENGINE_FIXED_SUBSTEP, 1, PHYSICS_ENGINE_FIXED_SUBSTEP,
+                                                  [this]() { _engine.updateContactMap(); });
+    }
+
+    void step(int numSteps) {
+        for (int i = 0; i < numSteps; ++i) {
+            step();
+        }
+    }
+
+    const std::vector<btRigidBody*>& getBodies() const { return _bodies; }
+
+    // every box is still resting on the one below it
+    bool areStacksStanding(QString& error) const {
+        const float TOLERANCE = 0.1f * BOX_HALF_EXTENT;
+        for (int i = 1; i < (int)_bodies.size(); ++i) {
+            int level = (i - 1) % BODIES_PER_STACK;
+            float expectedHeight = (2.0f * (float)level + 1.0f) * BOX_HALF_EXTENT;
+            float height = _bodies[i]->getWorldTransform().getOrigin().getY();
+            if (fabsf(height - expectedHeight) >= TOLERANCE) {
+                error = QString("box %1 at %2, expected %3").arg(i).arg(height).arg(expectedHeight);
+                return false;
+            }
+        }
+        return true;
+    }
+
+private:
+    void addBody(float mass, btCollisionShape* shape, const btTransform& transform) {
+        btVector3 inertia(0.0f, 0.0f, 0.0f);
+        if (mass > 0.0f) {
+            shape->calculateLocalInertia(mass, inertia);
+        }
+        btRigidBody* body = new btRigidBody(mass, nullptr, shape, inertia);
+        body->setWorldTransform(transform);
+        _world->addRigidBody(body);
+        _bodies.push_back(body);
+    }
+
+    PhysicsEngine _engine;
+    ThreadSafeDynamicsWorld* _world { nullptr };
+    btBoxShape _boxShape;
+    btBoxShape _floorShape;
+    std::vector<btRigidBody*> _bodies;
+};
+
+const int NUM_SETTLE_STEPS = 2 * (int)NUM_SUBSTEPS_PER_SECOND;
+
+// Records the Bullet thread index of every thread that runs part of a loop.
+class ThreadIndexBody : public btIParallelForBody {
+public:
+    void forLoop(int iBegin, int iEnd) const override {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _threadIndices.insert(btGetCurrentThreadIndex());
+    }
+
+    const std::set<unsigned int>& getThreadIndices() const { return _threadIndices; }
+
+private:
+    mutable std::mutex _mutex;
+    mutable std::set<unsigned int> _threadIndices;
+};
+
+}
+
+void PhysicsEngineTests::testStacksSettle_data() {
+    QTest::addColumn<int>("numThreads");
+
+    QTest::newRow("1 thread") << 1;
+    QTest::newRow("4 threads") << 4;
+}
+
+void PhysicsEngineTests::testStacksSettle() {
+    QFETCH(int, numThreads);
+
+    const int NUM_BODIES = 64;
+    StackScene scene(numThreads, NUM_BODIES);
+    scene.step(NUM_SETTLE_STEPS);
+
+    QString error;
+    QVERIFY2(scene.areStacksStanding(error), qPrintable(error));
+}
+
+void PhysicsEngineTests::testDeterministic_data() {
+    QTest::addColumn<int>("numThreads");
+
+    QTest::newRow("1 thread") << 1;
+    QTest::newRow("4 threads") << 4;
+}
+
+void PhysicsEngineTests::testDeterministic() {
+    QFETCH(int, numThreads);
+
+    // the same scene with the same number of threads comes out the same, however the steps were scheduled
+    const int NUM_BODIES = 256;
+    StackScene first(numThreads, NUM_BODIES);
+    StackScene second(numThreads, NUM_BODIES);
+    first.step(NUM_SETTLE_STEPS);
+    second.step(NUM_SETTLE_STEPS);
+
+    for (int i = 0; i < NUM_BODIES + 1; ++i) {
+        const btTransform& firstTransform = first.getBodies()[i]->getWorldTransform();
+        const btTransform& secondTransform = second.getBodies()[i]->getWorldTransform();
+        QVERIFY2(firstTransform.getOrigin() == secondTransform.getOrigin() &&
+                 firstTransform.getRotation() == secondTransform.getRotation(),
+                 qPrintable(QString("body %1 differs between runs").arg(i)));
+    }
+}
+
+void PhysicsEngineTests::testThreadCountsAgree() {
+    // islands are batched differently with more threads, so results only agree within a tolerance
+    const int NUM_BODIES = 256;
+    const int NUM_THREADS = 4;
+    StackScene sequential(1, NUM_BODIES);
+    StackScene multithreaded(NUM_THREADS, NUM_BODIES);
+    sequential.step(NUM_SETTLE_STEPS);
+    multithreaded.step(NUM_SETTLE_STEPS);
+
+    const float TOLERANCE = 0.05f * BOX_HALF_EXTENT;
+    for (int i = 0; i < NUM_BODIES + 1; ++i) {
+        btVector3 sequentialPosition = sequential.getBodies()[i]->getWorldTransform().getOrigin();
+        btVector3 multithreadedPosition = multithreaded.getBodies()[i]->getWorldTransform().getOrigin();
+        float distance = (sequentialPosition - multithreadedPosition).length();
+        QVERIFY2(distance < TOLERANCE, qPrintable(QString("body %1 is %2 from where one thread put it").arg(i).arg(distance)));
+    }
+}
+
+void PhysicsEngineTests::testSharedScheduler() {
+#if BT_THREADSAFE
+    // engines with different numbers of threads, stepped in turn, share the one scheduler and its pool
+    const int NUM_BODIES = 64;
+    int maxThreads = PhysicsTaskScheduler::getMaxThreadCount();
+    std::vector<std::unique_ptr<StackScene>> scenes;
+    for (int numThreads = 1; numThreads <= maxThreads; numThreads *= 2) {
+        scenes.emplace_back(new StackScene(numThreads, NUM_BODIES));
+        scenes.emplace_back(new StackScene(maxThreads, NUM_BODIES));
+    }
+    for (int i = 0; i < NUM_SETTLE_STEPS; ++i) {
+        for (auto& scene : scenes) {
+            scene->step();
+        }
+    }
+    for (auto& scene : scenes) {
+        QString error;
+        QVERIFY2(scene->areStacksStanding(error), qPrintable(error));
+    }
+
+    // however many engines were made, every thread that runs a loop has an index Bullet's per-thread arrays cover
+    PhysicsTaskScheduler* scheduler = PhysicsTaskScheduler::getInstance();
+    QCOMPARE(btGetTaskScheduler(), static_cast<btITaskScheduler*>(scheduler));
+    const int NUM_LOOPS = 100;
+    const int LOOP_SIZE = 1024;
+    ThreadIndexBody body;
+    for (int i = 0; i < NUM_LOOPS; ++i) {
+        btParallelFor(0, LOOP_SIZE, 1, body);
+    }
+    QVERIFY((int)body.getThreadIndices().size() <= maxThreads);
+    for (auto threadIndex : body.getThreadIndices()) {
+        QVERIFY2((int)threadIndex < scheduler->getNumThreads(), qPrintable(QString("thread index %1").arg(threadIndex)));
+    }
+#else
+    QSKIP("Bullet was built without multithreading");
+#endif
+}
+
+void PhysicsEngineTests::benchmarkStackedBodies_data() {
+    QTest::addColumn<int>("numThreads");
+    QTest::addColumn<int>("numBodies");
+
+    int maxThreads = PhysicsTaskScheduler::getMaxThreadCount();
+    for (int numBodies : { 256, 1024 }) {
+        for (int numThreads = 1; numThreads <= maxThreads; numThreads *= 2) {
+            QString name = QString("%1 bodies, %2 threads").arg(numBodies).arg(numThreads);
+            QTest::newRow(name.toUtf8().constData()) << numThreads << numBodies;
+        }
+    }
+}
+
+void PhysicsEngineTests::benchmarkStackedBodies() {
+    QFETCH(int, numThreads);
+    QFETCH(int, numBodies);
+
+    StackScene scene(numThreads, numBodies);
+
+    // get past the first contacts, and keep the bodies awake so every step does the same work
+    const int NUM_WARMUP_STEPS = 10;
+    for (int i = 0; i < NUM_WARMUP_STEPS; ++i) {
+        scene.step();
+    }
+    for (auto body : scene.getBodies()) {
+        body->setActivationState(DISABLE_DEACTIVATION);
+    }
+
+    QBENCHMARK {
+        scene.step();
+    }
+
+    // the steps being timed are still doing the work they should
+    QString error;
+    QVERIFY2(scene.areStacksStanding(error), qPrintable(error));
+}
@@ -0,0 +1,30 @@
+//
+//  PhysicsEngineTests.h
+//  tests/physics/src
+//
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_PhysicsEngineTests_h
+#define hifi_PhysicsEngineTests_h
+
+#include <QtTest/QtTest>
+
+class PhysicsEngineTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testStacksSettle_data();
+    void testStacksSettle();
+    void testDeterministic_data();
+    void testDeterministic();
+    void testThreadCountsAgree();
+    void testSharedScheduler();
+    void benchmarkStackedBodies_data();
+    void benchmarkStackedBodies();
+};
+
+#endif // hifi_PhysicsEngineTests_h
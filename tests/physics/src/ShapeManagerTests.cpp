@@ -13,6 +13,11 @@
 
 #include <iostream>
 
+#include <QtCore/QTemporaryDir>
+
+#include <BulletUtil.h>
+#include <NumericalConstants.h>
+#include <ShapeCache.h>
 #include <ShapeManager.h>
 #include <StreamUtils.h>
 #include <Extents.h>
@@ -244,3 +249,103 @@ void ShapeManagerTests::addCompoundShape() {
     QCOMPARE(shapeManager.getNumShapes(), 0);
     QCOMPARE(shapeManager.getNumReferences(info), 0);
 }
+
+void ShapeManagerTests::cacheStaticMeshShape() {
+    QTemporaryDir cacheDir;
+    ShapeCache::enable(cacheDir.path().toStdString(), 64 * 1024 * 1024);
+
+    // a grid with enough triangles to be worth caching
+    const int SIZE = 65;
+    ShapeInfo::PointList points;
+    for (int z = 0; z < SIZE; ++z) {
+        for (int x = 0; x < SIZE; ++x) {
+            points.push_back(glm::vec3((float)x, (float)((x * z) % 3), (float)z));
+        }
+    }
+    ShapeInfo info;
+    info.setParams(SHAPE_TYPE_STATIC_MESH, glm::vec3(0.5f * SIZE));
+    info.setPointCollection({ points });
+    ShapeInfo::TriangleIndices& triangleIndices = info.getTriangleIndices();
+    for (int z = 0; z + 1 < SIZE; ++z) {
+        for (int x = 0; x + 1 < SIZE; ++x) {
+            int32_t corner = z * SIZE + x;
+            for (int32_t index : { corner, corner + SIZE, corner + 1, corner + 1, corner + SIZE, corner + SIZE + 1 }) {
+                triangleIndices.push_back(index);
+            }
+        }
+    }
+
+    // the first shape is built and stored, the second one is read back
+    auto builtShape = const_cast<btCollisionShape*>(ShapeFactory::createShapeFromInfo(info));
+    QVERIFY(builtShape != nullptr);
+    QCOMPARE(ShapeCache::getNumMisses(), (size_t)1);
+    auto cachedShape = const_cast<btCollisionShape*>(ShapeFactory::createShapeFromInfo(info));
+    QVERIFY(cachedShape != nullptr);
+    QCOMPARE(ShapeCache::getNumHits(), (size_t)1);
+
+    QCOMPARE(cachedShape->getShapeType(), (int)TRIANGLE_MESH_SHAPE_PROXYTYPE);
+    btOptimizedBvh* builtBvh = static_cast<btBvhTriangleMeshShape*>(builtShape)->getOptimizedBvh();
+    btOptimizedBvh* cachedBvh = static_cast<btBvhTriangleMeshShape*>(cachedShape)->getOptimizedBvh();
+    QVERIFY(cachedBvh != nullptr);
+    QCOMPARE(cachedBvh->isQuantized(), builtBvh->isQuantized());
+    QCOMPARE(cachedBvh->getQuantizedNodeArray().size(), builtBvh->getQuantizedNodeArray().size());
+
+    btTransform identity;
+    identity.setIdentity();
+    btVector3 builtMin, builtMax, cachedMin, cachedMax;
+    builtShape->getAabb(identity, builtMin, builtMax);
+    cachedShape->getAabb(identity, cachedMin, cachedMax);
+    QCOMPARE(bulletToGLM(cachedMin), bulletToGLM(builtMin));
+    QCOMPARE(bulletToGLM(cachedMax), bulletToGLM(builtMax));
+
+    ShapeFactory::deleteShape(builtShape);
+    ShapeFactory::deleteShape(cachedShape);
+    ShapeCache::disable();
+}
+
+void ShapeManagerTests::cacheCompoundShape() {
+    QTemporaryDir cacheDir;
+    ShapeCache::enable(cacheDir.path().toStdString(), 64 * 1024 * 1024);
+
+    // two hulls of points on spheres, with more points than are kept per hull
+    const int NUM_HULLS = 2;
+    const int NUM_POINTS_PER_HULL = 4096;
+    ShapeInfo::PointCollection pointCollection;
+    for (int i = 0; i < NUM_HULLS; ++i) {
+        ShapeInfo::PointList pointList;
+        for (int j = 0; j < NUM_POINTS_PER_HULL; ++j) {
+            float theta = (float)j * 0.618f * TWO_PI;
+            float y = 1.0f - 2.0f * ((float)j + 0.5f) / (float)NUM_POINTS_PER_HULL;
+            float radius = sqrtf(1.0f - y * y);
+            pointList.push_back(glm::vec3(radius * cosf(theta) + (float)(2 * i), y, radius * sinf(theta)));
+        }
+        pointCollection.push_back(pointList);
+    }
+    ShapeInfo info;
+    info.setParams(SHAPE_TYPE_COMPOUND, glm::vec3(2.0f, 1.0f, 1.0f));
+    info.setPointCollection(pointCollection);
+
+    auto builtShape = const_cast<btCollisionShape*>(ShapeFactory::createShapeFromInfo(info));
+    QVERIFY(builtShape != nullptr);
+    auto cachedShape = const_cast<btCollisionShape*>(ShapeFactory::createShapeFromInfo(info));
+    QVERIFY(cachedShape != nullptr);
+    QCOMPARE(ShapeCache::getNumHits(), (size_t)1);
+
+    QCOMPARE(cachedShape->getShapeType(), (int)COMPOUND_SHAPE_PROXYTYPE);
+    auto builtCompound = static_cast<btCompoundShape*>(builtShape);
+    auto cachedCompound = static_cast<btCompoundShape*>(cachedShape);
+    QCOMPARE(cachedCompound->getNumChildShapes(), NUM_HULLS);
+    for (int i = 0; i < NUM_HULLS; ++i) {
+        auto builtHull = static_cast<btConvexHullShape*>(builtCompound->getChildShape(i));
+        auto cachedHull = static_cast<btConvexHullShape*>(cachedCompound->getChildShape(i));
+        QCOMPARE(cachedHull->getNumPoints(), builtHull->getNumPoints());
+        QCOMPARE(cachedHull->getMargin(), builtHull->getMargin());
+        for (int j = 0; j < builtHull->getNumPoints(); ++j) {
+            QCOMPARE(bulletToGLM(cachedHull->getUnscaledPoints()[j]), bulletToGLM(builtHull->getUnscaledPoints()[j]));
+        }
+    }
+
+    ShapeFactory::deleteShape(builtShape);
+    ShapeFactory::deleteShape(cachedShape);
+    ShapeCache::disable();
+}
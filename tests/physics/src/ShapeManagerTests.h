@@ -25,6 +25,8 @@ private slots:
     void addCylinderShape();
     void addCapsuleShape();
     void addCompoundShape();
+    void cacheStaticMeshShape();
+    void cacheCompoundShape();
 };
 
 #endif // hifi_ShapeManagerTests_h
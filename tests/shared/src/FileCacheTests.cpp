@@ -10,6 +10,7 @@
 
 #include "FileCacheTests.h"
 
+#include <shared/ContentCache.h>
 #include <shared/FileCache.h>
 
 QTEST_GUILESS_MAIN(FileCacheTests)
@@ -157,6 +158,43 @@ void FileCacheTests::testWipe() {
 }
 
 
+void FileCacheTests::testContentCache() {
+    const QString ARTIFACT_TYPE = "test";
+    const QByteArray CONTENT_ID = "atp-hash";
+    const QByteArray ARTIFACT { 4096, 'a' };
+    QString location = _testDir.path() + "/artifacts";
+
+    auto key = ContentCache::makeKey(CONTENT_ID, ARTIFACT_TYPE, 1);
+    QVERIFY(key != ContentCache::makeKey(CONTENT_ID, ARTIFACT_TYPE, 2));
+    QVERIFY(key != ContentCache::makeKey("other-hash", ARTIFACT_TYPE, 1));
+
+    {
+        auto cache = std::make_shared<ContentCache>(location.toStdString());
+        cache->initialize();
+
+        QByteArray artifact;
+        QVERIFY(!cache->load(key, artifact));
+        QVERIFY(cache->store(key, ARTIFACT));
+        QVERIFY(cache->store(key, ARTIFACT));
+        QCOMPARE(cache->getNumMisses(), (size_t)1);
+    }
+
+    // artifacts persist across cache instances
+    auto cache = std::make_shared<ContentCache>(location.toStdString());
+    cache->initialize();
+    QCOMPARE(cache->getNumTotalFiles(), (size_t)1);
+
+    QByteArray artifact;
+    QVERIFY(cache->load(key, artifact));
+    QCOMPARE(artifact, ARTIFACT);
+    QCOMPARE(cache->getNumHits(), (size_t)1);
+    QCOMPARE(cache->getNumMisses(), (size_t)0);
+
+    cache->wipe();
+    QVERIFY(!cache->load(key, artifact));
+    QVERIFY(artifact.isEmpty());
+}
+
 void FileCacheTests::cleanupTestCase() {
 }
 
@@ -0,0 +1,235 @@
+//
+//  FrameTracerTests.cpp
+//  tests/shared/src
+//
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "FrameTracerTests.h"
+
+#include <thread>
+
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+#include <QtCore/QTemporaryDir>
+
+#include <FrameTracer.h>
+
+QTEST_MAIN(FrameTracerTests)
+
+using namespace tracing;
+
+static const uint64_t FRAME_DEADLINE_USECS = 10 * 1000 * 1000;
+
+// the complete ("X") events of a trace, in the order they were written
+static QJsonArray getRangeEvents(const FrameTracer& tracer) {
+    QJsonParseError error;
+    QJsonDocument document = QJsonDocument::fromJson(tracer.getChromeTrace(), &error);
+    if (error.error != QJsonParseError::NoError) {
+        qWarning() << "Invalid trace:" << error.errorString();
+        return QJsonArray();
+    }
+
+    QJsonArray rangeEvents;
+    for (const auto& event : document.object()["traceEvents"].toArray()) {
+        if (event.toObject()["ph"].toString() == "X") {
+            rangeEvents.append(event);
+        }
+    }
+    return rangeEvents;
+}
+
+void FrameTracerTests::disabledTest() {
+    FrameTracer tracer("test");
+
+    tracer.beginFrame(0);
+    QVERIFY(!tracer.isActive());
+    {
+        FRAME_TRACE_RANGE(tracer, "disabled");
+    }
+    tracer.endFrame(FRAME_DEADLINE_USECS);
+
+    tracer.setEnabled(true);
+    {
+        FRAME_TRACE_RANGE(tracer, "betweenFrames");
+    }
+
+    QCOMPARE(getRangeEvents(tracer).size(), 0);
+}
+
+void FrameTracerTests::sampleIntervalTest() {
+    const int SAMPLE_INTERVAL = 4;
+    const int NUM_FRAMES = 12;
+
+    FrameTracer tracer("test");
+    tracer.setEnabled(true);
+    tracer.setSampleInterval(SAMPLE_INTERVAL);
+
+    for (int frame = 0; frame < NUM_FRAMES; frame++) {
+        tracer.beginFrame(frame);
+        QCOMPARE(tracer.isActive(), frame % SAMPLE_INTERVAL == 0);
+        {
+            FRAME_TRACE_RANGE_ARG(tracer, "work", frame);
+        }
+        tracer.endFrame(FRAME_DEADLINE_USECS);
+    }
+
+    // a work range and the frame itself, for each sampled frame
+    QJsonArray events = getRangeEvents(tracer);
+    QCOMPARE(events.size(), 2 * NUM_FRAMES / SAMPLE_INTERVAL);
+    for (const auto& event : events) {
+        QJsonObject args = event.toObject()["args"].toObject();
+        QCOMPARE(args["frame"].toInt() % SAMPLE_INTERVAL, 0);
+        if (event.toObject()["name"].toString() == "work") {
+            QCOMPARE(args["arg"].toInt(), args["frame"].toInt());
+        } else {
+            QVERIFY(!args.contains("arg"));
+        }
+    }
+
+    tracer.setSampleInterval(0);
+    QCOMPARE(tracer.getSampleInterval(), 1);
+}
+
+void FrameTracerTests::ringBufferTest() {
+    const int EVENTS_PER_THREAD = 8;
+    const int NUM_EVENTS = 20;
+
+    FrameTracer tracer("test", EVENTS_PER_THREAD);
+    tracer.setEnabled(true);
+
+    tracer.beginFrame(0);
+    for (int i = 0; i < NUM_EVENTS; i++) {
+        tracer.record("event", i, i + 1, i);
+    }
+
+    QJsonArray events = getRangeEvents(tracer);
+    QCOMPARE(events.size(), EVENTS_PER_THREAD);
+    for (int i = 0; i < EVENTS_PER_THREAD; i++) {
+        QJsonObject event = events[i].toObject();
+        int expected = NUM_EVENTS - EVENTS_PER_THREAD + i;
+        QCOMPARE(event["args"].toObject()["arg"].toInt(), expected);
+        QCOMPARE(event["ts"].toInt(), expected);
+        QCOMPARE(event["dur"].toInt(), 1);
+    }
+
+    tracer.clear();
+    QCOMPARE(getRangeEvents(tracer).size(), 0);
+}
+
+void FrameTracerTests::chromeTraceTest() {
+    FrameTracer tracer("test \"mixer\"");
+    tracer.setEnabled(true);
+
+    tracer.beginFrame(7);
+    {
+        FRAME_TRACE_RANGE(tracer, "loop");
+    }
+    std::thread worker([&tracer] {
+        FRAME_TRACE_RANGE_ARG(tracer, "worker", 42);
+    });
+    worker.join();
+    tracer.endFrame(FRAME_DEADLINE_USECS);
+
+    QJsonParseError error;
+    QJsonDocument document = QJsonDocument::fromJson(tracer.getChromeTrace(), &error);
+    QCOMPARE(error.error, QJsonParseError::NoError);
+
+    QJsonArray traceEvents = document.object()["traceEvents"].toArray();
+    // thread IDs don't fit in an int
+    QSet<qint64> rangeThreads;
+    QSet<qint64> namedThreads;
+    QStringList names;
+    for (const auto& value : traceEvents) {
+        QJsonObject event = value.toObject();
+        if (event["ph"].toString() == "M") {
+            if (event["name"].toString() == "process_name") {
+                QCOMPARE(event["args"].toObject()["name"].toString(), QString("test \"mixer\""));
+            } else {
+                QCOMPARE(event["name"].toString(), QString("thread_name"));
+                namedThreads.insert((qint64)event["tid"].toDouble());
+            }
+        } else {
+            QCOMPARE(event["ph"].toString(), QString("X"));
+            QCOMPARE(event["args"].toObject()["frame"].toInt(), 7);
+            rangeThreads.insert((qint64)event["tid"].toDouble());
+            names.append(event["name"].toString());
+        }
+    }
+
+    names.sort();
+    QCOMPARE(names, QStringList({ "frame", "loop", "worker" }));
+    QCOMPARE(rangeThreads.size(), 2);
+    QCOMPARE(namedThreads, rangeThreads);
+}
+
+void FrameTracerTests::deadlineMissTest() {
+    QTemporaryDir directory;
+    QVERIFY(directory.isValid());
+
+    FrameTracer tracer("test");
+    tracer.setEnabled(true);
+    tracer.setDumpDirectory(directory.path());
+
+    // a frame that takes any time at all misses a deadline of zero
+    auto lateFrame = [&](uint32_t frame) {
+        tracer.beginFrame(frame);
+        QThread::usleep(1000);
+        tracer.endFrame(0);
+    };
+
+    lateFrame(0);
+    QCOMPARE(tracer.getNumDeadlineMisses(), (uint32_t)1);
+    QCOMPARE(tracer.getNumDumps(), (uint32_t)1);
+
+    QStringList traces = QDir(directory.path()).entryList({ "test-*-frame0.json" }, QDir::Files);
+    QCOMPARE(traces.size(), 1);
+    QFile file(QDir(directory.path()).filePath(traces[0]));
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    QVERIFY(!QJsonDocument::fromJson(file.readAll()).isNull());
+
+    // the next late frame is too soon after the last trace
+    lateFrame(1);
+    QCOMPARE(tracer.getNumDeadlineMisses(), (uint32_t)2);
+    QCOMPARE(tracer.getNumDumps(), (uint32_t)1);
+
+    // nor is a trace written for a late frame that wasn't traced
+    FrameTracer untracedTracer("untraced");
+    untracedTracer.setDumpDirectory(directory.path());
+    untracedTracer.beginFrame(0);
+    QThread::usleep(1000);
+    untracedTracer.endFrame(0);
+    QCOMPARE(untracedTracer.getNumDeadlineMisses(), (uint32_t)1);
+    QCOMPARE(untracedTracer.getNumDumps(), (uint32_t)0);
+}
+
+void FrameTracerTests::requestedDumpTest() {
+    QTemporaryDir directory;
+    QVERIFY(directory.isValid());
+
+    FrameTracer tracer("test");
+    tracer.setEnabled(true);
+    tracer.setDumpDirectory(directory.path());
+
+    tracer.beginFrame(0);
+    tracer.requestDump();
+    QCOMPARE(tracer.getNumDumps(), (uint32_t)0);
+    tracer.endFrame(FRAME_DEADLINE_USECS);
+    QCOMPARE(tracer.getNumDumps(), (uint32_t)1);
+
+    // as the signal handler asks
+    FrameTracer::requestDumpAll();
+    tracer.beginFrame(1);
+    tracer.endFrame(FRAME_DEADLINE_USECS);
+    QCOMPARE(tracer.getNumDumps(), (uint32_t)2);
+
+    // and only once for each request
+    tracer.beginFrame(2);
+    tracer.endFrame(FRAME_DEADLINE_USECS);
+    QCOMPARE(tracer.getNumDumps(), (uint32_t)2);
+    QCOMPARE(QDir(directory.path()).entryList({ "*.json" }, QDir::Files).size(), 2);
+}
@@ -0,0 +1,40 @@
+//
+//  FrameTracerTests.h
+//  tests/shared/src
+//
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_FrameTracerTests_h
+#define hifi_FrameTracerTests_h
+
+#pragma once
+
+#include <QtTest/QtTest>
+
+class FrameTracerTests : public QObject {
+    Q_OBJECT
+private slots:
+    // Test that nothing is recorded while tracing is disabled, or outside of a frame
+    void disabledTest();
+
+    // Test that only one frame in every sample interval is traced
+    void sampleIntervalTest();
+
+    // Test that a full buffer keeps the most recent events, oldest first
+    void ringBufferTest();
+
+    // Test that the trace is Chrome trace JSON, with a track per recording thread
+    void chromeTraceTest();
+
+    // Test that a late frame writes a trace, but not again until the minimum interval has passed
+    void deadlineMissTest();
+
+    // Test that a requested trace is written at the end of the frame
+    void requestedDumpTest();
+};
+
+#endif // hifi_FrameTracerTests_h
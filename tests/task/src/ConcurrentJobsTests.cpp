@@ -0,0 +1,160 @@
+//
+//  ConcurrentJobsTests.cpp
+//  tests/task/src
+//
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ConcurrentJobsTests.h"
+
+#include <atomic>
+#include <string>
+#include <vector>
+
+#include <task/Parallel.h>
+#include <task/Task.h>
+
+QTEST_MAIN(ConcurrentJobsTests)
+
+namespace {
+
+class TestTimeProfiler {
+public:
+    TestTimeProfiler(const std::string& label) {}
+};
+
+// copied for each job of a concurrent group
+class CopyableContext : public task::JobContext {
+};
+
+// has every job of a concurrent group run in turn on the one context
+class NonCopyableContext : public task::JobContext {
+public:
+    NonCopyableContext() = default;
+    NonCopyableContext(const NonCopyableContext&) = delete;
+};
+
+// jobs that ran while the context held another job's config
+std::atomic<int> numConfigMismatches { 0 };
+
+// Scales every item of a range by a factor, with a loop of its own on the thread pool, and sums the results
+template <class C>
+class Scale {
+public:
+    using Input = int;
+    using Output = int;
+    using JobModel = typename task::Job<C, TestTimeProfiler>::template ModelIO<Scale, Input, Output>;
+
+    static const int NUM_ITEMS = 1000;
+
+    Scale(int factor) : _factor(factor) {}
+
+    void run(const std::shared_ptr<C>& context, const Input& input, Output& output) {
+        std::vector<int> items(NUM_ITEMS);
+        task::parallelFor(NUM_ITEMS, [&](int i) {
+            items[i] = (input + i) * _factor;
+        }, 16);
+
+        if (!context->jobConfig || context->jobConfig->objectName() != QString("Scale%1").arg(_factor)) {
+            numConfigMismatches++;
+        }
+
+        output = 0;
+        for (auto item : items) {
+            output += item;
+        }
+    }
+
+private:
+    int _factor;
+};
+
+template <class C>
+class Sum {
+public:
+    using Input = task::VaryingSet4<int, int, int, int>;
+    using Output = int;
+    using JobModel = typename task::Job<C, TestTimeProfiler>::template ModelIO<Sum, Input, Output>;
+
+    void run(const std::shared_ptr<C>& context, const Input& input, Output& output) {
+        output = input.get0() + input.get1() + input.get2() + input.get3();
+    }
+};
+
+// Four scale jobs, as a concurrent group or one after the other, and a job that consumes all of their outputs
+template <class C, bool IS_CONCURRENT>
+class ScaleTask {
+public:
+    using Input = int;
+    using Output = task::VaryingSet5<int, int, int, int, int>;
+    using JobModel = typename task::Task<C, TestTimeProfiler>::template ModelIO<ScaleTask, Input, Output>;
+
+    void build(JobModel& model, const task::Varying& input, task::Varying& output) {
+        if (IS_CONCURRENT) {
+            model.beginConcurrentJobs();
+        }
+        const auto scaled1 = model.template addJob<Scale<C>>("Scale1", input, 1);
+        const auto scaled2 = model.template addJob<Scale<C>>("Scale2", input, 2);
+        const auto scaled3 = model.template addJob<Scale<C>>("Scale3", input, 3);
+        const auto scaled4 = model.template addJob<Scale<C>>("Scale4", input, 4);
+        if (IS_CONCURRENT) {
+            model.endConcurrentJobs();
+        }
+
+        const auto sumInput = typename Sum<C>::Input(scaled1, scaled2, scaled3, scaled4).asVarying();
+        const auto sum = model.template addJob<Sum<C>>("Sum", sumInput);
+
+        output = Output(scaled1, scaled2, scaled3, scaled4, sum);
+    }
+};
+
+template <class C, bool IS_CONCURRENT>
+typename ScaleTask<C, IS_CONCURRENT>::Output runScaleTask(int input) {
+    using Task = ScaleTask<C, IS_CONCURRENT>;
+    auto engine = std::make_shared<task::Engine<C, TestTimeProfiler>>(Task::JobModel::create("ScaleTask"),
+                                                                       std::make_shared<C>());
+    engine->feedInput(input);
+    engine->run();
+    return engine->getOutput().template get<typename Task::Output>();
+}
+
+template <class C>
+void compareConcurrentToSequential() {
+    const int NUM_RUNS = 20;
+    numConfigMismatches = 0;
+    for (int input = 0; input < NUM_RUNS; input++) {
+        auto concurrent = runScaleTask<C, true>(input);
+        auto sequential = runScaleTask<C, false>(input);
+
+        int expected = 0;
+        for (int i = 0; i < Scale<C>::NUM_ITEMS; i++) {
+            expected += input + i;
+        }
+        QCOMPARE(sequential.get0(), expected);
+        QCOMPARE(sequential.get1(), 2 * expected);
+        QCOMPARE(sequential.get2(), 3 * expected);
+        QCOMPARE(sequential.get3(), 4 * expected);
+        QCOMPARE(sequential.get4(), 10 * expected);
+
+        QCOMPARE(concurrent.get0(), sequential.get0());
+        QCOMPARE(concurrent.get1(), sequential.get1());
+        QCOMPARE(concurrent.get2(), sequential.get2());
+        QCOMPARE(concurrent.get3(), sequential.get3());
+        QCOMPARE(concurrent.get4(), sequential.get4());
+    }
+    QCOMPARE(numConfigMismatches.load(), 0);
+}
+
+}
+
+void ConcurrentJobsTests::testConcurrentMatchesSequential() {
+    compareConcurrentToSequential<CopyableContext>();
+}
+
+void ConcurrentJobsTests::testNonCopyableContext() {
+    // a context that can't be copied runs the group's jobs one after the other, with the same results
+    compareConcurrentToSequential<NonCopyableContext>();
+}
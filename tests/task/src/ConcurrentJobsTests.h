@@ -0,0 +1,24 @@
+//
+//  ConcurrentJobsTests.h
+//  tests/task/src
+//
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_ConcurrentJobsTests_h
+#define hifi_ConcurrentJobsTests_h
+
+#include <QtTest/QtTest>
+
+class ConcurrentJobsTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testConcurrentMatchesSequential();
+    void testNonCopyableContext();
+};
+
+#endif // hifi_ConcurrentJobsTests_h
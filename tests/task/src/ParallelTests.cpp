@@ -0,0 +1,103 @@
+//
+//  ParallelTests.cpp
+//  tests/task/src
+//
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ParallelTests.h"
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include <QtCore/QThreadPool>
+
+#include <task/Parallel.h>
+
+QTEST_MAIN(ParallelTests)
+
+void ParallelTests::testCoverage_data() {
+    QTest::addColumn<int>("count");
+    QTest::addColumn<int>("grainSize");
+
+    QTest::newRow("one item") << 1 << 1;
+    QTest::newRow("grain of one") << 1000 << 1;
+    QTest::newRow("uneven grain") << 1000 << 7;
+    QTest::newRow("grain of the whole range") << 1000 << 1000;
+    QTest::newRow("grain larger than the range") << 5 << 100;
+    QTest::newRow("grain of zero") << 100 << 0;
+}
+
+void ParallelTests::testCoverage() {
+    QFETCH(int, count);
+    QFETCH(int, grainSize);
+
+    // every index is visited exactly once, in ranges no bigger than the grain
+    std::unique_ptr<std::atomic<int>[]> visits(new std::atomic<int>[count]);
+    for (int i = 0; i < count; i++) {
+        visits[i] = 0;
+    }
+    std::atomic<int> numBadRanges { 0 };
+    task::parallelForRange(count, grainSize, [&](int begin, int end) {
+        if (begin < 0 || end > count || begin >= end || end - begin > std::max(grainSize, 1)) {
+            numBadRanges++;
+        }
+        for (int i = begin; i < end; i++) {
+            visits[i]++;
+        }
+    });
+    QCOMPARE(numBadRanges.load(), 0);
+    for (int i = 0; i < count; i++) {
+        QVERIFY2(visits[i] == 1, qPrintable(QString("index %1 was visited %2 times").arg(i).arg(visits[i].load())));
+    }
+
+    std::unique_ptr<std::atomic<int>[]> indexVisits(new std::atomic<int>[count]);
+    for (int i = 0; i < count; i++) {
+        indexVisits[i] = 0;
+    }
+    task::parallelFor(count, [&](int i) {
+        indexVisits[i]++;
+    }, grainSize);
+    for (int i = 0; i < count; i++) {
+        QVERIFY2(indexVisits[i] == 1, qPrintable(QString("index %1 was visited %2 times").arg(i).arg(indexVisits[i].load())));
+    }
+}
+
+void ParallelTests::testEmptyRange() {
+    std::atomic<int> numCalls { 0 };
+    task::parallelForRange(0, 1, [&](int begin, int end) {
+        numCalls++;
+    });
+    task::parallelForRange(-1, 1, [&](int begin, int end) {
+        numCalls++;
+    });
+    task::parallelFor(0, [&](int i) {
+        numCalls++;
+    });
+    QCOMPARE(numCalls.load(), 0);
+}
+
+void ParallelTests::testNested() {
+    // more outer items than pool threads, so that every pool thread runs inner loops while others wait on theirs
+    const int NUM_OUTER = 4 * std::max(QThreadPool::globalInstance()->maxThreadCount(), 1);
+    const int NUM_INNER = 1000;
+    std::vector<int> sums(NUM_OUTER, 0);
+    task::parallelFor(NUM_OUTER, [&](int outer) {
+        std::vector<int> values(NUM_INNER, 0);
+        task::parallelFor(NUM_INNER, [&](int inner) {
+            values[inner] = outer + inner;
+        }, 16);
+        for (auto value : values) {
+            sums[outer] += value;
+        }
+    });
+
+    for (int outer = 0; outer < NUM_OUTER; outer++) {
+        QCOMPARE(sums[outer], NUM_INNER * outer + NUM_INNER * (NUM_INNER - 1) / 2);
+    }
+}
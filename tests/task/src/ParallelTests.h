@@ -0,0 +1,26 @@
+//
+//  ParallelTests.h
+//  tests/task/src
+//
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_ParallelTests_h
+#define hifi_ParallelTests_h
+
+#include <QtTest/QtTest>
+
+class ParallelTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testCoverage_data();
+    void testCoverage();
+    void testEmptyRange();
+    void testNested();
+};
+
+#endif // hifi_ParallelTests_h
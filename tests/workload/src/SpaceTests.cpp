@@ -11,6 +11,8 @@
 
 #include "SpaceTests.h"
 
+#include <math.h>
+#include <algorithm>
 #include <iostream>
 
 #include <workload/Space.h>
@@ -115,173 +117,235 @@ void SpaceTests::testOverlaps() {
 #endif
 }
 
-#ifdef MANUAL_TEST
-
 const float WORLD_WIDTH = 1000.0f;
-const float MIN_RADIUS = 1.0f;
-const float MAX_RADIUS = 100.0f;
+const float MIN_RADIUS = 0.1f;
+const float MAX_RADIUS = 20.0f;
 
 float randomFloat() {
     return 2.0f * ((float)rand() / (float)RAND_MAX) - 1.0f;
 }
 
-glm::vec3 randomVec3() {
-    glm::vec3 v(randomFloat(), randomFloat(), randomFloat());
-    return v;
-}
-
-void generateSpheres(uint32_t numProxies, std::vector<workload::Space::Sphere>& spheres) {
+// proxies spread over the world, flattened vertically like a real scene
+void generateSpheres(uint32_t numProxies, std::vector<workload::Sphere>& spheres) {
     spheres.reserve(numProxies);
     for (uint32_t i = 0; i < numProxies; ++i) {
-        workload::Space::Sphere sphere(
+        workload::Sphere sphere(
                 WORLD_WIDTH * randomFloat(),
+                0.1f * WORLD_WIDTH * randomFloat(),
                 WORLD_WIDTH * randomFloat(),
-                WORLD_WIDTH * randomFloat(),
-                (MIN_RADIUS + (MAX_RADIUS - MIN_RADIUS)) * randomFloat());
+                MIN_RADIUS + (MAX_RADIUS - MIN_RADIUS) * 0.5f * (randomFloat() + 1.0f));
         spheres.push_back(sphere);
     }
 }
 
-void generatePositions(uint32_t numProxies, std::vector<glm::vec3>& positions) {
-    positions.reserve(numProxies);
-    for (uint32_t i = 0; i < numProxies; ++i) {
-        positions.push_back(WORLD_WIDTH * randomVec3());
+workload::View makeView(const glm::vec3& position) {
+    workload::View view;
+    view.origin = position;
+    const float REGION_RADII[workload::Region::NUM_TRACKED_REGIONS] = { 0.05f * WORLD_WIDTH, 0.2f * WORLD_WIDTH, 0.6f * WORLD_WIDTH };
+    for (uint32_t k = 0; k < workload::Region::NUM_TRACKED_REGIONS; ++k) {
+        view.regions[k] = workload::Sphere(position, REGION_RADII[k]);
     }
+    return view;
 }
 
-void generateRadiuses(uint32_t numRadiuses, std::vector<float>& radiuses) {
-    radiuses.reserve(numRadiuses);
-    for (uint32_t i = 0; i < numRadiuses; ++i) {
-        radiuses.push_back(MIN_RADIUS + (MAX_RADIUS - MIN_RADIUS) * randomFloat());
+void addProxies(workload::Space& space, const std::vector<workload::Sphere>& spheres) {
+    workload::Transaction transaction;
+    for (auto& sphere : spheres) {
+        transaction.reset(space.allocateID(), sphere, workload::Owner());
     }
+    space.enqueueTransaction(transaction);
+    space.enqueueFrame();
+    space.processTransactionQueue();
 }
 
-void SpaceTests::benchmark() {
-    uint32_t numProxies[] = { 100, 1000, 10000, 100000 };
-    uint32_t numTests = 4;
-    std::vector<uint64_t> timeToAddAll;
-    std::vector<uint64_t> timeToMoveView;
-    std::vector<uint64_t> timeToMoveProxies;
-    std::vector<uint64_t> timeToRemoveAll;
-    for (uint32_t i = 0; i < numTests; ++i) {
-
-        workload::Space space;
-
-        { // build the views
-            std::vector<glm::vec3> viewPositions;
-            viewPositions.push_back(glm::vec3(0.0f, 0.0f, 0.0f));
-            viewPositions.push_back(glm::vec3(0.0f, 0.0f, 0.1f * WORLD_WIDTH));
-            float radius0 = 0.25f * WORLD_WIDTH;
-            float radius1 = 0.50f * WORLD_WIDTH;
-            float radius2 = 0.75f * WORLD_WIDTH;
-            std::vector<workload::Space::View> views;
-            views.push_back(workload::Space::View(viewPositions[0], radius0, radius1, radius2));
-            views.push_back(workload::Space::View(viewPositions[1], radius0, radius1, radius2));
-            space.setViews(views);
+// the region of the sphere by brute force, with the touch distances scaled by touchScale
+uint8_t computeRegion(const workload::Sphere& sphere, const workload::Views& views, float touchScale = 1.0f) {
+    uint8_t region = workload::Region::R4;
+    for (auto& view : views) {
+        for (uint8_t k = 0; k < region; ++k) {
+            float touchDistance = touchScale * (sphere.w + view.regions[k].w);
+            if (distance2(glm::vec3(sphere), glm::vec3(view.regions[k])) < touchDistance * touchDistance) {
+                region = k;
+                break;
+            }
         }
+    }
+    return region;
+}
 
-        // build the proxies
-        uint32_t n = numProxies[i];
-        std::vector<workload::Space::Sphere> proxySpheres;
-        generateSpheres(n, proxySpheres);
-        std::vector<int32_t> proxyKeys;
-        proxyKeys.reserve(n);
-
-        // measure time to put proxies in the space
-        uint64_t startTime = usecTimestampNow();
-        for (uint32_t j = 0; j < n; ++j) {
-            int32_t key = space.createProxy(proxySpheres[j]);
-            proxyKeys.push_back(key);
-        }
-        uint64_t usec = usecTimestampNow() - startTime;
-        timeToAddAll.push_back(usec);
-
-        {
-            // build the views
-            std::vector<glm::vec3> viewPositions;
-            viewPositions.push_back(glm::vec3(1.0f, 2.0f, 3.0f));
-            viewPositions.push_back(glm::vec3(1.0f, 2.0f, 3.0f + 0.1f * WORLD_WIDTH));
-            float radius0 = 0.25f * WORLD_WIDTH;
-            float radius1 = 0.50f * WORLD_WIDTH;
-            float radius2 = 0.75f * WORLD_WIDTH;
-            std::vector<workload::Space::View> views;
-            views.push_back(workload::Space::View(viewPositions[0], radius0, radius1, radius2));
-            views.push_back(workload::Space::View(viewPositions[1], radius0, radius1, radius2));
-            space.setViews(views);
-        }
+void SpaceTests::testCategorize() {
+    srand(1);
+    const uint32_t NUM_PROXIES = 20000;
+    std::vector<workload::Sphere> spheres;
+    generateSpheres(NUM_PROXIES, spheres);
+
+    // a few proxies the grid can't bound
+    spheres[0] = workload::Sphere(1.0e12f, 0.0f, 0.0f, 1.0f);
+    spheres[1] = workload::Sphere(0.0f, 0.0f, 0.0f, 1.0e12f);
 
-        // measure time to categorizeAndGetChanges everything
-        std::vector<workload::Space::Change> changes;
-        startTime = usecTimestampNow();
+    workload::Space space;
+    addProxies(space, spheres);
+
+    workload::Views views;
+    views.push_back(makeView(glm::vec3(0.0f)));
+    views.push_back(makeView(glm::vec3(0.3f * WORLD_WIDTH, 0.0f, 0.0f)));
+
+    std::vector<bool> removed(NUM_PROXIES, false);
+    const int NUM_FRAMES = 4;
+    for (int frame = 0; frame < NUM_FRAMES; ++frame) {
+        space.setViews(views);
+        workload::Changes changes;
         space.categorizeAndGetChanges(changes);
-        usec = usecTimestampNow() - startTime;
-        timeToMoveView.push_back(usec);
-
-        // move every 10th proxy around
-        const float proxySpeed = 1.0f;
-        std::vector<workload::Space::Sphere> newSpheres;
-        uint32_t numMovingProxies = n / 10;
-        uint32_t jstep = n / numMovingProxies;
-        uint32_t maxJ = numMovingProxies * jstep - 1;
-        glm::vec3 direction;
-        for (uint32_t j = 0; j < maxJ - jstep; j += jstep) {
-            glm::vec3 position = (glm::vec3)proxySpheres[j];
-            glm::vec3 destination = (glm::vec3)proxySpheres[j + jstep];
-            direction = glm::normalize(destination - position);
-            glm::vec3 newPosition = position + proxySpeed * direction;
-            newSpheres.push_back(workload::Space::Sphere(newPosition, proxySpheres[j].w));
+
+        std::vector<uint8_t> prevRegions(NUM_PROXIES, workload::Region::INVALID);
+        for (auto& change : changes) {
+            QVERIFY(change.proxyId >= 0 && change.proxyId < (int32_t)NUM_PROXIES);
+            QVERIFY(prevRegions[change.proxyId] == workload::Region::INVALID);
+            prevRegions[change.proxyId] = change.prevRegion;
         }
-        glm::vec3 position = (glm::vec3)proxySpheres[maxJ = jstep];
-        glm::vec3 destination = (glm::vec3)proxySpheres[0];
-        direction = glm::normalize(destination - position);
-        direction = position + proxySpeed * direction;
-        newSpheres.push_back(workload::Space::Sphere(direction, proxySpheres[0].w));
-        uint32_t k = 0;
-        startTime = usecTimestampNow();
-        for (uint32_t j = 0; j < maxJ; j += jstep) {
-            space.updateProxy(proxyKeys[j], newSpheres[k++]);
+
+        for (uint32_t i = 0; i < NUM_PROXIES; ++i) {
+            if (removed[i]) {
+                QCOMPARE(space.getRegion(i), (uint8_t)workload::Region::INVALID);
+                continue;
+            }
+            uint8_t region = space.getRegion(i);
+            uint8_t expected = computeRegion(spheres[i], views);
+            if (region != expected) {
+                // only allowed within rounding of a region boundary
+                const float ROUNDING = 1.0e-5f;
+                QVERIFY2(computeRegion(spheres[i], views, 1.0f - ROUNDING) != computeRegion(spheres[i], views, 1.0f + ROUNDING),
+                         qPrintable(QString("proxy %1 in region %2, expected %3").arg(i).arg(region).arg(expected)));
+            }
+            if (frame == 0) {
+                QCOMPARE(prevRegions[i], (uint8_t)workload::Region::UNKNOWN);
+            }
         }
-        changes.clear();
-        space.categorizeAndGetChanges(changes);
-        usec = usecTimestampNow() - startTime;
-        timeToMoveProxies.push_back(usec);
 
-        // measure time to remove proxies from space
-        startTime = usecTimestampNow();
-        for (uint32_t j = 0; j < n; ++j) {
-            space.deleteProxy(proxyKeys[j]);
+        // move the views and some of the proxies
+        for (auto& view : views) {
+            view = makeView(view.origin + glm::vec3(0.05f * WORLD_WIDTH, 0.0f, 0.02f * WORLD_WIDTH));
+        }
+        workload::Transaction transaction;
+        for (uint32_t i = 2; i < NUM_PROXIES; i += 3) {
+            spheres[i] += workload::Sphere(0.1f * WORLD_WIDTH * randomFloat(), 0.0f, 0.1f * WORLD_WIDTH * randomFloat(),
+                                           0.5f * (randomFloat() + 1.0f));
+            transaction.update(i, spheres[i]);
+        }
+        for (uint32_t i = 4 + frame; i < NUM_PROXIES; i += 100) {
+            if (!removed[i]) {
+                transaction.remove(i);
+                removed[i] = true;
+            }
         }
-        usec = usecTimestampNow() - startTime;
-        timeToRemoveAll.push_back(usec);
+        space.enqueueTransaction(transaction);
+        space.enqueueFrame();
+        space.processTransactionQueue();
     }
+}
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+#include <CPUDetect.h>
+
+void classifyProxies_ref(const float* x, const float* y, const float* z, const float* radius, uint8_t* regions,
+                         int numProxies, const float* regionX, const float* regionY, const float* regionZ,
+                         const float* regionRadius, int numViews);
+void classifyProxies_AVX2(const float* x, const float* y, const float* z, const float* radius, uint8_t* regions,
+                          int numProxies, const float* regionX, const float* regionY, const float* regionZ,
+                          const float* regionRadius, int numViews);
 
-    std::cout << "[numProxies, timeToAddAll] = [" << std::endl;
-    for (uint32_t i = 0; i < timeToAddAll.size(); ++i) {
-        uint32_t n = numProxies[i];
-        std::cout << "    " << n << ", " << timeToAddAll[i] << std::endl;
+void SpaceTests::testClassifyMatchesReference() {
+    if (!cpuSupportsAVX2()) {
+        QSKIP("AVX2 not supported");
     }
-    std::cout << "];" << std::endl;
 
-    std::cout << "[numProxies, timeToMoveView] = [" << std::endl;
-    for (uint32_t i = 0; i < timeToMoveView.size(); ++i) {
-        uint32_t n = numProxies[i];
-        std::cout << "    " << n << ", " << timeToMoveView[i] << std::endl;
+    // region spheres ordered by region and then by view, as Space passes them
+    const int NUM_VIEWS = 2;
+    std::vector<float> regionX, regionY, regionZ, regionRadius;
+    workload::Views views = { makeView(glm::vec3(0.0f)), makeView(glm::vec3(0.3f * WORLD_WIDTH, 1.5f, -7.25f)) };
+    for (uint32_t k = 0; k < workload::Region::NUM_TRACKED_REGIONS; ++k) {
+        for (auto& view : views) {
+            regionX.push_back(view.regions[k].x);
+            regionY.push_back(view.regions[k].y);
+            regionZ.push_back(view.regions[k].z);
+            regionRadius.push_back(view.regions[k].w);
+        }
     }
-    std::cout << "];" << std::endl;
 
-    std::cout << "[numProxies, timeToMoveProxies] = [" << std::endl;
-    for (uint32_t i = 0; i < timeToMoveProxies.size(); ++i) {
-        uint32_t n = numProxies[i];
-        std::cout << "    " << n << "/10, " << timeToMoveProxies[i] << std::endl;
+    // proxies exactly at the touch distance of each region sphere, and one float either side of it
+    srand(2);
+    std::vector<glm::vec3> directions = { { 1.0f, 0.0f, 0.0f }, { 0.0f, -1.0f, 0.0f }, { 0.0f, 0.0f, 1.0f },
+                                          { INV_SQRT_3, INV_SQRT_3, INV_SQRT_3 }, { -INV_SQRT_3, INV_SQRT_3, -INV_SQRT_3 } };
+    for (int i = 0; i < 8; ++i) {
+        directions.push_back(glm::normalize(glm::vec3(randomFloat(), randomFloat(), randomFloat())));
+    }
+    std::vector<float> x, y, z, radius;
+    for (size_t j = 0; j < regionRadius.size(); ++j) {
+        glm::vec3 center(regionX[j], regionY[j], regionZ[j]);
+        for (auto& direction : directions) {
+            for (float proxyRadius : { 0.0f, MIN_RADIUS, 1.5f, MAX_RADIUS }) {
+                float touchDistance = proxyRadius + regionRadius[j];
+                for (float distance : { nextafterf(touchDistance, 0.0f), touchDistance, nextafterf(touchDistance, INFINITY) }) {
+                    glm::vec3 position = center + distance * direction;
+                    x.push_back(position.x);
+                    y.push_back(position.y);
+                    z.push_back(position.z);
+                    radius.push_back(proxyRadius);
+                }
+            }
+        }
     }
-    std::cout << "];" << std::endl;
 
-    std::cout << "[numProxies, timeToRemoveAll] = [" << std::endl;
-    for (uint32_t i = 0; i < timeToRemoveAll.size(); ++i) {
-        uint32_t n = numProxies[i];
-        std::cout << "    " << n << ", " << timeToRemoveAll[i] << std::endl;
+    // every count up to a few blocks, so that the remainder is covered too
+    int numProxies = (int)radius.size();
+    std::vector<uint8_t> expected(numProxies);
+    std::vector<uint8_t> regions(numProxies);
+    for (int count : { 1, 7, 8, 9, 15, 16, 17, numProxies - 1, numProxies }) {
+        std::fill(expected.begin(), expected.end(), workload::Region::INVALID);
+        std::fill(regions.begin(), regions.end(), workload::Region::INVALID);
+        classifyProxies_ref(x.data(), y.data(), z.data(), radius.data(), expected.data(), count,
+                            regionX.data(), regionY.data(), regionZ.data(), regionRadius.data(), NUM_VIEWS);
+        classifyProxies_AVX2(x.data(), y.data(), z.data(), radius.data(), regions.data(), count,
+                             regionX.data(), regionY.data(), regionZ.data(), regionRadius.data(), NUM_VIEWS);
+        for (int i = 0; i < numProxies; ++i) {
+            QVERIFY2(regions[i] == expected[i],
+                     qPrintable(QString("proxy %1 of %2 in region %3, expected %4").arg(i).arg(count).arg(regions[i]).arg(expected[i])));
+        }
     }
-    std::cout << "];" << std::endl;
 }
 
-#endif // MANUAL_TEST
+#else
+void SpaceTests::testClassifyMatchesReference() {
+    QSKIP("no SIMD kernels on this architecture");
+}
+#endif
+
+void SpaceTests::benchmarkCategorize_data() {
+    QTest::addColumn<int>("numProxies");
+
+    QTest::newRow("10k proxies") << 10000;
+    QTest::newRow("100k proxies") << 100000;
+    QTest::newRow("1M proxies") << 1000000;
+}
+
+void SpaceTests::benchmarkCategorize() {
+    QFETCH(int, numProxies);
+
+    srand(1);
+    std::vector<workload::Sphere> spheres;
+    generateSpheres((uint32_t)numProxies, spheres);
+    workload::Space space;
+    addProxies(space, spheres);
+
+    // the view walks back and forth, so that every frame has proxies changing regions
+    glm::vec3 viewPosition(0.0f);
+    glm::vec3 viewStep(0.01f * WORLD_WIDTH, 0.0f, 0.0f);
+    workload::Changes changes;
+    QBENCHMARK {
+        viewPosition += viewStep;
+        viewStep = -viewStep;
+        space.setViews({ makeView(viewPosition), makeView(viewPosition + glm::vec3(0.0f, 0.0f, 0.1f * WORLD_WIDTH)) });
+        changes.clear();
+        space.categorizeAndGetChanges(changes);
+    }
+}
@@ -14,16 +14,15 @@
 
 #include <QtTest/QtTest>
 
-//#define MANUAL_TEST
-
 class SpaceTests : public QObject {
     Q_OBJECT
 
 private slots:
     void testOverlaps();
-#ifdef MANUAL_TEST
-    void benchmark();
-#endif // MANUAL_TEST
+    void testCategorize();
+    void testClassifyMatchesReference();
+    void benchmarkCategorize_data();
+    void benchmarkCategorize();
 };
 
 #endif // hifi_workload_SpaceTests_h
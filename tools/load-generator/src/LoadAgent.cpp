@@ -0,0 +1,711 @@
+//
+//  LoadAgent.cpp
+//  tools/load-generator/src
+//
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "LoadAgent.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+
+#include <QDataStream>
+#include <QThread>
+
+#include <glm/gtc/constants.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+#include <AudioConstants.h>
+#include <AudioStreamStats.h>
+#include <AvatarHashMap.h>
+#include <NetworkPeer.h>
+#include <NLPacket.h>
+#include <NodeList.h>
+#include <PositionalAudioStream.h>
+#include <SharedUtil.h>
+#include <shared/ConicalViewFrustum.h>
+#include <udt/PacketHeaders.h>
+
+using namespace std::chrono;
+
+static const float MIN_RADIUS = 1.0f;                   // meters
+static const float RADIUS_SPACING = 0.1f;               // meters
+static const float MOTION_PERIOD_SECS = 10.0f;          // time to walk once around the circle
+static const float VIEW_RADIUS = 1000.0f;               // meters, the agents see every other agent
+
+static const float TONE_FREQUENCY = 300.0f;             // Hz, raised by a step for each agent
+static const float TONE_FREQUENCY_STEP = 50.0f;         // Hz
+static const float TONE_AMPLITUDE = 0.25f * AudioConstants::MAX_SAMPLE_VALUE;
+static const int SILENCE_THRESHOLD = 64;                // peak below which a mixed frame counts as silent
+
+static const quint64 AVATAR_QUERY_INTERVAL_USECS = 100 * USECS_PER_MSEC;
+static const quint64 NEGOTIATE_INTERVAL_USECS = USECS_PER_SECOND;
+static const int MAX_PENDING_CHECK_INS = 5;             // unanswered check-ins before reconnecting
+static const quint64 MAX_FRAMES_BEHIND = 10;            // frames to catch up on after a stall, the rest are skipped
+static const int MAX_SEQUENCE_GAP = 1000;               // larger gaps are late or repeated frames, not losses
+static const float JITTER_SMOOTHING = 1.0f / 16.0f;     // same as RFC 3550
+
+// An avatar whose global position can be set without a physics model
+class LoadAvatar : public AvatarData {
+public:
+    void setGlobalPosition(const glm::vec3& position) {
+        _globalPosition = position;
+        setWorldPosition(position);
+    }
+};
+
+int LoadScript::getTurn(quint64 usecs) const {
+    if (usecs < startUsecs) {
+        return -1;
+    }
+    return (int)((usecs - startUsecs) / turnUsecs);
+}
+
+quint64 LoadScript::getSpeechOnset(int turn) const {
+    return startUsecs + turn * turnUsecs + pauseUsecs;
+}
+
+bool LoadScript::isTalking(int agentIndex, quint64 usecs) const {
+    int turn = getTurn(usecs);
+    if (turn < 0 || usecs < getSpeechOnset(turn) || numAgents == 0) {
+        return false;
+    }
+
+    // the talkers take turns in order
+    int firstTalker = (turn * numTalkers) % numAgents;
+    int offset = (agentIndex - firstTalker + numAgents) % numAgents;
+    return offset < numTalkers;
+}
+
+glm::vec3 LoadScript::getPosition(int agentIndex, quint64 usecs) const {
+    usecs = std::max(usecs, startUsecs);
+    float secs = (float)((usecs - startUsecs) % (quint64)(MOTION_PERIOD_SECS * USECS_PER_SECOND)) / USECS_PER_SECOND;
+    float angle = glm::two_pi<float>() * secs / MOTION_PERIOD_SECS;
+    float radius = MIN_RADIUS + RADIUS_SPACING * agentIndex;
+    return glm::vec3(radius * cosf(angle), 0.0f, radius * sinf(angle));
+}
+
+float LoadScript::getMotionAge(const glm::vec3& position, quint64 usecs) const {
+    if (usecs < startUsecs || glm::length(position) < MIN_RADIUS * 0.5f) {
+        return -1.0f;
+    }
+
+    // the time within the period at which any agent was at this angle
+    float angle = atan2f(position.z, position.x);
+    if (angle < 0.0f) {
+        angle += glm::two_pi<float>();
+    }
+    float thenSecs = angle / glm::two_pi<float>() * MOTION_PERIOD_SECS;
+    float nowSecs = (float)((usecs - startUsecs) % (quint64)(MOTION_PERIOD_SECS * USECS_PER_SECOND)) / USECS_PER_SECOND;
+
+    float age = nowSecs - thenSecs;
+    if (age < 0.0f) {
+        age += MOTION_PERIOD_SECS;
+    }
+    return age;
+}
+
+LoadAgent::LoadAgent(int index, const LoadScript& script, LoadStats& stats, const SockAddr& domainSockAddr) :
+    LimitedNodeList(0),
+    _index(index),
+    _script(script),
+    _stats(stats),
+    _phaseUsecs((quint64)index * AudioConstants::NETWORK_FRAME_USECS / std::max(script.numAgents, 1)),
+    _domainSockAddr(domainSockAddr),
+    _machineFingerprint(QUuid::createUuid()),
+    _checkInTimer(this),
+    _frameTimer(this)
+{
+    auto& packetReceiver = getPacketReceiver();
+    packetReceiver.registerListener(PacketType::DomainList,
+        PacketReceiver::makeUnsourcedListenerReference<LoadAgent>(this, &LoadAgent::processDomainList));
+    packetReceiver.registerListener(PacketType::DomainServerAddedNode,
+        PacketReceiver::makeUnsourcedListenerReference<LoadAgent>(this, &LoadAgent::processDomainServerAddedNode));
+    packetReceiver.registerListener(PacketType::DomainServerRemovedNode,
+        PacketReceiver::makeUnsourcedListenerReference<LoadAgent>(this, &LoadAgent::processDomainServerRemovedNode));
+    packetReceiver.registerListener(PacketType::DomainConnectionDenied,
+        PacketReceiver::makeUnsourcedListenerReference<LoadAgent>(this, &LoadAgent::processDomainConnectionDenied));
+
+    packetReceiver.registerListener(PacketType::Ping,
+        PacketReceiver::makeSourcedListenerReference<LoadAgent>(this, &LoadAgent::processPingPacket));
+    packetReceiver.registerListener(PacketType::PingReply,
+        PacketReceiver::makeSourcedListenerReference<LoadAgent>(this, &LoadAgent::processPingReplyPacket));
+
+    packetReceiver.registerListener(PacketType::SelectedAudioFormat,
+        PacketReceiver::makeSourcedListenerReference<LoadAgent>(this, &LoadAgent::processSelectedAudioFormat));
+    packetReceiver.registerListenerForTypes({ PacketType::MixedAudio, PacketType::SilentAudioFrame },
+        PacketReceiver::makeSourcedListenerReference<LoadAgent>(this, &LoadAgent::processMixedAudio));
+    packetReceiver.registerListener(PacketType::AudioStreamStats,
+        PacketReceiver::makeSourcedListenerReference<LoadAgent>(this, &LoadAgent::processAudioStreamStats));
+    packetReceiver.registerListener(PacketType::BulkAvatarData,
+        PacketReceiver::makeSourcedListenerReference<LoadAgent>(this, &LoadAgent::processBulkAvatarData));
+    packetReceiver.registerListener(PacketType::KillAvatar,
+        PacketReceiver::makeSourcedListenerReference<LoadAgent>(this, &LoadAgent::processKillAvatar));
+
+    // the rest of what the mixers send to clients
+    packetReceiver.registerListenerForTypes({ PacketType::AudioEnvironment, PacketType::NoisyMute,
+                                              PacketType::MuteEnvironment, PacketType::AvatarIdentity,
+                                              PacketType::BulkAvatarTraits },
+        PacketReceiver::makeSourcedListenerReference<LoadAgent>(this, &LoadAgent::ignorePacket));
+
+    connect(this, &LimitedNodeList::nodeKilled, this, &LoadAgent::handleNodeKilled);
+
+    connect(&_checkInTimer, &QTimer::timeout, this, &LoadAgent::sendDomainServerCheckIn);
+    connect(&_frameTimer, &QTimer::timeout, this, &LoadAgent::sendFrames);
+}
+
+LoadAgent::~LoadAgent() {
+    if (_isConnected) {
+        _stats.agentDisconnected();
+    }
+}
+
+void LoadAgent::start() {
+    // created here so that it lives on the thread of the agent
+    _avatar = std::make_shared<LoadAvatar>();
+    _avatar->setGlobalPosition(_script.getPosition(_index, usecTimestampNow()));
+
+    _checkInTimer.start(DOMAIN_SERVER_CHECK_IN_MSECS);
+    sendDomainServerCheckIn();
+
+    // wake up often enough to send every frame close to its time
+    _frameTimer.setTimerType(Qt::PreciseTimer);
+    _frameTimer.start((int)(AudioConstants::NETWORK_FRAME_USECS / USECS_PER_MSEC / 2));
+}
+
+void LoadAgent::stop() {
+    _checkInTimer.stop();
+    _frameTimer.stop();
+
+    if (_isConnected) {
+        auto disconnectPacket = NLPacket::create(PacketType::DomainDisconnectRequest, 0);
+        sendUnreliablePacket(*disconnectPacket, _domainSockAddr);
+    }
+
+    // hand over the last frame
+    if (!_frameStats.isEmpty()) {
+        _stats.addFrame(_frame, _frameStats);
+        _frameStats = LoadFrameStats();
+    }
+}
+
+void LoadAgent::setIsConnected(bool isConnected) {
+    if (isConnected == _isConnected) {
+        return;
+    }
+    _isConnected = isConnected;
+
+    if (isConnected) {
+        _stats.agentConnected();
+    } else {
+        _stats.agentDisconnected();
+
+        // start over with a new session
+        _domainUUID = QUuid();
+        _domainLocalID = Node::NULL_LOCAL_ID;
+        _domainListAssembler.reset();
+        reset("Lost connection to the domain-server");
+        setSessionUUID(QUuid());
+        setSessionLocalID(Node::NULL_LOCAL_ID);
+    }
+}
+
+void LoadAgent::sendDomainServerCheckIn() {
+    if (_isConnected && _numPendingCheckIns >= MAX_PENDING_CHECK_INS) {
+        qWarning() << "Agent" << _index << "lost its connection to the domain-server, reconnecting";
+        setIsConnected(false);
+    }
+
+    PacketType packetType = _isConnected ? PacketType::DomainListRequest : PacketType::DomainConnectRequest;
+    auto domainPacket = NLPacket::create(packetType);
+    QDataStream packetStream(domainPacket.get());
+
+    // the domain-server reaches every agent on the loopback interface
+    SockAddr publicSockAddr(SocketType::UDP, QHostAddress::LocalHost, getSocketLocalPort(SocketType::UDP));
+    SockAddr localSockAddr = getLocalSockAddr().isNull() ? publicSockAddr : getLocalSockAddr();
+
+    if (packetType == PacketType::DomainConnectRequest) {
+        packetStream << QUuid();
+
+        QByteArray protocolVersionSig = protocolVersionsSignature();
+        packetStream.writeBytes(protocolVersionSig.constData(), protocolVersionSig.size());
+
+        // no hardware address or system info, and a fingerprint of our own so that the agents are separate machines
+        packetStream << QString() << _machineFingerprint << QByteArray();
+        packetStream << (quint32)LimitedNodeList::ConnectReason::Connect << (quint64)0;
+    }
+
+    packetStream << quint64(duration_cast<microseconds>(system_clock::now().time_since_epoch()).count());
+
+    QList<NodeType_t> nodeTypesOfInterest { NodeType::AudioMixer, NodeType::AvatarMixer };
+    packetStream << NodeType::Agent << publicSockAddr.getType() << publicSockAddr << localSockAddr.getType()
+        << localSockAddr << nodeTypesOfInterest;
+    packetStream << QString();
+
+    if (packetType == PacketType::DomainListRequest) {
+        packetStream << _domainListAssembler.getAckedVersion();
+    } else {
+        // no metaverse account and no username signature
+        packetStream << QString() << QString("");
+    }
+
+    ++_numPendingCheckIns;
+    sendPacket(std::move(domainPacket), _domainSockAddr);
+}
+
+void LoadAgent::processDomainList(QSharedPointer<ReceivedMessage> message) {
+    QDataStream packetStream(message->getMessage());
+
+    QUuid domainUUID;
+    Node::LocalID domainLocalID;
+    QUuid newUUID;
+    Node::LocalID newLocalID;
+    NodePermissions newPermissions;
+    bool isAuthenticated;
+    quint64 connectRequestTimestamp;
+    quint64 domainServerPingSendTime;
+    quint64 domainServerCheckinProcessingTime;
+    bool newConnection;
+    quint32 domainListVersion;
+    quint32 domainListBaseVersion;
+    quint32 numDomainListEntries;
+
+    packetStream >> domainUUID >> domainLocalID >> newUUID >> newLocalID >> newPermissions >> isAuthenticated
+        >> connectRequestTimestamp >> domainServerPingSendTime >> domainServerCheckinProcessingTime >> newConnection
+        >> domainListVersion >> domainListBaseVersion >> numDomainListEntries;
+
+    _numPendingCheckIns = 0;
+
+    if (_isConnected && (domainUUID != _domainUUID || newLocalID != getSessionLocalID() || newUUID != getSessionUUID())) {
+        // the domain-server restarted or forgot us, start over
+        setIsConnected(false);
+    }
+
+    if (!_isConnected) {
+        _domainUUID = domainUUID;
+        _domainLocalID = domainLocalID;
+        setSessionLocalID(newLocalID);
+        setSessionUUID(newUUID);
+        setIsConnected(true);
+    }
+
+    setPermissions(newPermissions);
+    setAuthenticatePackets(isAuthenticated);
+
+    // the same bookkeeping as NodeList, for lists of changes that come in several packets
+    _domainListAssembler.beginPacket(domainListVersion, domainListBaseVersion, numDomainListEntries);
+
+    while (packetStream.device()->pos() < message->getSize()) {
+        bool isRemoved;
+        packetStream >> isRemoved;
+        if (isRemoved) {
+            QUuid nodeUUID;
+            packetStream >> nodeUUID;
+            killNodeWithUUID(nodeUUID);
+            removeDelayedAdd(nodeUUID);
+            _domainListAssembler.addEntry(nodeUUID, true);
+        } else {
+            _domainListAssembler.addEntry(parseNodeFromPacketStream(packetStream), false);
+        }
+    }
+
+    _domainListAssembler.endPacket();
+}
+
+void LoadAgent::processDomainServerAddedNode(QSharedPointer<ReceivedMessage> message) {
+    QDataStream packetStream(message->getMessage());
+    parseNodeFromPacketStream(packetStream);
+}
+
+void LoadAgent::processDomainServerRemovedNode(QSharedPointer<ReceivedMessage> message) {
+    QUuid nodeUUID = QUuid::fromRfc4122(message->readWithoutCopy(NUM_BYTES_RFC4122_UUID));
+    killNodeWithUUID(nodeUUID);
+    removeDelayedAdd(nodeUUID);
+}
+
+void LoadAgent::processDomainConnectionDenied(QSharedPointer<ReceivedMessage> message) {
+    quint8 reasonCode;
+    message->readPrimitive(&reasonCode);
+
+    quint16 reasonSize;
+    message->readPrimitive(&reasonSize);
+    QString reason = QString::fromUtf8(message->readWithoutCopy(reasonSize));
+
+    stop();
+    emit connectionDenied(_index, reason);
+}
+
+QUuid LoadAgent::parseNodeFromPacketStream(QDataStream& packetStream) {
+    NewNodeInfo info;
+
+    SocketType publicSocketType, localSocketType;
+    packetStream >> info.type
+                 >> info.uuid
+                 >> publicSocketType
+                 >> info.publicSocket
+                 >> localSocketType
+                 >> info.localSocket
+                 >> info.permissions
+                 >> info.isReplicated
+                 >> info.sessionLocalID
+                 >> info.connectionSecretUUID;
+    info.publicSocket.setType(publicSocketType);
+    info.localSocket.setType(localSocketType);
+
+    // if the public socket address is 0 then it's reachable at the same IP as the domain server
+    if (info.publicSocket.getAddress().isNull()) {
+        info.publicSocket.setAddress(_domainSockAddr.getAddress());
+    }
+
+    addNewNode(info);
+
+    return info.uuid;
+}
+
+void LoadAgent::processPingPacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer sendingNode) {
+    auto replyPacket = constructPingReplyPacket(*message);
+    sendPacket(std::move(replyPacket), *sendingNode, message->getSenderSockAddr());
+}
+
+void LoadAgent::processPingReplyPacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer sendingNode) {
+    // the same as NodeList, activate the socket that the reply came back on
+    quint8 pingType;
+    message->readPrimitive(&pingType);
+
+    if (pingType == PingType::Local && sendingNode->getActiveSocket() != &sendingNode->getLocalSocket()) {
+        sendingNode->activateLocalSocket();
+    } else if (pingType == PingType::Public && !sendingNode->getActiveSocket()) {
+        sendingNode->activatePublicSocket();
+    } else if (pingType == PingType::Symmetric && !sendingNode->getActiveSocket()) {
+        sendingNode->activateSymmetricSocket();
+    }
+}
+
+void LoadAgent::punchInactiveNodes(quint64 now) {
+    if (now - _lastPunchUsecs < UDP_PUNCH_PING_INTERVAL_MS * USECS_PER_MSEC) {
+        return;
+    }
+    _lastPunchUsecs = now;
+
+    eachNode([&](const SharedNodePointer& node) {
+        if (!node->getActiveSocket()) {
+            sendPacket(constructPingPacket(node->getUUID(), PingType::Local), *node, node->getLocalSocket());
+            sendPacket(constructPingPacket(node->getUUID(), PingType::Public), *node, node->getPublicSocket());
+        }
+    });
+}
+
+void LoadAgent::handleNodeKilled(SharedNodePointer node) {
+    if (node->getType() == NodeType::AudioMixer) {
+        _hasSelectedCodec = false;
+        _hasMixedSequence = false;
+    } else if (node->getType() == NodeType::AvatarMixer) {
+        _otherAvatars.clear();
+    }
+}
+
+void LoadAgent::negotiateAudioFormat(const SharedNodePointer& audioMixer) {
+    // the agents only speak PCM
+    auto negotiateFormatPacket = NLPacket::create(PacketType::NegotiateAudioFormat);
+    quint8 numberOfCodecs = 1;
+    negotiateFormatPacket->writePrimitive(numberOfCodecs);
+    negotiateFormatPacket->writeString(QString("pcm"));
+    sendPacket(std::move(negotiateFormatPacket), *audioMixer);
+}
+
+void LoadAgent::processSelectedAudioFormat(QSharedPointer<ReceivedMessage> message, SharedNodePointer sendingNode) {
+    _selectedCodecName = message->readString();
+
+    // no codec, or PCM, both send the samples as they are
+    if (!_selectedCodecName.isEmpty() && _selectedCodecName != "pcm") {
+        qWarning() << "Agent" << _index << "can't send audio with codec" << _selectedCodecName;
+        return;
+    }
+    _hasSelectedCodec = true;
+}
+
+void LoadAgent::sendFrames() {
+    quint64 now = usecTimestampNow();
+    if (now < _script.startUsecs + _phaseUsecs) {
+        return;
+    }
+    quint64 elapsedUsecs = now - _script.startUsecs - _phaseUsecs;
+
+    // keep the frame stats current even when nothing arrives
+    frameStats(now);
+
+    punchInactiveNodes(now);
+
+    SharedNodePointer audioMixer = soloNodeOfType(NodeType::AudioMixer);
+    SharedNodePointer avatarMixer = soloNodeOfType(NodeType::AvatarMixer);
+
+    // audio, one frame every network frame, from its scheduled time so that the speech starts on time
+    quint64 numAudioFrames = elapsedUsecs / AudioConstants::NETWORK_FRAME_USECS + 1;
+    if (numAudioFrames - _numAudioFrames > MAX_FRAMES_BEHIND) {
+        _numAudioFrames = numAudioFrames - MAX_FRAMES_BEHIND;
+    }
+    for (; _numAudioFrames < numAudioFrames; ++_numAudioFrames) {
+        if (audioMixer && audioMixer->getActiveSocket()) {
+            if (_hasSelectedCodec) {
+                quint64 frameUsecs = _script.startUsecs + _phaseUsecs + _numAudioFrames * AudioConstants::NETWORK_FRAME_USECS;
+                sendAudioFrame(audioMixer, frameUsecs);
+            } else if (now - _lastNegotiateUsecs > NEGOTIATE_INTERVAL_USECS) {
+                _lastNegotiateUsecs = now;
+                negotiateAudioFormat(audioMixer);
+            }
+        }
+    }
+
+    // avatar data at the same rate as the interface, and avatar queries
+    _avatar->setGlobalPosition(_script.getPosition(_index, now));
+    if (avatarMixer && avatarMixer->getActiveSocket()) {
+        quint64 numAvatarFrames = elapsedUsecs / MIN_TIME_BETWEEN_MY_AVATAR_DATA_SENDS + 1;
+        if (numAvatarFrames > _numAvatarFrames) {
+            _numAvatarFrames = numAvatarFrames;
+            sendAvatarFrame(avatarMixer, now);
+        }
+
+        quint64 numAvatarQueries = elapsedUsecs / AVATAR_QUERY_INTERVAL_USECS + 1;
+        if (numAvatarQueries > _numAvatarQueries) {
+            _numAvatarQueries = numAvatarQueries;
+            sendAvatarQuery(avatarMixer);
+        }
+    }
+}
+
+void LoadAgent::sendAudioFrame(const SharedNodePointer& audioMixer, quint64 frameUsecs) {
+    bool isTalking = _script.isTalking(_index, frameUsecs);
+    PacketType packetType = isTalking ? PacketType::MicrophoneAudioNoEcho : PacketType::SilentAudioFrame;
+
+    // the same layout as AbstractAudioInterface::emitAudioPacket()
+    auto audioPacket = NLPacket::create(packetType);
+    audioPacket->writePrimitive(_audioSequence++);
+    audioPacket->writeString(_selectedCodecName);
+
+    if (isTalking) {
+        quint8 channelFlag = 0;
+        audioPacket->writePrimitive(channelFlag);
+    } else {
+        quint16 numSilentSamples = AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL;
+        audioPacket->writePrimitive(numSilentSamples);
+    }
+
+    glm::vec3 position = _avatar->getClientGlobalPosition();
+    glm::quat orientation;
+    glm::vec3 boundingBoxScale(0.5f, 1.8f, 0.5f);
+    glm::vec3 boundingBoxCorner = position - 0.5f * boundingBoxScale;
+    audioPacket->writePrimitive(position);
+    audioPacket->writePrimitive(orientation);
+    audioPacket->writePrimitive(boundingBoxCorner);
+    audioPacket->writePrimitive(boundingBoxScale);
+
+    if (isTalking) {
+        // a tone of this agent's own pitch
+        int16_t samples[AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL];
+        double phaseStep = glm::two_pi<double>() * (TONE_FREQUENCY + TONE_FREQUENCY_STEP * (_index % 8)) /
+            AudioConstants::SAMPLE_RATE;
+        for (int i = 0; i < AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL; i++) {
+            samples[i] = (int16_t)(TONE_AMPLITUDE * sin(_tonePhase));
+            _tonePhase += phaseStep;
+        }
+        _tonePhase = fmod(_tonePhase, glm::two_pi<double>());
+        audioPacket->write(reinterpret_cast<const char*>(samples), sizeof(samples));
+    }
+
+    sendUnreliablePacket(*audioPacket, *audioMixer);
+    frameStats(usecTimestampNow()).audioSent++;
+}
+
+void LoadAgent::sendAvatarFrame(const SharedNodePointer& avatarMixer, quint64 now) {
+    // the same as AvatarData::sendAvatarDataPacket(), which only sends to the NodeList
+    bool cullSmallData = (randFloat() < AVATAR_SEND_FULL_UPDATE_RATIO);
+    auto dataDetail = cullSmallData ? AvatarData::SendAllData : AvatarData::CullSmallData;
+    QByteArray avatarByteArray = _avatar->toByteArrayStateful(dataDetail);
+    _avatar->doneEncoding(cullSmallData);
+
+    auto avatarPacket = NLPacket::create(PacketType::AvatarData, avatarByteArray.size() + sizeof(_avatarSequence));
+    avatarPacket->writePrimitive(_avatarSequence++);
+    avatarPacket->write(avatarByteArray);
+
+    sendUnreliablePacket(*avatarPacket, *avatarMixer);
+    frameStats(now).avatarSent++;
+}
+
+void LoadAgent::sendAvatarQuery(const SharedNodePointer& avatarMixer) {
+    ConicalViewFrustum view;
+    view.setPositionAndSimpleRadius(_avatar->getClientGlobalPosition(), VIEW_RADIUS);
+
+    auto avatarPacket = NLPacket::create(PacketType::AvatarQuery);
+    auto destinationBuffer = reinterpret_cast<unsigned char*>(avatarPacket->getPayload());
+    unsigned char* bufferStart = destinationBuffer;
+
+    uint8_t numFrustums = 1;
+    memcpy(destinationBuffer, &numFrustums, sizeof(numFrustums));
+    destinationBuffer += sizeof(numFrustums);
+    destinationBuffer += view.serialize(destinationBuffer);
+
+    avatarPacket->setPayloadSize(destinationBuffer - bufferStart);
+    sendUnreliablePacket(*avatarPacket, *avatarMixer);
+}
+
+void LoadAgent::processMixedAudio(QSharedPointer<ReceivedMessage> message, SharedNodePointer sendingNode) {
+    quint64 now = usecTimestampNow();
+    LoadFrameStats& stats = frameStats(now);
+
+    quint16 sequence;
+    message->readPrimitive(&sequence);
+    QString codecName = message->readString();
+
+    // check the size and look for the speech of the talkers
+    bool isValid;
+    bool isSilent = true;
+    if (message->getType() == PacketType::MixedAudio) {
+        isValid = message->getBytesLeftToRead() == AudioConstants::NETWORK_FRAME_BYTES_STEREO;
+        if (isValid) {
+            QByteArray audio = message->readWithoutCopy(AudioConstants::NETWORK_FRAME_BYTES_STEREO);
+            auto samples = reinterpret_cast<const int16_t*>(audio.constData());
+            for (int i = 0; i < AudioConstants::NETWORK_FRAME_SAMPLES_STEREO && isSilent; i++) {
+                isSilent = std::abs(samples[i]) < SILENCE_THRESHOLD;
+            }
+        }
+    } else {
+        quint16 numSilentSamples;
+        message->readPrimitive(&numSilentSamples);
+        isValid = numSilentSamples == AudioConstants::NETWORK_FRAME_SAMPLES_STEREO;
+    }
+
+    if (!isValid) {
+        stats.audioInvalid++;
+        return;
+    }
+    stats.audioReceived++;
+    if (isSilent) {
+        stats.audioSilent++;
+    }
+
+    // losses and jitter, by the sequence numbers and the time between frames
+    if (_hasMixedSequence) {
+        quint16 gap = sequence - _lastMixedSequence;
+        if (gap == 0 || gap > MAX_SEQUENCE_GAP) {
+            // a repeated or late frame
+            return;
+        }
+        stats.audioLost += gap - 1;
+
+        float expectedMsecs = gap * AudioConstants::NETWORK_FRAME_MSECS;
+        float arrivalMsecs = (float)(now - _lastMixedUsecs) / USECS_PER_MSEC;
+        _jitterMsecs += (fabsf(arrivalMsecs - expectedMsecs) - _jitterMsecs) * JITTER_SMOOTHING;
+        stats.audioJitterSum += _jitterMsecs;
+        stats.audioJitterCount++;
+    }
+    _hasMixedSequence = true;
+    _lastMixedSequence = sequence;
+    _lastMixedUsecs = now;
+
+    // latency, from the scheduled start of the speech to the first frame of it that comes back
+    int turn = _script.getTurn(now);
+    if (!isSilent && turn >= 0 && turn != _lastHeardTurn && now >= _script.getSpeechOnset(turn)) {
+        _lastHeardTurn = turn;
+        float latencyMsecs = (float)(now - _script.getSpeechOnset(turn)) / USECS_PER_MSEC;
+        stats.audioLatencySum += latencyMsecs;
+        stats.audioLatencyMax = std::max(stats.audioLatencyMax, latencyMsecs);
+        stats.audioLatencyCount++;
+    }
+}
+
+void LoadAgent::processAudioStreamStats(QSharedPointer<ReceivedMessage> message, SharedNodePointer sendingNode) {
+    LoadFrameStats& stats = frameStats(usecTimestampNow());
+
+    quint8 appendFlag;
+    message->readPrimitive(&appendFlag);
+    quint16 numStreamStats;
+    message->readPrimitive(&numStreamStats);
+
+    // only the mixer's view of this agent's microphone stream
+    AudioStreamStats streamStats;
+    for (quint16 i = 0; i < numStreamStats; i++) {
+        if (message->readPrimitive(&streamStats) != (qint64)sizeof(streamStats)) {
+            break;
+        }
+        if (streamStats._streamType == PositionalAudioStream::Microphone) {
+            stats.mixerTimeGapSum += streamStats._timeGapWindowAverage / USECS_PER_MSEC;
+            stats.mixerFramesAvailableSum += streamStats._framesAvailableAverage;
+            stats.mixerDesiredFramesSum += streamStats._desiredJitterBufferFrames;
+            stats.mixerStatsCount++;
+
+            // the counts are totals for the stream
+            if (streamStats._starveCount >= _lastStarveCount) {
+                stats.mixerStarves += streamStats._starveCount - _lastStarveCount;
+            }
+            if (streamStats._framesDropped >= _lastFramesDropped) {
+                stats.mixerDropped += streamStats._framesDropped - _lastFramesDropped;
+            }
+            _lastStarveCount = streamStats._starveCount;
+            _lastFramesDropped = streamStats._framesDropped;
+        }
+    }
+}
+
+void LoadAgent::processBulkAvatarData(QSharedPointer<ReceivedMessage> message, SharedNodePointer sendingNode) {
+    quint64 now = usecTimestampNow();
+    LoadFrameStats& stats = frameStats(now);
+
+    // the same as AvatarHashMap::parseAvatarData(), with an avatar for each of the other agents
+    while (message->getBytesLeftToRead() > NUM_BYTES_RFC4122_UUID) {
+        QUuid sessionUUID = QUuid::fromRfc4122(message->readWithoutCopy(NUM_BYTES_RFC4122_UUID));
+        int positionBeforeRead = message->getPosition();
+        QByteArray byteArray = message->readWithoutCopy(message->getBytesLeftToRead());
+
+        auto& avatar = _otherAvatars[sessionUUID];
+        if (!avatar) {
+            avatar = std::make_shared<AvatarData>();
+        }
+
+        glm::vec3 lastPosition = avatar->getClientGlobalPosition();
+        int bytesRead = avatar->parseDataFromBuffer(byteArray);
+        if (bytesRead <= 0) {
+            stats.avatarReceived++;
+            break;
+        }
+        message->seek(positionBeforeRead + bytesRead);
+        stats.avatarReceived++;
+
+        // the agents only move in the script, so their position tells how old the update is
+        glm::vec3 position = avatar->getClientGlobalPosition();
+        if (position != lastPosition) {
+            float ageSecs = _script.getMotionAge(position, now);
+            if (ageSecs >= 0.0f) {
+                float latencyMsecs = ageSecs * MSECS_PER_SECOND;
+                stats.avatarLatencySum += latencyMsecs;
+                stats.avatarLatencyMax = std::max(stats.avatarLatencyMax, latencyMsecs);
+                stats.avatarLatencyCount++;
+            }
+        }
+    }
+}
+
+void LoadAgent::processKillAvatar(QSharedPointer<ReceivedMessage> message, SharedNodePointer sendingNode) {
+    QUuid sessionUUID = QUuid::fromRfc4122(message->readWithoutCopy(NUM_BYTES_RFC4122_UUID));
+    _otherAvatars.remove(sessionUUID);
+}
+
+void LoadAgent::ignorePacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer sendingNode) {
+}
+
+LoadFrameStats& LoadAgent::frameStats(quint64 now) {
+    int frame = _stats.frameForTime(now);
+    if (frame != _frame) {
+        if (!_frameStats.isEmpty()) {
+            _stats.addFrame(_frame, _frameStats);
+        }
+        _frame = frame;
+        _frameStats = LoadFrameStats();
+    }
+    return _frameStats;
+}
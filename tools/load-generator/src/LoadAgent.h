@@ -0,0 +1,156 @@
+//
+//  LoadAgent.h
+//  tools/load-generator/src
+//
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_LoadAgent_h
+#define hifi_LoadAgent_h
+
+#include <memory>
+
+#include <QHash>
+#include <QTimer>
+
+#include <glm/glm.hpp>
+
+#include <AvatarData.h>
+#include <DomainListAssembler.h>
+#include <LimitedNodeList.h>
+#include <NumericalConstants.h>
+#include <ReceivedMessage.h>
+
+#include "LoadStats.h"
+
+class LoadAvatar;
+
+// The motion and speech that every agent follows, timed from the same start so that the agents can tell how late the
+// mixed audio and avatar data they receive is without sending any timestamps.
+//
+// The agents walk around a common center on circles of different radii, all at the same angle. Each turn starts with
+// a pause, then the talkers of that turn speak until the turn ends.
+struct LoadScript {
+    quint64 startUsecs { 0 };
+    int numAgents { 0 };
+    int numTalkers { 1 };
+    quint64 turnUsecs { 3 * USECS_PER_SECOND };
+    quint64 pauseUsecs { USECS_PER_SECOND };
+
+    int getTurn(quint64 usecs) const;
+    quint64 getSpeechOnset(int turn) const;
+    bool isTalking(int agentIndex, quint64 usecs) const;
+
+    glm::vec3 getPosition(int agentIndex, quint64 usecs) const;
+    // how long ago an agent was at the given position, or a negative value if not known
+    float getMotionAge(const glm::vec3& position, quint64 usecs) const;
+};
+
+// One fake client of the domain. Each agent is its own node list, with its own socket and session, so that a single
+// process can load the mixers with many clients. It checks in with the domain-server, sends microphone audio, avatar
+// data and avatar queries by the script, and checks the mixed audio and avatar data that the mixers send back.
+class LoadAgent : public LimitedNodeList {
+    Q_OBJECT
+public:
+    LoadAgent(int index, const LoadScript& script, LoadStats& stats, const SockAddr& domainSockAddr);
+    ~LoadAgent();
+
+    bool isDomainServer() const override { return false; }
+    QUuid getDomainUUID() const override { return _domainUUID; }
+    Node::LocalID getDomainLocalID() const override { return _domainLocalID; }
+    SockAddr getDomainSockAddr() const override { return _domainSockAddr; }
+
+public slots:
+    void start();
+    void stop();
+
+signals:
+    void connectionDenied(int index, const QString& reason);
+
+private slots:
+    void sendDomainServerCheckIn();
+    void sendFrames();
+
+    void processDomainList(QSharedPointer<ReceivedMessage> message);
+    void processDomainServerAddedNode(QSharedPointer<ReceivedMessage> message);
+    void processDomainServerRemovedNode(QSharedPointer<ReceivedMessage> message);
+    void processDomainConnectionDenied(QSharedPointer<ReceivedMessage> message);
+
+    void processPingPacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer sendingNode);
+    void processPingReplyPacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer sendingNode);
+
+    void processSelectedAudioFormat(QSharedPointer<ReceivedMessage> message, SharedNodePointer sendingNode);
+    void processMixedAudio(QSharedPointer<ReceivedMessage> message, SharedNodePointer sendingNode);
+    void processAudioStreamStats(QSharedPointer<ReceivedMessage> message, SharedNodePointer sendingNode);
+    void processBulkAvatarData(QSharedPointer<ReceivedMessage> message, SharedNodePointer sendingNode);
+    void processKillAvatar(QSharedPointer<ReceivedMessage> message, SharedNodePointer sendingNode);
+    void ignorePacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer sendingNode);
+
+    void handleNodeKilled(SharedNodePointer node);
+
+private:
+    QUuid parseNodeFromPacketStream(QDataStream& packetStream);
+    void setIsConnected(bool isConnected);
+
+    void punchInactiveNodes(quint64 now);
+    void sendAudioFrame(const SharedNodePointer& audioMixer, quint64 frameUsecs);
+    void sendAvatarFrame(const SharedNodePointer& avatarMixer, quint64 now);
+    void sendAvatarQuery(const SharedNodePointer& avatarMixer);
+    void negotiateAudioFormat(const SharedNodePointer& audioMixer);
+
+    // adds to the stats of the current frame, handing the last frame over when it has ended
+    LoadFrameStats& frameStats(quint64 now);
+
+    const int _index;
+    const LoadScript& _script;
+    LoadStats& _stats;
+
+    // offset of this agent's frames, so that the agents don't all send at once
+    const quint64 _phaseUsecs;
+
+    SockAddr _domainSockAddr;
+    QUuid _domainUUID;
+    Node::LocalID _domainLocalID { Node::NULL_LOCAL_ID };
+    QUuid _machineFingerprint;
+    bool _isConnected { false };
+    int _numPendingCheckIns { 0 };
+
+    DomainListAssembler _domainListAssembler;
+
+    QTimer _checkInTimer;
+    QTimer _frameTimer;
+    quint64 _lastPunchUsecs { 0 };
+    quint64 _lastNegotiateUsecs { 0 };
+
+    // sending
+    QString _selectedCodecName;
+    bool _hasSelectedCodec { false };
+    quint16 _audioSequence { 0 };
+    quint64 _numAudioFrames { 0 };
+    double _tonePhase { 0.0 };
+
+    std::shared_ptr<LoadAvatar> _avatar;
+    AvatarDataSequenceNumber _avatarSequence { 0 };
+    quint64 _numAvatarFrames { 0 };
+    quint64 _numAvatarQueries { 0 };
+
+    // receiving
+    bool _hasMixedSequence { false };
+    quint16 _lastMixedSequence { 0 };
+    quint64 _lastMixedUsecs { 0 };
+    float _jitterMsecs { 0.0f };
+    int _lastHeardTurn { -1 };
+
+    QHash<QUuid, AvatarSharedPointer> _otherAvatars;
+
+    quint32 _lastStarveCount { 0 };
+    quint32 _lastFramesDropped { 0 };
+
+    int _frame { 0 };
+    LoadFrameStats _frameStats;
+};
+
+#endif // hifi_LoadAgent_h
@@ -0,0 +1,204 @@
+//
+//  LoadGeneratorApp.cpp
+//  tools/load-generator/src
+//
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "LoadGeneratorApp.h"
+
+#include <algorithm>
+
+#include <QCommandLineParser>
+#include <QLoggingCategory>
+
+#include <AudioLogging.h>
+#include <AvatarLogging.h>
+#include <DomainHandler.h>
+#include <NetworkLogging.h>
+#include <SharedLogging.h>
+#include <SharedUtil.h>
+
+static const int DEFAULT_NUM_AGENTS = 10;
+static const int DEFAULT_DURATION_SECS = 60;
+static const int FLUSH_INTERVAL_MSECS = 100;
+static const int STATUS_INTERVAL_MSECS = 5000;
+
+LoadGeneratorApp::LoadGeneratorApp(int argc, char* argv[]) :
+    QCoreApplication(argc, argv)
+{
+    // parse command-line
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Load generator for the audio and avatar mixers");
+
+    const QCommandLineOption helpOption = parser.addHelpOption();
+
+    const QCommandLineOption verboseOutput("v", "verbose output");
+    parser.addOption(verboseOutput);
+
+    const QCommandLineOption domainAddressOption("d", "domain-server address", "127.0.0.1");
+    parser.addOption(domainAddressOption);
+
+    const QCommandLineOption numAgentsOption("n", "number of agents", QString::number(DEFAULT_NUM_AGENTS));
+    parser.addOption(numAgentsOption);
+
+    const QCommandLineOption numTalkersOption("t", "number of agents that talk at once", "1");
+    parser.addOption(numTalkersOption);
+
+    const QCommandLineOption numThreadsOption("threads", "number of threads for the agents",
+                                              QString::number(QThread::idealThreadCount()));
+    parser.addOption(numThreadsOption);
+
+    const QCommandLineOption durationOption("duration", "seconds to run for, 0 to run until stopped",
+                                            QString::number(DEFAULT_DURATION_SECS));
+    parser.addOption(durationOption);
+
+    const QCommandLineOption outputOption("o", "CSV file of the per-frame stats", "load-generator.csv");
+    parser.addOption(outputOption);
+
+    if (!parser.parse(QCoreApplication::arguments())) {
+        qCritical() << parser.errorText() << Qt::endl;
+        parser.showHelp();
+        Q_UNREACHABLE();
+    }
+
+    if (parser.isSet(helpOption)) {
+        parser.showHelp();
+        Q_UNREACHABLE();
+    }
+
+    if (!parser.isSet(verboseOutput)) {
+        QLoggingCategory::setFilterRules("qt.network.ssl.warning=false");
+
+        const_cast<QLoggingCategory*>(&networking())->setEnabled(QtDebugMsg, false);
+        const_cast<QLoggingCategory*>(&networking())->setEnabled(QtInfoMsg, false);
+        const_cast<QLoggingCategory*>(&networking())->setEnabled(QtWarningMsg, false);
+
+        const_cast<QLoggingCategory*>(&shared())->setEnabled(QtDebugMsg, false);
+        const_cast<QLoggingCategory*>(&shared())->setEnabled(QtInfoMsg, false);
+        const_cast<QLoggingCategory*>(&shared())->setEnabled(QtWarningMsg, false);
+
+        const_cast<QLoggingCategory*>(&audio())->setEnabled(QtDebugMsg, false);
+        const_cast<QLoggingCategory*>(&avatars())->setEnabled(QtDebugMsg, false);
+    }
+
+    QString domainServerAddress = "127.0.0.1";
+    if (parser.isSet(domainAddressOption)) {
+        domainServerAddress = parser.value(domainAddressOption);
+    }
+
+    quint16 domainPort = DEFAULT_DOMAIN_SERVER_PORT;
+    QStringList addressPieces = domainServerAddress.split(":");
+    if (addressPieces.size() == 2) {
+        domainServerAddress = addressPieces[0];
+        domainPort = addressPieces[1].toUShort();
+    }
+    SockAddr domainSockAddr(SocketType::UDP, domainServerAddress, domainPort, true);
+    if (domainSockAddr.getAddress().isNull()) {
+        qCritical() << "Unable to look up the domain-server address" << domainServerAddress;
+        parser.showHelp();
+        Q_UNREACHABLE();
+    }
+
+    int numAgents = parser.value(numAgentsOption).toInt();
+    int numTalkers = parser.value(numTalkersOption).toInt();
+    int numThreads = parser.value(numThreadsOption).toInt();
+    int durationSecs = parser.value(durationOption).toInt();
+    if (numAgents < 1 || numTalkers < 0 || numThreads < 1 || durationSecs < 0) {
+        qCritical() << "The number of agents and threads must be positive";
+        parser.showHelp();
+        Q_UNREACHABLE();
+    }
+    numThreads = std::min(numThreads, numAgents);
+
+    // every agent follows the same script, from now
+    _script.startUsecs = usecTimestampNow();
+    _script.numAgents = numAgents;
+    _script.numTalkers = std::min(numTalkers, numAgents);
+
+    _stats = std::make_unique<LoadStats>(_script.startUsecs);
+    QString outputPath = parser.value(outputOption);
+    if (!_stats->open(outputPath)) {
+        qCritical() << "Unable to write to" << outputPath;
+        parser.showHelp();
+        Q_UNREACHABLE();
+    }
+
+    qInfo() << "Connecting" << numAgents << "agents on" << numThreads << "threads to" << domainSockAddr;
+
+    for (int i = 0; i < numThreads; i++) {
+        QThread* thread = new QThread(this);
+        thread->setObjectName(QString("Load Agents %1").arg(i));
+        thread->start();
+        _threads.push_back(thread);
+    }
+
+    // the agents are spread over the threads, each one started on its own thread
+    for (int i = 0; i < numAgents; i++) {
+        LoadAgent* agent = new LoadAgent(i, _script, *_stats, domainSockAddr);
+        agent->moveToThread(_threads[i % numThreads]);
+        connect(agent, &LoadAgent::connectionDenied, this, &LoadGeneratorApp::agentConnectionDenied);
+        QMetaObject::invokeMethod(agent, "start");
+        _agents.push_back(agent);
+    }
+
+    connect(&_flushTimer, &QTimer::timeout, this, &LoadGeneratorApp::flushStats);
+    _flushTimer.start(FLUSH_INTERVAL_MSECS);
+
+    connect(&_statusTimer, &QTimer::timeout, this, &LoadGeneratorApp::printStatus);
+    _statusTimer.start(STATUS_INTERVAL_MSECS);
+
+    if (durationSecs > 0) {
+        QTimer::singleShot((int)(durationSecs * MSECS_PER_SECOND), this, [this] {
+            finish(0);
+        });
+    }
+}
+
+LoadGeneratorApp::~LoadGeneratorApp() {
+    finish(0);
+}
+
+void LoadGeneratorApp::flushStats() {
+    _stats->flush(usecTimestampNow());
+}
+
+void LoadGeneratorApp::printStatus() {
+    qInfo() << _stats->getNumConnected() << "of" << _agents.size() << "agents connected";
+}
+
+void LoadGeneratorApp::agentConnectionDenied(int index, const QString& reason) {
+    qCritical() << "Agent" << index << "was refused by the domain-server:" << reason;
+    finish(1);
+}
+
+void LoadGeneratorApp::finish(int exitCode) {
+    if (_isFinished) {
+        return;
+    }
+    _isFinished = true;
+
+    _flushTimer.stop();
+    _statusTimer.stop();
+
+    // stop every agent on its own thread, so that its last frame is counted, and delete them when the threads end
+    for (auto agent : _agents) {
+        QMetaObject::invokeMethod(agent, "stop", Qt::BlockingQueuedConnection);
+        agent->deleteLater();
+    }
+    _agents.clear();
+
+    for (auto thread : _threads) {
+        thread->quit();
+        thread->wait();
+    }
+    _threads.clear();
+
+    _stats->close();
+    qInfo().noquote() << _stats->getSummary();
+
+    QCoreApplication::exit(exitCode);
+}
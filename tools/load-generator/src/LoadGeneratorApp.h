@@ -0,0 +1,51 @@
+//
+//  LoadGeneratorApp.h
+//  tools/load-generator/src
+//
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_LoadGeneratorApp_h
+#define hifi_LoadGeneratorApp_h
+
+#include <memory>
+
+#include <QCoreApplication>
+#include <QThread>
+#include <QTimer>
+#include <QVector>
+
+#include "LoadAgent.h"
+#include "LoadStats.h"
+
+// Connects a swarm of fake agents to a domain, so that the audio and avatar mixers can be benchmarked without running
+// any interface clients, and writes what the agents measure to a CSV file.
+class LoadGeneratorApp : public QCoreApplication {
+    Q_OBJECT
+public:
+    LoadGeneratorApp(int argc, char* argv[]);
+    ~LoadGeneratorApp();
+
+private slots:
+    void flushStats();
+    void printStatus();
+    void agentConnectionDenied(int index, const QString& reason);
+
+private:
+    void finish(int exitCode);
+
+    LoadScript _script;
+    std::unique_ptr<LoadStats> _stats;
+
+    QVector<QThread*> _threads;
+    QVector<LoadAgent*> _agents;
+
+    QTimer _flushTimer;
+    QTimer _statusTimer;
+    bool _isFinished { false };
+};
+
+#endif // hifi_LoadGeneratorApp_h
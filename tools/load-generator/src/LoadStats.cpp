@@ -0,0 +1,163 @@
+//
+//  LoadStats.cpp
+//  tools/load-generator/src
+//
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "LoadStats.h"
+
+#include <algorithm>
+
+#include <AudioConstants.h>
+
+// rows are written this many frames late, so that every agent has reported the frame
+static const int FLUSH_DELAY_FRAMES = 50;
+
+void LoadFrameStats::add(const LoadFrameStats& other) {
+    audioSent += other.audioSent;
+    avatarSent += other.avatarSent;
+
+    audioReceived += other.audioReceived;
+    audioSilent += other.audioSilent;
+    audioLost += other.audioLost;
+    audioInvalid += other.audioInvalid;
+    audioJitterSum += other.audioJitterSum;
+    audioJitterCount += other.audioJitterCount;
+    audioLatencySum += other.audioLatencySum;
+    audioLatencyMax = std::max(audioLatencyMax, other.audioLatencyMax);
+    audioLatencyCount += other.audioLatencyCount;
+
+    avatarReceived += other.avatarReceived;
+    avatarLatencySum += other.avatarLatencySum;
+    avatarLatencyMax = std::max(avatarLatencyMax, other.avatarLatencyMax);
+    avatarLatencyCount += other.avatarLatencyCount;
+
+    mixerTimeGapSum += other.mixerTimeGapSum;
+    mixerFramesAvailableSum += other.mixerFramesAvailableSum;
+    mixerDesiredFramesSum += other.mixerDesiredFramesSum;
+    mixerStatsCount += other.mixerStatsCount;
+    mixerStarves += other.mixerStarves;
+    mixerDropped += other.mixerDropped;
+}
+
+bool LoadFrameStats::isEmpty() const {
+    return audioSent == 0 && avatarSent == 0 && audioReceived == 0 && audioLost == 0 && audioInvalid == 0 &&
+        audioLatencyCount == 0 && avatarReceived == 0 && mixerStatsCount == 0;
+}
+
+int LoadStats::frameForTime(quint64 usecs) const {
+    if (usecs < _startUsecs) {
+        return 0;
+    }
+    return (int)((usecs - _startUsecs) / AudioConstants::NETWORK_FRAME_USECS);
+}
+
+void LoadStats::addFrame(int frame, const LoadFrameStats& stats) {
+    QMutexLocker locker(&_mutex);
+
+    // a frame that was already written only counts toward the totals
+    if (frame >= _nextRow) {
+        _frames[frame].add(stats);
+    }
+    _totals.add(stats);
+}
+
+bool LoadStats::open(const QString& path) {
+    _file.setFileName(path);
+    if (!_file.open(QIODevice::WriteOnly | QIODevice::Text | QIODevice::Truncate)) {
+        return false;
+    }
+    _stream.setDevice(&_file);
+
+    _stream << "frame,time_ms,agents,audio_sent,avatar_sent,"
+               "audio_received,audio_silent,audio_lost,audio_invalid,audio_jitter_ms,audio_latency_ms,audio_latency_max_ms,"
+               "avatar_received,avatar_latency_ms,avatar_latency_max_ms,"
+               "mixer_time_gap_ms,mixer_frames_available,mixer_desired_frames,mixer_starves,mixer_dropped\n";
+    return true;
+}
+
+// an empty cell when there is nothing to average
+static QString average(float sum, int count) {
+    return count > 0 ? QString::number(sum / count, 'f', 3) : QString();
+}
+
+void LoadStats::writeRow(int frame, const LoadFrameStats& stats) {
+    if (!_file.isOpen()) {
+        return;
+    }
+
+    float timeMsecs = frame * AudioConstants::NETWORK_FRAME_MSECS;
+
+    _stream << frame << ',' << QString::number(timeMsecs, 'f', 1) << ',' << _numConnected.load() << ','
+            << stats.audioSent << ',' << stats.avatarSent << ','
+            << stats.audioReceived << ',' << stats.audioSilent << ',' << stats.audioLost << ',' << stats.audioInvalid << ','
+            << average(stats.audioJitterSum, stats.audioJitterCount) << ','
+            << average(stats.audioLatencySum, stats.audioLatencyCount) << ','
+            << (stats.audioLatencyCount > 0 ? QString::number(stats.audioLatencyMax, 'f', 3) : QString()) << ','
+            << stats.avatarReceived << ','
+            << average(stats.avatarLatencySum, stats.avatarLatencyCount) << ','
+            << (stats.avatarLatencyCount > 0 ? QString::number(stats.avatarLatencyMax, 'f', 3) : QString()) << ','
+            << average(stats.mixerTimeGapSum, stats.mixerStatsCount) << ','
+            << average(stats.mixerFramesAvailableSum, stats.mixerStatsCount) << ','
+            << average(stats.mixerDesiredFramesSum, stats.mixerStatsCount) << ','
+            << stats.mixerStarves << ',' << stats.mixerDropped << '\n';
+}
+
+void LoadStats::flush(quint64 nowUsecs) {
+    QMutexLocker locker(&_mutex);
+
+    int endRow = frameForTime(nowUsecs) - FLUSH_DELAY_FRAMES;
+    for (; _nextRow < endRow; ++_nextRow) {
+        auto it = _frames.find(_nextRow);
+        if (it != _frames.end()) {
+            writeRow(_nextRow, it->second);
+            _frames.erase(it);
+        } else {
+            writeRow(_nextRow, LoadFrameStats());
+        }
+    }
+    _stream.flush();
+}
+
+void LoadStats::close() {
+    QMutexLocker locker(&_mutex);
+
+    for (auto& frame : _frames) {
+        writeRow(frame.first, frame.second);
+    }
+    _frames.clear();
+
+    if (_file.isOpen()) {
+        _stream.flush();
+        _file.close();
+    }
+}
+
+QString LoadStats::getSummary() const {
+    QMutexLocker locker(&_mutex);
+
+    const LoadFrameStats& t = _totals;
+    int audioExpected = t.audioReceived + t.audioLost;
+    float lossPercent = audioExpected > 0 ? 100.0f * t.audioLost / audioExpected : 0.0f;
+
+    return QString("audio: %1 sent, %2 received (%3 silent), %4 lost (%5%), %6 invalid, "
+                   "jitter %7 ms, latency %8 ms (max %9 ms)\n"
+                   "avatar: %10 sent, %11 received, latency %12 ms (max %13 ms)\n"
+                   "mixer: time gap %14 ms, %15 frames available, %16 desired, %17 starves, %18 dropped")
+        .arg(t.audioSent).arg(t.audioReceived).arg(t.audioSilent).arg(t.audioLost)
+        .arg(QString::number(lossPercent, 'f', 2)).arg(t.audioInvalid)
+        .arg(average(t.audioJitterSum, t.audioJitterCount))
+        .arg(average(t.audioLatencySum, t.audioLatencyCount))
+        .arg(QString::number(t.audioLatencyMax, 'f', 3))
+        .arg(t.avatarSent).arg(t.avatarReceived)
+        .arg(average(t.avatarLatencySum, t.avatarLatencyCount))
+        .arg(QString::number(t.avatarLatencyMax, 'f', 3))
+        .arg(average(t.mixerTimeGapSum, t.mixerStatsCount))
+        .arg(average(t.mixerFramesAvailableSum, t.mixerStatsCount))
+        .arg(average(t.mixerDesiredFramesSum, t.mixerStatsCount))
+        .arg(t.mixerStarves).arg(t.mixerDropped);
+}
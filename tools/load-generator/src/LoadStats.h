@@ -0,0 +1,92 @@
+//
+//  LoadStats.h
+//  tools/load-generator/src
+//
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_LoadStats_h
+#define hifi_LoadStats_h
+
+#include <atomic>
+#include <map>
+
+#include <QFile>
+#include <QMutex>
+#include <QTextStream>
+
+// The totals for one network frame, either of one agent or of the whole swarm.
+struct LoadFrameStats {
+    void add(const LoadFrameStats& other);
+    bool isEmpty() const;
+
+    int audioSent { 0 };
+    int avatarSent { 0 };
+
+    int audioReceived { 0 };
+    int audioSilent { 0 };
+    int audioLost { 0 };
+    int audioInvalid { 0 };
+    float audioJitterSum { 0.0f };
+    int audioJitterCount { 0 };
+    float audioLatencySum { 0.0f };
+    float audioLatencyMax { 0.0f };
+    int audioLatencyCount { 0 };
+
+    int avatarReceived { 0 };
+    float avatarLatencySum { 0.0f };
+    float avatarLatencyMax { 0.0f };
+    int avatarLatencyCount { 0 };
+
+    // as reported by the audio mixer for the microphone streams of the agents
+    float mixerTimeGapSum { 0.0f };
+    float mixerFramesAvailableSum { 0.0f };
+    float mixerDesiredFramesSum { 0.0f };
+    int mixerStatsCount { 0 };
+    int mixerStarves { 0 };
+    int mixerDropped { 0 };
+};
+
+// Collects the frame totals of every agent and writes them as one CSV row per network frame.
+// Agents run on several threads, so everything but the agent count is behind a mutex.
+class LoadStats {
+public:
+    LoadStats(quint64 startUsecs) : _startUsecs(startUsecs) {}
+
+    quint64 getStartUsecs() const { return _startUsecs; }
+    int frameForTime(quint64 usecs) const;
+
+    void agentConnected() { ++_numConnected; }
+    void agentDisconnected() { --_numConnected; }
+    int getNumConnected() const { return _numConnected; }
+
+    // called by the agents about once per frame
+    void addFrame(int frame, const LoadFrameStats& stats);
+
+    bool open(const QString& path);
+
+    // writes the rows of every frame that ended before the given time, less a margin for late agents
+    void flush(quint64 nowUsecs);
+    void close();
+
+    QString getSummary() const;
+
+private:
+    void writeRow(int frame, const LoadFrameStats& stats);
+
+    const quint64 _startUsecs;
+    std::atomic<int> _numConnected { 0 };
+
+    mutable QMutex _mutex;
+    std::map<int, LoadFrameStats> _frames;
+    LoadFrameStats _totals;
+    int _nextRow { 0 };
+
+    QFile _file;
+    QTextStream _stream;
+};
+
+#endif // hifi_LoadStats_h
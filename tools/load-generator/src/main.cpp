@@ -0,0 +1,23 @@
+//
+//  main.cpp
+//  tools/load-generator/src
+//
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include <SettingHandle.h>
+#include <SharedUtil.h>
+
+#include "LoadGeneratorApp.h"
+
+int main(int argc, char* argv[]) {
+    setupHifiApplication("Load Generator");
+
+    Setting::init();
+
+    LoadGeneratorApp app(argc, argv);
+    return app.exec();
+}
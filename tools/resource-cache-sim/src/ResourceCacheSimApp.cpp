@@ -0,0 +1,119 @@
+//
+//  ResourceCacheSimApp.cpp
+//  tools/resource-cache-sim/src
+//
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ResourceCacheSimApp.h"
+
+#include <QCommandLineParser>
+#include <QFile>
+#include <QSet>
+#include <QTextStream>
+
+#include <ResourceCacheTrace.h>
+
+static const qint64 BYTES_PER_MEGABYTE = 1024 * 1024;
+
+ResourceCacheSimApp::ResourceCacheSimApp(int argc, char* argv[]) : QCoreApplication(argc, argv) {
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Vircadia Resource Cache Eviction Simulator");
+    const QCommandLineOption helpOption = parser.addHelpOption();
+
+    const QCommandLineOption inputFilenameOption("i", "trace recorded with VIRCADIA_RESOURCE_CACHE_TRACE", "filename");
+    parser.addOption(inputFilenameOption);
+
+    const QCommandLineOption cacheOption("c", "only replay requests of this cache, e.g. TextureCache", "cache");
+    parser.addOption(cacheOption);
+
+    const QCommandLineOption budgetsOption("b", "comma separated unused resource budgets, in MB", "budgets", "100,1024");
+    parser.addOption(budgetsOption);
+
+    const QCommandLineOption policiesOption("p", "comma separated eviction policies: " +
+                                            ResourceEvictionPolicy::getTypeNames().join(", "), "policies",
+                                            ResourceEvictionPolicy::getTypeNames().join(","));
+    parser.addOption(policiesOption);
+
+    if (!parser.parse(QCoreApplication::arguments())) {
+        qCritical() << parser.errorText() << Qt::endl;
+        parser.showHelp();
+        _returnCode = 1;
+        return;
+    }
+
+    if (parser.isSet(helpOption)) {
+        parser.showHelp();
+        return;
+    }
+
+    if (!parser.isSet(inputFilenameOption)) {
+        qCritical() << "A trace file is required";
+        parser.showHelp();
+        _returnCode = 1;
+        return;
+    }
+
+    QList<qint64> budgets;
+    for (auto& budget : parser.value(budgetsOption).split(',', Qt::SkipEmptyParts)) {
+        bool valid = false;
+        qint64 megabytes = budget.trimmed().toLongLong(&valid);
+        if (!valid || megabytes < 0) {
+            qCritical() << "Invalid budget" << budget;
+            _returnCode = 1;
+            return;
+        }
+        budgets.append(megabytes * BYTES_PER_MEGABYTE);
+    }
+
+    QList<ResourceEvictionPolicy::Type> policies;
+    for (auto& name : parser.value(policiesOption).split(',', Qt::SkipEmptyParts)) {
+        ResourceEvictionPolicy::Type policy;
+        if (!ResourceEvictionPolicy::getTypeFromName(name.trimmed(), policy)) {
+            qCritical() << "Unknown eviction policy" << name;
+            _returnCode = 1;
+            return;
+        }
+        policies.append(policy);
+    }
+
+    QFile file(parser.value(inputFilenameOption));
+    std::vector<ResourceCacheTrace::Event> events;
+    if (!file.open(QIODevice::ReadOnly) || !ResourceCacheTrace::read(file, events)) {
+        qCritical() << "Failed to read trace" << file.fileName() << file.errorString();
+        _returnCode = 2;
+        return;
+    }
+
+    // each cache has its own budget, so replay them separately unless one was picked
+    QStringList caches;
+    if (parser.isSet(cacheOption)) {
+        caches.append(parser.value(cacheOption));
+    } else {
+        QSet<QString> seenCaches;
+        for (const auto& event : events) {
+            if (!seenCaches.contains(event.cache)) {
+                seenCaches.insert(event.cache);
+                caches.append(event.cache);
+            }
+        }
+    }
+
+    QTextStream out(stdout);
+    out << "cache\tpolicy\tbudget MB\trequests\thit ratio\tcompulsory\tevictions\trefetched MB\n";
+    for (auto& cache : caches) {
+        for (auto budget : budgets) {
+            for (auto policy : policies) {
+                auto result = ResourceCacheTrace::simulate(events, policy, budget, cache);
+                out << cache << '\t' << ResourceEvictionPolicy::getTypeName(policy) << '\t'
+                    << budget / BYTES_PER_MEGABYTE << '\t' << result.requests << '\t'
+                    << QString::number(result.getHitRatio(), 'f', 4) << '\t' << result.compulsoryMisses << '\t'
+                    << result.evictions << '\t'
+                    << QString::number((double)result.bytesRefetched / BYTES_PER_MEGABYTE, 'f', 2) << '\n';
+            }
+        }
+    }
+}
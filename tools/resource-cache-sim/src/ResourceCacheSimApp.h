@@ -0,0 +1,29 @@
+//
+//  ResourceCacheSimApp.h
+//  tools/resource-cache-sim/src
+//
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_ResourceCacheSimApp_h
+#define hifi_ResourceCacheSimApp_h
+
+#include <QCoreApplication>
+
+// Replays a trace recorded with VIRCADIA_RESOURCE_CACHE_TRACE against each resource eviction policy,
+// and prints the hit ratio and bytes re-fetched for every policy and budget.
+class ResourceCacheSimApp : public QCoreApplication {
+    Q_OBJECT
+public:
+    ResourceCacheSimApp(int argc, char* argv[]);
+
+    int getReturnCode() const { return _returnCode; }
+
+private:
+    int _returnCode { 0 };
+};
+
+#endif // hifi_ResourceCacheSimApp_h
@@ -0,0 +1,20 @@
+//
+//  main.cpp
+//  tools/resource-cache-sim/src
+//
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include <SharedUtil.h>
+
+#include "ResourceCacheSimApp.h"
+
+int main(int argc, char* argv[]) {
+    setupHifiApplication("Resource Cache Simulator");
+
+    ResourceCacheSimApp app(argc, argv);
+    return app.getReturnCode();
+}